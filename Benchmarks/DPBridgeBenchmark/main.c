@@ -0,0 +1,530 @@
+//
+//  main.c
+//  DPBridgeBenchmark
+//
+//  Bridge 事件缓冲区吞吐基准测试
+//
+//  测量项（事件 / 秒，越高越好）：
+//  - ring:        DPEventRing 无锁写入，N 个生产者线程 + 1 个消费者线程按批次取出
+//  - mutex_array: 互斥锁 + 有界数组（替换前 bufferQueue + [DebugEvent] 的等价 C 实现），同样的线程模型
+//
+//  每个生产者写入固定数量的事件，缓冲区已满时让出 CPU 后重试（不丢弃），
+//  耗时为第一个生产者开始到消费者取完全部事件
+//
+//  用法：
+//    DPBridgeBenchmark [--producers 1,4,8] [--events 200000] [--capacity 10000]
+//                      [--rounds 10] [--json] [--baseline <file>] [--max-regression 0.10]
+//
+//  --json 每行输出一个 JSON 对象；--baseline 读取之前的 --json 输出，
+//  任一测量项 p50 吞吐下降超过 --max-regression 时以退出码 2 结束
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "DPEventRing.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// MARK: - 常量定义
+
+/// 消费者每批取出的事件数（对应 Configuration.batchSize 默认值）
+#define DP_BENCH_BATCH 100
+
+/// 最多支持的生产者档位
+#define DP_BENCH_MAX_SIZES 8
+
+/// 单个档位最多的生产者线程数
+#define DP_BENCH_MAX_PRODUCERS 64
+
+/// 最多记录的测量结果
+#define DP_BENCH_MAX_RESULTS 32
+
+// MARK: - 数据结构
+
+/// 单项测量结果（事件 / 秒）
+typedef struct {
+    char name[32];
+    uint32_t producers;
+    uint32_t samples;
+    double min;
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+} DPBenchResult;
+
+/// 基准测试配置
+typedef struct {
+    uint32_t sizes[DP_BENCH_MAX_SIZES];
+    uint32_t sizeCount;
+    uint32_t events;
+    uint32_t capacity;
+    uint32_t rounds;
+    bool json;
+    const char* baselinePath;
+    double maxRegression;
+} DPBenchConfig;
+
+/// 被测缓冲区实现
+typedef struct DPBenchBuffer {
+    const char* name;
+    void* (*create)(uint32_t capacity);
+    void (*destroy)(void* buffer);
+    /// 写入一个事件，已满时返回 false
+    bool (*push)(void* buffer, uint64_t value);
+    /// 取出至多 maxCount 个事件，返回取出数量
+    uint32_t (*drain)(void* buffer, uint64_t* outValues, uint32_t maxCount);
+} DPBenchBuffer;
+
+/// 一轮测量的共享状态
+typedef struct {
+    const DPBenchBuffer* impl;
+    void* buffer;
+    uint32_t eventsPerProducer;
+    uint64_t expectedTotal;
+    _Atomic uint32_t ready;
+    _Atomic bool start;
+    /// 消费者得到的校验和（防止编译器消除读取）
+    uint64_t checksum;
+} DPBenchRun;
+
+/// 生产者线程参数
+typedef struct {
+    DPBenchRun* run;
+    uint32_t index;
+} DPBenchProducer;
+
+// MARK: - 全局数据
+
+static DPBenchResult g_results[DP_BENCH_MAX_RESULTS];
+static uint32_t g_resultCount = 0;
+
+// MARK: - 计时与统计
+
+static uint64_t dp_bench_now_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int dp_bench_compare_double(const void* a, const void* b) {
+    double lhs = *(const double*)a;
+    double rhs = *(const double*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static double dp_bench_percentile(const double* sorted, uint32_t count, double percentile) {
+    uint32_t index = (uint32_t)(percentile * (double)(count - 1) + 0.5);
+    return sorted[index];
+}
+
+/// 汇总样本并记录结果
+/// 吞吐越高越好，百分位按从低到高排列：p90 / p99 表示较好的轮次，min 为最差轮次
+static void dp_bench_record(const char* name, uint32_t producers, double* samples, uint32_t count) {
+    if (count == 0 || g_resultCount >= DP_BENCH_MAX_RESULTS) {
+        return;
+    }
+
+    qsort(samples, count, sizeof(double), dp_bench_compare_double);
+
+    double sum = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+
+    DPBenchResult* result = &g_results[g_resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->producers = producers;
+    result->samples = count;
+    result->min = samples[0];
+    result->mean = sum / count;
+    result->p50 = dp_bench_percentile(samples, count, 0.50);
+    result->p90 = dp_bench_percentile(samples, count, 0.90);
+    result->p99 = dp_bench_percentile(samples, count, 0.99);
+}
+
+// MARK: - DPEventRing
+
+/// 环形缓冲区 + 调用方持有的元素数组（与 Swift EventRingBuffer 的布局一致）
+typedef struct {
+    DPEventRing* ring;
+    uint64_t* values;
+    uint64_t mask;
+} DPBenchRing;
+
+static void* dp_bench_ring_create(uint32_t capacity) {
+    DPBenchRing* buffer = calloc(1, sizeof(DPBenchRing));
+    if (buffer == NULL) {
+        return NULL;
+    }
+    buffer->ring = DPEventRingCreate(capacity);
+    if (buffer->ring == NULL) {
+        free(buffer);
+        return NULL;
+    }
+    uint32_t slotCount = DPEventRingGetSlotCount(buffer->ring);
+    buffer->values = malloc((size_t)slotCount * sizeof(uint64_t));
+    buffer->mask = slotCount - 1;
+    return buffer;
+}
+
+static void dp_bench_ring_destroy(void* opaque) {
+    DPBenchRing* buffer = opaque;
+    DPEventRingDestroy(buffer->ring);
+    free(buffer->values);
+    free(buffer);
+}
+
+static bool dp_bench_ring_push(void* opaque, uint64_t value) {
+    DPBenchRing* buffer = opaque;
+    uint64_t position = 0;
+    if (!DPEventRingClaim(buffer->ring, &position)) {
+        return false;
+    }
+    buffer->values[position & buffer->mask] = value;
+    DPEventRingPublish(buffer->ring, position);
+    return true;
+}
+
+static uint32_t dp_bench_ring_drain(void* opaque, uint64_t* outValues, uint32_t maxCount) {
+    DPBenchRing* buffer = opaque;
+    uint32_t count = 0;
+    uint64_t position = 0;
+
+    DPEventRingLockConsumer(buffer->ring);
+    while (count < maxCount && DPEventRingPeek(buffer->ring, &position)) {
+        outValues[count++] = buffer->values[position & buffer->mask];
+        DPEventRingConsume(buffer->ring, position);
+    }
+    DPEventRingUnlockConsumer(buffer->ring);
+    return count;
+}
+
+static const DPBenchBuffer kDPBenchRing = {
+    "ring", dp_bench_ring_create, dp_bench_ring_destroy, dp_bench_ring_push, dp_bench_ring_drain,
+};
+
+// MARK: - 互斥锁 + 数组（基线）
+
+typedef struct {
+    pthread_mutex_t mutex;
+    uint64_t* values;
+    uint32_t capacity;
+    uint32_t head;
+    uint32_t count;
+} DPBenchLocked;
+
+static void* dp_bench_locked_create(uint32_t capacity) {
+    DPBenchLocked* buffer = calloc(1, sizeof(DPBenchLocked));
+    if (buffer == NULL) {
+        return NULL;
+    }
+    buffer->values = malloc((size_t)capacity * sizeof(uint64_t));
+    if (buffer->values == NULL) {
+        free(buffer);
+        return NULL;
+    }
+    pthread_mutex_init(&buffer->mutex, NULL);
+    buffer->capacity = capacity;
+    return buffer;
+}
+
+static void dp_bench_locked_destroy(void* opaque) {
+    DPBenchLocked* buffer = opaque;
+    pthread_mutex_destroy(&buffer->mutex);
+    free(buffer->values);
+    free(buffer);
+}
+
+static bool dp_bench_locked_push(void* opaque, uint64_t value) {
+    DPBenchLocked* buffer = opaque;
+    bool pushed = false;
+
+    pthread_mutex_lock(&buffer->mutex);
+    if (buffer->count < buffer->capacity) {
+        buffer->values[(buffer->head + buffer->count) % buffer->capacity] = value;
+        buffer->count++;
+        pushed = true;
+    }
+    pthread_mutex_unlock(&buffer->mutex);
+    return pushed;
+}
+
+static uint32_t dp_bench_locked_drain(void* opaque, uint64_t* outValues, uint32_t maxCount) {
+    DPBenchLocked* buffer = opaque;
+
+    pthread_mutex_lock(&buffer->mutex);
+    uint32_t count = buffer->count < maxCount ? buffer->count : maxCount;
+    for (uint32_t i = 0; i < count; i++) {
+        outValues[i] = buffer->values[buffer->head];
+        buffer->head = (buffer->head + 1) % buffer->capacity;
+    }
+    buffer->count -= count;
+    pthread_mutex_unlock(&buffer->mutex);
+    return count;
+}
+
+static const DPBenchBuffer kDPBenchLocked = {
+    "mutex_array", dp_bench_locked_create, dp_bench_locked_destroy, dp_bench_locked_push, dp_bench_locked_drain,
+};
+
+// MARK: - 线程模型
+
+/// 所有线程就绪后同时开始
+static void dp_bench_wait_start(DPBenchRun* run) {
+    atomic_fetch_add_explicit(&run->ready, 1, memory_order_acq_rel);
+    while (!atomic_load_explicit(&run->start, memory_order_acquire)) {
+        sched_yield();
+    }
+}
+
+static void* dp_bench_producer_main(void* context) {
+    DPBenchProducer* producer = context;
+    DPBenchRun* run = producer->run;
+    uint64_t base = (uint64_t)producer->index << 32;
+
+    dp_bench_wait_start(run);
+    for (uint32_t i = 0; i < run->eventsPerProducer; i++) {
+        while (!run->impl->push(run->buffer, base | i)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void* dp_bench_consumer_main(void* context) {
+    DPBenchRun* run = context;
+    uint64_t values[DP_BENCH_BATCH];
+    uint64_t received = 0;
+    uint64_t checksum = 0;
+
+    dp_bench_wait_start(run);
+    while (received < run->expectedTotal) {
+        uint32_t count = run->impl->drain(run->buffer, values, DP_BENCH_BATCH);
+        if (count == 0) {
+            sched_yield();
+            continue;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            checksum += values[i];
+        }
+        received += count;
+    }
+    run->checksum = checksum;
+    return NULL;
+}
+
+/// 执行一轮，返回吞吐（事件 / 秒），失败时返回 0
+static double dp_bench_run_once(const DPBenchBuffer* impl, const DPBenchConfig* config, uint32_t producers) {
+    DPBenchRun run;
+    memset(&run, 0, sizeof(run));
+    run.impl = impl;
+    run.buffer = impl->create(config->capacity);
+    run.eventsPerProducer = config->events;
+    run.expectedTotal = (uint64_t)config->events * producers;
+    atomic_init(&run.ready, 0);
+    atomic_init(&run.start, false);
+    if (run.buffer == NULL) {
+        fprintf(stderr, "%s: failed to create buffer\n", impl->name);
+        return 0;
+    }
+
+    pthread_t consumer;
+    pthread_t threads[DP_BENCH_MAX_PRODUCERS];
+    DPBenchProducer contexts[DP_BENCH_MAX_PRODUCERS];
+    pthread_create(&consumer, NULL, dp_bench_consumer_main, &run);
+    for (uint32_t i = 0; i < producers; i++) {
+        contexts[i].run = &run;
+        contexts[i].index = i;
+        pthread_create(&threads[i], NULL, dp_bench_producer_main, &contexts[i]);
+    }
+
+    while (atomic_load_explicit(&run.ready, memory_order_acquire) < producers + 1) {
+        sched_yield();
+    }
+    uint64_t start = dp_bench_now_nanos();
+    atomic_store_explicit(&run.start, true, memory_order_release);
+
+    for (uint32_t i = 0; i < producers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_join(consumer, NULL);
+    uint64_t elapsed = dp_bench_now_nanos() - start;
+
+    // 每个生产者写入 (index << 32) | i，校验和可直接算出
+    uint64_t expectedChecksum = 0;
+    uint64_t perProducerSum = (uint64_t)config->events * (config->events - 1) / 2;
+    for (uint32_t i = 0; i < producers; i++) {
+        expectedChecksum += ((uint64_t)i << 32) * config->events + perProducerSum;
+    }
+    impl->destroy(run.buffer);
+    if (run.checksum != expectedChecksum) {
+        fprintf(stderr, "%s: checksum mismatch (lost or duplicated events)\n", impl->name);
+        return 0;
+    }
+
+    return elapsed > 0 ? (double)run.expectedTotal * 1e9 / (double)elapsed : 0;
+}
+
+static bool dp_bench_throughput(const DPBenchBuffer* impl, const DPBenchConfig* config, uint32_t producers) {
+    double* samples = malloc(config->rounds * sizeof(double));
+    if (samples == NULL) {
+        return false;
+    }
+
+    for (uint32_t round = 0; round < config->rounds; round++) {
+        samples[round] = dp_bench_run_once(impl, config, producers);
+        if (samples[round] == 0) {
+            free(samples);
+            return false;
+        }
+    }
+    dp_bench_record(impl->name, producers, samples, config->rounds);
+    free(samples);
+    return true;
+}
+
+// MARK: - 输出与回归门禁
+
+static void dp_bench_print(bool json) {
+    if (!json) {
+        printf("%-14s %9s %8s %12s %12s %12s %12s %12s\n",
+               "benchmark", "producers", "samples", "min", "mean", "p50", "p90", "p99");
+    }
+
+    for (uint32_t i = 0; i < g_resultCount; i++) {
+        const DPBenchResult* r = &g_results[i];
+        if (json) {
+            printf("{\"name\":\"%s\",\"producers\":%u,\"samples\":%u,\"unit\":\"events/s\","
+                   "\"min\":%.0f,\"mean\":%.0f,\"p50\":%.0f,\"p90\":%.0f,\"p99\":%.0f}\n",
+                   r->name, r->producers, r->samples, r->min, r->mean, r->p50, r->p90, r->p99);
+        } else {
+            printf("%-14s %9u %8u %12.0f %12.0f %12.0f %12.0f %12.0f\n",
+                   r->name, r->producers, r->samples, r->min, r->mean, r->p50, r->p90, r->p99);
+        }
+    }
+}
+
+/// 与基线比较 p50 吞吐，返回回退的测量项数量
+static int dp_bench_compare_baseline(const char* path, double maxRegression) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "cannot open baseline %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    int regressions = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char name[32];
+        unsigned producers = 0;
+        double p50 = 0;
+
+        const char* nameField = strstr(line, "\"name\":\"");
+        const char* producersField = strstr(line, "\"producers\":");
+        const char* p50Field = strstr(line, "\"p50\":");
+        if (nameField == NULL || producersField == NULL || p50Field == NULL ||
+            sscanf(nameField, "\"name\":\"%31[^\"]\"", name) != 1 ||
+            sscanf(producersField, "\"producers\":%u", &producers) != 1 ||
+            sscanf(p50Field, "\"p50\":%lf", &p50) != 1) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < g_resultCount; i++) {
+            const DPBenchResult* r = &g_results[i];
+            // mutex_array 为参照项，不参与门禁
+            if (r->producers != producers || strcmp(r->name, name) != 0 || strcmp(name, "mutex_array") == 0) {
+                continue;
+            }
+            if (p50 > 0 && r->p50 < p50 * (1.0 - maxRegression)) {
+                fprintf(stderr, "REGRESSION %s[%u]: p50 %.0f -> %.0f events/s (%.1f%%)\n",
+                        name, producers, p50, r->p50, (r->p50 / p50 - 1.0) * 100.0);
+                regressions++;
+            }
+        }
+    }
+
+    fclose(file);
+    return regressions;
+}
+
+// MARK: - 入口
+
+static bool dp_bench_parse_args(int argc, char** argv, DPBenchConfig* config) {
+    config->sizes[0] = 1;
+    config->sizes[1] = 4;
+    config->sizes[2] = 8;
+    config->sizeCount = 3;
+    config->events = 200000;
+    config->capacity = 10000;
+    config->rounds = 10;
+    config->json = false;
+    config->baselinePath = NULL;
+    config->maxRegression = 0.10;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            config->json = true;
+        } else if (strcmp(argv[i], "--producers") == 0 && i + 1 < argc) {
+            config->sizeCount = 0;
+            char* cursor = argv[++i];
+            while (*cursor != '\0' && config->sizeCount < DP_BENCH_MAX_SIZES) {
+                char* end = NULL;
+                unsigned long value = strtoul(cursor, &end, 10);
+                if (end == cursor || value == 0 || value > DP_BENCH_MAX_PRODUCERS) return false;
+                config->sizes[config->sizeCount++] = (uint32_t)value;
+                cursor = (*end == ',') ? end + 1 : end;
+            }
+        } else if (strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+            config->events = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--capacity") == 0 && i + 1 < argc) {
+            config->capacity = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            config->rounds = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            config->baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--max-regression") == 0 && i + 1 < argc) {
+            config->maxRegression = strtod(argv[++i], NULL);
+        } else {
+            return false;
+        }
+    }
+    return config->sizeCount > 0 && config->events > 0 && config->capacity > 0 && config->rounds > 0;
+}
+
+int main(int argc, char** argv) {
+    DPBenchConfig config;
+    if (!dp_bench_parse_args(argc, argv, &config)) {
+        fprintf(stderr, "usage: %s [--producers 1,4,8] [--events 200000] [--capacity 10000] "
+                        "[--rounds 10] [--json] [--baseline <file>] [--max-regression 0.10]\n", argv[0]);
+        return 64;
+    }
+
+    for (uint32_t i = 0; i < config.sizeCount; i++) {
+        if (!dp_bench_throughput(&kDPBenchRing, &config, config.sizes[i]) ||
+            !dp_bench_throughput(&kDPBenchLocked, &config, config.sizes[i])) {
+            return 1;
+        }
+    }
+
+    dp_bench_print(config.json);
+
+    int status = 0;
+    if (config.baselinePath != NULL) {
+        int regressions = dp_bench_compare_baseline(config.baselinePath, config.maxRegression);
+        status = regressions < 0 ? 1 : (regressions > 0 ? 2 : 0);
+    }
+    return status;
+}
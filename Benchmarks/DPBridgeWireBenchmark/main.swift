@@ -0,0 +1,286 @@
+// main.swift
+// DPBridgeWireBenchmark
+//
+// Created by Sun on 2025/12/18.
+// Copyright © 2025 Sun. All rights reserved.
+//
+// Bridge 传输编码对比：JSON vs binary-v1，各自不压缩 / deflate-dict-v1
+//
+// 测量项（每种编码 + 压缩组合）：
+// - bytes_per_event:  批量上报消息的线上字节数 / 事件数
+// - encode_ns:        采集线程上编码单个事件的耗时（EncodedEvent.init）
+// - e2e_events_per_s: 拼接批量消息 -> 压缩 -> 管道 -> 本地 Hub 替身解压并解码出 BridgeMessage 的端到端吞吐
+// - ratio / cpu_us_per_kb: 压缩率与每 KB 的压缩 CPU 时间（BridgeBatchCompressor.stats）
+//
+// 本地 Hub 替身：独立线程从管道读取 4 字节长度 + 消息（模拟 WebSocket 消息边界），
+// 去掉压缩信封后用 BridgeWireCodec.decodeMessages 解码并核对事件数，与真实 Hub 的解析工作量一致
+//
+// 用法：
+//   DPBridgeWireBenchmark [--events 20000] [--batch 100] [--body-size 4096] [--threshold 1024] [--json]
+//
+
+import DebugProbe
+import Foundation
+
+// MARK: - 配置
+
+struct BenchConfig {
+    var events = 20000
+    var batch = 100
+    var bodySize = 4096
+    var threshold = 1024
+    var json = false
+
+    init?(arguments: [String]) {
+        var iterator = arguments.dropFirst().makeIterator()
+        while let argument = iterator.next() {
+            switch argument {
+            case "--json":
+                json = true
+            case "--events":
+                guard let value = iterator.next().flatMap(Int.init), value > 0 else { return nil }
+                events = value
+            case "--batch":
+                guard let value = iterator.next().flatMap(Int.init), value > 0 else { return nil }
+                batch = value
+            case "--body-size":
+                guard let value = iterator.next().flatMap(Int.init), value >= 0 else { return nil }
+                bodySize = value
+            case "--threshold":
+                guard let value = iterator.next().flatMap(Int.init), value >= 0 else { return nil }
+                threshold = value
+            default:
+                return nil
+            }
+        }
+    }
+}
+
+struct BenchResult {
+    let encoding: BridgeWireEncoding
+    let compression: BridgeWireCompression
+    let events: Int
+    let wireBytes: Int
+    let encodeNanosPerEvent: Double
+    let endToEndEventsPerSecond: Double
+    let compressionStats: BridgeCompressionStats?
+
+    var name: String {
+        compression == .none ? encoding.rawValue : "\(encoding.rawValue)+\(compression.rawValue)"
+    }
+
+    var bytesPerEvent: Double {
+        Double(wireBytes) / Double(events)
+    }
+}
+
+// MARK: - 合成事件
+
+/// 生成 HTTP（带请求 / 响应体）与日志事件交替的样本
+func makeEvents(count: Int, bodySize: Int) -> [DebugEvent] {
+    // 类 JSON 的响应体，压缩特性接近真实接口返回
+    let unit = Array(#"{"id":12345,"name":"item","tags":["a","b"],"price":9.99},"#.utf8)
+    var body = [UInt8]()
+    body.reserveCapacity(bodySize)
+    while body.count < bodySize {
+        body.append(unit[body.count % unit.count])
+    }
+    let responseBody = Data(body)
+    let requestBody = Data(#"{"page":1,"pageSize":20,"filter":"recent"}"#.utf8)
+
+    return (0..<count).map { index in
+        if index % 4 == 3 {
+            return .log(LogEvent(
+                source: .osLog,
+                level: .info,
+                subsystem: "com.example.app",
+                category: "network",
+                message: "Request \(index) finished in \(index % 500) ms",
+                tags: ["bench"]
+            ))
+        }
+        let request = HTTPEvent.Request(
+            method: "POST",
+            url: "https://api.example.com/v1/items?page=\(index)",
+            queryItems: ["page": "\(index)"],
+            headers: ["Content-Type": "application/json", "Accept": "application/json", "Authorization": "Bearer token"],
+            body: requestBody
+        )
+        let response = HTTPEvent.Response(
+            statusCode: 200,
+            headers: ["Content-Type": "application/json", "Cache-Control": "no-cache"],
+            body: responseBody,
+            duration: 0.123
+        )
+        return .http(HTTPEvent(request: request, response: response, timing: HTTPEvent.Timing(protocolName: "h2")))
+    }
+}
+
+// MARK: - Hub 替身
+
+/// 从管道读取消息并解码，统计收到的事件数
+final class HubStandIn {
+    private let input: FileHandle
+    private let expectedEvents: Int
+    private let enveloped: Bool
+    private let finished = DispatchSemaphore(value: 0)
+    private(set) var receivedEvents = 0
+    private(set) var decodeErrors = 0
+
+    init(input: FileHandle, expectedEvents: Int, enveloped: Bool) {
+        self.input = input
+        self.expectedEvents = expectedEvents
+        self.enveloped = enveloped
+    }
+
+    func start() {
+        let thread = Thread { [self] in
+            run()
+            finished.signal()
+        }
+        thread.start()
+    }
+
+    func wait() {
+        finished.wait()
+    }
+
+    private func run() {
+        while receivedEvents < expectedEvents {
+            let header = input.readData(ofLength: 4)
+            guard header.count == 4 else { return }
+            let length = header.reduce(0) { ($0 << 8) | Int($1) }
+            let message = input.readData(ofLength: length)
+            do {
+                let payload = enveloped ? try BridgeCompressionEnvelope.unwrap(message) : message
+                for case let .events(events) in try BridgeWireCodec.decodeMessages(from: payload) {
+                    receivedEvents += events.count
+                }
+            } catch {
+                decodeErrors += 1
+                return
+            }
+        }
+    }
+}
+
+// MARK: - 测量
+
+func nowNanos() -> UInt64 {
+    DispatchTime.now().uptimeNanoseconds
+}
+
+func run(
+    encoding: BridgeWireEncoding,
+    compression: BridgeWireCompression,
+    events: [DebugEvent],
+    config: BenchConfig
+) -> BenchResult? {
+    // 采集线程：每个事件编码一次
+    let encodeStart = nowNanos()
+    let encoded: [EncodedEvent]
+    do {
+        encoded = try events.map { try EncodedEvent($0, encoding: encoding) }
+    } catch {
+        print("encode failed (\(encoding.rawValue)): \(error)")
+        return nil
+    }
+    let encodeNanos = nowNanos() - encodeStart
+
+    // 刷新线程：按批拼接、压缩，写入管道；Hub 替身并行解压、解码
+    let compressor = compression == .none ? nil : BridgeBatchCompressor(level: 6, threshold: config.threshold)
+    let pipe = Pipe()
+    let hub = HubStandIn(input: pipe.fileHandleForReading, expectedEvents: events.count, enveloped: compressor != nil)
+    hub.start()
+
+    var wireBytes = 0
+    let sendStart = nowNanos()
+    var index = 0
+    while index < encoded.count {
+        let batch = Array(encoded[index..<min(index + config.batch, encoded.count)])
+        var message = BridgeMessage.encodedEventsMessage(batch, encoding: encoding)
+        if let compressor {
+            message = compressor.envelope(message)
+        }
+        wireBytes += message.count
+
+        let length = UInt32(message.count)
+        var frame = Data([UInt8(length >> 24), UInt8((length >> 16) & 0xFF), UInt8((length >> 8) & 0xFF), UInt8(length & 0xFF)])
+        frame.append(message)
+        pipe.fileHandleForWriting.write(frame)
+        index += config.batch
+    }
+    hub.wait()
+    let sendNanos = nowNanos() - sendStart
+
+    guard hub.decodeErrors == 0, hub.receivedEvents == events.count else {
+        print("hub received \(hub.receivedEvents)/\(events.count) events (\(encoding.rawValue), \(compression.rawValue))")
+        return nil
+    }
+
+    return BenchResult(
+        encoding: encoding,
+        compression: compression,
+        events: events.count,
+        wireBytes: wireBytes,
+        encodeNanosPerEvent: Double(encodeNanos) / Double(events.count),
+        endToEndEventsPerSecond: Double(events.count) * 1e9 / Double(encodeNanos + sendNanos),
+        compressionStats: compressor?.stats
+    )
+}
+
+// MARK: - 入口
+
+guard let config = BenchConfig(arguments: CommandLine.arguments) else {
+    print("usage: DPBridgeWireBenchmark [--events 20000] [--batch 100] [--body-size 4096] [--threshold 1024] [--json]")
+    exit(64)
+}
+
+let events = makeEvents(count: config.events, bodySize: config.bodySize)
+var results: [BenchResult] = []
+for encoding in BridgeWireEncoding.allCases {
+    for compression in BridgeWireCompression.allCases {
+        guard let result = run(encoding: encoding, compression: compression, events: events, config: config) else {
+            exit(1)
+        }
+        results.append(result)
+    }
+}
+
+if config.json {
+    for result in results {
+        print(
+            #"{"encoding":"\#(result.encoding.rawValue)","compression":"\#(result.compression.rawValue)","#
+                + #""events":\#(result.events),"wire_bytes":\#(result.wireBytes),"#
+                + #""bytes_per_event":\#(String(format: "%.1f", result.bytesPerEvent)),"#
+                + #""encode_ns":\#(String(format: "%.0f", result.encodeNanosPerEvent)),"#
+                + #""e2e_events_per_s":\#(String(format: "%.0f", result.endToEndEventsPerSecond)),"#
+                + #""ratio":\#(String(format: "%.2f", result.compressionStats?.compressionRatio ?? 1)),"#
+                + #""cpu_us_per_kb":\#(String(format: "%.1f", result.compressionStats?.cpuMicrosPerKB ?? 0))}"#
+        )
+    }
+} else {
+    print("encoding                    events   wire_bytes  bytes/event  encode_ns  e2e_events/s   ratio  cpu_us/KB")
+    for result in results {
+        let name = result.name.padding(toLength: 25, withPad: " ", startingAt: 0)
+        print(name + String(
+            format: " %8d %12d %12.1f %10.0f %13.0f %7.2f %10.1f",
+            result.events,
+            result.wireBytes,
+            result.bytesPerEvent,
+            result.encodeNanosPerEvent,
+            result.endToEndEventsPerSecond,
+            result.compressionStats?.compressionRatio ?? 1,
+            result.compressionStats?.cpuMicrosPerKB ?? 0
+        ))
+    }
+    if let baseline = results.first(where: { $0.encoding == .json && $0.compression == .none }) {
+        for result in results where result.name != baseline.name {
+            print(result.name + String(
+                format: " / json: %.1f%% bytes, %.2fx end-to-end throughput",
+                Double(result.wireBytes) / Double(baseline.wireBytes) * 100,
+                result.endToEndEventsPerSecond / baseline.endToEndEventsPerSecond
+            ))
+        }
+    }
+}
@@ -0,0 +1,647 @@
+//
+//  main.c
+//  DPPreMainBenchmark
+//
+//  PreMain 监控热路径基准测试
+//
+//  测量项：
+//  - callback:        dyld 镜像加载回调热路径（每次回调）
+//  - mach_to_nanos:   DPMachTimeToNanos（每次转换）
+//  - mach_to_nanos_batch: DPMachTimesToNanos（平台换算比例，写入独立输出缓冲区，按元素均摊）
+//  - mach_to_nanos_batch_fixed: 同上，以 125/3（Apple Silicon）覆盖换算比例，测量定点乘法路径
+//  - resolve_first:   首次查询时的延迟解析（dladdr + 名称驻留，按镜像均摊）
+//  - get_all:         DPPreMainGetAllDylibs（已解析，每次调用）
+//  - get_slowest_20:  DPPreMainGetSlowestDylibs(count = 20)（每次调用）
+//  - copy_snapshot:   DPPreMainCopySnapshot 复制全部数据与名称/耗时列（已解析，每次调用）
+//  - export_trace:    DPPreMainExportChromeTrace 生成完整时间线（仅计算长度，每次调用）
+//  - dlopen:          dlopen 单个合成共享库的耗时（启动开销的分母）
+//  - startup_overhead_pct: 回调 p50 / 单个 dlopen 平均耗时，监控在镜像加载阶段引入的额外开销
+//
+//  合成共享库：用 $CC 编译一个模板共享库，再复制 N 份到临时目录后逐个 dlopen
+//
+//  用法：
+//    DPPreMainBenchmark [--images 100,500,5000] [--rounds 30] [--json]
+//                       [--baseline <file>] [--max-regression 0.10]
+//
+//  --json 每行输出一个 JSON 对象；--baseline 读取之前的 --json 输出，
+//  任一测量项 p50 回退超过 --max-regression 时以退出码 2 结束，可直接作为回归门禁
+//
+//  测量前先以一组 numer / denom 校验定点换算与 (__int128)t * numer / denom 完全一致，不一致时以退出码 1 结束
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "DPPreMainMonitor.h"
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// 回调热路径与时间基准覆盖（声明见 Sources/Core/PreMain/DPPreMainInternal.h）
+void dp_dyld_image_added_callback(const void* mh, intptr_t slide);
+void dp_timebase_override(uint32_t numer, uint32_t denom);
+
+// MARK: - 常量定义
+
+/// 单个样本内重复执行的次数（摊薄计时开销）
+#define DP_BENCH_BATCH 16
+
+/// 最多支持的镜像规模档位
+#define DP_BENCH_MAX_SIZES 8
+
+/// 最多记录的测量结果
+#define DP_BENCH_MAX_RESULTS 64
+
+#if defined(__APPLE__)
+#define DP_BENCH_SHARED_FLAGS "-dynamiclib"
+#define DP_BENCH_LIBRARY_SUFFIX "dylib"
+#else
+#define DP_BENCH_SHARED_FLAGS "-shared -fPIC"
+#define DP_BENCH_LIBRARY_SUFFIX "so"
+#endif
+
+// MARK: - 数据结构
+
+/// 单项测量结果（纳秒 / 操作）
+typedef struct {
+    char name[32];
+    uint32_t images;
+    uint32_t samples;
+    double min;
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+} DPBenchResult;
+
+/// 基准测试配置
+typedef struct {
+    uint32_t sizes[DP_BENCH_MAX_SIZES];
+    uint32_t sizeCount;
+    uint32_t rounds;
+    bool json;
+    const char* baselinePath;
+    double maxRegression;
+} DPBenchConfig;
+
+// MARK: - 全局数据
+
+static DPBenchResult g_results[DP_BENCH_MAX_RESULTS];
+static uint32_t g_resultCount = 0;
+
+/// 合成共享库所在目录
+static char g_workDir[256];
+
+// MARK: - 计时与统计
+
+static uint64_t dp_bench_now_nanos(void) {
+    return DPMachTimeToNanos(DPGetCurrentMachTime());
+}
+
+static int dp_bench_compare_double(const void* a, const void* b) {
+    double lhs = *(const double*)a;
+    double rhs = *(const double*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static double dp_bench_percentile(const double* sorted, uint32_t count, double percentile) {
+    uint32_t index = (uint32_t)(percentile * (double)(count - 1) + 0.5);
+    return sorted[index];
+}
+
+/// 汇总样本并记录结果
+static void dp_bench_record(const char* name, uint32_t images, double* samples, uint32_t count) {
+    if (count == 0 || g_resultCount >= DP_BENCH_MAX_RESULTS) {
+        return;
+    }
+
+    qsort(samples, count, sizeof(double), dp_bench_compare_double);
+
+    double sum = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+
+    DPBenchResult* result = &g_results[g_resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->images = images;
+    result->samples = count;
+    result->min = samples[0];
+    result->mean = sum / count;
+    result->p50 = dp_bench_percentile(samples, count, 0.50);
+    result->p90 = dp_bench_percentile(samples, count, 0.90);
+    result->p99 = dp_bench_percentile(samples, count, 0.99);
+}
+
+// MARK: - 合成共享库
+
+/// 复制文件
+static bool dp_bench_copy_file(const char* from, const char* to) {
+    int in = open(from, O_RDONLY);
+    if (in < 0) return false;
+    int out = open(to, O_WRONLY | O_CREAT | O_TRUNC, 0755);
+    if (out < 0) {
+        close(in);
+        return false;
+    }
+
+    char buffer[16 * 1024];
+    ssize_t n;
+    bool ok = true;
+    while ((n = read(in, buffer, sizeof(buffer))) > 0) {
+        if (write(out, buffer, (size_t)n) != n) {
+            ok = false;
+            break;
+        }
+    }
+    close(in);
+    close(out);
+    return ok && n == 0;
+}
+
+/// 编译模板共享库并复制 count 份
+static bool dp_bench_generate_libraries(uint32_t count) {
+    snprintf(g_workDir, sizeof(g_workDir), "%s/dp_premain_bench_XXXXXX",
+             getenv("TMPDIR") != NULL ? getenv("TMPDIR") : "/tmp");
+    if (mkdtemp(g_workDir) == NULL) {
+        fprintf(stderr, "mkdtemp failed: %s\n", strerror(errno));
+        return false;
+    }
+
+    char sourcePath[320];
+    char templatePath[320];
+    snprintf(sourcePath, sizeof(sourcePath), "%s/template.c", g_workDir);
+    snprintf(templatePath, sizeof(templatePath), "%s/template." DP_BENCH_LIBRARY_SUFFIX, g_workDir);
+
+    FILE* source = fopen(sourcePath, "w");
+    if (source == NULL) return false;
+    fputs("int dp_bench_value = 1;\n"
+          "static int dp_bench_counter;\n"
+          "__attribute__((constructor)) static void dp_bench_init(void) { dp_bench_counter = dp_bench_value; }\n"
+          "int dp_bench_symbol(void) { return dp_bench_counter; }\n", source);
+    fclose(source);
+
+    const char* compiler = getenv("CC") != NULL ? getenv("CC") : "cc";
+    char command[1024];
+    snprintf(command, sizeof(command), "%s " DP_BENCH_SHARED_FLAGS " -O2 -o '%s' '%s'",
+             compiler, templatePath, sourcePath);
+    if (system(command) != 0) {
+        fprintf(stderr, "failed to build template library: %s\n", command);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        char path[320];
+        snprintf(path, sizeof(path), "%s/libdpbench_%05u." DP_BENCH_LIBRARY_SUFFIX, g_workDir, i);
+        if (!dp_bench_copy_file(templatePath, path)) {
+            fprintf(stderr, "failed to copy %s\n", path);
+            return false;
+        }
+    }
+    return true;
+}
+
+/// 删除临时目录
+static void dp_bench_cleanup_libraries(void) {
+    if (g_workDir[0] == '\0') return;
+    char command[320];
+    snprintf(command, sizeof(command), "rm -rf '%s'", g_workDir);
+    if (system(command) != 0) {
+        fprintf(stderr, "failed to remove %s\n", g_workDir);
+    }
+}
+
+// MARK: - 测量项
+
+/// dlopen 合成共享库，返回镜像头地址（dladdr 解析符号所在镜像）
+static bool dp_bench_load_libraries(uint32_t count, const void** outHeaders, void** outHandles) {
+    double* samples = malloc(count * sizeof(double));
+    if (samples == NULL) return false;
+
+    for (uint32_t i = 0; i < count; i++) {
+        char path[320];
+        snprintf(path, sizeof(path), "%s/libdpbench_%05u." DP_BENCH_LIBRARY_SUFFIX, g_workDir, i);
+
+        uint64_t start = dp_bench_now_nanos();
+        void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+        samples[i] = (double)(dp_bench_now_nanos() - start);
+
+        if (handle == NULL) {
+            fprintf(stderr, "dlopen failed: %s\n", dlerror());
+            free(samples);
+            return false;
+        }
+
+        Dl_info info;
+        void* symbol = dlsym(handle, "dp_bench_symbol");
+        outHeaders[i] = (symbol != NULL && dladdr(symbol, &info)) ? info.dli_fbase : handle;
+        outHandles[i] = handle;
+    }
+
+    dp_bench_record("dlopen", count, samples, count);
+    free(samples);
+    return true;
+}
+
+/// 回调热路径：每轮重置后按镜像顺序回调 N 次
+static void dp_bench_callback(const void** headers, uint32_t count, uint32_t rounds) {
+    uint32_t batches = count / DP_BENCH_BATCH;
+    if (batches == 0) return;
+
+    double* samples = malloc((size_t)batches * rounds * sizeof(double));
+    if (samples == NULL) return;
+    uint32_t sampleCount = 0;
+
+    for (uint32_t round = 0; round < rounds; round++) {
+        DPPreMainReset();
+        for (uint32_t batch = 0; batch < batches; batch++) {
+            uint64_t start = dp_bench_now_nanos();
+            for (uint32_t i = 0; i < DP_BENCH_BATCH; i++) {
+                uint32_t index = batch * DP_BENCH_BATCH + i;
+                dp_dyld_image_added_callback(headers[index], (intptr_t)index);
+            }
+            samples[sampleCount++] = (double)(dp_bench_now_nanos() - start) / DP_BENCH_BATCH;
+        }
+    }
+
+    dp_bench_record("callback", count, samples, sampleCount);
+    free(samples);
+}
+
+/// 查询路径：首次解析、GetAllDylibs、GetSlowestDylibs
+static void dp_bench_queries(const void** headers, uint32_t count, uint32_t rounds) {
+    double* resolveSamples = malloc(rounds * sizeof(double));
+    double* allSamples = malloc(rounds * sizeof(double));
+    double* slowestSamples = malloc(rounds * sizeof(double));
+    double* snapshotSamples = malloc(rounds * sizeof(double));
+    double* exportSamples = malloc(rounds * sizeof(double));
+    DPDylibLoadInfo* buffer = malloc(count * sizeof(DPDylibLoadInfo));
+    uint32_t* nameOffsets = malloc(count * sizeof(uint32_t));
+    uint64_t* durations = malloc(count * sizeof(uint64_t));
+    DPDylibLoadInfo slowest[20];
+
+    if (resolveSamples == NULL || allSamples == NULL || slowestSamples == NULL || snapshotSamples == NULL
+        || exportSamples == NULL || buffer == NULL || nameOffsets == NULL || durations == NULL) {
+        free(resolveSamples);
+        free(allSamples);
+        free(slowestSamples);
+        free(snapshotSamples);
+        free(exportSamples);
+        free(buffer);
+        free(nameOffsets);
+        free(durations);
+        return;
+    }
+
+    for (uint32_t round = 0; round < rounds; round++) {
+        DPPreMainReset();
+        for (uint32_t i = 0; i < count; i++) {
+            dp_dyld_image_added_callback(headers[i], (intptr_t)i);
+        }
+
+        uint64_t start = dp_bench_now_nanos();
+        DPPreMainGetData();
+        resolveSamples[round] = (double)(dp_bench_now_nanos() - start) / count;
+
+        start = dp_bench_now_nanos();
+        DPPreMainGetAllDylibs(buffer, count);
+        allSamples[round] = (double)(dp_bench_now_nanos() - start);
+
+        start = dp_bench_now_nanos();
+        DPPreMainGetSlowestDylibs(slowest, 20);
+        slowestSamples[round] = (double)(dp_bench_now_nanos() - start);
+
+        DPPreMainData data;
+        DPDylibColumns columns = {
+            .capacity = count,
+            .loadDurationNanos = durations,
+            .nameOffsets = nameOffsets,
+        };
+        start = dp_bench_now_nanos();
+        DPPreMainCopySnapshot(&data, &columns);
+        snapshotSamples[round] = (double)(dp_bench_now_nanos() - start);
+
+        start = dp_bench_now_nanos();
+        DPPreMainExportChromeTrace(NULL, 0);
+        exportSamples[round] = (double)(dp_bench_now_nanos() - start);
+    }
+
+    dp_bench_record("resolve_first", count, resolveSamples, rounds);
+    dp_bench_record("get_all", count, allSamples, rounds);
+    dp_bench_record("get_slowest_20", count, slowestSamples, rounds);
+    dp_bench_record("copy_snapshot", count, snapshotSamples, rounds);
+    dp_bench_record("export_trace", count, exportSamples, rounds);
+
+    free(resolveSamples);
+    free(allSamples);
+    free(slowestSamples);
+    free(snapshotSamples);
+    free(exportSamples);
+    free(buffer);
+    free(nameOffsets);
+    free(durations);
+}
+
+/// 时间换算
+static void dp_bench_mach_to_nanos(uint32_t rounds) {
+    enum { kBatches = 4096 };
+    double* samples = malloc((size_t)kBatches * rounds * sizeof(double));
+    if (samples == NULL) return;
+
+    volatile uint64_t sink = 0;
+    uint64_t machTime = DPGetCurrentMachTime();
+    uint32_t sampleCount = 0;
+
+    for (uint32_t round = 0; round < rounds; round++) {
+        for (uint32_t batch = 0; batch < kBatches; batch++) {
+            uint64_t start = dp_bench_now_nanos();
+            for (uint32_t i = 0; i < DP_BENCH_BATCH; i++) {
+                sink += DPMachTimeToNanos(machTime + i);
+            }
+            samples[sampleCount++] = (double)(dp_bench_now_nanos() - start) / DP_BENCH_BATCH;
+        }
+    }
+
+    dp_bench_record("mach_to_nanos", 0, samples, sampleCount);
+
+    // 批量换算（每批 1024 个时间戳，写入独立的输出缓冲区；原地转换在恒等比例下不做任何工作）
+    enum { kBulkSize = 1024 };
+    uint64_t bulk[kBulkSize];
+    uint64_t bulkNanos[kBulkSize];
+    for (uint32_t i = 0; i < kBulkSize; i++) {
+        bulk[i] = machTime + i;
+    }
+
+    static const struct { const char* name; uint32_t numer; uint32_t denom; } kModes[] = {
+        { "mach_to_nanos_batch", 0, 0 },
+        { "mach_to_nanos_batch_fixed", 125, 3 },
+    };
+    for (size_t mode = 0; mode < sizeof(kModes) / sizeof(kModes[0]); mode++) {
+        // 覆盖期间计时也会按覆盖比例换算，先记录原始计数，恢复平台比例后再换算
+        dp_timebase_override(kModes[mode].numer, kModes[mode].denom);
+        sampleCount = 0;
+        for (uint32_t round = 0; round < rounds; round++) {
+            for (uint32_t batch = 0; batch < 64; batch++) {
+                uint64_t start = DPGetCurrentMachTime();
+                DPMachTimesToNanos(bulk, bulkNanos, kBulkSize);
+                samples[sampleCount++] = (double)(DPGetCurrentMachTime() - start);
+                sink += bulkNanos[batch];
+            }
+        }
+        dp_timebase_override(0, 0);
+        for (uint32_t i = 0; i < sampleCount; i++) {
+            samples[i] = (double)DPMachTimeToNanos((uint64_t)samples[i]) / kBulkSize;
+        }
+        dp_bench_record(kModes[mode].name, 0, samples, sampleCount);
+    }
+
+    (void)sink;
+    free(samples);
+}
+
+/// 校验定点换算：每组换算比例下，单个与批量换算结果都须等于 (__int128)t * numer / denom
+/// @return 不一致的数量
+static uint32_t dp_bench_verify_timebase(void) {
+    static const uint32_t kRatios[][2] = {
+        { 1, 1 }, { 125, 3 }, { 3, 125 }, { 1, 3 }, { 83, 2 }, { 41, 24 },
+        { 1000000000, 24000000 }, { 4294967291u, 4294967279u }, { 7, 4294967291u }, { 4294967291u, 1 },
+    };
+    enum { kValueCount = 64 };
+    uint32_t mismatches = 0;
+
+    for (size_t r = 0; r < sizeof(kRatios) / sizeof(kRatios[0]); r++) {
+        uint32_t numer = kRatios[r][0];
+        uint32_t denom = kRatios[r][1];
+        dp_timebase_override(numer, denom);
+
+        // 有效区间：结果不超过 64 位，且 t < 2^64 / denom（定点系数的精度范围）
+        unsigned __int128 limit = ((unsigned __int128)UINT64_MAX * denom) / numer;
+        unsigned __int128 precision = (((unsigned __int128)1) << 64) / denom;
+        uint64_t maxValue = (uint64_t)(limit < precision ? limit : precision - 1);
+
+        uint64_t values[kValueCount];
+        uint64_t state = 0x9E3779B97F4A7C15ull ^ ((uint64_t)numer << 32 | denom);
+        for (uint32_t i = 0; i < kValueCount; i++) {
+            if (i < 8) {
+                // 边界：0、1、denom 附近与区间上限附近
+                static const uint64_t kEdges[] = { 0, 1, 2, 3 };
+                values[i] = i < 4 ? kEdges[i] : (i < 6 ? (uint64_t)denom + i - 5 : maxValue - (i - 6));
+            } else {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                // 在 [0, maxValue] 内按数量级均匀分布
+                uint32_t bits = 1 + (uint32_t)(state % 64);
+                uint64_t mask = bits >= 64 ? UINT64_MAX : ((1ull << bits) - 1);
+                values[i] = (state & mask) % (maxValue == UINT64_MAX ? UINT64_MAX : maxValue + 1);
+            }
+        }
+
+        uint64_t nanos[kValueCount];
+        DPMachTimesToNanos(values, nanos, kValueCount);
+        for (uint32_t i = 0; i < kValueCount; i++) {
+            uint64_t expected = (uint64_t)((unsigned __int128)values[i] * numer / denom);
+            uint64_t single = DPMachTimeToNanos(values[i]);
+            if (single != expected || nanos[i] != expected) {
+                fprintf(stderr, "timebase %u/%u: t=%llu expected %llu, got %llu (batch %llu)\n",
+                        numer, denom, (unsigned long long)values[i], (unsigned long long)expected,
+                        (unsigned long long)single, (unsigned long long)nanos[i]);
+                mismatches++;
+            }
+        }
+    }
+
+    dp_timebase_override(0, 0);
+    return mismatches;
+}
+
+/// 监控启动开销：每个镜像的回调耗时占 dlopen 耗时的百分比
+static void dp_bench_startup_overhead(uint32_t count) {
+    const DPBenchResult* callback = NULL;
+    const DPBenchResult* load = NULL;
+    for (uint32_t i = 0; i < g_resultCount; i++) {
+        // dlopen 只按最大档位测量一次，作为每个镜像的加载耗时参照
+        if (strcmp(g_results[i].name, "dlopen") == 0) load = &g_results[i];
+        if (strcmp(g_results[i].name, "callback") == 0 && g_results[i].images == count) callback = &g_results[i];
+    }
+    if (callback == NULL || load == NULL || load->mean <= 0) {
+        return;
+    }
+
+    double overhead = callback->p50 / load->mean * 100.0;
+    dp_bench_record("startup_overhead_pct", count, &overhead, 1);
+}
+
+// MARK: - 输出与回归门禁
+
+static void dp_bench_print(bool json) {
+    if (!json) {
+        printf("%-22s %7s %8s %10s %10s %10s %10s %10s\n",
+               "benchmark", "images", "samples", "min", "mean", "p50", "p90", "p99");
+    }
+
+    for (uint32_t i = 0; i < g_resultCount; i++) {
+        const DPBenchResult* r = &g_results[i];
+        if (json) {
+            printf("{\"name\":\"%s\",\"images\":%u,\"samples\":%u,\"unit\":\"%s\","
+                   "\"min\":%.2f,\"mean\":%.2f,\"p50\":%.2f,\"p90\":%.2f,\"p99\":%.2f}\n",
+                   r->name, r->images, r->samples,
+                   strstr(r->name, "_pct") != NULL ? "percent" : "ns/op",
+                   r->min, r->mean, r->p50, r->p90, r->p99);
+        } else {
+            const char* format = strstr(r->name, "_pct") != NULL
+                ? "%-22s %7u %8u %10.4f %10.4f %10.4f %10.4f %10.4f\n"
+                : "%-22s %7u %8u %10.1f %10.1f %10.1f %10.1f %10.1f\n";
+            printf(format, r->name, r->images, r->samples, r->min, r->mean, r->p50, r->p90, r->p99);
+        }
+    }
+}
+
+/// 与基线比较 p50，返回回退的测量项数量
+static int dp_bench_compare_baseline(const char* path, double maxRegression) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "cannot open baseline %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    int regressions = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char name[32];
+        unsigned images = 0;
+        double p50 = 0;
+
+        const char* nameField = strstr(line, "\"name\":\"");
+        const char* imagesField = strstr(line, "\"images\":");
+        const char* p50Field = strstr(line, "\"p50\":");
+        if (nameField == NULL || imagesField == NULL || p50Field == NULL ||
+            sscanf(nameField, "\"name\":\"%31[^\"]\"", name) != 1 ||
+            sscanf(imagesField, "\"images\":%u", &images) != 1 ||
+            sscanf(p50Field, "\"p50\":%lf", &p50) != 1) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < g_resultCount; i++) {
+            const DPBenchResult* r = &g_results[i];
+            // dlopen 为参照项，不参与门禁
+            if (r->images != images || strcmp(r->name, name) != 0 || strcmp(name, "dlopen") == 0) {
+                continue;
+            }
+            if (p50 > 0 && r->p50 > p50 * (1.0 + maxRegression)) {
+                fprintf(stderr, "REGRESSION %s[%u]: p50 %.2f -> %.2f (+%.1f%%)\n",
+                        name, images, p50, r->p50, (r->p50 / p50 - 1.0) * 100.0);
+                regressions++;
+            }
+        }
+    }
+
+    fclose(file);
+    return regressions;
+}
+
+// MARK: - 入口
+
+static bool dp_bench_parse_args(int argc, char** argv, DPBenchConfig* config) {
+    config->sizes[0] = 100;
+    config->sizes[1] = 500;
+    config->sizes[2] = 5000;
+    config->sizeCount = 3;
+    config->rounds = 30;
+    config->json = false;
+    config->baselinePath = NULL;
+    config->maxRegression = 0.10;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            config->json = true;
+        } else if (strcmp(argv[i], "--images") == 0 && i + 1 < argc) {
+            config->sizeCount = 0;
+            char* cursor = argv[++i];
+            while (*cursor != '\0' && config->sizeCount < DP_BENCH_MAX_SIZES) {
+                char* end = NULL;
+                unsigned long value = strtoul(cursor, &end, 10);
+                if (end == cursor || value < DP_BENCH_BATCH) return false;
+                config->sizes[config->sizeCount++] = (uint32_t)value;
+                cursor = (*end == ',') ? end + 1 : end;
+            }
+        } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            config->rounds = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            config->baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--max-regression") == 0 && i + 1 < argc) {
+            config->maxRegression = strtod(argv[++i], NULL);
+        } else {
+            return false;
+        }
+    }
+    return config->sizeCount > 0 && config->rounds > 0;
+}
+
+int main(int argc, char** argv) {
+    DPBenchConfig config;
+    if (!dp_bench_parse_args(argc, argv, &config)) {
+        fprintf(stderr, "usage: %s [--images 100,500,5000] [--rounds 30] [--json] "
+                        "[--baseline <file>] [--max-regression 0.10]\n", argv[0]);
+        return 64;
+    }
+
+    uint32_t maxImages = 0;
+    for (uint32_t i = 0; i < config.sizeCount; i++) {
+        if (config.sizes[i] > maxImages) maxImages = config.sizes[i];
+    }
+
+    // 基准测试会写入远超真实启动的镜像记录
+    DPPreMainSetDylibMemoryLimit((size_t)maxImages * 2 * sizeof(DPDylibLoadInfo) + 4 * 1024 * 1024);
+
+    if (!dp_bench_generate_libraries(maxImages)) {
+        dp_bench_cleanup_libraries();
+        return 1;
+    }
+
+    const void** headers = malloc(maxImages * sizeof(void*));
+    void** handles = malloc(maxImages * sizeof(void*));
+    if (headers == NULL || handles == NULL || !dp_bench_load_libraries(maxImages, headers, handles)) {
+        dp_bench_cleanup_libraries();
+        return 1;
+    }
+
+    // 未以 --wrap=dlopen 链接时，首次查询会补扫上面加载的合成库，提前完成避免污染测量
+    DPPreMainGetData();
+
+    if (dp_bench_verify_timebase() != 0) {
+        dp_bench_cleanup_libraries();
+        return 1;
+    }
+
+    dp_bench_mach_to_nanos(config.rounds);
+    for (uint32_t i = 0; i < config.sizeCount; i++) {
+        dp_bench_callback(headers, config.sizes[i], config.rounds);
+        dp_bench_queries(headers, config.sizes[i], config.rounds);
+        dp_bench_startup_overhead(config.sizes[i]);
+    }
+
+    dp_bench_print(config.json);
+
+    int status = 0;
+    if (config.baselinePath != NULL) {
+        int regressions = dp_bench_compare_baseline(config.baselinePath, config.maxRegression);
+        status = regressions < 0 ? 1 : (regressions > 0 ? 2 : 0);
+    }
+
+    DPPreMainReset();
+    dp_bench_cleanup_libraries();
+    free(headers);
+    free(handles);
+    return status;
+}
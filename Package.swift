@@ -21,24 +21,103 @@ let package = Package(
     targets: [
         // C 语言模块：PreMain 监控核心
         // 使用 dyld 回调 + mach_absolute_time 实现纳秒级精度的 PreMain 时间统计
+        // 平台层同时提供 Linux 实现，C 核心可在 Linux 上构建、测试与基准测试
+        // Apple 的 dlopen 挂接（DP_PREMAIN_DLOPEN_INTERPOSE）依赖 dyld 私有接口，此处不定义，
+        // 以本包为依赖时 dlopen 计时不可用（PreMainMonitor.isDlopenTracingAvailable 为 false）
         .target(
             name: "DPPreMainMonitor",
             path: "Sources/Core/PreMain",
-            exclude: ["PreMainMonitor.swift"],
-            sources: ["DPPreMainMonitor.c"],
+            exclude: ["PreMainMonitor.swift", "LaunchHistory.swift"],
+            sources: [
+                "DPPreMainMonitor.c",
+                "DPPreMainStringArena.c",
+                "DPPreMainInitializers.c",
+                "DPPreMainMarkers.c",
+                "DPPreMainTraceExport.c",
+                "DPPreMainLaunchHistory.c",
+                "DPPreMainDlopen.c",
+                "DPPreMainPageTrace.c",
+                "DPPreMainSampler.c",
+                "DPPreMainPlatformDarwin.c",
+                "DPPreMainPlatformLinux.c",
+            ],
             publicHeadersPath: "include",
             cSettings: [
                 .headerSearchPath("include"),
+            ],
+            linkerSettings: [
+                .linkedLibrary("dl", .when(platforms: [.linux])),
+                .linkedLibrary("pthread", .when(platforms: [.linux])),
+            ]
+        ),
+        // C 语言模块：Bridge 事件通道底层数据结构（无锁事件环形缓冲区）
+        .target(
+            name: "DPBridgeCore",
+            path: "Sources/Core/BridgeCore",
+            publicHeadersPath: "include",
+            linkerSettings: [
+                // deflate-dict-v1 批量压缩
+                .linkedLibrary("z"),
             ]
         ),
         .target(
             name: "DebugProbe",
             dependencies: [
                 "DPPreMainMonitor",
+                "DPBridgeCore",
                 // CocoaLumberjack 为可选依赖，使用 #if canImport(CocoaLumberjack) 条件编译
             ],
             path: "Sources",
-            exclude: ["Core/PreMain/DPPreMainMonitor.c", "Core/PreMain/include"]
+            exclude: [
+                "Core/PreMain/DPPreMainMonitor.c",
+                "Core/PreMain/DPPreMainStringArena.c",
+                "Core/PreMain/DPPreMainInitializers.c",
+                "Core/PreMain/DPPreMainMarkers.c",
+                "Core/PreMain/DPPreMainTraceExport.c",
+                "Core/PreMain/DPPreMainLaunchHistory.c",
+                "Core/PreMain/DPPreMainDlopen.c",
+                "Core/PreMain/DPPreMainPageTrace.c",
+                "Core/PreMain/DPPreMainSampler.c",
+                "Core/PreMain/DPPreMainPlatformDarwin.c",
+                "Core/PreMain/DPPreMainPlatformLinux.c",
+                "Core/PreMain/DPPreMainInternal.h",
+                "Core/PreMain/include",
+                "Core/BridgeCore",
+            ]
+        ),
+        // PreMain 监控热路径基准测试（C 可执行文件，可在 Linux 上运行）
+        // swift run -c release DPPreMainBenchmark --json
+        .executableTarget(
+            name: "DPPreMainBenchmark",
+            dependencies: ["DPPreMainMonitor"],
+            path: "Benchmarks/DPPreMainBenchmark"
+        ),
+        // Bridge 事件环形缓冲区吞吐基准测试（C 可执行文件，可在 Linux 上运行）
+        // swift run -c release DPBridgeBenchmark --producers 1,4,8 --json
+        .executableTarget(
+            name: "DPBridgeBenchmark",
+            dependencies: ["DPBridgeCore"],
+            path: "Benchmarks/DPBridgeBenchmark",
+            linkerSettings: [
+                .linkedLibrary("pthread", .when(platforms: [.linux])),
+            ]
+        ),
+        // Bridge 传输编码与压缩对比（JSON / binary-v1 × 不压缩 / deflate-dict-v1，含本地 Hub 替身）
+        // swift run -c release DPBridgeWireBenchmark --events 20000 --body-size 4096
+        .executableTarget(
+            name: "DPBridgeWireBenchmark",
+            dependencies: ["DebugProbe"],
+            path: "Benchmarks/DPBridgeWireBenchmark"
+        ),
+        // 离线启动对比工具（C 可执行文件，可在 Linux 上运行）
+        // swift run -c release DPLaunchCompare --baseline old.bin --candidate new.bin
+        .executableTarget(
+            name: "DPLaunchCompare",
+            dependencies: ["DPPreMainMonitor"],
+            path: "Tools/DPLaunchCompare",
+            linkerSettings: [
+                .linkedLibrary("m", .when(platforms: [.linux])),
+            ]
         ),
     ]
 )
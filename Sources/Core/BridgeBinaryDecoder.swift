@@ -0,0 +1,322 @@
+// BridgeBinaryDecoder.swift
+// DebugProbe
+//
+// Created by Sun on 2025/12/18.
+// Copyright © 2025 Sun. All rights reserved.
+//
+// binary-v1 解码器（字节 -> BridgeWireValue -> Codable）
+//
+
+import Foundation
+
+/// binary-v1 解码器
+public struct BridgeBinaryDecoder {
+    public init() {}
+
+    /// 解码单个 value（不含帧长度前缀）
+    public func decode<T: Decodable>(_ type: T.Type, from data: Data) throws -> T {
+        var reader = BridgeWireReader(data)
+        let value = try reader.readValue()
+        guard reader.isAtEnd else {
+            throw BridgeWireError.trailingBytes(reader.remainingCount)
+        }
+        return try decodeValue(type, from: value, codingPath: [])
+    }
+}
+
+// MARK: - Value Conversion
+
+/// 解码任意值：Data / Date / URL 特殊处理，其余调用 init(from:)
+private func decodeValue<T: Decodable>(_ type: T.Type, from value: BridgeWireValue, codingPath: [CodingKey]) throws -> T {
+    if type == Data.self {
+        guard case let .bytes(data) = value else {
+            throw typeMismatch(type, value, codingPath)
+        }
+        return data as! T
+    }
+    if type == Date.self {
+        switch value {
+        case let .date(date):
+            return date as! T
+        case let .double(seconds):
+            return Date(timeIntervalSince1970: seconds) as! T
+        default:
+            throw typeMismatch(type, value, codingPath)
+        }
+    }
+    if type == URL.self {
+        guard case let .string(string) = value, let url = URL(string: string) else {
+            throw typeMismatch(type, value, codingPath)
+        }
+        return url as! T
+    }
+    return try T(from: BridgeWireDecoderImpl(value: value, codingPath: codingPath))
+}
+
+private func typeMismatch(_ type: Any.Type, _ value: BridgeWireValue, _ codingPath: [CodingKey]) -> DecodingError {
+    DecodingError.typeMismatch(
+        type,
+        DecodingError.Context(codingPath: codingPath, debugDescription: "Expected \(type) but found \(value.kindDescription)")
+    )
+}
+
+private func decodeBool(_ value: BridgeWireValue, _ codingPath: [CodingKey]) throws -> Bool {
+    guard case let .bool(flag) = value else {
+        throw typeMismatch(Bool.self, value, codingPath)
+    }
+    return flag
+}
+
+private func decodeString(_ value: BridgeWireValue, _ codingPath: [CodingKey]) throws -> String {
+    guard case let .string(string) = value else {
+        throw typeMismatch(String.self, value, codingPath)
+    }
+    return string
+}
+
+private func decodeInteger<I: FixedWidthInteger>(_ type: I.Type, _ value: BridgeWireValue, _ codingPath: [CodingKey]) throws -> I {
+    let result: I? = switch value {
+    case let .int(number): I(exactly: number)
+    case let .uint(number): I(exactly: number)
+    case let .double(number): I(exactly: number)
+    default: nil
+    }
+    guard let result else {
+        throw typeMismatch(type, value, codingPath)
+    }
+    return result
+}
+
+private func decodeFloat<F: BinaryFloatingPoint>(_ type: F.Type, _ value: BridgeWireValue, _ codingPath: [CodingKey]) throws -> F {
+    switch value {
+    case let .double(number): F(number)
+    case let .int(number): F(number)
+    case let .uint(number): F(number)
+    default: throw typeMismatch(type, value, codingPath)
+    }
+}
+
+// MARK: - Decoder
+
+private struct BridgeWireDecoderImpl: Decoder {
+    let value: BridgeWireValue
+    let codingPath: [CodingKey]
+
+    var userInfo: [CodingUserInfoKey: Any] {
+        [:]
+    }
+
+    func container<Key: CodingKey>(keyedBy type: Key.Type) throws -> KeyedDecodingContainer<Key> {
+        guard case let .map(entries) = value else {
+            throw typeMismatch([String: Any].self, value, codingPath)
+        }
+        return KeyedDecodingContainer(BridgeWireKeyedDecodingContainer<Key>(entries: entries, codingPath: codingPath))
+    }
+
+    func unkeyedContainer() throws -> UnkeyedDecodingContainer {
+        guard case let .array(elements) = value else {
+            throw typeMismatch([Any].self, value, codingPath)
+        }
+        return BridgeWireUnkeyedDecodingContainer(elements: elements, codingPath: codingPath)
+    }
+
+    func singleValueContainer() throws -> SingleValueDecodingContainer {
+        BridgeWireSingleValueDecodingContainer(value: value, codingPath: codingPath)
+    }
+}
+
+// MARK: - Keyed
+
+private struct BridgeWireKeyedDecodingContainer<Key: CodingKey>: KeyedDecodingContainerProtocol {
+    let codingPath: [CodingKey]
+    private let values: [String: BridgeWireValue]
+
+    init(entries: [(key: String, value: BridgeWireValue)], codingPath: [CodingKey]) {
+        // 重复的键保留最后一次写入（与 JSONDecoder 一致）
+        values = Dictionary(entries.map { ($0.key, $0.value) }, uniquingKeysWith: { _, last in last })
+        self.codingPath = codingPath
+    }
+
+    var allKeys: [Key] {
+        values.keys.compactMap { Key(stringValue: $0) }
+    }
+
+    func contains(_ key: Key) -> Bool {
+        values[key.stringValue] != nil
+    }
+
+    private func value(forKey key: Key) throws -> BridgeWireValue {
+        guard let value = values[key.stringValue] else {
+            throw DecodingError.keyNotFound(
+                key,
+                DecodingError.Context(codingPath: codingPath, debugDescription: "No value associated with key \(key.stringValue)")
+            )
+        }
+        return value
+    }
+
+    func decodeNil(forKey key: Key) throws -> Bool {
+        if case .null = try value(forKey: key) {
+            return true
+        }
+        return false
+    }
+
+    func decode(_ type: Bool.Type, forKey key: Key) throws -> Bool { try decodeBool(value(forKey: key), codingPath + [key]) }
+    func decode(_ type: String.Type, forKey key: Key) throws -> String { try decodeString(value(forKey: key), codingPath + [key]) }
+    func decode(_ type: Double.Type, forKey key: Key) throws -> Double { try decodeFloat(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: Float.Type, forKey key: Key) throws -> Float { try decodeFloat(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: Int.Type, forKey key: Key) throws -> Int { try decodeInteger(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: Int8.Type, forKey key: Key) throws -> Int8 { try decodeInteger(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: Int16.Type, forKey key: Key) throws -> Int16 { try decodeInteger(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: Int32.Type, forKey key: Key) throws -> Int32 { try decodeInteger(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: Int64.Type, forKey key: Key) throws -> Int64 { try decodeInteger(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: UInt.Type, forKey key: Key) throws -> UInt { try decodeInteger(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: UInt8.Type, forKey key: Key) throws -> UInt8 { try decodeInteger(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: UInt16.Type, forKey key: Key) throws -> UInt16 { try decodeInteger(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: UInt32.Type, forKey key: Key) throws -> UInt32 { try decodeInteger(type, value(forKey: key), codingPath + [key]) }
+    func decode(_ type: UInt64.Type, forKey key: Key) throws -> UInt64 { try decodeInteger(type, value(forKey: key), codingPath + [key]) }
+
+    func decode<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T {
+        try decodeValue(type, from: value(forKey: key), codingPath: codingPath + [key])
+    }
+
+    func nestedContainer<NestedKey: CodingKey>(
+        keyedBy type: NestedKey.Type,
+        forKey key: Key
+    ) throws -> KeyedDecodingContainer<NestedKey> {
+        try BridgeWireDecoderImpl(value: value(forKey: key), codingPath: codingPath + [key]).container(keyedBy: type)
+    }
+
+    func nestedUnkeyedContainer(forKey key: Key) throws -> UnkeyedDecodingContainer {
+        try BridgeWireDecoderImpl(value: value(forKey: key), codingPath: codingPath + [key]).unkeyedContainer()
+    }
+
+    func superDecoder() throws -> Decoder {
+        let key = BridgeWireSuperKey()
+        return BridgeWireDecoderImpl(value: values[key.stringValue] ?? .null, codingPath: codingPath + [key])
+    }
+
+    func superDecoder(forKey key: Key) throws -> Decoder {
+        BridgeWireDecoderImpl(value: values[key.stringValue] ?? .null, codingPath: codingPath + [key])
+    }
+}
+
+// MARK: - Unkeyed
+
+private struct BridgeWireUnkeyedDecodingContainer: UnkeyedDecodingContainer {
+    let elements: [BridgeWireValue]
+    let codingPath: [CodingKey]
+    private(set) var currentIndex = 0
+
+    init(elements: [BridgeWireValue], codingPath: [CodingKey]) {
+        self.elements = elements
+        self.codingPath = codingPath
+    }
+
+    var count: Int? {
+        elements.count
+    }
+
+    var isAtEnd: Bool {
+        currentIndex >= elements.count
+    }
+
+    private var currentPath: [CodingKey] {
+        codingPath + [BridgeWireIndexKey(currentIndex)]
+    }
+
+    /// 取出下一个元素
+    private mutating func next(_ type: Any.Type) throws -> BridgeWireValue {
+        guard !isAtEnd else {
+            throw DecodingError.valueNotFound(
+                type,
+                DecodingError.Context(codingPath: currentPath, debugDescription: "Unkeyed container is at end")
+            )
+        }
+        defer { currentIndex += 1 }
+        return elements[currentIndex]
+    }
+
+    mutating func decodeNil() throws -> Bool {
+        guard !isAtEnd else {
+            throw DecodingError.valueNotFound(
+                Any?.self,
+                DecodingError.Context(codingPath: currentPath, debugDescription: "Unkeyed container is at end")
+            )
+        }
+        if case .null = elements[currentIndex] {
+            currentIndex += 1
+            return true
+        }
+        return false
+    }
+
+    mutating func decode(_ type: Bool.Type) throws -> Bool { let path = currentPath; return try decodeBool(next(type), path) }
+    mutating func decode(_ type: String.Type) throws -> String { let path = currentPath; return try decodeString(next(type), path) }
+    mutating func decode(_ type: Double.Type) throws -> Double { let path = currentPath; return try decodeFloat(type, next(type), path) }
+    mutating func decode(_ type: Float.Type) throws -> Float { let path = currentPath; return try decodeFloat(type, next(type), path) }
+    mutating func decode(_ type: Int.Type) throws -> Int { let path = currentPath; return try decodeInteger(type, next(type), path) }
+    mutating func decode(_ type: Int8.Type) throws -> Int8 { let path = currentPath; return try decodeInteger(type, next(type), path) }
+    mutating func decode(_ type: Int16.Type) throws -> Int16 { let path = currentPath; return try decodeInteger(type, next(type), path) }
+    mutating func decode(_ type: Int32.Type) throws -> Int32 { let path = currentPath; return try decodeInteger(type, next(type), path) }
+    mutating func decode(_ type: Int64.Type) throws -> Int64 { let path = currentPath; return try decodeInteger(type, next(type), path) }
+    mutating func decode(_ type: UInt.Type) throws -> UInt { let path = currentPath; return try decodeInteger(type, next(type), path) }
+    mutating func decode(_ type: UInt8.Type) throws -> UInt8 { let path = currentPath; return try decodeInteger(type, next(type), path) }
+    mutating func decode(_ type: UInt16.Type) throws -> UInt16 { let path = currentPath; return try decodeInteger(type, next(type), path) }
+    mutating func decode(_ type: UInt32.Type) throws -> UInt32 { let path = currentPath; return try decodeInteger(type, next(type), path) }
+    mutating func decode(_ type: UInt64.Type) throws -> UInt64 { let path = currentPath; return try decodeInteger(type, next(type), path) }
+
+    mutating func decode<T: Decodable>(_ type: T.Type) throws -> T {
+        let path = currentPath
+        return try decodeValue(type, from: next(type), codingPath: path)
+    }
+
+    mutating func nestedContainer<NestedKey: CodingKey>(keyedBy type: NestedKey.Type) throws -> KeyedDecodingContainer<NestedKey> {
+        let path = currentPath
+        return try BridgeWireDecoderImpl(value: next(type), codingPath: path).container(keyedBy: type)
+    }
+
+    mutating func nestedUnkeyedContainer() throws -> UnkeyedDecodingContainer {
+        let path = currentPath
+        return try BridgeWireDecoderImpl(value: next([Any].self), codingPath: path).unkeyedContainer()
+    }
+
+    mutating func superDecoder() throws -> Decoder {
+        let path = currentPath
+        return try BridgeWireDecoderImpl(value: next(Decoder.self), codingPath: path)
+    }
+}
+
+// MARK: - Single Value
+
+private struct BridgeWireSingleValueDecodingContainer: SingleValueDecodingContainer {
+    let value: BridgeWireValue
+    let codingPath: [CodingKey]
+
+    func decodeNil() -> Bool {
+        if case .null = value {
+            return true
+        }
+        return false
+    }
+
+    func decode(_ type: Bool.Type) throws -> Bool { try decodeBool(value, codingPath) }
+    func decode(_ type: String.Type) throws -> String { try decodeString(value, codingPath) }
+    func decode(_ type: Double.Type) throws -> Double { try decodeFloat(type, value, codingPath) }
+    func decode(_ type: Float.Type) throws -> Float { try decodeFloat(type, value, codingPath) }
+    func decode(_ type: Int.Type) throws -> Int { try decodeInteger(type, value, codingPath) }
+    func decode(_ type: Int8.Type) throws -> Int8 { try decodeInteger(type, value, codingPath) }
+    func decode(_ type: Int16.Type) throws -> Int16 { try decodeInteger(type, value, codingPath) }
+    func decode(_ type: Int32.Type) throws -> Int32 { try decodeInteger(type, value, codingPath) }
+    func decode(_ type: Int64.Type) throws -> Int64 { try decodeInteger(type, value, codingPath) }
+    func decode(_ type: UInt.Type) throws -> UInt { try decodeInteger(type, value, codingPath) }
+    func decode(_ type: UInt8.Type) throws -> UInt8 { try decodeInteger(type, value, codingPath) }
+    func decode(_ type: UInt16.Type) throws -> UInt16 { try decodeInteger(type, value, codingPath) }
+    func decode(_ type: UInt32.Type) throws -> UInt32 { try decodeInteger(type, value, codingPath) }
+    func decode(_ type: UInt64.Type) throws -> UInt64 { try decodeInteger(type, value, codingPath) }
+
+    func decode<T: Decodable>(_ type: T.Type) throws -> T {
+        try decodeValue(type, from: value, codingPath: codingPath)
+    }
+}
@@ -0,0 +1,301 @@
+// BridgeBinaryEncoder.swift
+// DebugProbe
+//
+// Created by Sun on 2025/12/18.
+// Copyright © 2025 Sun. All rights reserved.
+//
+// binary-v1 编码器（Codable -> BridgeWireValue -> 字节）
+// Data 编码为原始字节、Date 编码为 8 字节时间戳，其余类型与 JSONEncoder 的对象结构一致
+//
+
+import Foundation
+
+/// binary-v1 编码器
+public struct BridgeBinaryEncoder {
+    public init() {}
+
+    /// 编码为单个 value（不含帧长度前缀）
+    public func encode<T: Encodable>(_ value: T) throws -> Data {
+        let root = BridgeWireNode()
+        try root.encode(value, codingPath: [])
+
+        var writer = BridgeWireWriter()
+        writer.write(root.value)
+        return writer.data
+    }
+}
+
+// MARK: - Node
+
+/// 编码过程中的可变节点：嵌套容器通过引用写回父节点
+private final class BridgeWireNode {
+    private enum Kind {
+        case unset
+        case scalar(BridgeWireValue)
+        case array
+        case map
+    }
+
+    private var kind = Kind.unset
+    private var elements: [BridgeWireNode] = []
+    private var entries: [(key: String, node: BridgeWireNode)] = []
+
+    /// 最终值（未写入任何内容时与 JSONEncoder 一致，编码为空对象）
+    var value: BridgeWireValue {
+        switch kind {
+        case .unset:
+            .map([])
+        case let .scalar(value):
+            value
+        case .array:
+            .array(elements.map(\.value))
+        case .map:
+            .map(entries.map { (key: $0.key, value: $0.node.value) })
+        }
+    }
+
+    var elementCount: Int {
+        elements.count
+    }
+
+    func set(_ value: BridgeWireValue) {
+        kind = .scalar(value)
+    }
+
+    /// 转为数组节点（重复获取容器时保留已写入的元素）
+    func makeArray() {
+        if case .array = kind { return }
+        kind = .array
+        elements = []
+    }
+
+    /// 转为对象节点（重复获取容器时保留已写入的键）
+    func makeMap() {
+        if case .map = kind { return }
+        kind = .map
+        entries = []
+    }
+
+    func appendElement() -> BridgeWireNode {
+        let node = BridgeWireNode()
+        elements.append(node)
+        return node
+    }
+
+    /// 追加键（重复的键由解码端保留最后一次写入）
+    func child(forKey key: String) -> BridgeWireNode {
+        let node = BridgeWireNode()
+        entries.append((key, node))
+        return node
+    }
+
+    /// 编码任意值：常见标量直接写入，Data / Date / URL 特殊处理，其余调用 encode(to:)
+    func encode(_ value: some Encodable, codingPath: [CodingKey]) throws {
+        switch value {
+        case let string as String:
+            set(.string(string))
+        case let number as Int:
+            set(.int(Int64(number)))
+        case let number as Double:
+            set(.double(number))
+        case let flag as Bool:
+            set(.bool(flag))
+        case let data as Data:
+            set(.bytes(data))
+        case let date as Date:
+            set(.date(date))
+        case let url as URL:
+            set(.string(url.absoluteString))
+        default:
+            try value.encode(to: BridgeWireEncoderImpl(node: self, codingPath: codingPath))
+        }
+    }
+}
+
+// MARK: - Encoder
+
+private struct BridgeWireEncoderImpl: Encoder {
+    let node: BridgeWireNode
+    let codingPath: [CodingKey]
+
+    var userInfo: [CodingUserInfoKey: Any] {
+        [:]
+    }
+
+    func container<Key: CodingKey>(keyedBy type: Key.Type) -> KeyedEncodingContainer<Key> {
+        node.makeMap()
+        return KeyedEncodingContainer(BridgeWireKeyedEncodingContainer<Key>(node: node, codingPath: codingPath))
+    }
+
+    func unkeyedContainer() -> UnkeyedEncodingContainer {
+        node.makeArray()
+        return BridgeWireUnkeyedEncodingContainer(node: node, codingPath: codingPath)
+    }
+
+    func singleValueContainer() -> SingleValueEncodingContainer {
+        BridgeWireSingleValueEncodingContainer(node: node, codingPath: codingPath)
+    }
+}
+
+/// 数组下标编码键
+struct BridgeWireIndexKey: CodingKey {
+    let intValue: Int?
+    let stringValue: String
+
+    init(_ index: Int) {
+        intValue = index
+        stringValue = "Index \(index)"
+    }
+
+    init?(stringValue: String) {
+        return nil
+    }
+
+    init?(intValue: Int) {
+        self.init(intValue)
+    }
+}
+
+/// superEncoder / superDecoder 使用的键
+struct BridgeWireSuperKey: CodingKey {
+    let stringValue = "super"
+    let intValue: Int? = nil
+
+    init() {}
+
+    init?(stringValue: String) {
+        return nil
+    }
+
+    init?(intValue: Int) {
+        return nil
+    }
+}
+
+// MARK: - Keyed
+
+private struct BridgeWireKeyedEncodingContainer<Key: CodingKey>: KeyedEncodingContainerProtocol {
+    let node: BridgeWireNode
+    let codingPath: [CodingKey]
+
+    mutating func encodeNil(forKey key: Key) throws { node.child(forKey: key.stringValue).set(.null) }
+    mutating func encode(_ value: Bool, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.bool(value)) }
+    mutating func encode(_ value: String, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.string(value)) }
+    mutating func encode(_ value: Double, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.double(value)) }
+    mutating func encode(_ value: Float, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.double(Double(value))) }
+    mutating func encode(_ value: Int, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.int(Int64(value))) }
+    mutating func encode(_ value: Int8, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.int(Int64(value))) }
+    mutating func encode(_ value: Int16, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.int(Int64(value))) }
+    mutating func encode(_ value: Int32, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.int(Int64(value))) }
+    mutating func encode(_ value: Int64, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.int(value)) }
+    mutating func encode(_ value: UInt, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt8, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt16, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt32, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt64, forKey key: Key) throws { node.child(forKey: key.stringValue).set(.uint(value)) }
+
+    mutating func encode(_ value: some Encodable, forKey key: Key) throws {
+        try node.child(forKey: key.stringValue).encode(value, codingPath: codingPath + [key])
+    }
+
+    mutating func nestedContainer<NestedKey: CodingKey>(
+        keyedBy keyType: NestedKey.Type,
+        forKey key: Key
+    ) -> KeyedEncodingContainer<NestedKey> {
+        let child = node.child(forKey: key.stringValue)
+        child.makeMap()
+        return KeyedEncodingContainer(BridgeWireKeyedEncodingContainer<NestedKey>(node: child, codingPath: codingPath + [key]))
+    }
+
+    mutating func nestedUnkeyedContainer(forKey key: Key) -> UnkeyedEncodingContainer {
+        let child = node.child(forKey: key.stringValue)
+        child.makeArray()
+        return BridgeWireUnkeyedEncodingContainer(node: child, codingPath: codingPath + [key])
+    }
+
+    mutating func superEncoder() -> Encoder {
+        BridgeWireEncoderImpl(node: node.child(forKey: BridgeWireSuperKey().stringValue), codingPath: codingPath + [BridgeWireSuperKey()])
+    }
+
+    mutating func superEncoder(forKey key: Key) -> Encoder {
+        BridgeWireEncoderImpl(node: node.child(forKey: key.stringValue), codingPath: codingPath + [key])
+    }
+}
+
+// MARK: - Unkeyed
+
+private struct BridgeWireUnkeyedEncodingContainer: UnkeyedEncodingContainer {
+    let node: BridgeWireNode
+    let codingPath: [CodingKey]
+
+    var count: Int {
+        node.elementCount
+    }
+
+    mutating func encodeNil() throws { node.appendElement().set(.null) }
+    mutating func encode(_ value: Bool) throws { node.appendElement().set(.bool(value)) }
+    mutating func encode(_ value: String) throws { node.appendElement().set(.string(value)) }
+    mutating func encode(_ value: Double) throws { node.appendElement().set(.double(value)) }
+    mutating func encode(_ value: Float) throws { node.appendElement().set(.double(Double(value))) }
+    mutating func encode(_ value: Int) throws { node.appendElement().set(.int(Int64(value))) }
+    mutating func encode(_ value: Int8) throws { node.appendElement().set(.int(Int64(value))) }
+    mutating func encode(_ value: Int16) throws { node.appendElement().set(.int(Int64(value))) }
+    mutating func encode(_ value: Int32) throws { node.appendElement().set(.int(Int64(value))) }
+    mutating func encode(_ value: Int64) throws { node.appendElement().set(.int(value)) }
+    mutating func encode(_ value: UInt) throws { node.appendElement().set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt8) throws { node.appendElement().set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt16) throws { node.appendElement().set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt32) throws { node.appendElement().set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt64) throws { node.appendElement().set(.uint(value)) }
+
+    mutating func encode(_ value: some Encodable) throws {
+        let key = BridgeWireIndexKey(count)
+        try node.appendElement().encode(value, codingPath: codingPath + [key])
+    }
+
+    mutating func nestedContainer<NestedKey: CodingKey>(keyedBy keyType: NestedKey.Type) -> KeyedEncodingContainer<NestedKey> {
+        let key = BridgeWireIndexKey(count)
+        let child = node.appendElement()
+        child.makeMap()
+        return KeyedEncodingContainer(BridgeWireKeyedEncodingContainer<NestedKey>(node: child, codingPath: codingPath + [key]))
+    }
+
+    mutating func nestedUnkeyedContainer() -> UnkeyedEncodingContainer {
+        let key = BridgeWireIndexKey(count)
+        let child = node.appendElement()
+        child.makeArray()
+        return BridgeWireUnkeyedEncodingContainer(node: child, codingPath: codingPath + [key])
+    }
+
+    mutating func superEncoder() -> Encoder {
+        let key = BridgeWireIndexKey(count)
+        return BridgeWireEncoderImpl(node: node.appendElement(), codingPath: codingPath + [key])
+    }
+}
+
+// MARK: - Single Value
+
+private struct BridgeWireSingleValueEncodingContainer: SingleValueEncodingContainer {
+    let node: BridgeWireNode
+    let codingPath: [CodingKey]
+
+    mutating func encodeNil() throws { node.set(.null) }
+    mutating func encode(_ value: Bool) throws { node.set(.bool(value)) }
+    mutating func encode(_ value: String) throws { node.set(.string(value)) }
+    mutating func encode(_ value: Double) throws { node.set(.double(value)) }
+    mutating func encode(_ value: Float) throws { node.set(.double(Double(value))) }
+    mutating func encode(_ value: Int) throws { node.set(.int(Int64(value))) }
+    mutating func encode(_ value: Int8) throws { node.set(.int(Int64(value))) }
+    mutating func encode(_ value: Int16) throws { node.set(.int(Int64(value))) }
+    mutating func encode(_ value: Int32) throws { node.set(.int(Int64(value))) }
+    mutating func encode(_ value: Int64) throws { node.set(.int(value)) }
+    mutating func encode(_ value: UInt) throws { node.set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt8) throws { node.set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt16) throws { node.set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt32) throws { node.set(.uint(UInt64(value))) }
+    mutating func encode(_ value: UInt64) throws { node.set(.uint(value)) }
+
+    mutating func encode(_ value: some Encodable) throws {
+        try node.encode(value, codingPath: codingPath)
+    }
+}
@@ -0,0 +1,206 @@
+// BridgeCompression.swift
+// DebugProbe
+//
+// Created by Sun on 2025/12/18.
+// Copyright © 2025 Sun. All rights reserved.
+//
+// Bridge 批量事件压缩
+// 注册时与传输编码一起协商；协商成功后设备 -> Hub 的每条消息带 1 字节信封标记：
+//   0x00 + 原始消息
+//   0x01 + varint(原始长度) + raw deflate（DPBridgeCompression 预置字典，deflate-dict-v1）
+// 只压缩 events 批次，且原始长度不低于阈值；小批次压缩收益低于 CPU 开销，直接以 0x00 发送
+//
+
+import DPBridgeCore
+import Foundation
+
+// MARK: - Compression
+
+/// Bridge 批量压缩算法
+public enum BridgeWireCompression: String, Codable, CaseIterable {
+    /// 不压缩
+    case none
+    /// raw deflate + 预置字典（每批独立）
+    case deflateDictV1 = "deflate-dict-v1"
+}
+
+/// 批量压缩统计（随 StatsEvent 上报）
+public struct BridgeCompressionStats: Codable {
+    /// 压缩后发送的批次数
+    public let compressedBatches: Int
+    /// 原样发送的批次数（低于阈值、压缩失败或压缩后未变小）
+    public let uncompressedBatches: Int
+    /// 执行了压缩的批次数（含压缩后未变小、最终原样发送的批次）
+    public let attemptedBatches: Int
+    /// 压缩前字节数（仅压缩后发送的批次）
+    public let inputBytes: UInt64
+    /// 压缩后字节数（仅压缩后发送的批次）
+    public let outputBytes: UInt64
+    /// 压缩率（压缩前 / 压缩后，仅压缩后发送的批次）
+    public let compressionRatio: Double
+    /// 压缩耗费的线程 CPU 时间（毫秒，含未采用压缩结果的批次）
+    public let cpuTimeMs: Double
+    /// 每 KB 输入的压缩 CPU 时间（微秒，按执行了压缩的全部输入计算）
+    public let cpuMicrosPerKB: Double
+
+    public init(
+        compressedBatches: Int,
+        uncompressedBatches: Int,
+        attemptedBatches: Int,
+        inputBytes: UInt64,
+        outputBytes: UInt64,
+        compressionRatio: Double,
+        cpuTimeMs: Double,
+        cpuMicrosPerKB: Double
+    ) {
+        self.compressedBatches = compressedBatches
+        self.uncompressedBatches = uncompressedBatches
+        self.attemptedBatches = attemptedBatches
+        self.inputBytes = inputBytes
+        self.outputBytes = outputBytes
+        self.compressionRatio = compressionRatio
+        self.cpuTimeMs = cpuTimeMs
+        self.cpuMicrosPerKB = cpuMicrosPerKB
+    }
+}
+
+// MARK: - Envelope
+
+/// 压缩信封
+public enum BridgeCompressionEnvelope {
+    /// 未压缩
+    static let plainFlag: UInt8 = 0x00
+    /// deflate-dict-v1
+    static let deflateFlag: UInt8 = 0x01
+
+    /// 单条消息解压后的上限（防止恶意长度耗尽内存）
+    private static var maxMessageLength: Int { 64 * 1024 * 1024 }
+
+    /// 为不压缩的消息加上信封
+    static func plain(_ message: Data) -> Data {
+        var data = Data(capacity: message.count + 1)
+        data.append(plainFlag)
+        data.append(message)
+        return data
+    }
+
+    /// 去掉信封，必要时解压（Hub 侧 / 基准测试使用）
+    public static func unwrap(_ data: Data) throws -> Data {
+        guard let flag = data.first else { throw BridgeWireError.truncated }
+
+        switch flag {
+        case plainFlag:
+            return data.dropFirst()
+        case deflateFlag:
+            var reader = BridgeWireReader(data.dropFirst())
+            let length = try reader.readVarint()
+            guard length <= UInt64(maxMessageLength) else { throw BridgeWireError.decompressionFailed }
+            let compressed = data.suffix(reader.remainingCount)
+
+            var output = Data(count: Int(length))
+            let ok = output.withUnsafeMutableBytes { outputBuffer in
+                compressed.withUnsafeBytes { inputBuffer in
+                    DPBridgeInflate(
+                        inputBuffer.bindMemory(to: UInt8.self).baseAddress,
+                        inputBuffer.count,
+                        outputBuffer.bindMemory(to: UInt8.self).baseAddress,
+                        outputBuffer.count
+                    )
+                }
+            }
+            guard ok else { throw BridgeWireError.decompressionFailed }
+            return output
+        default:
+            throw BridgeWireError.invalidTag(flag)
+        }
+    }
+}
+
+// MARK: - Compressor
+
+/// 批量压缩器（复用 zlib 状态，非线程安全，由发送方所在队列串行使用）
+/// zlib 状态分配失败时退化为只加 0x00 信封，与 Hub 的协商结果保持一致
+public final class BridgeBatchCompressor {
+    /// 压缩阈值（字节），低于此长度的批次不压缩
+    public let threshold: Int
+
+    private let deflater: OpaquePointer?
+    private var compressedBatches = 0
+    private var uncompressedBatches = 0
+    /// 压缩后发送的批次的压缩前 / 压缩后字节数（deflater 的统计包含未采用压缩结果的批次）
+    private var sentInputBytes: UInt64 = 0
+    private var sentOutputBytes: UInt64 = 0
+    private var output: [UInt8] = []
+
+    public init(level: Int, threshold: Int) {
+        deflater = DPBridgeDeflaterCreate(Int32(clamping: level))
+        self.threshold = threshold
+        if deflater == nil {
+            DebugLog.error(.bridge, "Failed to create deflater, batches will be sent uncompressed")
+        }
+    }
+
+    deinit {
+        DPBridgeDeflaterDestroy(deflater)
+    }
+
+    /// 为批量消息加上信封：达到阈值时压缩，压缩失败或没有变小时原样发送
+    public func envelope(_ message: Data) -> Data {
+        guard let deflater, message.count >= threshold else {
+            uncompressedBatches += 1
+            return BridgeCompressionEnvelope.plain(message)
+        }
+
+        let bound = DPBridgeDeflateBound(deflater, message.count)
+        if output.count < bound {
+            output = [UInt8](repeating: 0, count: bound)
+        }
+        let compressedLength = output.withUnsafeMutableBufferPointer { outputBuffer in
+            message.withUnsafeBytes { inputBuffer in
+                DPBridgeDeflate(
+                    deflater,
+                    inputBuffer.bindMemory(to: UInt8.self).baseAddress,
+                    inputBuffer.count,
+                    outputBuffer.baseAddress,
+                    outputBuffer.count
+                )
+            }
+        }
+
+        var writer = BridgeWireWriter()
+        writer.writeVarint(UInt64(message.count))
+        guard compressedLength > 0, compressedLength + writer.bytes.count < message.count else {
+            uncompressedBatches += 1
+            return BridgeCompressionEnvelope.plain(message)
+        }
+
+        compressedBatches += 1
+        sentInputBytes += UInt64(message.count)
+        sentOutputBytes += UInt64(compressedLength)
+
+        var data = Data(capacity: 1 + writer.bytes.count + compressedLength)
+        data.append(BridgeCompressionEnvelope.deflateFlag)
+        data.append(contentsOf: writer.bytes)
+        data.append(contentsOf: output[0..<compressedLength])
+        return data
+    }
+
+    /// 当前统计
+    public var stats: BridgeCompressionStats {
+        var raw = DPBridgeDeflateStats()
+        if let deflater {
+            DPBridgeDeflaterGetStats(deflater, &raw)
+        }
+        let cpuTimeMs = Double(raw.cpuNanos) / 1_000_000
+        return BridgeCompressionStats(
+            compressedBatches: compressedBatches,
+            uncompressedBatches: uncompressedBatches,
+            attemptedBatches: Int(raw.batches),
+            inputBytes: sentInputBytes,
+            outputBytes: sentOutputBytes,
+            compressionRatio: sentOutputBytes > 0 ? Double(sentInputBytes) / Double(sentOutputBytes) : 0,
+            cpuTimeMs: cpuTimeMs,
+            cpuMicrosPerKB: raw.inputBytes > 0 ? Double(raw.cpuNanos) / 1000 / (Double(raw.inputBytes) / 1024) : 0
+        )
+    }
+}
@@ -0,0 +1,203 @@
+//
+//  DPBridgeCompression.c
+//  DebugProbe
+//
+//  Bridge 批量事件压缩（zlib raw deflate + 预置字典）
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "DPBridgeCompression.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <zlib.h>
+
+// MARK: - 字典
+
+/// deflate-dict-v1 预置字典
+/// deflate 对字典末尾的内容使用更短的回溯距离，出现频率越高的片段越靠后：
+/// 响应头与取值 -> 请求头 -> JSON 的日志 / WebSocket / HTTP 字段与外层结构 -> binary-v1 的同一组字段与外层结构
+/// JSONEncoder 默认把 "/" 转义为 "\/"，常见取值同时收录两种写法
+/// binary-v1 段按编码结果收录：map 键为 varint(字节数) + 键名，后接常见取值的标签（0x03 int / 0x05 double /
+/// 0x06 string / 0x07 bytes / 0x08 date / 0x0A map），UUID 字符串的长度 36 一并收录；默认编码为 binary-v1，因此放在最后
+/// 二进制段以三位八进制转义书写，避免 \x 转义吞掉紧随其后的十六进制字母
+static const char kDPBridgeDictionaryV1[] =
+    // 响应头名称与常见取值
+    "Strict-Transport-SecurityX-Content-Type-OptionsX-Frame-OptionsAccess-Control-Allow-Origin"
+    "Content-Security-PolicyLast-ModifiedETagExpiresVaryServerSet-CookieDateConnectionkeep-alive"
+    "Transfer-EncodingchunkedContent-Encodinggzipbrdeflatemax-age=no-cacheno-storeprivatepublic"
+    "Cache-ControlContent-LengthLocationtext/html; charset=utf-8text\\/html; charset=utf-8"
+    "text/plainimage/jpegimage/pngimage/webpapplication/octet-streamapplication\\/octet-stream"
+    // 请求头名称与常见取值
+    "X-Requested-WithX-Request-IDOriginRefererCookieIf-None-MatchIf-Modified-SinceAccept-Language"
+    "en-US,en;q=0.9zh-CN,zh;q=0.9Accept-Encodinggzip, deflate, brUser-AgentMozilla/5.0 CFNetwork Darwin"
+    "AuthorizationBearer HostAcceptapplication/json; charset=utf-8application\\/json; charset=utf-8"
+    "Content-Typeapplication/jsonapplication\\/jsonhttps://https:\\/\\/"
+    // WebSocket 事件字段
+    "{\"webSocket\":{\"_0\":{\"kind\":{\"frame\":{\"_0\":{\"id\":\"\",\"sessionId\":\"\",\"sessionUrl\":\""
+    "\",\"direction\":\"receive\",\"opcode\":\"text\",\"payload\":\"\",\"payloadPreview\":\""
+    "\"requestHeaders\":{\"subprotocols\":[],\"connectTime\":\"sessionCreatedsessionClosed"
+    // 日志事件字段
+    "{\"log\":{\"_0\":{\"id\":\"\",\"source\":\"osLog\",\"timestamp\":\"\",\"level\":\"info\",\"subsystem\":\""
+    "\",\"category\":\"\",\"loggerName\":\"\",\"thread\":\"\",\"file\":\"\",\"function\":\"\",\"line\":"
+    ",\"message\":\"\",\"tags\":[],\"traceId\":\"cocoaLumberjackverbosedebugwarningerror"
+    // HTTP 事件字段
+    "\"timing\":{\"dnsLookup\":,\"tcpConnection\":,\"tlsHandshake\":,\"timeToFirstByte\":"
+    ",\"contentDownload\":,\"connectionReused\":false,\"protocolName\":\"h2\",\"localAddress\":\""
+    "\",\"remoteAddress\":\"\",\"requestBodyBytesSent\":,\"responseBodyBytesReceived\":"
+    "\"response\":{\"statusCode\":200,\"headers\":{\"Content-Type\":\"application\\/json\"},\"body\":\""
+    "\",\"endTime\":\"\",\"duration\":0.,\"errorDescription\":\"\"},"
+    "{\"http\":{\"_0\":{\"request\":{\"id\":\"\",\"method\":\"GET\",\"url\":\"https:\\/\\/\",\"queryItems\":{},"
+    "\"headers\":{\"Accept\":\"*\\/*\",\"Content-Type\":\"application\\/json\"},\"body\":\"\",\"startTime\":\""
+    "\",\"traceId\":\"\"},\"isMocked\":false,\"isReplay\":false,\"mockRuleId\":\"POSTPUTDELETE"
+    // 批量消息外层结构
+    "{\"type\":\"events\",\"payload\":["
+    // binary-v1：WebSocket 事件字段
+    "\011webSocket\012\001\002_0\012\001\004kind\012\001\005frame\012"
+    "\002id\006\044\011sessionId\006\044\012sessionUrl\006\011direction\006\007receive"
+    "\006opcode\006\004text\007payload\007\016payloadPreview\006"
+    // binary-v1：日志事件字段
+    "\003log\012\001\002_0\012\002id\006\044\006source\006\005osLog\011timestamp\010"
+    "\005level\006\004info\011subsystem\006\010category\006\012loggerName\006\006thread\006"
+    "\004file\006\010function\006\004line\003\007message\006\004tags\011\000\007traceId\006"
+    // binary-v1：HTTP 事件字段
+    "\006timing\012\011dnsLookup\005\015tcpConnection\005\014tlsHandshake\005\017timeToFirstByte\005"
+    "\017contentDownload\005\020connectionReused\001\014protocolName\006\002h2\014localAddress\006"
+    "\015remoteAddress\006\024requestBodyBytesSent\003\031responseBodyBytesReceived\003"
+    "\010response\012\012statusCode\003\220\003\007headers\012\014Content-Type\006\020application/json"
+    "\004body\007\007endTime\010\010duration\005\020errorDescription\006"
+    "\004http\012\001\002_0\012\007request\012\002id\006\044\006method\006\003GET\003url\006\010https://"
+    "\012queryItems\012\000\007headers\012\006Accept\006\003*/*\004body\007\011startTime\010"
+    "\007traceId\006\010isMocked\001\010isReplay\001\012mockRuleId\006"
+    // binary-v1：批量消息外层结构 map { "type": "events", "payload": array }
+    "\012\002\004type\006\006events\007payload\011";
+
+const uint8_t* DPBridgeCompressionDictionary(size_t* outLength) {
+    if (outLength != NULL) {
+        *outLength = sizeof(kDPBridgeDictionaryV1) - 1;
+    }
+    return (const uint8_t*)kDPBridgeDictionaryV1;
+}
+
+// MARK: - 压缩
+
+/// raw deflate（无 zlib 头与校验，长度与完整性由外层帧保证）
+#define DP_BRIDGE_WINDOW_BITS (-15)
+
+struct DPBridgeDeflater {
+    z_stream stream;
+    DPBridgeDeflateStats stats;
+};
+
+static uint64_t dp_bridge_thread_cpu_nanos(void) {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+DPBridgeDeflater* DPBridgeDeflaterCreate(int level) {
+    if (level < 1 || level > 9) {
+        level = 6;
+    }
+
+    DPBridgeDeflater* deflater = calloc(1, sizeof(DPBridgeDeflater));
+    if (deflater == NULL) {
+        return NULL;
+    }
+    if (deflateInit2(&deflater->stream, level, Z_DEFLATED, DP_BRIDGE_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        free(deflater);
+        return NULL;
+    }
+    return deflater;
+}
+
+void DPBridgeDeflaterDestroy(DPBridgeDeflater* deflater) {
+    if (deflater == NULL) {
+        return;
+    }
+    deflateEnd(&deflater->stream);
+    free(deflater);
+}
+
+size_t DPBridgeDeflateBound(DPBridgeDeflater* deflater, size_t inputLength) {
+    return (size_t)deflateBound(&deflater->stream, (uLong)inputLength);
+}
+
+size_t DPBridgeDeflate(DPBridgeDeflater* deflater,
+                       const uint8_t* input, size_t inputLength,
+                       uint8_t* output, size_t outputCapacity) {
+    if (inputLength > UINT32_MAX || outputCapacity > UINT32_MAX) {
+        return 0;
+    }
+
+    uint64_t cpuStart = dp_bridge_thread_cpu_nanos();
+    z_stream* stream = &deflater->stream;
+
+    // 每批独立：复位后重新装载字典（deflateReset 保留已分配的窗口与哈希表）
+    size_t dictionaryLength = 0;
+    const uint8_t* dictionary = DPBridgeCompressionDictionary(&dictionaryLength);
+    if (deflateReset(stream) != Z_OK ||
+        deflateSetDictionary(stream, dictionary, (uInt)dictionaryLength) != Z_OK) {
+        return 0;
+    }
+
+    stream->next_in = (Bytef*)input;
+    stream->avail_in = (uInt)inputLength;
+    stream->next_out = output;
+    stream->avail_out = (uInt)outputCapacity;
+    int status = deflate(stream, Z_FINISH);
+    size_t outputLength = (size_t)stream->total_out;
+
+    deflater->stats.cpuNanos += dp_bridge_thread_cpu_nanos() - cpuStart;
+    if (status != Z_STREAM_END) {
+        return 0;
+    }
+
+    deflater->stats.batches++;
+    deflater->stats.inputBytes += inputLength;
+    deflater->stats.outputBytes += outputLength;
+    return outputLength;
+}
+
+void DPBridgeDeflaterGetStats(const DPBridgeDeflater* deflater, DPBridgeDeflateStats* outStats) {
+    *outStats = deflater->stats;
+}
+
+// MARK: - 解压
+
+bool DPBridgeInflate(const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputLength) {
+    if (inputLength > UINT32_MAX || outputLength > UINT32_MAX) {
+        return false;
+    }
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, DP_BRIDGE_WINDOW_BITS) != Z_OK) {
+        return false;
+    }
+
+    // raw deflate 需在开始解压前装载字典
+    size_t dictionaryLength = 0;
+    const uint8_t* dictionary = DPBridgeCompressionDictionary(&dictionaryLength);
+    bool ok = inflateSetDictionary(&stream, dictionary, (uInt)dictionaryLength) == Z_OK;
+
+    if (ok) {
+        stream.next_in = (Bytef*)input;
+        stream.avail_in = (uInt)inputLength;
+        stream.next_out = output;
+        stream.avail_out = (uInt)outputLength;
+        ok = inflate(&stream, Z_FINISH) == Z_STREAM_END && stream.total_out == outputLength;
+    }
+
+    inflateEnd(&stream);
+    return ok;
+}
@@ -0,0 +1,217 @@
+//
+//  DPEventRing.c
+//  DebugProbe
+//
+//  有界 MPSC 环形缓冲区（Vyukov 有界队列）
+//  每个槽位带序号：初始为槽位下标 i；位置 p 写入完成后置为 p + 1；消费后置为 p + slotCount，供下一轮写入
+//  生产者比较槽位序号与写入位置判断空 / 满，CAS 前移写入位置认领；消费者只需比较序号，无需 CAS
+//  槽位数取 2 的幂以便用掩码索引，容量上限另行检查，使 capacity 可为任意值（如默认的 10000）
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "DPEventRing.h"
+
+#include <sched.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// MARK: - 数据结构
+
+/// 缓存行大小（写入位置、消费位置分属不同缓存行，避免生产者与消费者互相失效）
+#define DP_EVENT_RING_CACHE_LINE 64
+
+/// 获取消费者锁时自旋多少次后让出 CPU
+#define DP_EVENT_RING_SPIN_LIMIT 64
+
+struct DPEventRing {
+    /// 下一个写入位置（生产者 CAS 前移）
+    alignas(DP_EVENT_RING_CACHE_LINE) _Atomic uint64_t enqueuePosition;
+    /// 下一个消费位置（仅消费者写入，其他线程只读统计）
+    alignas(DP_EVENT_RING_CACHE_LINE) _Atomic uint64_t dequeuePosition;
+    /// 消费者锁
+    atomic_flag consumerLock;
+    /// 丢弃计数
+    _Atomic uint64_t droppedCount;
+    /// 待消费字节数
+    _Atomic uint64_t pendingBytes;
+    /// 唤醒原因（DPEventRingWake* 位掩码）
+    _Atomic uint32_t wakeReasons;
+    /// 容量上限、槽位数与掩码
+    alignas(DP_EVENT_RING_CACHE_LINE) uint32_t capacity;
+    uint32_t slotCount;
+    uint64_t mask;
+    /// 槽位序号（紧随结构体分配）
+    _Atomic uint64_t sequences[];
+};
+
+// MARK: - 生命周期
+
+DPEventRing* DPEventRingCreate(uint32_t capacity) {
+    if (capacity == 0) {
+        capacity = 1;
+    } else if (capacity > (1u << 31)) {
+        capacity = 1u << 31;
+    }
+    uint32_t slotCount = 2;
+    while (slotCount < capacity) {
+        slotCount <<= 1;
+    }
+
+    // 结构体要求缓存行对齐，分配大小须为对齐值的整数倍
+    size_t size = sizeof(DPEventRing) + (size_t)slotCount * sizeof(_Atomic uint64_t);
+    size = (size + DP_EVENT_RING_CACHE_LINE - 1) & ~(size_t)(DP_EVENT_RING_CACHE_LINE - 1);
+    DPEventRing* ring = aligned_alloc(DP_EVENT_RING_CACHE_LINE, size);
+    if (ring == NULL) {
+        return NULL;
+    }
+
+    atomic_init(&ring->enqueuePosition, 0);
+    atomic_init(&ring->dequeuePosition, 0);
+    atomic_flag_clear(&ring->consumerLock);
+    atomic_init(&ring->droppedCount, 0);
+    atomic_init(&ring->pendingBytes, 0);
+    atomic_init(&ring->wakeReasons, 0);
+    ring->capacity = capacity;
+    ring->slotCount = slotCount;
+    ring->mask = slotCount - 1;
+    for (uint32_t i = 0; i < slotCount; i++) {
+        atomic_init(&ring->sequences[i], i);
+    }
+    return ring;
+}
+
+void DPEventRingDestroy(DPEventRing* ring) {
+    free(ring);
+}
+
+uint32_t DPEventRingGetCapacity(const DPEventRing* ring) {
+    return ring->capacity;
+}
+
+uint32_t DPEventRingGetSlotCount(const DPEventRing* ring) {
+    return ring->slotCount;
+}
+
+// MARK: - 生产者
+
+bool DPEventRingClaim(DPEventRing* ring, uint64_t* outPosition) {
+    uint64_t position = atomic_load_explicit(&ring->enqueuePosition, memory_order_relaxed);
+    for (;;) {
+        uint64_t sequence = atomic_load_explicit(&ring->sequences[position & ring->mask], memory_order_acquire);
+        int64_t difference = (int64_t)(sequence - position);
+        if (difference == 0) {
+            // 容量上限：消费位置只增不减，读到旧值只会偏保守地判为已满
+            if (position - atomic_load_explicit(&ring->dequeuePosition, memory_order_relaxed) >= ring->capacity) {
+                return false;
+            }
+            // 槽位空闲，竞争认领（失败时 position 被更新为最新值）
+            if (atomic_compare_exchange_weak_explicit(&ring->enqueuePosition, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                *outPosition = position;
+                return true;
+            }
+        } else if (difference < 0) {
+            // 槽位仍保存着上一轮未消费的元素：已满
+            return false;
+        } else {
+            // 其他生产者已认领该位置
+            position = atomic_load_explicit(&ring->enqueuePosition, memory_order_relaxed);
+        }
+    }
+}
+
+void DPEventRingPublish(DPEventRing* ring, uint64_t position) {
+    atomic_store_explicit(&ring->sequences[position & ring->mask], position + 1, memory_order_release);
+}
+
+void DPEventRingRecordDrop(DPEventRing* ring) {
+    atomic_fetch_add_explicit(&ring->droppedCount, 1, memory_order_relaxed);
+}
+
+void DPEventRingAddBytes(DPEventRing* ring, uint64_t bytes) {
+    atomic_fetch_add_explicit(&ring->pendingBytes, bytes, memory_order_relaxed);
+}
+
+bool DPEventRingRequestWake(DPEventRing* ring, uint32_t reasons) {
+    // 与 DPEventRingTakeWake 中的屏障配对：生产者先写入元素再读标记，消费者先清标记再读元素数量
+    atomic_thread_fence(memory_order_seq_cst);
+    // 已置位时只读不写，避免每次写入都争抢同一缓存行
+    uint32_t current = atomic_load_explicit(&ring->wakeReasons, memory_order_relaxed);
+    if ((current & reasons) == reasons) {
+        return false;
+    }
+    uint32_t previous = atomic_fetch_or_explicit(&ring->wakeReasons, reasons, memory_order_acq_rel);
+    return (previous & reasons) != reasons;
+}
+
+// MARK: - 消费者
+
+bool DPEventRingTryLockConsumer(DPEventRing* ring) {
+    return !atomic_flag_test_and_set_explicit(&ring->consumerLock, memory_order_acquire);
+}
+
+void DPEventRingLockConsumer(DPEventRing* ring) {
+    uint32_t spins = 0;
+    while (atomic_flag_test_and_set_explicit(&ring->consumerLock, memory_order_acquire)) {
+        if (++spins >= DP_EVENT_RING_SPIN_LIMIT) {
+            spins = 0;
+            sched_yield();
+        }
+    }
+}
+
+void DPEventRingUnlockConsumer(DPEventRing* ring) {
+    atomic_flag_clear_explicit(&ring->consumerLock, memory_order_release);
+}
+
+bool DPEventRingPeek(DPEventRing* ring, uint64_t* outPosition) {
+    uint64_t position = atomic_load_explicit(&ring->dequeuePosition, memory_order_relaxed);
+    uint64_t sequence = atomic_load_explicit(&ring->sequences[position & ring->mask], memory_order_acquire);
+    if (sequence != position + 1) {
+        return false;
+    }
+    *outPosition = position;
+    return true;
+}
+
+void DPEventRingConsume(DPEventRing* ring, uint64_t position) {
+    atomic_store_explicit(&ring->sequences[position & ring->mask], position + ring->slotCount, memory_order_release);
+    atomic_store_explicit(&ring->dequeuePosition, position + 1, memory_order_relaxed);
+}
+
+void DPEventRingSubtractBytes(DPEventRing* ring, uint64_t bytes) {
+    atomic_fetch_sub_explicit(&ring->pendingBytes, bytes, memory_order_relaxed);
+}
+
+uint32_t DPEventRingTakeWake(DPEventRing* ring, uint32_t reasons) {
+    uint32_t previous = atomic_fetch_and_explicit(&ring->wakeReasons, ~reasons, memory_order_acq_rel);
+    atomic_thread_fence(memory_order_seq_cst);
+    return previous & reasons;
+}
+
+// MARK: - 查询
+
+uint64_t DPEventRingGetCount(const DPEventRing* ring) {
+    // 先读消费位置：两次读取之间消费者前移只会使结果偏大，不会下溢
+    uint64_t dequeued = atomic_load_explicit(&((DPEventRing*)ring)->dequeuePosition, memory_order_relaxed);
+    uint64_t enqueued = atomic_load_explicit(&((DPEventRing*)ring)->enqueuePosition, memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+uint64_t DPEventRingGetBytes(const DPEventRing* ring) {
+    return atomic_load_explicit(&((DPEventRing*)ring)->pendingBytes, memory_order_relaxed);
+}
+
+void DPEventRingGetStats(const DPEventRing* ring, DPEventRingStats* outStats) {
+    DPEventRing* mutableRing = (DPEventRing*)ring;
+    outStats->consumed = atomic_load_explicit(&mutableRing->dequeuePosition, memory_order_relaxed);
+    outStats->claimed = atomic_load_explicit(&mutableRing->enqueuePosition, memory_order_relaxed);
+    outStats->dropped = atomic_load_explicit(&mutableRing->droppedCount, memory_order_relaxed);
+}
@@ -0,0 +1,81 @@
+//
+//  DPBridgeCompression.h
+//  DebugProbe
+//
+//  Bridge 批量事件压缩（deflate-dict-v1）
+//  raw deflate + 预置字典：字典由常见 HTTP 头名称 / 取值与 DebugEvent 字段名（JSON 与 binary-v1 两种编码）组成，
+//  每批都从同一字典开始，单批即可获得接近长会话的压缩率，批与批之间互不依赖（可单独重传、持久化）
+//  字典内容属于协议的一部分，修改时必须提升版本号（deflate-dict-v2）
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#ifndef DPBridgeCompression_h
+#define DPBridgeCompression_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - 数据结构
+
+/// 压缩器（不透明类型，复用 zlib 状态，非线程安全）
+typedef struct DPBridgeDeflater DPBridgeDeflater;
+
+/// 压缩统计
+typedef struct {
+    /// 执行压缩的批次数（含压缩后未变小、调用方最终原样发送的批次）
+    uint64_t batches;
+    /// 压缩前字节数
+    uint64_t inputBytes;
+    /// 压缩后字节数
+    uint64_t outputBytes;
+    /// 压缩耗费的线程 CPU 时间（纳秒）
+    uint64_t cpuNanos;
+} DPBridgeDeflateStats;
+
+// MARK: - 字典
+
+/// deflate-dict-v1 预置字典
+const uint8_t* DPBridgeCompressionDictionary(size_t* outLength);
+
+// MARK: - 压缩
+
+/// 创建压缩器
+/// @param level zlib 压缩级别（1-9，越大越慢；超出范围时使用 6）
+/// @return 分配失败时返回 NULL
+DPBridgeDeflater* DPBridgeDeflaterCreate(int level);
+
+/// 销毁压缩器
+void DPBridgeDeflaterDestroy(DPBridgeDeflater* deflater);
+
+/// 压缩输出的最大长度
+size_t DPBridgeDeflateBound(DPBridgeDeflater* deflater, size_t inputLength);
+
+/// 压缩一批数据
+/// @param output 输出缓冲区，容量至少为 DPBridgeDeflateBound
+/// @return 压缩后的长度，失败时返回 0
+size_t DPBridgeDeflate(DPBridgeDeflater* deflater,
+                       const uint8_t* input, size_t inputLength,
+                       uint8_t* output, size_t outputCapacity);
+
+/// 获取压缩统计
+void DPBridgeDeflaterGetStats(const DPBridgeDeflater* deflater, DPBridgeDeflateStats* outStats);
+
+// MARK: - 解压
+
+/// 解压一批数据（Hub 侧 / 基准测试使用）
+/// @param outputLength 解压后的长度（发送方随数据一起传输）
+/// @return 数据损坏或长度不符时返回 false
+bool DPBridgeInflate(const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputLength);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DPBridgeCompression_h */
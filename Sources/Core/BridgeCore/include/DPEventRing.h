@@ -0,0 +1,129 @@
+//
+//  DPEventRing.h
+//  DebugProbe
+//
+//  有界多生产者单消费者（MPSC）环形缓冲区
+//  只管理槽位序号，元素由调用方存放在与槽位数等长的数组中，按 position & (slotCount - 1) 索引：
+//    生产者：DPEventRingClaim -> 写入元素 -> DPEventRingPublish
+//    消费者：持有消费者锁 -> DPEventRingPeek -> 取出元素 -> DPEventRingConsume
+//  生产者之间、生产者与消费者之间均无锁；消费者锁只用于在多个潜在消费者（定时刷新、满时淘汰最旧事件）间互斥
+//  另外维护待消费字节数与唤醒标记，供生产者在积压达到阈值时只唤醒一次消费者
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#ifndef DPEventRing_h
+#define DPEventRing_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - 数据结构
+
+/// 环形缓冲区（不透明类型）
+typedef struct DPEventRing DPEventRing;
+
+/// 环形缓冲区统计
+typedef struct {
+    /// 已认领的写入数量（含尚未发布的）
+    uint64_t claimed;
+    /// 已消费的数量（含淘汰的）
+    uint64_t consumed;
+    /// 丢弃数量（满时丢弃新元素或淘汰最旧元素，由调用方通过 DPEventRingRecordDrop 记录）
+    uint64_t dropped;
+} DPEventRingStats;
+
+/// 唤醒原因（位掩码）
+enum {
+    /// 缓冲区有待消费的元素，消费者需按最大延迟安排一次消费（缓冲区清空前保持置位）
+    DPEventRingWakeDeadline = 1u << 0,
+    /// 积压达到阈值，消费者需立即消费
+    DPEventRingWakeFlush = 1u << 1,
+};
+
+// MARK: - 生命周期
+
+/// 创建环形缓冲区
+/// @param capacity 最多容纳的元素数量（槽位数向上取整为 2 的幂，超出 capacity 的槽位不会被使用）
+/// @return 分配失败时返回 NULL
+DPEventRing* DPEventRingCreate(uint32_t capacity);
+
+/// 销毁环形缓冲区（调用方需先取出并释放仍在缓冲区中的元素）
+void DPEventRingDestroy(DPEventRing* ring);
+
+/// 最多容纳的元素数量（创建时传入的 capacity）
+uint32_t DPEventRingGetCapacity(const DPEventRing* ring);
+
+/// 槽位数量（2 的幂，调用方的元素数组按此分配）
+uint32_t DPEventRingGetSlotCount(const DPEventRing* ring);
+
+// MARK: - 生产者
+
+/// 认领一个写入位置（任意线程）
+/// @param outPosition 写入位置，元素存放在 position & (slotCount - 1)
+/// @return 缓冲区已满（元素数量达到 capacity）时返回 false
+bool DPEventRingClaim(DPEventRing* ring, uint64_t* outPosition);
+
+/// 发布已写入的位置，之后对消费者可见（release 语义）
+void DPEventRingPublish(DPEventRing* ring, uint64_t position);
+
+/// 记录一次丢弃（仅用于统计）
+void DPEventRingRecordDrop(DPEventRing* ring);
+
+/// 增加待消费字节数（在 DPEventRingPublish 之前调用，保证消费者减去时不会下溢）
+void DPEventRingAddBytes(DPEventRing* ring, uint64_t bytes);
+
+/// 请求唤醒消费者（任意线程）
+/// 与 DPEventRingTakeWake 之间有完整内存屏障：消费者清除标记后再检查元素数量，不会漏掉并发写入
+/// @param reasons DPEventRingWake* 的组合
+/// @return 有原因此前未置位时返回 true，调用方负责调度消费者；全部已置位（消费者已被通知）时返回 false
+bool DPEventRingRequestWake(DPEventRing* ring, uint32_t reasons);
+
+// MARK: - 消费者
+
+/// 尝试获取消费者锁（已被占用时立即返回 false）
+bool DPEventRingTryLockConsumer(DPEventRing* ring);
+
+/// 获取消费者锁（自旋等待，持有方只做 O(1) 或有界的出队操作）
+void DPEventRingLockConsumer(DPEventRing* ring);
+
+/// 释放消费者锁
+void DPEventRingUnlockConsumer(DPEventRing* ring);
+
+/// 查看最旧的已发布位置（需持有消费者锁）
+/// 最旧位置已认领但尚未发布时同样返回 false，保证按认领顺序消费
+/// @return 没有可消费的元素时返回 false
+bool DPEventRingPeek(DPEventRing* ring, uint64_t* outPosition);
+
+/// 消费 DPEventRingPeek 返回的位置，槽位归还给生产者（需持有消费者锁，调用前应已取出元素）
+void DPEventRingConsume(DPEventRing* ring, uint64_t position);
+
+/// 减少待消费字节数（取出或淘汰元素后调用）
+void DPEventRingSubtractBytes(DPEventRing* ring, uint64_t bytes);
+
+/// 清除唤醒原因
+/// @param reasons 要清除的 DPEventRingWake* 组合
+/// @return 清除前其中已置位的原因
+uint32_t DPEventRingTakeWake(DPEventRing* ring, uint32_t reasons);
+
+// MARK: - 查询
+
+/// 当前元素数量（已认领减已消费，并发写入时为近似值）
+uint64_t DPEventRingGetCount(const DPEventRing* ring);
+
+/// 待消费字节数（并发写入时为近似值）
+uint64_t DPEventRingGetBytes(const DPEventRing* ring);
+
+/// 获取统计
+void DPEventRingGetStats(const DPEventRing* ring, DPEventRingStats* outStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DPEventRing_h */
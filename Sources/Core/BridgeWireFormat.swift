@@ -0,0 +1,370 @@
+// BridgeWireFormat.swift
+// DebugProbe
+//
+// Created by Sun on 2025/12/18.
+// Copyright © 2025 Sun. All rights reserved.
+//
+// Bridge 传输编码
+// 注册时协商：设备在 register 中列出支持的编码，Hub 在 registered 中确认；未确认时使用 JSON
+//
+// binary-v1 帧格式（WebSocket 二进制消息可包含一个或多个帧）：
+//   frame = varint(length) value
+//   value = tag(1 字节) + 内容
+//     0x00 null   0x01 false   0x02 true
+//     0x03 int    zigzag varint
+//     0x04 uint   varint
+//     0x05 double 8 字节小端 IEEE 754
+//     0x06 string varint(字节数) + UTF-8
+//     0x07 bytes  varint(字节数) + 原始字节（Data 不再 base64）
+//     0x08 date   8 字节小端 double，Unix 秒
+//     0x09 array  varint(元素数) + value...
+//     0x0A map    varint(键数) + (varint(字节数) + UTF-8 键, value)...
+// 结构与 JSON 编码一一对应（Codable 键名不变），Hub 可解码为同一棵对象树
+//
+
+import Foundation
+
+// MARK: - Encoding
+
+/// Bridge 传输编码
+public enum BridgeWireEncoding: String, Codable, CaseIterable {
+    /// JSON 文本（默认 / 兜底）
+    case json
+    /// 长度前缀 + varint 的紧凑二进制编码
+    case binaryV1 = "binary-v1"
+}
+
+// MARK: - Codec
+
+/// Bridge 消息编解码
+public enum BridgeWireCodec {
+    /// 编码一条完整消息
+    public static func encodeMessage(_ message: BridgeMessage, encoding: BridgeWireEncoding) throws -> Data {
+        switch encoding {
+        case .json:
+            let encoder = JSONEncoder()
+            encoder.dateEncodingStrategy = .iso8601WithMilliseconds
+            return try encoder.encode(message)
+        case .binaryV1:
+            return try frame(BridgeBinaryEncoder().encode(message))
+        }
+    }
+
+    /// 解码一条 WebSocket 消息中的全部 Bridge 消息
+    /// 以 `{` 开头的内容按 JSON 解析（协商前、或 Hub 仍发送 JSON 时），否则按 binary-v1 帧解析
+    public static func decodeMessages(from data: Data) throws -> [BridgeMessage] {
+        if data.first == UInt8(ascii: "{") {
+            let decoder = JSONDecoder()
+            decoder.dateDecodingStrategy = .iso8601
+            return try [decoder.decode(BridgeMessage.self, from: data)]
+        }
+
+        var reader = BridgeWireReader(data)
+        var messages: [BridgeMessage] = []
+        let decoder = BridgeBinaryDecoder()
+        while !reader.isAtEnd {
+            try messages.append(decoder.decode(BridgeMessage.self, from: reader.readFrame()))
+        }
+        return messages
+    }
+
+    /// 为编码好的 value 加上长度前缀
+    public static func frame(_ body: Data) -> Data {
+        var writer = BridgeWireWriter()
+        writer.writeVarint(UInt64(body.count))
+        writer.append(body)
+        return writer.data
+    }
+}
+
+// MARK: - Error
+
+/// binary-v1 解析错误
+public enum BridgeWireError: LocalizedError {
+    case truncated
+    case invalidTag(UInt8)
+    case invalidVarint
+    case invalidUTF8
+    case nestingTooDeep
+    case trailingBytes(Int)
+    case decompressionFailed
+
+    public var errorDescription: String? {
+        switch self {
+        case .truncated: "Unexpected end of binary frame"
+        case let .invalidTag(tag): "Invalid value tag: \(tag)"
+        case .invalidVarint: "Malformed varint"
+        case .invalidUTF8: "Invalid UTF-8 string"
+        case .nestingTooDeep: "Value nesting too deep"
+        case let .trailingBytes(count): "Unexpected \(count) trailing bytes after value"
+        case .decompressionFailed: "Failed to decompress message"
+        }
+    }
+}
+
+// MARK: - Value
+
+/// binary-v1 值树
+indirect enum BridgeWireValue {
+    case null
+    case bool(Bool)
+    case int(Int64)
+    case uint(UInt64)
+    case double(Double)
+    case string(String)
+    case bytes(Data)
+    case date(Date)
+    case array([BridgeWireValue])
+    case map([(key: String, value: BridgeWireValue)])
+
+    /// 类型描述（用于解码错误信息）
+    var kindDescription: String {
+        switch self {
+        case .null: "null"
+        case .bool: "bool"
+        case .int: "int"
+        case .uint: "uint"
+        case .double: "double"
+        case .string: "string"
+        case .bytes: "bytes"
+        case .date: "date"
+        case .array: "array"
+        case .map: "map"
+        }
+    }
+}
+
+/// 值标签
+enum BridgeWireTag: UInt8 {
+    case null = 0x00
+    case falseValue = 0x01
+    case trueValue = 0x02
+    case int = 0x03
+    case uint = 0x04
+    case double = 0x05
+    case string = 0x06
+    case bytes = 0x07
+    case date = 0x08
+    case array = 0x09
+    case map = 0x0A
+}
+
+// MARK: - Writer
+
+/// binary-v1 写入器
+struct BridgeWireWriter {
+    private(set) var bytes: [UInt8] = []
+
+    var data: Data {
+        Data(bytes)
+    }
+
+    mutating func reserveCapacity(_ count: Int) {
+        bytes.reserveCapacity(count)
+    }
+
+    mutating func writeTag(_ tag: BridgeWireTag) {
+        bytes.append(tag.rawValue)
+    }
+
+    mutating func writeVarint(_ value: UInt64) {
+        var remaining = value
+        while remaining >= 0x80 {
+            bytes.append(UInt8(truncatingIfNeeded: remaining) | 0x80)
+            remaining >>= 7
+        }
+        bytes.append(UInt8(remaining))
+    }
+
+    mutating func writeFixed64(_ value: UInt64) {
+        withUnsafeBytes(of: value.littleEndian) { bytes.append(contentsOf: $0) }
+    }
+
+    /// 写入 varint(字节数) + UTF-8（不含标签，map 的键也使用此格式）
+    mutating func writeString(_ string: String) {
+        var string = string
+        string.withUTF8 { utf8 in
+            writeVarint(UInt64(utf8.count))
+            bytes.append(contentsOf: utf8)
+        }
+    }
+
+    mutating func append(_ data: Data) {
+        bytes.append(contentsOf: data)
+    }
+
+    mutating func append(contentsOf other: [UInt8]) {
+        bytes.append(contentsOf: other)
+    }
+
+    mutating func write(_ value: BridgeWireValue) {
+        switch value {
+        case .null:
+            writeTag(.null)
+        case let .bool(flag):
+            writeTag(flag ? .trueValue : .falseValue)
+        case let .int(number):
+            writeTag(.int)
+            writeVarint(UInt64(bitPattern: (number << 1) ^ (number >> 63)))
+        case let .uint(number):
+            writeTag(.uint)
+            writeVarint(number)
+        case let .double(number):
+            writeTag(.double)
+            writeFixed64(number.bitPattern)
+        case let .string(string):
+            writeTag(.string)
+            writeString(string)
+        case let .bytes(data):
+            writeTag(.bytes)
+            writeVarint(UInt64(data.count))
+            append(data)
+        case let .date(date):
+            writeTag(.date)
+            writeFixed64(date.timeIntervalSince1970.bitPattern)
+        case let .array(elements):
+            writeTag(.array)
+            writeVarint(UInt64(elements.count))
+            for element in elements {
+                write(element)
+            }
+        case let .map(entries):
+            writeTag(.map)
+            writeVarint(UInt64(entries.count))
+            for entry in entries {
+                writeString(entry.key)
+                write(entry.value)
+            }
+        }
+    }
+}
+
+// MARK: - Reader
+
+/// binary-v1 读取器
+struct BridgeWireReader {
+    /// 最大嵌套深度（防止恶意数据耗尽栈）
+    private static var maxDepth: Int { 128 }
+
+    private let bytes: [UInt8]
+    private var offset = 0
+
+    init(_ data: Data) {
+        bytes = [UInt8](data)
+    }
+
+    var isAtEnd: Bool {
+        offset >= bytes.count
+    }
+
+    var remainingCount: Int {
+        bytes.count - offset
+    }
+
+    /// 读取一个长度前缀帧的内容
+    mutating func readFrame() throws -> Data {
+        let length = try readLength()
+        defer { offset += length }
+        return Data(bytes[offset..<offset + length])
+    }
+
+    mutating func readValue() throws -> BridgeWireValue {
+        try readValue(depth: 0)
+    }
+
+    private mutating func readValue(depth: Int) throws -> BridgeWireValue {
+        guard depth < Self.maxDepth else { throw BridgeWireError.nestingTooDeep }
+
+        let rawTag = try readByte()
+        guard let tag = BridgeWireTag(rawValue: rawTag) else {
+            throw BridgeWireError.invalidTag(rawTag)
+        }
+
+        switch tag {
+        case .null:
+            return .null
+        case .falseValue:
+            return .bool(false)
+        case .trueValue:
+            return .bool(true)
+        case .int:
+            let zigzag = try readVarint()
+            return .int(Int64(bitPattern: zigzag >> 1) ^ -Int64(bitPattern: zigzag & 1))
+        case .uint:
+            return try .uint(readVarint())
+        case .double:
+            return try .double(Double(bitPattern: readFixed64()))
+        case .string:
+            return try .string(readString())
+        case .bytes:
+            let length = try readLength()
+            defer { offset += length }
+            return .bytes(Data(bytes[offset..<offset + length]))
+        case .date:
+            return try .date(Date(timeIntervalSince1970: Double(bitPattern: readFixed64())))
+        case .array:
+            let count = try readLength()
+            var elements: [BridgeWireValue] = []
+            elements.reserveCapacity(count)
+            for _ in 0..<count {
+                try elements.append(readValue(depth: depth + 1))
+            }
+            return .array(elements)
+        case .map:
+            let count = try readLength()
+            var entries: [(key: String, value: BridgeWireValue)] = []
+            entries.reserveCapacity(count)
+            for _ in 0..<count {
+                let key = try readString()
+                try entries.append((key, readValue(depth: depth + 1)))
+            }
+            return .map(entries)
+        }
+    }
+
+    private mutating func readByte() throws -> UInt8 {
+        guard offset < bytes.count else { throw BridgeWireError.truncated }
+        defer { offset += 1 }
+        return bytes[offset]
+    }
+
+    mutating func readVarint() throws -> UInt64 {
+        var result: UInt64 = 0
+        var shift: UInt64 = 0
+        while true {
+            let byte = try readByte()
+            guard shift < 64, shift < 63 || byte <= 1 else { throw BridgeWireError.invalidVarint }
+            result |= UInt64(byte & 0x7F) << shift
+            if byte & 0x80 == 0 {
+                return result
+            }
+            shift += 7
+        }
+    }
+
+    /// 读取长度 / 数量，并确认剩余字节至少有这么多（每个元素至少 1 字节）
+    private mutating func readLength() throws -> Int {
+        let length = try readVarint()
+        guard length <= UInt64(remainingCount) else { throw BridgeWireError.truncated }
+        return Int(length)
+    }
+
+    private mutating func readFixed64() throws -> UInt64 {
+        guard remainingCount >= 8 else { throw BridgeWireError.truncated }
+        var value: UInt64 = 0
+        for index in 0..<8 {
+            value |= UInt64(bytes[offset + index]) << (8 * UInt64(index))
+        }
+        offset += 8
+        return value
+    }
+
+    private mutating func readString() throws -> String {
+        let length = try readLength()
+        defer { offset += length }
+        guard let string = String(bytes: bytes[offset..<offset + length], encoding: .utf8) else {
+            throw BridgeWireError.invalidUTF8
+        }
+        return string
+    }
+}
@@ -32,9 +32,19 @@ public final class DebugBridgeClient: NSObject {
         /// 配合 ping/pong 机制可以更快检测到连接断开
         public var heartbeatInterval: TimeInterval = 10.0
 
+        /// 单批事件数上限；积压达到此数量时立即发送，不等待 flushInterval
         public var batchSize: Int = 100
+
+        /// 最大发送延迟（秒）- 事件进入缓冲区后最迟经过此时间发送
         public var flushInterval: TimeInterval = 1.0
 
+        /// 单批字节数上限；积压事件的编码达到此大小时立即发送
+        public var flushByteThreshold: Int = 256 * 1024
+
+        /// 空闲时检查间隔的上限（秒）- 没有事件时检查间隔从 flushInterval 起倍增到此上限
+        /// 新事件到达时会立即把下一次发送提前到 flushInterval 之内
+        public var maxIdleFlushInterval: TimeInterval = 30.0
+
         /// 是否启用事件持久化（断线时保存到本地）
         public var enablePersistence: Bool = true
 
@@ -50,6 +60,19 @@ public final class DebugBridgeClient: NSObject {
         /// 事件丢弃策略
         public var dropPolicy: DropPolicy = .dropOldest
 
+        /// 首选传输编码（注册时与 Hub 协商，Hub 未确认时回退为 JSON）
+        /// 事件在采集时按当前协商结果编码（Hub 确认前为 JSON），协商前后产生的事件混在同一批时在发送前转码
+        public var wireEncoding: BridgeWireEncoding = .binaryV1
+
+        /// 首选批量压缩算法（注册时与 Hub 协商，Hub 未确认时不压缩）
+        public var compression: BridgeWireCompression = .deflateDictV1
+
+        /// 压缩阈值（字节）- 低于此长度的批次直接发送，压缩收益抵不上 CPU 开销
+        public var compressionThreshold: Int = 1024
+
+        /// zlib 压缩级别（1-9）
+        public var compressionLevel: Int = 6
+
         public init(hubURL: URL, token: String) {
             self.hubURL = hubURL
             self.token = token
@@ -105,7 +128,12 @@ public final class DebugBridgeClient: NSObject {
     private var webSocketTask: URLSessionWebSocketTask?
     private var urlSession: URLSession?
     private var heartbeatTimer: Timer?
-    private var flushTimer: Timer?
+    /// 刷新调度定时器（workQueue 上的单次定时器，每次刷新后按积压情况重新设定）
+    private var flushSource: DispatchSourceTimer?
+    /// 下一次定时刷新的时间
+    private var flushDeadline: DispatchTime = .distantFuture
+    /// 当前空闲检查间隔（指数退避）
+    private var idleFlushInterval: TimeInterval = 1.0
     private var reconnectTimer: Timer?
     private var recoveryTimer: Timer?
     private let workQueue = DispatchQueue(label: "com.sunimp.debugplatform.bridge", qos: .utility)
@@ -113,8 +141,11 @@ public final class DebugBridgeClient: NSObject {
     private var isRecovering = false
     private var pendingEventIds: [String] = [] // 正在发送中的事件ID
 
-    /// 事件缓冲区
-    private var eventBuffer: [DebugEvent] = []
+    /// 事件缓冲区（有界 MPSC 环形缓冲区，采集线程直接写入已编码的事件）
+    private var eventRing: EventRingBuffer<EncodedEvent>?
+    /// 已从环形缓冲区取出、正在发送（或发送失败待重试）的一批事件
+    private var inFlightBatch: [EncodedEvent] = []
+    /// 保护 eventRing 引用与 inFlightBatch（事件写入不经过此队列）
     private let bufferQueue = DispatchQueue(label: "com.sunimp.debugplatform.bridge.buffer", qos: .utility)
 
     /// 重连尝试次数
@@ -130,6 +161,35 @@ public final class DebugBridgeClient: NSObject {
     /// 是否已发送注册请求（防止重复发送）
     private var hasRegistered = false
 
+    /// 协商结果（只在 workQueue 上写入；采集线程与公开的发送方法会并发读取，经 negotiationLock 访问）
+    private let negotiationLock = NSLock()
+    private var _negotiatedEncoding: BridgeWireEncoding = .json
+    private var _compressor: BridgeBatchCompressor?
+
+    /// 与 Hub 协商后的传输编码（Hub 确认注册前始终为 JSON）
+    /// 采集时也按此编码，协商完成后产生的事件发送前无需转码
+    private var negotiatedEncoding: BridgeWireEncoding {
+        get { withNegotiationLock { _negotiatedEncoding } }
+        set { withNegotiationLock { _negotiatedEncoding = newValue } }
+    }
+
+    /// 批量压缩器（协商出压缩算法后创建；存在时设备 -> Hub 的消息都带压缩信封）
+    private var compressor: BridgeBatchCompressor? {
+        get { withNegotiationLock { _compressor } }
+        set { withNegotiationLock { _compressor = newValue } }
+    }
+    /// 已发送的含非 stats 事件的批次数（workQueue 上读写）
+    /// 只含 stats 事件的批次不计入，否则统计事件自身成批发送后下次心跳又会上报，空闲连接永远停不下来
+    private var sentEventBatches = 0
+    /// 上次随心跳上报压缩统计时的 sentEventBatches（无新批次时不重复上报）
+    private var reportedCompressionBatches = 0
+
+    private func withNegotiationLock<T>(_ body: () -> T) -> T {
+        negotiationLock.lock()
+        defer { negotiationLock.unlock() }
+        return body()
+    }
+
     // MARK: - Lifecycle
 
     override public init() {
@@ -196,8 +256,13 @@ public final class DebugBridgeClient: NSObject {
         updateState(.connecting)
         isManualDisconnect = false
         hasRegistered = false // 重置注册标记
+        negotiatedEncoding = .json
+        compressor = nil
+        sentEventBatches = 0
+        reportedCompressionBatches = 0
 
-        // 注册事件回调（接收来自插件的事件）
+        // 创建事件缓冲区并注册事件回调（接收来自插件的事件）
+        prepareEventRing(capacity: configuration.maxBufferSize)
         registerEventCallback()
 
         // 初始化持久化队列
@@ -230,6 +295,10 @@ public final class DebugBridgeClient: NSObject {
         urlSession = nil
         sessionId = nil
         hasRegistered = false // 重置注册标记
+        negotiatedEncoding = .json
+        compressor = nil
+        sentEventBatches = 0
+        reportedCompressionBatches = 0
 
         updateState(.disconnected)
     }
@@ -260,10 +329,10 @@ public final class DebugBridgeClient: NSObject {
         }
 
         do {
-            let decoder = JSONDecoder()
-            decoder.dateDecodingStrategy = .iso8601
-            let bridgeMessage = try decoder.decode(BridgeMessage.self, from: data)
-            handleBridgeMessage(bridgeMessage)
+            // JSON 与 binary-v1 按首字节区分，一条二进制消息可包含多个帧
+            for bridgeMessage in try BridgeWireCodec.decodeMessages(from: data) {
+                handleBridgeMessage(bridgeMessage)
+            }
         } catch {
             DebugLog.error(.bridge, "Failed to decode message: \(error)")
         }
@@ -271,17 +340,10 @@ public final class DebugBridgeClient: NSObject {
 
     private func handleBridgeMessage(_ message: BridgeMessage) {
         switch message {
-        case let .registered(sessionId):
-            self.sessionId = sessionId
-            updateState(.registered)
-            startTimers()
-
-            // 连接成功，重置重连状态
-            resetReconnectState()
-
-            // 连接成功后，开始恢复发送持久化的事件
-            if configuration?.enablePersistence == true {
-                startRecovery()
+        case let .registered(sessionId, wireEncoding, compression):
+            // 消息在 URLSession 代理线程上到达，协商状态只在 workQueue 上修改，与刷新、断开串行
+            workQueue.async { [weak self] in
+                self?.handleRegistered(sessionId: sessionId, wireEncoding: wireEncoding, compression: compression)
             }
 
         case let .replayRequest(payload):
@@ -314,6 +376,33 @@ public final class DebugBridgeClient: NSObject {
         }
     }
 
+    /// 应用注册结果（在 workQueue 上调用）
+    private func handleRegistered(sessionId: String, wireEncoding: BridgeWireEncoding, compression: BridgeWireCompression) {
+        self.sessionId = sessionId
+        negotiatedEncoding = wireEncoding
+        if compression != .none, let configuration {
+            compressor = BridgeBatchCompressor(
+                level: configuration.compressionLevel,
+                threshold: configuration.compressionThreshold
+            )
+        } else {
+            compressor = nil
+        }
+        sentEventBatches = 0
+        reportedCompressionBatches = 0
+        DebugLog.info(.bridge, "Registered with wire encoding: \(wireEncoding.rawValue), compression: \(compression.rawValue)")
+        updateState(.registered)
+        startTimers()
+
+        // 连接成功，重置重连状态
+        resetReconnectState()
+
+        // 连接成功后，开始恢复发送持久化的事件
+        if configuration?.enablePersistence == true {
+            startRecovery()
+        }
+    }
+
     /// 执行请求重放
     private func executeReplayRequest(_ payload: ReplayRequestPayload) {
         guard let url = URL(string: payload.url) else {
@@ -392,22 +481,38 @@ public final class DebugBridgeClient: NSObject {
 
     private func send(_ message: BridgeMessage, completion: ((Error?) -> Void)? = nil) {
         do {
-            let encoder = JSONEncoder()
-            encoder.dateEncodingStrategy = .iso8601WithMilliseconds
-            let data = try encoder.encode(message)
-
-            webSocketTask?.send(.data(data)) { [weak self] error in
-                if let error {
-                    self?.handleError(error)
-                }
-                completion?(error)
-            }
+            let data = try BridgeWireCodec.encodeMessage(message, encoding: negotiatedEncoding)
+            send(data, compressible: false, completion: completion)
         } catch {
             DebugLog.error(.bridge, "Failed to encode message: \(error)")
             completion?(error)
         }
     }
 
+    /// 发送预序列化事件的批量上报消息（拼接各事件的编码，不重新编码；协商了压缩时按阈值压缩）
+    private func send(_ events: [EncodedEvent], completion: ((Error?) -> Void)? = nil) {
+        if events.contains(where: { !$0.isStats }) {
+            sentEventBatches += 1
+        }
+        send(BridgeMessage.encodedEventsMessage(events, encoding: negotiatedEncoding), compressible: true, completion: completion)
+    }
+
+    /// 发送已编码的消息
+    /// 协商了压缩时每条消息都带信封；只有批量事件（在 workQueue 上串行发送）会真正压缩
+    private func send(_ data: Data, compressible: Bool, completion: ((Error?) -> Void)?) {
+        var data = data
+        if let compressor {
+            data = compressible ? compressor.envelope(data) : BridgeCompressionEnvelope.plain(data)
+        }
+
+        webSocketTask?.send(.data(data)) { [weak self] error in
+            if let error {
+                self?.handleError(error)
+            }
+            completion?(error)
+        }
+    }
+
     /// 发送设备注册请求
     private func sendRegister() {
         guard let configuration else { return }
@@ -428,7 +533,22 @@ public final class DebugBridgeClient: NSObject {
         }
 
         DebugLog.debug(.bridge, "Sending register request for device: \(deviceInfo.deviceId), plugins: \(pluginStates)")
-        send(.register(deviceInfo, token: configuration.token, pluginStates: pluginStates))
+        // 首选编码在前，JSON 始终作为兜底
+        var wireEncodings = [configuration.wireEncoding]
+        if configuration.wireEncoding != .json {
+            wireEncodings.append(.json)
+        }
+        var compressions = [configuration.compression]
+        if configuration.compression != .none {
+            compressions.append(.none)
+        }
+        send(.register(
+            deviceInfo,
+            token: configuration.token,
+            pluginStates: pluginStates,
+            wireEncodings: wireEncodings,
+            compressions: compressions
+        ))
     }
 
     /// 发送设备信息更新（如别名变更）
@@ -450,29 +570,38 @@ public final class DebugBridgeClient: NSObject {
     }
 
     /// 批量发送事件
+    /// 由刷新调度触发：定时器到期、积压达到阈值时的生产者唤醒、上一批发送完成后仍有积压
     private func flushEvents() {
         guard let configuration else { return }
+        // 正在发送时不重复发送，发送完成后会继续调度
         guard !isFlushing else { return }
 
-        // 从内置缓冲区获取事件
-        var events: [DebugEvent] = []
+        // 上一批发送失败时先重试该批，否则从环形缓冲区取出新的一批（按数量与字节数截断）
+        var events: [EncodedEvent] = []
         bufferQueue.sync {
-            events = Array(eventBuffer.prefix(configuration.batchSize))
+            // 先清除阈值唤醒再取出：取出期间写入并达到阈值的生产者会重新唤醒，不会因标记仍置位而被吞掉
+            eventRing?.takeWake(.flush)
+            if inFlightBatch.isEmpty, let eventRing {
+                inFlightBatch = eventRing.drain(maxCount: configuration.batchSize, maxBytes: configuration.flushByteThreshold)
+            }
+            events = inFlightBatch
+        }
+        guard !events.isEmpty else {
+            scheduleNextFlush()
+            return
         }
-        guard !events.isEmpty else { return }
 
         // 如果已连接，直接发送
         if state == .registered {
             isFlushing = true
             DebugLog.debug(.bridge, "Flushing \(events.count) events to hub")
 
-            send(.events(events)) { [weak self] error in
+            send(events) { [weak self] error in
                 guard let self else { return }
                 if error == nil {
-                    // 成功发送，从缓冲区移除
+                    // 成功发送，释放该批
                     bufferQueue.async {
-                        let removeCount = min(events.count, self.eventBuffer.count)
-                        self.eventBuffer.removeFirst(removeCount)
+                        self.inFlightBatch.removeAll()
                     }
                 } else {
                     DebugLog.error(.bridge, "Failed to flush events, keeping in queue")
@@ -480,97 +609,249 @@ public final class DebugBridgeClient: NSObject {
 
                 workQueue.async {
                     self.isFlushing = false
+                    // 积压仍达到阈值时立即发送下一批：突发按 socket 的速度排空，而不是每个周期一批
+                    if error == nil, self.isFlushThresholdReached() {
+                        self.flushEvents()
+                    } else {
+                        self.scheduleNextFlush()
+                    }
                 }
             }
         } else {
             DebugLog.debug(.bridge, "Not registered (state=\(state)), events pending: \(events.count)")
             if configuration.enablePersistence {
                 // 未连接时，将事件存入持久化队列
-                var eventsToSave: [DebugEvent] = []
+                var eventsToSave: [EncodedEvent] = []
                 bufferQueue.sync {
-                    eventsToSave = eventBuffer
-                    eventBuffer.removeAll()
+                    eventsToSave = inFlightBatch
+                    inFlightBatch.removeAll()
+                    if let eventRing {
+                        eventsToSave += eventRing.drain(maxCount: .max)
+                    }
                 }
                 if !eventsToSave.isEmpty {
                     EventPersistenceQueue.shared.enqueue(eventsToSave)
                     DebugLog.debug(.persistence, "Persisted \(eventsToSave.count) events (offline)")
                 }
             }
+            scheduleNextFlush()
         }
     }
 
+    // MARK: - Flush Scheduling
+
+    /// 启动刷新调度（在 workQueue 上调用）
+    private func startFlushScheduler() {
+        guard let configuration, flushSource == nil else { return }
+
+        let source = DispatchSource.makeTimerSource(queue: workQueue)
+        source.setEventHandler { [weak self] in
+            self?.flushEvents()
+        }
+        flushSource = source
+        idleFlushInterval = configuration.flushInterval
+
+        // 立即刷新一次，发送注册完成前积压的事件
+        flushDeadline = .now()
+        source.schedule(deadline: flushDeadline, repeating: .never)
+        source.resume()
+    }
+
+    /// 停止刷新调度（在 workQueue 上调用）
+    private func stopFlushScheduler() {
+        flushSource?.cancel()
+        flushSource = nil
+        flushDeadline = .distantFuture
+    }
+
+    /// 按积压情况设定下一次定时刷新
+    /// 有积压（含发送失败待重试的一批）时最迟 flushInterval 后刷新；空闲时检查间隔倍增到 maxIdleFlushInterval
+    private func scheduleNextFlush() {
+        guard let configuration, flushSource != nil else { return }
+
+        var ring: EventRingBuffer<EncodedEvent>?
+        var hasPending = false
+        bufferQueue.sync {
+            ring = eventRing
+            hasPending = !inFlightBatch.isEmpty || (eventRing?.count ?? 0) > 0
+        }
+
+        if !hasPending, let ring {
+            // 缓冲区已清空：清除 deadline 唤醒，之后第一个到达的事件会重新唤醒调度
+            // 清除后再检查一次，期间写入的事件可能没有看到清除
+            ring.takeWake(.deadline)
+            if ring.count > 0 {
+                hasPending = true
+                _ = ring.requestWake(.deadline)
+            }
+        }
+
+        if hasPending {
+            idleFlushInterval = configuration.flushInterval
+            armFlushTimer(after: configuration.flushInterval)
+        } else {
+            armFlushTimer(after: idleFlushInterval)
+            idleFlushInterval = min(idleFlushInterval * 2, max(configuration.maxIdleFlushInterval, configuration.flushInterval))
+        }
+    }
+
+    /// 处理生产者的唤醒请求（在 workQueue 上调用）
+    private func handleFlushWake() {
+        guard let configuration, flushSource != nil,
+              let ring = bufferQueue.sync(execute: { eventRing }) else { return }
+
+        ring.takeWake(.flush)
+        if isFlushThresholdReached() {
+            flushEvents()
+            return
+        }
+
+        // 新事件到达：空闲退避中的定时器提前到 flushInterval 之内
+        let deadline = DispatchTime.now() + configuration.flushInterval
+        if !isFlushing, flushDeadline > deadline {
+            idleFlushInterval = configuration.flushInterval
+            armFlushTimer(after: configuration.flushInterval)
+        }
+    }
+
+    /// 写入后按积压情况唤醒刷新调度（采集线程上调用；已唤醒时不重复切换队列）
+    private func wakeFlushScheduler(_ ring: EventRingBuffer<EncodedEvent>, configuration: Configuration) {
+        var reasons: EventRingBuffer<EncodedEvent>.WakeReasons = .deadline
+        if ring.count >= configuration.batchSize || ring.pendingBytes >= configuration.flushByteThreshold {
+            reasons.insert(.flush)
+        }
+        guard ring.requestWake(reasons) else { return }
+
+        workQueue.async { [weak self] in
+            self?.handleFlushWake()
+        }
+    }
+
+    /// 积压是否达到立即发送的阈值
+    private func isFlushThresholdReached() -> Bool {
+        guard let configuration, let ring = bufferQueue.sync(execute: { eventRing }) else { return false }
+        return ring.count >= configuration.batchSize || ring.pendingBytes >= configuration.flushByteThreshold
+    }
+
+    private func armFlushTimer(after interval: TimeInterval) {
+        guard let flushSource else { return }
+        flushDeadline = .now() + interval
+        // 允许 10% 的误差，便于系统合并唤醒
+        flushSource.schedule(deadline: flushDeadline, repeating: .never, leeway: .milliseconds(Int(interval * 100)))
+    }
+
     // MARK: - Event Buffer Management
 
+    /// 按配置的容量准备环形缓冲区
+    /// 容量变化时重建，并把旧缓冲区中的事件迁移过去（超出新容量的最旧事件被丢弃）
+    private func prepareEventRing(capacity: Int) {
+        bufferQueue.sync {
+            if let eventRing, eventRing.capacity == max(capacity, 1) {
+                return
+            }
+            let ring = EventRingBuffer<EncodedEvent>(capacity: capacity)
+            if let eventRing {
+                for event in eventRing.drain(maxCount: .max) {
+                    _ = ring.pushEvictingOldest(event, bytes: event.data.count)
+                }
+            }
+            eventRing = ring
+        }
+    }
+
     /// 注册事件回调
     /// 插件通过 EventCallbacks.reportEvent() 发送事件
     private func registerEventCallback() {
+        guard let ring = bufferQueue.sync(execute: { eventRing }) else { return }
         EventCallbacks.onDebugEvent = { [weak self] event in
-            self?.enqueueEvent(event)
+            self?.enqueueEvent(event, into: ring)
         }
     }
 
     /// 入队一个调试事件
-    private func enqueueEvent(_ event: DebugEvent) {
+    /// 在采集线程上直接写入环形缓冲区，不切换队列、不分配闭包
+    /// 事件在这里编码一次，之后发送、持久化、恢复都直接使用编码结果
+    private func enqueueEvent(_ event: DebugEvent, into ring: EventRingBuffer<EncodedEvent>) {
         guard let configuration else { return }
 
-        bufferQueue.async { [weak self] in
-            guard let self else { return }
+        // dropNewest 已满时直接丢弃，省去编码
+        if case .dropNewest = configuration.dropPolicy, ring.count >= ring.capacity {
+            ring.recordDrop()
+            return
+        }
 
-            // 检查缓冲区是否已满
-            if eventBuffer.count >= configuration.maxBufferSize {
-                switch configuration.dropPolicy {
-                case .dropOldest:
-                    eventBuffer.removeFirst()
-                case .dropNewest:
-                    return // 不添加新事件
-                case let .sample(rate):
-                    // rate 表示保留率：rate=0.8 意味着保留 80% 的事件
-                    if Double.random(in: 0...1) > rate {
-                        return // 不满足采样条件，丢弃此事件
-                    }
-                    if eventBuffer.count >= configuration.maxBufferSize {
-                        eventBuffer.removeFirst()
-                    }
+        let encoded: EncodedEvent
+        do {
+            // 按当前协商结果编码（Hub 确认前为 JSON），避免发送时再转码
+            encoded = try EncodedEvent(event, encoding: negotiatedEncoding)
+        } catch {
+            DebugLog.error(.bridge, "Failed to encode event: \(error)")
+            return
+        }
+
+        let bytes = encoded.data.count
+        switch configuration.dropPolicy {
+        case .dropOldest:
+            guard ring.pushEvictingOldest(encoded, bytes: bytes) != .dropped else { return }
+        case .dropNewest:
+            // 不添加新事件
+            guard ring.tryPush(encoded, bytes: bytes) else {
+                ring.recordDrop()
+                return
+            }
+        case let .sample(rate):
+            if !ring.tryPush(encoded, bytes: bytes) {
+                // rate 表示保留率：rate=0.8 意味着保留 80% 的事件
+                guard Double.random(in: 0...1) <= rate else {
+                    ring.recordDrop() // 不满足采样条件，丢弃此事件
+                    return
                 }
+                guard ring.pushEvictingOldest(encoded, bytes: bytes) != .dropped else { return }
             }
+        }
 
-            eventBuffer.append(event)
-
-            // 打印事件入队日志（便于调试）
-            switch event {
-            case let .http(httpEvent):
-                DebugLog.debug(
-                    .bridge,
-                    "Event queued: HTTP \(httpEvent.request.method) \(httpEvent.request.url.prefix(80))... (buffer: \(eventBuffer.count))"
-                )
-            case let .log(logEvent):
-                DebugLog.debug(
-                    .bridge,
-                    "Event queued: Log [\(logEvent.level)] \(logEvent.message.prefix(50))... (buffer: \(eventBuffer.count))"
-                )
-            case let .webSocket(wsEvent):
-                DebugLog.debug(.bridge, "Event queued: WebSocket \(wsEvent) (buffer: \(eventBuffer.count))")
-            case .stats:
-                DebugLog.debug(.bridge, "Event queued: Stats (buffer: \(eventBuffer.count))")
-            case let .performance(perfEvent):
-                DebugLog.debug(.bridge, "Event queued: Performance \(perfEvent.eventType.rawValue) (buffer: \(eventBuffer.count))")
-            }
+        wakeFlushScheduler(ring, configuration: configuration)
+
+        // 打印事件入队日志（便于调试）
+        switch event {
+        case let .http(httpEvent):
+            DebugLog.debug(
+                .bridge,
+                "Event queued: HTTP \(httpEvent.request.method) \(httpEvent.request.url.prefix(80))... (buffer: \(ring.count))"
+            )
+        case let .log(logEvent):
+            DebugLog.debug(
+                .bridge,
+                "Event queued: Log [\(logEvent.level)] \(logEvent.message.prefix(50))... (buffer: \(ring.count))"
+            )
+        case let .webSocket(wsEvent):
+            DebugLog.debug(.bridge, "Event queued: WebSocket \(wsEvent) (buffer: \(ring.count))")
+        case .stats:
+            DebugLog.debug(.bridge, "Event queued: Stats (buffer: \(ring.count))")
+        case let .performance(perfEvent):
+            DebugLog.debug(.bridge, "Event queued: Performance \(perfEvent.eventType.rawValue) (buffer: \(ring.count))")
         }
     }
 
-    /// 获取当前缓冲区大小
+    /// 获取当前缓冲区大小（含正在发送的一批）
     public var bufferCount: Int {
         var count = 0
         bufferQueue.sync {
-            count = eventBuffer.count
+            count = (eventRing?.count ?? 0) + inFlightBatch.count
         }
         return count
     }
 
+    /// 因缓冲区已满被丢弃的事件数量
+    public var droppedEventCount: UInt64 {
+        bufferQueue.sync { eventRing?.droppedCount ?? 0 }
+    }
+
     /// 清空缓冲区
     public func clearBuffer() {
         bufferQueue.async { [weak self] in
-            self?.eventBuffer.removeAll()
+            self?.eventRing?.removeAll()
+            self?.inFlightBatch.removeAll()
         }
     }
 
@@ -609,7 +890,7 @@ public final class DebugBridgeClient: NSObject {
             return
         }
 
-        let events = EventPersistenceQueue.shared.dequeueBatch(maxCount: configuration.recoveryBatchSize)
+        let events = EventPersistenceQueue.shared.dequeueEncodedBatch(maxCount: configuration.recoveryBatchSize)
 
         if events.isEmpty {
             // 恢复完成
@@ -618,8 +899,8 @@ public final class DebugBridgeClient: NSObject {
             return
         }
 
-        // 发送事件
-        send(.events(events))
+        // 发送事件（直接拼接持久化的 JSON）
+        send(events)
         DebugLog.debug(
             .bridge,
             "Recovered \(events.count) events, remaining: \(EventPersistenceQueue.shared.queueCount)"
@@ -651,13 +932,11 @@ public final class DebugBridgeClient: NSObject {
                 }
             }
 
-            // 事件刷新定时器
-            self?.flushTimer = Timer
-                .scheduledTimer(withTimeInterval: configuration.flushInterval, repeats: true) { [weak self] _ in
-                    self?.workQueue.async {
-                        self?.flushEvents()
-                    }
-                }
+        }
+
+        // 事件刷新调度
+        workQueue.async { [weak self] in
+            self?.startFlushScheduler()
         }
     }
 
@@ -665,6 +944,8 @@ public final class DebugBridgeClient: NSObject {
     private func sendHeartbeatWithHealthCheck() {
         guard state == .registered else { return }
 
+        reportCompressionStats()
+
         // 使用 WebSocket 的 ping 检测连接是否真正活跃
         webSocketTask?.sendPing { [weak self] error in
             guard let self else { return }
@@ -684,17 +965,26 @@ public final class DebugBridgeClient: NSObject {
         }
     }
 
+    /// 把压缩统计作为 stats 事件写入缓冲区，随下一批事件上报（在 workQueue 上调用）
+    private func reportCompressionStats() {
+        guard let compressor, let ring = bufferQueue.sync(execute: { eventRing }) else { return }
+
+        guard sentEventBatches != reportedCompressionBatches else { return }
+        reportedCompressionBatches = sentEventBatches
+
+        enqueueEvent(.stats(StatsEvent(compression: compressor.stats)), into: ring)
+    }
+
     private func stopTimers() {
         DispatchQueue.main.async { [weak self] in
             self?.heartbeatTimer?.invalidate()
             self?.heartbeatTimer = nil
-            self?.flushTimer?.invalidate()
-            self?.flushTimer = nil
             self?.reconnectTimer?.invalidate()
             self?.reconnectTimer = nil
             self?.recoveryTimer?.invalidate()
             self?.recoveryTimer = nil
         }
+        stopFlushScheduler()
         isRecovering = false
     }
 
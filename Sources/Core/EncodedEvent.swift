@@ -0,0 +1,142 @@
+// EncodedEvent.swift
+// DebugProbe
+//
+// Created by Sun on 2025/12/18.
+// Copyright © 2025 Sun. All rights reserved.
+//
+// 预序列化的调试事件
+// 事件在采集时编码一次，之后的批量发送、断线持久化与恢复都直接拼接这段编码，不再重新编码 / 解码
+// 采集时按当前协商的传输编码编码（Hub 确认注册前为 JSON）；只有协商前后产生的事件混在同一批时才在发送前转码
+//
+
+import Foundation
+
+/// 预序列化的调试事件（DebugEvent 的 JSON 或 binary-v1 value 片段）
+public struct EncodedEvent {
+    /// 事件 ID
+    public let eventId: String
+    /// 事件类型（http / websocket / log / stats / performance）
+    public let eventType: String
+    /// 片段的编码
+    public let encoding: BridgeWireEncoding
+    /// DebugEvent 的编码结果
+    public let data: Data
+
+    public init(eventId: String, eventType: String, encoding: BridgeWireEncoding = .json, data: Data) {
+        self.eventId = eventId
+        self.eventType = eventType
+        self.encoding = encoding
+        self.data = data
+    }
+
+    /// 编码事件
+    public init(_ event: DebugEvent, encoding: BridgeWireEncoding = .json) throws {
+        let data: Data
+        switch encoding {
+        case .json:
+            data = try Self.encoder.encode(event)
+        case .binaryV1:
+            data = try BridgeBinaryEncoder().encode(event)
+        }
+        self.init(eventId: event.eventId, eventType: Self.eventType(of: event), encoding: encoding, data: data)
+    }
+
+    /// 是否为统计事件（不含业务数据，批次中只有统计事件时不触发下一次统计上报）
+    public var isStats: Bool {
+        eventType == "stats"
+    }
+
+    /// 解码为 DebugEvent（仅在需要读取事件内容时使用）
+    public func decode() throws -> DebugEvent {
+        switch encoding {
+        case .json:
+            let decoder = JSONDecoder()
+            decoder.dateDecodingStrategy = .iso8601WithMilliseconds
+            return try decoder.decode(DebugEvent.self, from: data)
+        case .binaryV1:
+            return try BridgeBinaryDecoder().decode(DebugEvent.self, from: data)
+        }
+    }
+
+    /// 转为指定编码（编码相同时原样返回）
+    public func converted(to encoding: BridgeWireEncoding) throws -> EncodedEvent {
+        guard encoding != self.encoding else { return self }
+        return try EncodedEvent(decode(), encoding: encoding)
+    }
+
+    // MARK: - Private
+
+    /// 共享编码器：配置只在初始化时写入，encode 本身不修改编码器状态，可被多个采集线程并发使用
+    private static let encoder: JSONEncoder = {
+        let encoder = JSONEncoder()
+        encoder.dateEncodingStrategy = .iso8601WithMilliseconds
+        return encoder
+    }()
+
+    private static func eventType(of event: DebugEvent) -> String {
+        switch event {
+        case .http: "http"
+        case .webSocket: "websocket"
+        case .log: "log"
+        case .stats: "stats"
+        case .performance: "performance"
+        }
+    }
+}
+
+// MARK: - Batch Message
+
+extension BridgeMessage {
+    /// 拼接预序列化事件，生成与 `.events(_:)` 编码结果等价的批量上报消息
+    /// 编码与 encoding 不同的片段先转码，转码失败的事件被跳过
+    public static func encodedEventsMessage(_ events: [EncodedEvent], encoding: BridgeWireEncoding) -> Data {
+        let fragments = events.compactMap { event -> Data? in
+            do {
+                return try event.converted(to: encoding).data
+            } catch {
+                DebugLog.error(.bridge, "Failed to convert event \(event.eventId) to \(encoding.rawValue): \(error)")
+                return nil
+            }
+        }
+        let fragmentBytes = fragments.reduce(0) { $0 + $1.count }
+
+        switch encoding {
+        case .json:
+            let prefix = #"{"type":"events","payload":["#
+            let suffix = "]}"
+
+            var data = Data()
+            data.reserveCapacity(prefix.utf8.count + suffix.utf8.count + fragments.count + fragmentBytes)
+            data.append(contentsOf: prefix.utf8)
+            for (index, fragment) in fragments.enumerated() {
+                if index > 0 {
+                    data.append(UInt8(ascii: ","))
+                }
+                data.append(fragment)
+            }
+            data.append(contentsOf: suffix.utf8)
+            return data
+
+        case .binaryV1:
+            // map { "type": "events", "payload": array(片段...) }，每个片段本身就是完整的 value
+            var header = BridgeWireWriter()
+            header.writeTag(.map)
+            header.writeVarint(2)
+            header.writeString("type")
+            header.write(.string("events"))
+            header.writeString("payload")
+            header.writeTag(.array)
+            header.writeVarint(UInt64(fragments.count))
+
+            var frame = BridgeWireWriter()
+            let bodyLength = header.bytes.count + fragmentBytes
+            frame.reserveCapacity(bodyLength + 10)
+            frame.writeVarint(UInt64(bodyLength))
+            frame.append(contentsOf: header.bytes)
+            for fragment in fragments {
+                frame.append(fragment)
+            }
+            return frame.data
+        }
+    }
+}
@@ -128,6 +128,7 @@ public final class EventPersistenceQueue {
             event_id TEXT NOT NULL UNIQUE,
             event_type TEXT NOT NULL,
             event_data BLOB NOT NULL,
+            encoding TEXT NOT NULL DEFAULT 'json',
             created_at REAL NOT NULL,
             retry_count INTEGER DEFAULT 0
         );
@@ -141,19 +142,37 @@ public final class EventPersistenceQueue {
             sqlite3_free(errMsg)
             throw PersistenceError.tableCreationFailed(error)
         }
+
+        // 旧版本数据库没有 encoding 列（已存在时报错，忽略即可）
+        sqlite3_exec(db, "ALTER TABLE event_queue ADD COLUMN encoding TEXT NOT NULL DEFAULT 'json'", nil, nil, nil)
     }
 
     // MARK: - Enqueue
 
     /// 将事件入队到持久化存储
+    /// 编码在持久化队列上进行，不占用调用方线程；已有编码结果时使用 `enqueue(_: [EncodedEvent])`
     public func enqueue(_ event: DebugEvent) {
+        enqueue([event])
+    }
+
+    /// 批量入队事件（编码在持久化队列上进行）
+    public func enqueue(_ events: [DebugEvent]) {
+        guard !events.isEmpty else { return }
         queue.async { [weak self] in
-            self?.internalEnqueue(event)
+            guard let self else { return }
+            for event in events {
+                do {
+                    try internalEnqueue(EncodedEvent(event))
+                } catch {
+                    DebugLog.error(.persistence, "Failed to encode event: \(error)")
+                }
+            }
         }
     }
 
-    /// 批量入队事件
-    public func enqueue(_ events: [DebugEvent]) {
+    /// 批量入队预序列化事件（直接写入已编码的 JSON，不重新编码）
+    public func enqueue(_ events: [EncodedEvent]) {
+        guard !events.isEmpty else { return }
         queue.async { [weak self] in
             guard let self else { return }
             for event in events {
@@ -162,7 +181,7 @@ public final class EventPersistenceQueue {
         }
     }
 
-    private func internalEnqueue(_ event: DebugEvent) {
+    private func internalEnqueue(_ event: EncodedEvent) {
         guard isInitialized, db != nil else { return }
 
         do {
@@ -174,24 +193,12 @@ public final class EventPersistenceQueue {
                 deleteOldestEvents(count: deleteCount)
             }
 
-            // 编码事件
-            let encoder = JSONEncoder()
-            encoder.dateEncodingStrategy = .iso8601WithMilliseconds
-            let eventData = try encoder.encode(event)
-
-            // 获取事件类型
-            let eventType = switch event {
-            case .http: "http"
-            case .webSocket: "websocket"
-            case .log: "log"
-            case .stats: "stats"
-            case .performance: "performance"
-            }
+            let eventData = event.data
 
             // 插入数据库
             let sql = """
-            INSERT OR REPLACE INTO event_queue (event_id, event_type, event_data, created_at)
-            VALUES (?, ?, ?, ?)
+            INSERT OR REPLACE INTO event_queue (event_id, event_type, event_data, encoding, created_at)
+            VALUES (?, ?, ?, ?, ?)
             """
 
             var stmt: OpaquePointer?
@@ -201,11 +208,12 @@ public final class EventPersistenceQueue {
             defer { sqlite3_finalize(stmt) }
 
             sqlite3_bind_text(stmt, 1, event.eventId, -1, SQLITE_TRANSIENT)
-            sqlite3_bind_text(stmt, 2, eventType, -1, SQLITE_TRANSIENT)
+            sqlite3_bind_text(stmt, 2, event.eventType, -1, SQLITE_TRANSIENT)
             _ = eventData.withUnsafeBytes { ptr in
                 sqlite3_bind_blob(stmt, 3, ptr.baseAddress, Int32(eventData.count), SQLITE_TRANSIENT)
             }
-            sqlite3_bind_double(stmt, 4, Date().timeIntervalSince1970)
+            sqlite3_bind_text(stmt, 4, event.encoding.rawValue, -1, SQLITE_TRANSIENT)
+            sqlite3_bind_double(stmt, 5, Date().timeIntervalSince1970)
 
             if sqlite3_step(stmt) != SQLITE_DONE {
                 throw PersistenceError.insertFailed(String(cString: sqlite3_errmsg(db)))
@@ -219,13 +227,25 @@ public final class EventPersistenceQueue {
 
     /// 获取并移除一批待发送的事件
     public func dequeueBatch(maxCount: Int? = nil) -> [DebugEvent] {
-        var events: [DebugEvent] = []
+        dequeueEncodedBatch(maxCount: maxCount).compactMap { event in
+            do {
+                return try event.decode()
+            } catch {
+                DebugLog.error(.persistence, "Failed to decode event: \(error)")
+                return nil
+            }
+        }
+    }
+
+    /// 获取并移除一批待发送的预序列化事件（直接返回存储的 JSON，不解码）
+    public func dequeueEncodedBatch(maxCount: Int? = nil) -> [EncodedEvent] {
+        var events: [EncodedEvent] = []
 
         queue.sync {
             guard isInitialized, db != nil else { return }
 
             let limit = maxCount ?? configuration.batchSize
-            let sql = "SELECT id, event_data FROM event_queue ORDER BY created_at ASC LIMIT ?"
+            let sql = "SELECT id, event_id, event_type, event_data, encoding FROM event_queue ORDER BY created_at ASC LIMIT ?"
 
             var stmt: OpaquePointer?
             guard sqlite3_prepare_v2(db, sql, -1, &stmt, nil) == SQLITE_OK else {
@@ -237,28 +257,26 @@ public final class EventPersistenceQueue {
             sqlite3_bind_int(stmt, 1, Int32(limit))
 
             var idsToDelete: [Int64] = []
-            let decoder = JSONDecoder()
-            decoder.dateDecodingStrategy = .iso8601WithMilliseconds
 
             while sqlite3_step(stmt) == SQLITE_ROW {
                 let rowId = sqlite3_column_int64(stmt, 0)
-
-                if let blobPointer = sqlite3_column_blob(stmt, 1) {
-                    let blobSize = Int(sqlite3_column_bytes(stmt, 1))
-                    let data = Data(bytes: blobPointer, count: blobSize)
-
-                    do {
-                        let event = try decoder.decode(DebugEvent.self, from: data)
-                        events.append(event)
-                        idsToDelete.append(rowId)
-                    } catch {
-                        // 解码失败的事件也要删除
-                        idsToDelete.append(rowId)
-                        DebugLog.error(.persistence, "Failed to decode event: \(error)")
-                    }
-                } else {
-                    idsToDelete.append(rowId)
+                // 读取的行无论内容是否有效都要删除
+                idsToDelete.append(rowId)
+
+                guard let eventId = sqlite3_column_text(stmt, 1),
+                      let eventType = sqlite3_column_text(stmt, 2),
+                      let blobPointer = sqlite3_column_blob(stmt, 3),
+                      let encodingText = sqlite3_column_text(stmt, 4),
+                      let encoding = BridgeWireEncoding(rawValue: String(cString: encodingText)) else {
+                    continue
                 }
+                let blobSize = Int(sqlite3_column_bytes(stmt, 3))
+                events.append(EncodedEvent(
+                    eventId: String(cString: eventId),
+                    eventType: String(cString: eventType),
+                    encoding: encoding,
+                    data: Data(bytes: blobPointer, count: blobSize)
+                ))
             }
 
             // 删除已读取的事件
@@ -278,7 +296,7 @@ public final class EventPersistenceQueue {
             guard isInitialized, db != nil else { return }
 
             let limit = maxCount ?? configuration.batchSize
-            let sql = "SELECT event_data FROM event_queue ORDER BY created_at ASC LIMIT ?"
+            let sql = "SELECT event_data, encoding FROM event_queue ORDER BY created_at ASC LIMIT ?"
 
             var stmt: OpaquePointer?
             guard sqlite3_prepare_v2(db, sql, -1, &stmt, nil) == SQLITE_OK else { return }
@@ -286,15 +304,19 @@ public final class EventPersistenceQueue {
 
             sqlite3_bind_int(stmt, 1, Int32(limit))
 
-            let decoder = JSONDecoder()
-            decoder.dateDecodingStrategy = .iso8601WithMilliseconds
-
             while sqlite3_step(stmt) == SQLITE_ROW {
-                if let blobPointer = sqlite3_column_blob(stmt, 0) {
+                if let blobPointer = sqlite3_column_blob(stmt, 0),
+                   let encodingText = sqlite3_column_text(stmt, 1),
+                   let encoding = BridgeWireEncoding(rawValue: String(cString: encodingText)) {
                     let blobSize = Int(sqlite3_column_bytes(stmt, 0))
-                    let data = Data(bytes: blobPointer, count: blobSize)
-
-                    if let event = try? decoder.decode(DebugEvent.self, from: data) {
+                    let encoded = EncodedEvent(
+                        eventId: "",
+                        eventType: "",
+                        encoding: encoding,
+                        data: Data(bytes: blobPointer, count: blobSize)
+                    )
+
+                    if let event = try? encoded.decode() {
                         events.append(event)
                     }
                 }
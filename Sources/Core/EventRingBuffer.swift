@@ -0,0 +1,202 @@
+// EventRingBuffer.swift
+// DebugProbe
+//
+// Created by Sun on 2025/12/18.
+// Copyright © 2025 Sun. All rights reserved.
+//
+// 有界多生产者单消费者环形缓冲区
+// 槽位序号由 C 层 DPEventRing 管理（无锁），元素直接存放在预分配的槽位数组中：
+// 写入不分配闭包、不切换队列，淘汰最旧元素为 O(1)
+// 同时记录待消费字节数与唤醒原因，生产者据此在积压达到阈值时只唤醒一次消费者
+//
+
+import DPBridgeCore
+import Foundation
+
+/// 有界 MPSC 环形缓冲区
+/// - 任意线程调用 `tryPush` / `pushEvictingOldest` 写入
+/// - `drain` / `removeAll` 在消费者锁内取出元素，可从任意线程调用（彼此互斥）
+final class EventRingBuffer<Element>: @unchecked Sendable {
+    /// 写入结果
+    enum PushResult {
+        /// 已写入
+        case pushed
+        /// 淘汰最旧元素后写入
+        case pushedEvictingOldest
+        /// 已满，未写入
+        case dropped
+    }
+
+    /// 唤醒原因
+    struct WakeReasons: OptionSet {
+        let rawValue: UInt32
+
+        /// 有待消费的元素，需按最大延迟安排一次消费（缓冲区清空前保持置位）
+        static let deadline = WakeReasons(rawValue: UInt32(DPEventRingWakeDeadline))
+        /// 积压达到阈值，需立即消费
+        static let flush = WakeReasons(rawValue: UInt32(DPEventRingWakeFlush))
+    }
+
+    /// 最多容纳的元素数量
+    let capacity: Int
+
+    private let ring: OpaquePointer
+    private let mask: UInt64
+
+    /// 槽位存储（长度为 2 的幂的槽位数）：仅 [消费位置, 写入位置) 之间已发布的槽位处于已初始化状态
+    private let storage: UnsafeMutablePointer<Element>
+    /// 每个槽位元素的字节数（与 storage 同步写入、取出）
+    private let byteCounts: UnsafeMutablePointer<UInt64>
+
+    /// 满时淘汰最旧元素的重试次数（淘汰出的槽位可能被其他生产者抢先占用，最旧槽位可能尚未发布）
+    private static var evictionAttempts: Int { 4 }
+
+    init(capacity: Int) {
+        guard let ring = DPEventRingCreate(UInt32(clamping: max(capacity, 1))) else {
+            fatalError("DPEventRingCreate failed")
+        }
+        self.ring = ring
+        self.capacity = Int(DPEventRingGetCapacity(ring))
+        let slotCount = Int(DPEventRingGetSlotCount(ring))
+        mask = UInt64(slotCount - 1)
+        // 不预先初始化，未使用的槽位不会占用物理内存
+        storage = .allocate(capacity: slotCount)
+        byteCounts = .allocate(capacity: slotCount)
+    }
+
+    deinit {
+        removeAll()
+        storage.deallocate()
+        byteCounts.deallocate()
+        DPEventRingDestroy(ring)
+    }
+
+    // MARK: - 生产者
+
+    /// 写入元素，已满时返回 false
+    /// - Parameter bytes: 元素的字节数（计入 pendingBytes）
+    @discardableResult
+    func tryPush(_ element: Element, bytes: Int = 0) -> Bool {
+        var position: UInt64 = 0
+        guard DPEventRingClaim(ring, &position) else { return false }
+        let slot = Int(position & mask)
+        (storage + slot).initialize(to: element)
+        byteCounts[slot] = UInt64(bytes)
+        DPEventRingAddBytes(ring, UInt64(bytes))
+        DPEventRingPublish(ring, position)
+        return true
+    }
+
+    /// 写入元素，已满时淘汰最旧元素
+    /// 消费者正在取出元素时等待其释放消费者锁，取出已腾出空间时直接写入、不淘汰；
+    /// 只有最旧槽位持续处于已占用未发布状态（其他生产者写入中途被挂起）时才放弃，返回 `.dropped`
+    func pushEvictingOldest(_ element: Element, bytes: Int = 0) -> PushResult {
+        if tryPush(element, bytes: bytes) {
+            return .pushed
+        }
+        for _ in 0..<Self.evictionAttempts {
+            DPEventRingLockConsumer(ring)
+            if tryPush(element, bytes: bytes) {
+                DPEventRingUnlockConsumer(ring)
+                return .pushed
+            }
+            let evicted = evictOldestLocked()
+            let pushed = evicted && tryPush(element, bytes: bytes)
+            DPEventRingUnlockConsumer(ring)
+
+            if evicted {
+                DPEventRingRecordDrop(ring)
+            }
+            if pushed {
+                return .pushedEvictingOldest
+            }
+        }
+        recordDrop()
+        return .dropped
+    }
+
+    /// 记录一次丢弃（调用方按自身策略放弃写入时调用）
+    func recordDrop() {
+        DPEventRingRecordDrop(ring)
+    }
+
+    /// 请求唤醒消费者
+    /// - Returns: 有原因此前未置位时返回 true，调用方负责调度消费者
+    func requestWake(_ reasons: WakeReasons) -> Bool {
+        DPEventRingRequestWake(ring, reasons.rawValue)
+    }
+
+    // MARK: - 消费者
+
+    /// 按写入顺序取出至多 maxCount 个元素，累计字节数达到 maxBytes 后停止（至少取出一个）
+    func drain(maxCount: Int, maxBytes: Int = .max) -> [Element] {
+        guard maxCount > 0 else { return [] }
+
+        DPEventRingLockConsumer(ring)
+        defer { DPEventRingUnlockConsumer(ring) }
+
+        var elements: [Element] = []
+        elements.reserveCapacity(min(maxCount, Int(DPEventRingGetCount(ring))))
+        var bytes: UInt64 = 0
+        var position: UInt64 = 0
+        while elements.count < maxCount, bytes < UInt64(max(maxBytes, 1)), DPEventRingPeek(ring, &position) {
+            let slot = Int(position & mask)
+            elements.append((storage + slot).move())
+            bytes += byteCounts[slot]
+            DPEventRingConsume(ring, position)
+        }
+        DPEventRingSubtractBytes(ring, bytes)
+        return elements
+    }
+
+    /// 丢弃全部已发布的元素
+    func removeAll() {
+        DPEventRingLockConsumer(ring)
+        defer { DPEventRingUnlockConsumer(ring) }
+
+        var position: UInt64 = 0
+        while DPEventRingPeek(ring, &position) {
+            let slot = Int(position & mask)
+            (storage + slot).deinitialize(count: 1)
+            DPEventRingSubtractBytes(ring, byteCounts[slot])
+            DPEventRingConsume(ring, position)
+        }
+    }
+
+    /// 清除唤醒原因（消费者开始处理前调用，之后再检查 count 不会漏掉并发写入）
+    /// - Returns: 清除前其中已置位的原因
+    @discardableResult
+    func takeWake(_ reasons: WakeReasons) -> WakeReasons {
+        WakeReasons(rawValue: DPEventRingTakeWake(ring, reasons.rawValue))
+    }
+
+    /// 淘汰最旧的元素（调用方持有消费者锁；最旧槽位尚未发布时返回 false）
+    private func evictOldestLocked() -> Bool {
+        var position: UInt64 = 0
+        guard DPEventRingPeek(ring, &position) else { return false }
+        let slot = Int(position & mask)
+        (storage + slot).deinitialize(count: 1)
+        DPEventRingSubtractBytes(ring, byteCounts[slot])
+        DPEventRingConsume(ring, position)
+        return true
+    }
+
+    // MARK: - 查询
+
+    /// 当前元素数量（并发写入时为近似值）
+    var count: Int {
+        Int(DPEventRingGetCount(ring))
+    }
+
+    /// 待消费字节数（并发写入时为近似值）
+    var pendingBytes: Int {
+        Int(clamping: DPEventRingGetBytes(ring))
+    }
+
+    /// 因缓冲区已满丢弃或淘汰的元素数量
+    var droppedCount: UInt64 {
+        var stats = DPEventRingStats()
+        DPEventRingGetStats(ring, &stats)
+        return stats.dropped
+    }
+}
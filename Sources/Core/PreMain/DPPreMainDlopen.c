@@ -0,0 +1,142 @@
+//
+//  DPPreMainDlopen.c
+//  DebugProbe
+//
+//  dlopen / dlclose 阻塞耗时记录
+//  dyld 回调只能给出镜像加载完成的时间点，无法得知 dlopen 本身阻塞调用线程多久；
+//  平台层挂接 dlopen / dlclose（Apple 为 DYLD_INTERPOSE，Linux 为 --wrap），在真实调用前后计时后交给本模块
+//
+//  事件写入互斥锁保护的固定容量环形缓冲区：dlopen 本身耗时在百微秒以上，加锁开销可以忽略
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#include "DPPreMainInternal.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+// MARK: - 全局数据
+
+/// 是否已开启计时
+static atomic_bool g_dlopenTracingEnabled = false;
+
+/// 事件环形缓冲区（序号 s 位于 (s - 1) % 容量）
+static pthread_mutex_t g_dlopenMutex = PTHREAD_MUTEX_INITIALIZER;
+static DPDlopenEvent g_dlopenEvents[DP_DLOPEN_RING_CAPACITY];
+
+/// 最近写入的序号（0 表示尚无事件）
+static uint64_t g_dlopenHead = 0;
+
+/// 线程信息缓存
+static _Thread_local uint64_t t_dlopenThreadId = 0;
+static _Thread_local bool t_dlopenIsMainThread = false;
+
+// MARK: - 内部 API
+
+bool dp_dlopen_tracing_enabled(void) {
+    return atomic_load_explicit(&g_dlopenTracingEnabled, memory_order_relaxed);
+}
+
+/// 最旧的仍在缓冲区中的序号（调用方需持有 g_dlopenMutex）
+static uint64_t dp_dlopen_oldest_locked(void) {
+    return g_dlopenHead > DP_DLOPEN_RING_CAPACITY ? g_dlopenHead - DP_DLOPEN_RING_CAPACITY + 1 : 1;
+}
+
+void dp_dlopen_record(DPDlopenKind kind, const char* path, const void* handle,
+                      uint64_t startMachTime, uint64_t endMachTime, bool succeeded) {
+    if (t_dlopenThreadId == 0) {
+        t_dlopenThreadId = dp_platform_thread_id();
+        t_dlopenIsMainThread = dp_platform_is_main_thread();
+    }
+
+    // 路径过长时保留末尾（文件名比目录更有辨识度）
+    uint32_t pathOffset = 0;
+    if (path != NULL && path[0] != '\0') {
+        size_t length = strlen(path);
+        if (length >= DP_MAX_DYLIB_NAME_LENGTH) {
+            path += length - (DP_MAX_DYLIB_NAME_LENGTH - 1);
+            length = DP_MAX_DYLIB_NAME_LENGTH - 1;
+        }
+        dp_premain_lock();
+        pathOffset = dp_string_arena_intern(path, length, NULL);
+        dp_premain_unlock();
+    }
+
+    pthread_mutex_lock(&g_dlopenMutex);
+
+    // dlclose 只有句柄，沿用最近一次返回该句柄的 dlopen 的路径
+    if (kind == DPDlopenKindClose && handle != NULL) {
+        uint64_t oldest = dp_dlopen_oldest_locked();
+        for (uint64_t sequence = g_dlopenHead; sequence >= oldest && sequence > 0; sequence--) {
+            const DPDlopenEvent* previous = &g_dlopenEvents[(sequence - 1) % DP_DLOPEN_RING_CAPACITY];
+            if (previous->kind == DPDlopenKindOpen && previous->handle == handle) {
+                pathOffset = previous->pathOffset;
+                break;
+            }
+        }
+    }
+
+    uint64_t sequence = ++g_dlopenHead;
+    g_dlopenEvents[(sequence - 1) % DP_DLOPEN_RING_CAPACITY] = (DPDlopenEvent){
+        .sequence = sequence,
+        .startMachTime = startMachTime,
+        .durationNanos = endMachTime > startMachTime ? DPMachTimeToNanos(endMachTime - startMachTime) : 0,
+        .threadId = t_dlopenThreadId,
+        .handle = handle,
+        .pathOffset = pathOffset,
+        .kind = (uint32_t)kind,
+        .isMainThread = t_dlopenIsMainThread,
+        .succeeded = succeeded,
+    };
+
+    pthread_mutex_unlock(&g_dlopenMutex);
+}
+
+void dp_dlopen_reset_locked(void) {
+    pthread_mutex_lock(&g_dlopenMutex);
+    g_dlopenHead = 0;
+    memset(g_dlopenEvents, 0, sizeof(g_dlopenEvents));
+    pthread_mutex_unlock(&g_dlopenMutex);
+}
+
+// MARK: - 公开 API 实现
+
+bool DPPreMainIsDlopenTracingAvailable(void) {
+    return dp_platform_dlopen_hooks_installed();
+}
+
+bool DPPreMainSetDlopenTracingEnabled(bool enabled) {
+    // 钩子未挂接时开启也不会产生事件，不接受该设置
+    if (enabled && !dp_platform_dlopen_hooks_installed()) {
+        return false;
+    }
+    atomic_store_explicit(&g_dlopenTracingEnabled, enabled, memory_order_relaxed);
+    return true;
+}
+
+uint32_t DPPreMainCopyDlopenEvents(DPDlopenEvent* outBuffer, uint32_t bufferSize, uint64_t afterSequence,
+                                   uint64_t* outOverwrittenCount) {
+    pthread_mutex_lock(&g_dlopenMutex);
+
+    uint64_t first = afterSequence + 1;
+    uint64_t oldest = dp_dlopen_oldest_locked();
+    if (outOverwrittenCount != NULL) {
+        *outOverwrittenCount = first < oldest && g_dlopenHead > 0 ? oldest - first : 0;
+    }
+    if (first < oldest) {
+        first = oldest;
+    }
+
+    uint32_t copied = 0;
+    if (outBuffer != NULL) {
+        for (uint64_t sequence = first; sequence <= g_dlopenHead && copied < bufferSize; sequence++) {
+            outBuffer[copied++] = g_dlopenEvents[(sequence - 1) % DP_DLOPEN_RING_CAPACITY];
+        }
+    }
+
+    pthread_mutex_unlock(&g_dlopenMutex);
+    return copied;
+}
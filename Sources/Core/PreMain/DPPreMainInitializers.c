@@ -0,0 +1,538 @@
+//
+//  DPPreMainInitializers.c
+//  DebugProbe
+//
+//  PreMain 静态初始化器逐个计时
+//  将尚未执行的初始化器表项（__mod_init_func / .init_array）替换为预生成的包装函数，
+//  包装函数记录原函数的开始/结束时间后调用原函数
+//  - 启动批次：constructor 执行时只包装尚未初始化的用户镜像（本模块所在镜像、主程序及依赖它们的镜像）
+//  - 运行时 dlopen（仅 Apple）：dyld 在通知新镜像之后才执行其初始化器，在镜像通知中包装
+//
+//  限制：
+//  1. 本模块的依赖镜像先于 constructor 初始化，无法计时，计入 untimedInitializerCount
+//  2. 同一镜像中先于本模块 constructor 的表项已执行，包装不会被调用，到达 main() 后计入 untimedInitializerCount
+//  3. Linux 上 dlopen 钩子在真实 dlopen 返回后才补扫，新镜像的初始化器已执行，不计时也不计数
+//  4. __init_offsets、DT_INIT、arm64e 签名表项无法替换，仅计数
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "DPPreMainInternal.h"
+
+#include <dlfcn.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// MARK: - 初始化器签名
+
+#if defined(__APPLE__)
+/// dyld 调用初始化器时传入 argc / argv / envp / apple / ProgramVars
+typedef void (*dp_initializer_function_t)(int, const char**, const char**, const char**, const void*);
+#define DP_INITIALIZER_PARAMS int argc, const char** argv, const char** envp, const char** apple, const void* vars
+#define DP_INITIALIZER_ARGS argc, argv, envp, apple, vars
+#else
+/// 动态链接器 / libc 调用 .init_array 表项时传入 argc / argv / envp
+typedef void (*dp_initializer_function_t)(int, char**, char**);
+#define DP_INITIALIZER_PARAMS int argc, char** argv, char** envp
+#define DP_INITIALIZER_ARGS argc, argv, envp
+#endif
+
+// MARK: - 全局数据
+
+/// 单个被包装初始化器的记录
+typedef struct {
+    /// 所属镜像头地址
+    const void* imageHeader;
+    /// 原初始化器函数
+    dp_initializer_function_t function;
+    /// imageHeader / function 是否已写入（release 发布）
+    atomic_bool installed;
+    /// 开始执行时间
+    uint64_t startMachTime;
+    /// 结束执行时间（release 写入，非 0 表示已执行完成）
+    _Atomic uint64_t endMachTime;
+    /// 名称是否已解析
+    bool namesResolved;
+    /// 镜像文件名偏移
+    uint32_t imageNameOffset;
+    /// 符号名偏移
+    uint32_t symbolNameOffset;
+} DPInitializerSlot;
+
+/// 初始化器记录（认领槽位后写入 imageHeader / function，再以 installed 发布）
+static DPInitializerSlot g_initializerSlots[DP_MAX_TIMED_INITIALIZERS];
+
+/// 已认领的槽位数量（可能超过 DP_MAX_TIMED_INITIALIZERS，读取时截断）
+static atomic_uint g_claimedSlotCount = 0;
+
+/// 无法计时的初始化器数量
+static atomic_uint g_untimedInitializerCount = 0;
+
+/// 是否包装运行时加载的镜像（constructor 完成启动批次后开启）
+static atomic_bool g_runtimeInstallEnabled = false;
+
+/// 启动批次中单个用户镜像的初始化器表（constructor 中单线程收集）
+typedef struct {
+    const void* header;
+    void** table;
+    size_t count;
+    bool isReadOnly;
+} DPLaunchInitializerTable;
+
+/// 启动批次最多收集的初始化器表数量（超出部分计入无法计时）
+#define DP_MAX_LAUNCH_INITIALIZER_TABLES 512
+
+static DPLaunchInitializerTable g_launchTables[DP_MAX_LAUNCH_INITIALIZER_TABLES];
+static uint32_t g_launchTableCount = 0;
+
+/// 已认领的有效槽位数量
+static inline uint32_t dp_initializer_slot_limit(void) {
+    uint32_t claimed = atomic_load_explicit(&g_claimedSlotCount, memory_order_acquire);
+    return claimed < DP_MAX_TIMED_INITIALIZERS ? claimed : DP_MAX_TIMED_INITIALIZERS;
+}
+
+// MARK: - 包装函数
+
+/// 计时执行第 index 个原初始化器
+static void dp_run_timed_initializer(uint32_t index, DP_INITIALIZER_PARAMS) {
+    DPInitializerSlot* slot = &g_initializerSlots[index];
+
+    uint64_t start = dp_platform_now();
+    slot->function(DP_INITIALIZER_ARGS);
+    uint64_t end = dp_platform_now();
+
+    slot->startMachTime = start;
+    atomic_store_explicit(&slot->endMachTime, end > start ? end : start + 1, memory_order_release);
+}
+
+/// 预生成 DP_MAX_TIMED_INITIALIZERS 个包装函数，函数名与索引均为两位十六进制
+#define DP_INITIALIZER_WRAPPER(high, low)                                            \
+    static void dp_timed_initializer_##high##low(DP_INITIALIZER_PARAMS) {            \
+        dp_run_timed_initializer(0x##high##low, DP_INITIALIZER_ARGS);                \
+    }
+
+#define DP_INITIALIZER_WRAPPERS_16(high)                                             \
+    DP_INITIALIZER_WRAPPER(high, 0) DP_INITIALIZER_WRAPPER(high, 1)                  \
+    DP_INITIALIZER_WRAPPER(high, 2) DP_INITIALIZER_WRAPPER(high, 3)                  \
+    DP_INITIALIZER_WRAPPER(high, 4) DP_INITIALIZER_WRAPPER(high, 5)                  \
+    DP_INITIALIZER_WRAPPER(high, 6) DP_INITIALIZER_WRAPPER(high, 7)                  \
+    DP_INITIALIZER_WRAPPER(high, 8) DP_INITIALIZER_WRAPPER(high, 9)                  \
+    DP_INITIALIZER_WRAPPER(high, a) DP_INITIALIZER_WRAPPER(high, b)                  \
+    DP_INITIALIZER_WRAPPER(high, c) DP_INITIALIZER_WRAPPER(high, d)                  \
+    DP_INITIALIZER_WRAPPER(high, e) DP_INITIALIZER_WRAPPER(high, f)
+
+#define DP_INITIALIZER_ENTRIES_16(high)                                              \
+    dp_timed_initializer_##high##0, dp_timed_initializer_##high##1,                  \
+    dp_timed_initializer_##high##2, dp_timed_initializer_##high##3,                  \
+    dp_timed_initializer_##high##4, dp_timed_initializer_##high##5,                  \
+    dp_timed_initializer_##high##6, dp_timed_initializer_##high##7,                  \
+    dp_timed_initializer_##high##8, dp_timed_initializer_##high##9,                  \
+    dp_timed_initializer_##high##a, dp_timed_initializer_##high##b,                  \
+    dp_timed_initializer_##high##c, dp_timed_initializer_##high##d,                  \
+    dp_timed_initializer_##high##e, dp_timed_initializer_##high##f,
+
+DP_INITIALIZER_WRAPPERS_16(0) DP_INITIALIZER_WRAPPERS_16(1)
+DP_INITIALIZER_WRAPPERS_16(2) DP_INITIALIZER_WRAPPERS_16(3)
+DP_INITIALIZER_WRAPPERS_16(4) DP_INITIALIZER_WRAPPERS_16(5)
+DP_INITIALIZER_WRAPPERS_16(6) DP_INITIALIZER_WRAPPERS_16(7)
+DP_INITIALIZER_WRAPPERS_16(8) DP_INITIALIZER_WRAPPERS_16(9)
+DP_INITIALIZER_WRAPPERS_16(a) DP_INITIALIZER_WRAPPERS_16(b)
+DP_INITIALIZER_WRAPPERS_16(c) DP_INITIALIZER_WRAPPERS_16(d)
+DP_INITIALIZER_WRAPPERS_16(e) DP_INITIALIZER_WRAPPERS_16(f)
+
+/// 包装函数表（索引即记录索引）
+static const dp_initializer_function_t g_initializerWrappers[DP_MAX_TIMED_INITIALIZERS] = {
+    DP_INITIALIZER_ENTRIES_16(0) DP_INITIALIZER_ENTRIES_16(1)
+    DP_INITIALIZER_ENTRIES_16(2) DP_INITIALIZER_ENTRIES_16(3)
+    DP_INITIALIZER_ENTRIES_16(4) DP_INITIALIZER_ENTRIES_16(5)
+    DP_INITIALIZER_ENTRIES_16(6) DP_INITIALIZER_ENTRIES_16(7)
+    DP_INITIALIZER_ENTRIES_16(8) DP_INITIALIZER_ENTRIES_16(9)
+    DP_INITIALIZER_ENTRIES_16(a) DP_INITIALIZER_ENTRIES_16(b)
+    DP_INITIALIZER_ENTRIES_16(c) DP_INITIALIZER_ENTRIES_16(d)
+    DP_INITIALIZER_ENTRIES_16(e) DP_INITIALIZER_ENTRIES_16(f)
+};
+
+// MARK: - 安装
+
+/// 判断函数是否为本模块的包装函数（避免重复包装）
+static bool dp_is_initializer_wrapper(dp_initializer_function_t function) {
+    uint32_t limit = dp_initializer_slot_limit();
+    for (uint32_t i = 0; i < limit; i++) {
+        if (g_initializerWrappers[i] == function) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// 替换一张初始化器表的表项
+static void dp_patch_table(const void* header, void** table, size_t count, bool isReadOnly) {
+    // 只读表临时改为可写（按页对齐）
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t pageStart = (uintptr_t)table & ~(pageSize - 1);
+    size_t pageLength = (uintptr_t)(table + count) - pageStart;
+    if (isReadOnly && mprotect((void*)pageStart, pageLength, PROT_READ | PROT_WRITE) != 0) {
+        atomic_fetch_add_explicit(&g_untimedInitializerCount, (uint32_t)count, memory_order_relaxed);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        dp_initializer_function_t function = (dp_initializer_function_t)table[i];
+        if (function == NULL || (uintptr_t)function == (uintptr_t)-1 || dp_is_initializer_wrapper(function)) {
+            continue;
+        }
+
+        uint32_t index = atomic_fetch_add_explicit(&g_claimedSlotCount, 1, memory_order_relaxed);
+        if (index >= DP_MAX_TIMED_INITIALIZERS) {
+            atomic_fetch_add_explicit(&g_untimedInitializerCount, 1, memory_order_relaxed);
+            continue;
+        }
+
+        DPInitializerSlot* slot = &g_initializerSlots[index];
+        slot->imageHeader = header;
+        slot->function = function;
+        atomic_store_explicit(&slot->installed, true, memory_order_release);
+        table[i] = (void*)g_initializerWrappers[index];
+    }
+
+    if (isReadOnly) {
+        mprotect((void*)pageStart, pageLength, PROT_READ);
+    }
+}
+
+/// 初始化器表遍历回调：收集启动批次中用户镜像的表
+static void dp_collect_launch_table(const void* header, const char* path,
+                                    void** table, size_t count, bool isReadOnly,
+                                    uint32_t untimedCount, void* context) {
+    (void)context;
+
+    // 系统库初始化器不在应用可优化范围内，且通常位于共享缓存只读映射中
+    if (dp_platform_is_system_path(path)) {
+        return;
+    }
+
+    atomic_fetch_add_explicit(&g_untimedInitializerCount, untimedCount, memory_order_relaxed);
+    if (table == NULL || count == 0) {
+        return;
+    }
+    if (g_launchTableCount >= DP_MAX_LAUNCH_INITIALIZER_TABLES) {
+        atomic_fetch_add_explicit(&g_untimedInitializerCount, (uint32_t)count, memory_order_relaxed);
+        return;
+    }
+
+    g_launchTables[g_launchTableCount++] = (DPLaunchInitializerTable){
+        .header = header,
+        .table = table,
+        .count = count,
+        .isReadOnly = isReadOnly,
+    };
+}
+
+/// 初始化器表遍历回调：直接替换运行时新镜像的表
+static void dp_install_table(const void* header, const char* path,
+                             void** table, size_t count, bool isReadOnly,
+                             uint32_t untimedCount, void* context) {
+    (void)context;
+
+    if (dp_platform_is_system_path(path)) {
+        return;
+    }
+
+    atomic_fetch_add_explicit(&g_untimedInitializerCount, untimedCount, memory_order_relaxed);
+    if (table != NULL && count > 0) {
+        dp_patch_table(header, table, count, isReadOnly);
+    }
+}
+
+void dp_initializers_install(void) {
+    const char* disabled = getenv("DP_PREMAIN_DISABLE_INITIALIZER_TIMING");
+    if (disabled != NULL && disabled[0] != '\0' && disabled[0] != '0') {
+        return;
+    }
+
+    g_launchTableCount = 0;
+    dp_platform_enumerate_initializer_tables(dp_collect_launch_table, NULL);
+
+    // 启动批次按依赖关系自底向上初始化：本模块所在镜像、主程序以及（传递）依赖它们的镜像尚未初始化；
+    // 其余镜像是本模块的依赖或排序更早，初始化器已经执行，包装永远不会被调用
+    Dl_info selfInfo;
+    const void* selfHeader = dladdr((const void*)(uintptr_t)dp_initializers_install, &selfInfo)
+        ? selfInfo.dli_fbase : NULL;
+
+    bool pending[DP_MAX_LAUNCH_INITIALIZER_TABLES];
+    for (uint32_t i = 0; i < g_launchTableCount; i++) {
+        const void* header = g_launchTables[i].header;
+        pending[i] = header == selfHeader || dp_platform_is_main_executable(header);
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint32_t i = 0; i < g_launchTableCount; i++) {
+            if (pending[i]) continue;
+            for (uint32_t j = 0; j < g_launchTableCount; j++) {
+                if (pending[j] && g_launchTables[j].header != g_launchTables[i].header
+                    && dp_platform_image_depends_on(g_launchTables[i].header, g_launchTables[j].header)) {
+                    pending[i] = true;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < g_launchTableCount; i++) {
+        const DPLaunchInitializerTable* entry = &g_launchTables[i];
+        if (pending[i]) {
+            dp_patch_table(entry->header, entry->table, entry->count, entry->isReadOnly);
+        } else {
+            atomic_fetch_add_explicit(&g_untimedInitializerCount, (uint32_t)entry->count, memory_order_relaxed);
+        }
+    }
+    g_launchTableCount = 0;
+
+    atomic_store_explicit(&g_runtimeInstallEnabled, true, memory_order_release);
+}
+
+void dp_initializers_image_added(const void* header) {
+    if (!atomic_load_explicit(&g_runtimeInstallEnabled, memory_order_acquire)) {
+        return;
+    }
+    dp_platform_visit_image_initializers(header, dp_install_table, NULL);
+}
+
+// MARK: - 内部 API
+
+void dp_initializers_get_counts(bool mainExecuted, uint32_t* outTimedCount, uint32_t* outUntimedCount) {
+    uint32_t limit = dp_initializer_slot_limit();
+    uint32_t timed = 0;
+    uint32_t unfired = 0;
+    for (uint32_t i = 0; i < limit; i++) {
+        DPInitializerSlot* slot = &g_initializerSlots[i];
+        if (!atomic_load_explicit(&slot->installed, memory_order_acquire)) {
+            continue;
+        }
+        if (atomic_load_explicit(&slot->endMachTime, memory_order_acquire) != 0) {
+            timed++;
+        } else {
+            unfired++;
+        }
+    }
+
+    *outTimedCount = timed;
+    *outUntimedCount = atomic_load_explicit(&g_untimedInitializerCount, memory_order_relaxed)
+        + (mainExecuted ? unfired : 0);
+}
+
+uint32_t dp_initializers_image_costs(dp_image_initializer_cost_t* outCosts, uint32_t capacity) {
+    uint32_t limit = dp_initializer_slot_limit();
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < limit; i++) {
+        DPInitializerSlot* slot = &g_initializerSlots[i];
+        if (!atomic_load_explicit(&slot->installed, memory_order_acquire)) {
+            continue;
+        }
+        uint64_t end = atomic_load_explicit(&slot->endMachTime, memory_order_acquire);
+        if (end == 0) {
+            continue;
+        }
+
+        // 同一镜像的表项连续包装，通常命中最后一项；镜像数量不超过槽位数量，线性查找即可
+        uint32_t index = count;
+        for (uint32_t j = count; j > 0; j--) {
+            if (outCosts[j - 1].header == slot->imageHeader) {
+                index = j - 1;
+                break;
+            }
+        }
+        if (index == count) {
+            if (count == capacity) {
+                continue;
+            }
+            outCosts[count].header = slot->imageHeader;
+            outCosts[count].nanos = 0;
+            count++;
+        }
+        outCosts[index].nanos += DPMachTimeToNanos(end - slot->startMachTime);
+    }
+    return count;
+}
+
+uint32_t dp_initializers_slot_count(void) {
+    return dp_initializer_slot_limit();
+}
+
+void dp_initializers_reset_locked(void) {
+    // 保留原函数指针：包装函数仍在表中，只清除记录结果
+    uint32_t limit = dp_initializer_slot_limit();
+    for (uint32_t i = 0; i < limit; i++) {
+        DPInitializerSlot* slot = &g_initializerSlots[i];
+        slot->startMachTime = 0;
+        atomic_store_explicit(&slot->endMachTime, 0, memory_order_relaxed);
+        slot->namesResolved = false;
+        slot->imageNameOffset = 0;
+        slot->symbolNameOffset = 0;
+    }
+}
+
+/// 解析初始化器所属镜像与符号名称（调用方需持有 PreMain 模块互斥锁）
+static void dp_resolve_initializer_names_locked(DPInitializerSlot* slot) {
+    if (slot->namesResolved) {
+        return;
+    }
+    slot->namesResolved = true;
+
+    Dl_info info;
+    if (dladdr((const void*)(uintptr_t)slot->function, &info) == 0) {
+        return;
+    }
+
+    if (info.dli_fname != NULL) {
+        const char* name = strrchr(info.dli_fname, '/');
+        name = name != NULL ? name + 1 : info.dli_fname;
+        slot->imageNameOffset = dp_string_arena_intern(name, strlen(name), NULL);
+    }
+    // 仅当最近符号恰好是函数入口时记录，避免把内部静态函数误标为相邻的导出符号
+    if (info.dli_sname != NULL && info.dli_saddr == (void*)(uintptr_t)slot->function) {
+        slot->symbolNameOffset = dp_string_arena_intern(info.dli_sname, strlen(info.dli_sname), NULL);
+    }
+}
+
+bool dp_initializer_info_at(uint32_t index, DPInitializerInfo* outInfo) {
+    if (index >= dp_initializer_slot_limit()) {
+        return false;
+    }
+
+    DPInitializerSlot* slot = &g_initializerSlots[index];
+    if (!atomic_load_explicit(&slot->installed, memory_order_acquire)) {
+        return false;
+    }
+    uint64_t end = atomic_load_explicit(&slot->endMachTime, memory_order_acquire);
+    if (end == 0) {
+        return false;
+    }
+
+    dp_premain_lock();
+    dp_resolve_initializer_names_locked(slot);
+    outInfo->imageHeader = slot->imageHeader;
+    outInfo->function = (const void*)(uintptr_t)slot->function;
+    outInfo->startMachTime = slot->startMachTime;
+    outInfo->durationNanos = DPMachTimeToNanos(end - slot->startMachTime);
+    outInfo->imageNameOffset = slot->imageNameOffset;
+    outInfo->symbolNameOffset = slot->symbolNameOffset;
+    dp_premain_unlock();
+
+    return true;
+}
+
+// MARK: - 公开 API 实现
+
+/// 小顶堆下沉（按 durationNanos）
+static void dp_initializer_heap_sift_down(DPInitializerInfo* heap, uint32_t size, uint32_t index) {
+    while (true) {
+        uint32_t smallest = index;
+        uint32_t left = index * 2 + 1;
+        uint32_t right = left + 1;
+
+        if (left < size && heap[left].durationNanos < heap[smallest].durationNanos) {
+            smallest = left;
+        }
+        if (right < size && heap[right].durationNanos < heap[smallest].durationNanos) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            return;
+        }
+
+        DPInitializerInfo tmp = heap[index];
+        heap[index] = heap[smallest];
+        heap[smallest] = tmp;
+        index = smallest;
+    }
+}
+
+/// 小顶堆上浮
+static void dp_initializer_heap_sift_up(DPInitializerInfo* heap, uint32_t index) {
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (heap[parent].durationNanos <= heap[index].durationNanos) {
+            return;
+        }
+
+        DPInitializerInfo tmp = heap[index];
+        heap[index] = heap[parent];
+        heap[parent] = tmp;
+        index = parent;
+    }
+}
+
+uint32_t DPPreMainGetSlowestInitializers(DPInitializerInfo* outBuffer, uint32_t count) {
+    if (outBuffer == NULL || count == 0) {
+        return 0;
+    }
+
+    uint32_t heapSize = 0;
+    uint32_t limit = dp_initializer_slot_limit();
+
+    dp_premain_lock();
+
+    for (uint32_t i = 0; i < limit; i++) {
+        DPInitializerSlot* slot = &g_initializerSlots[i];
+        if (!atomic_load_explicit(&slot->installed, memory_order_acquire)) {
+            continue;
+        }
+        uint64_t end = atomic_load_explicit(&slot->endMachTime, memory_order_acquire);
+        if (end == 0) {
+            continue;
+        }
+
+        DPInitializerInfo info = {
+            .imageHeader = slot->imageHeader,
+            .function = (const void*)(uintptr_t)slot->function,
+            .startMachTime = slot->startMachTime,
+            .durationNanos = DPMachTimeToNanos(end - slot->startMachTime),
+        };
+
+        if (heapSize < count) {
+            outBuffer[heapSize] = info;
+            dp_initializer_heap_sift_up(outBuffer, heapSize);
+            heapSize++;
+        } else if (info.durationNanos > outBuffer[0].durationNanos) {
+            outBuffer[0] = info;
+            dp_initializer_heap_sift_down(outBuffer, heapSize, 0);
+        }
+    }
+
+    // 名称只为入选的初始化器解析
+    for (uint32_t i = 0; i < heapSize; i++) {
+        for (uint32_t s = 0; s < limit; s++) {
+            DPInitializerSlot* slot = &g_initializerSlots[s];
+            if ((const void*)(uintptr_t)slot->function == outBuffer[i].function) {
+                dp_resolve_initializer_names_locked(slot);
+                outBuffer[i].imageNameOffset = slot->imageNameOffset;
+                outBuffer[i].symbolNameOffset = slot->symbolNameOffset;
+                break;
+            }
+        }
+    }
+
+    dp_premain_unlock();
+
+    // 堆排序：得到按耗时降序的结果
+    for (uint32_t end = heapSize; end > 1; end--) {
+        DPInitializerInfo tmp = outBuffer[0];
+        outBuffer[0] = outBuffer[end - 1];
+        outBuffer[end - 1] = tmp;
+        dp_initializer_heap_sift_down(outBuffer, end - 1, 0);
+    }
+
+    return heapSize;
+}
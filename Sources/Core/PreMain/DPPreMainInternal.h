@@ -0,0 +1,279 @@
+//
+//  DPPreMainInternal.h
+//  DebugProbe
+//
+//  PreMain 监控模块内部共享声明（不对外公开）
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#ifndef DPPreMainInternal_h
+#define DPPreMainInternal_h
+
+#include "DPPreMainMonitor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - 平台层
+//
+// 时钟与镜像加载通知的平台实现：
+// - Apple: mach_absolute_time + _dyld_register_func_for_add_image + sysctl(KERN_PROC)
+// - Linux: clock_gettime(CLOCK_MONOTONIC_RAW) + dl_iterate_phdr / dlopen 钩子 + /proc/self/stat
+
+/// 镜像加载回调
+/// @param header 镜像头地址（Apple 为 mach_header，Linux 为 ELF 头）
+/// @param slide 镜像加载偏移
+typedef void (*dp_image_added_callback_t)(const void* header, intptr_t slide);
+
+/// 当前单调时钟计数（Apple 为 mach_absolute_time，Linux 为 CLOCK_MONOTONIC_RAW 纳秒）
+uint64_t dp_platform_now(void);
+
+/// 时钟计数与纳秒的换算比例（纳秒 = 计数 * numer / denom）
+void dp_platform_timebase(uint32_t* outNumer, uint32_t* outDenom);
+
+/// 进程启动时间（Unix 时间戳，微秒），获取失败返回 0
+uint64_t dp_platform_process_start_unix_micros(void);
+
+/// 注册镜像加载回调
+/// 已加载的镜像会立即逐个回调一次，之后新加载的镜像在加载时回调
+void dp_platform_register_image_callback(dp_image_added_callback_t callback);
+
+/// 补发尚未通知的新镜像
+/// Apple 由 dyld 实时通知，空实现；Linux 在未挂接 dlopen 时由查询路径调用补扫
+void dp_platform_poll_images(void);
+
+/// 判断镜像路径是否为系统库
+bool dp_platform_is_system_path(const char* path);
+
+/// 当前线程的系统线程 ID（Apple 为 pthread_threadid_np，Linux 为 gettid）
+uint64_t dp_platform_thread_id(void);
+
+/// 当前线程是否为主线程
+bool dp_platform_is_main_thread(void);
+
+/// 默认缓存目录（Apple 为 $HOME/Library/Caches，Linux 为 $XDG_CACHE_HOME 或 $HOME/.cache）
+/// @return 路径长度，获取失败或缓冲区不足时返回 0
+size_t dp_platform_cache_directory(char* buffer, size_t bufferSize);
+
+/// 当前可执行文件路径（Apple 为 _NSGetExecutablePath，Linux 为 /proc/self/exe）
+/// @return 路径长度，获取失败或缓冲区不足时返回 0
+size_t dp_platform_executable_path(char* buffer, size_t bufferSize);
+
+/// 初始化器表遍历回调
+/// @param header 镜像头地址
+/// @param path 镜像路径（主程序在 Linux 上为空字符串）
+/// @param table 初始化器函数指针表，可原地替换表项；无可替换的表时为 NULL
+/// @param count 表项数量
+/// @param isReadOnly 表所在页当前是否只读（替换前需临时改为可写）
+/// @param untimedCount 无法单独计时的初始化器数量（如 __init_offsets、DT_INIT）
+/// @param context 调用方上下文
+typedef void (*dp_initializer_table_visitor_t)(const void* header, const char* path,
+                                               void** table, size_t count, bool isReadOnly,
+                                               uint32_t untimedCount, void* context);
+
+/// 遍历已加载镜像的静态初始化器表
+/// Apple 为 __mod_init_func / __init_offsets，Linux 为 DT_INIT_ARRAY / DT_INIT
+void dp_platform_enumerate_initializer_tables(dp_initializer_table_visitor_t visitor, void* context);
+
+/// 访问单个镜像的静态初始化器表
+void dp_platform_visit_image_initializers(const void* header, dp_initializer_table_visitor_t visitor, void* context);
+
+/// 镜像是否直接依赖另一镜像（依赖先于依赖方初始化）
+/// Apple 比较 LC_LOAD_DYLIB 等与依赖的 LC_ID_DYLIB，Linux 比较 DT_NEEDED 与依赖的 DT_SONAME（无则为文件名）
+bool dp_platform_image_depends_on(const void* header, const void* dependency);
+
+/// 镜像是否为主程序（启动批次中最后初始化）
+bool dp_platform_is_main_executable(const void* header);
+
+/// 可执行段遍历回调
+/// @param header 镜像头地址
+/// @param path 镜像路径（主程序在 Linux 上为空字符串）
+/// @param start 段起始地址（运行时）
+/// @param size 段大小
+/// @param context 调用方上下文
+typedef void (*dp_text_segment_visitor_t)(const void* header, const char* path,
+                                          uintptr_t start, size_t size, void* context);
+
+/// 遍历已加载镜像的可执行段（Apple 为 __TEXT，Linux 为带 PF_X 的 PT_LOAD）
+void dp_platform_enumerate_text_segments(dp_text_segment_visitor_t visitor, void* context);
+
+/// 函数符号遍历回调
+/// @param name 符号名（仅在回调期间有效）
+/// @param address 运行时地址
+/// @param size 符号大小，0 表示未知（由调用方按相邻符号推算）
+typedef void (*dp_symbol_visitor_t)(const char* name, uintptr_t address, size_t size, void* context);
+
+/// 遍历镜像中定义的函数符号
+/// Apple 读取内存中 __LINKEDIT 的 LC_SYMTAB，Linux 映射磁盘上的 ELF 文件读取 .symtab（无则 .dynsym）
+/// @return 找不到符号表时返回 false
+bool dp_platform_enumerate_function_symbols(const void* header, const char* path,
+                                            dp_symbol_visitor_t visitor, void* context);
+
+/// 解析镜像的修正数量、段大小与初始化器数量
+/// Apple 读取内存中的加载命令与 __LINKEDIT（链式修正需读取磁盘文件），Linux 读取内存中的程序头与 PT_DYNAMIC
+/// @param header 镜像头地址
+/// @param path 镜像路径（可为 NULL）
+/// @param outStats 输出；解析失败时 flags 不含 DP_IMAGE_STATS_AVAILABLE
+void dp_platform_image_stats(const void* header, const char* path, DPImageStats* outStats);
+
+/// 进程启动时刻（单调时钟纳秒，与 DPMachTimeToNanos 换算结果同一坐标）
+/// Apple 读取内核记录的启动 mach_absolute_time（proc_pid_rusage），
+/// Linux 将 /proc/self/stat 的 starttime（CLOCK_BOOTTIME 滴答）对齐到 CLOCK_MONOTONIC_RAW
+/// @param outErrorNanos 误差上界（纳秒）
+/// @return 读取失败时返回 false（核心模块回退到墙上时间对齐）
+bool dp_platform_process_start_nanos(uint64_t* outStartNanos, uint64_t* outErrorNanos);
+
+/// 启动采样平台实现：按 intervalMicros 定时调用 dp_launch_sampler_record
+/// Linux 为 setitimer(ITIMER_PROF) + SIGPROF，Apple 为挂起主线程读取寄存器的采样线程（须在主线程调用）
+/// @return 平台或架构不支持时返回 false
+bool dp_platform_sampler_start(uint32_t intervalMicros);
+
+/// 停止定时采样（返回后不会再有新的 dp_launch_sampler_record 调用开始）
+void dp_platform_sampler_stop(void);
+
+/// 读取本进程内存，地址未映射或不可读时返回 false 而不触发 SIGSEGV（可在信号处理函数中调用）
+/// Linux 为 process_vm_readv，Apple 为 vm_read_overwrite
+bool dp_platform_read_memory(uintptr_t address, void* buffer, size_t size);
+
+/// dlopen / dlclose 钩子是否已挂接
+/// Apple 取决于编译期开关 DP_PREMAIN_DLOPEN_INTERPOSE，Linux 检测 --wrap 是否生效或钩子是否已被调用
+bool dp_platform_dlopen_hooks_installed(void);
+
+// MARK: - 核心模块
+
+/// 镜像加载回调热路径（由平台层注册，基准测试直接调用）
+void dp_dyld_image_added_callback(const void* mh, intptr_t slide);
+
+/// 进入已挂接的 dlopen（平台挂接函数在调用真实 dlopen 前调用，须与 dp_dlopen_exit 成对）
+/// 本线程随后通知的首个新镜像以此为加载起点并标记 DP_DYLIB_LOAD_TIMED
+/// @return 入口时间（可直接作为 dp_dlopen_record 的 startMachTime）
+uint64_t dp_dlopen_enter(void);
+
+/// 离开已挂接的 dlopen（平台挂接函数在补发新镜像之后调用）
+void dp_dlopen_exit(void);
+
+/// 以指定换算比例覆盖时间基准（仅供基准测试校验定点换算，非线程安全；numer 或 denom 为 0 时恢复平台比例）
+void dp_timebase_override(uint32_t numer, uint32_t denom);
+
+/// 将另一时钟对齐到单调时钟：多次成对采样（单调、目标、单调），取间隔最短的一对
+/// @param clock 目标时钟 clockid_t（如 CLOCK_BOOTTIME、CLOCK_REALTIME；以 int 传递，本头文件不依赖 POSIX 扩展声明）
+/// @param outOffsetNanos 目标时钟读数减去同一时刻单调时钟纳秒
+/// @param outErrorNanos 对齐误差上界（最短间隔的一半）
+/// @return 目标时钟不可用时返回 false
+bool dp_clock_align(int clock, int64_t* outOffsetNanos, uint64_t* outErrorNanos);
+
+/// 获取/释放 PreMain 模块互斥锁（驻留字符串区等共享状态）
+void dp_premain_lock(void);
+void dp_premain_unlock(void);
+
+// MARK: - 静态初始化器计时
+
+/// 包装启动批次中尚未初始化的用户镜像的初始化器表项（仅在 constructor 中调用一次）
+void dp_initializers_install(void);
+
+/// 运行时新加载的镜像（由平台层在镜像通知之后、初始化器执行之前调用；Linux 的通知晚于初始化器，不调用）
+void dp_initializers_image_added(const void* header);
+
+/// 已执行完成的包装数量与无法计时的初始化器数量
+/// @param mainExecuted 是否已到达 main()：此后仍未执行的包装说明原函数早于包装执行，计入无法计时
+void dp_initializers_get_counts(bool mainExecuted, uint32_t* outTimedCount, uint32_t* outUntimedCount);
+
+/// 已包装的槽位数量（dp_initializer_info_at 的索引上界）
+uint32_t dp_initializers_slot_count(void);
+
+/// 清除已记录的初始化器耗时与名称（仅用于重置，调用方需持有 PreMain 模块互斥锁）
+void dp_initializers_reset_locked(void);
+
+/// 单个镜像已计时的初始化器耗时合计
+typedef struct {
+    const void* header;
+    uint64_t nanos;
+} dp_image_initializer_cost_t;
+
+/// 按镜像汇总已执行完成的初始化器耗时（不加锁，不解析名称）
+/// @param outCosts 输出缓冲区，容量 DP_MAX_TIMED_INITIALIZERS 即可容纳全部镜像
+/// @return 写入的镜像数量
+uint32_t dp_initializers_image_costs(dp_image_initializer_cost_t* outCosts, uint32_t capacity);
+
+/// 按包装顺序获取第 index 个已执行完成的初始化器（含名称解析）
+/// @return 索引越界或尚未执行完成时返回 false
+bool dp_initializer_info_at(uint32_t index, DPInitializerInfo* outInfo);
+
+// MARK: - 自定义标记
+
+/// 清空标记环形缓冲区（仅用于重置）
+void dp_markers_reset(void);
+
+/// 标记遍历回调，返回 false 停止遍历
+typedef bool (*dp_mark_visitor_t)(const DPMarkEvent* event, void* context);
+
+/// 按写入序号升序遍历环形缓冲区中最新的至多 maxCount 条标记（无锁，跳过正在写入或已覆盖的槽位）
+/// @return 遍历到的有效标记数量
+uint32_t dp_markers_visit(uint64_t maxCount, dp_mark_visitor_t visitor, void* context);
+
+// MARK: - dlopen / dlclose 计时
+
+/// 是否已开启计时（平台挂接函数在调用前检查，未开启时不读取时钟）
+bool dp_dlopen_tracing_enabled(void);
+
+/// 记录一次调用（平台挂接函数在真实调用返回后调用，不得在持有 PreMain 模块互斥锁时调用）
+/// @param path dlopen 传入的路径，dlclose 传 NULL
+void dp_dlopen_record(DPDlopenKind kind, const char* path, const void* handle,
+                      uint64_t startMachTime, uint64_t endMachTime, bool succeeded);
+
+/// 清空事件（仅用于重置，调用方需持有 PreMain 模块互斥锁）
+void dp_dlopen_reset_locked(void);
+
+// MARK: - 代码页访问追踪
+
+/// 采样 main() 时的常驻页（由 DPPreMainMarkMainExecuted 在首次标记后调用，不持有模块互斥锁）
+void dp_page_trace_capture_main(void);
+
+/// 释放采样数据（仅用于重置）
+void dp_page_trace_reset(void);
+
+// MARK: - 启动采样
+
+/// 记录一个样本（在信号处理函数中或目标线程被挂起时调用：不加锁、不分配内存）
+/// @param pc 当前指令地址
+/// @param fp 帧指针，沿 [fp] = 上一帧 fp、[fp + 1] = 返回地址 回溯
+/// @param stackLow 栈的最低地址，与 stackHigh 均为 0 时以 dp_platform_read_memory 读取每一帧
+/// @param stackHigh 栈的最高地址
+/// @param threadId 被采样线程的系统线程 ID
+/// @param isMainThread 被采样线程是否为主线程
+void dp_launch_sampler_record(uintptr_t pc, uintptr_t fp, uintptr_t stackLow, uintptr_t stackHigh,
+                              uint64_t threadId, bool isMainThread);
+
+// MARK: - 启动历史
+
+/// 向启动历史文件追加本次启动的记录（由 DPPreMainMarkMainExecuted 在首次标记后调用，不持有模块互斥锁）
+/// 只解析路径并启动后台线程，数据收集与文件写入在后台完成
+void dp_launch_history_record(void);
+
+// MARK: - 驻留字符串区
+
+/// 字符串区单个块大小（字符串不跨块，块分配后地址不再移动）
+#define DP_STRING_ARENA_BLOCK_SIZE (16 * 1024)
+
+/// 字符串区最大块数量（总容量 = 块大小 * 块数量）
+#define DP_STRING_ARENA_MAX_BLOCKS 256
+
+/// 驻留字符串，相同内容只存储一次
+/// 调用方需持有 PreMain 模块互斥锁
+/// @param string 字符串起始地址（无需 NUL 结尾）
+/// @param length 字符串长度（超出 DP_MAX_DYLIB_NAME_LENGTH - 1 时截断）
+/// @param outLength 实际存储的长度，可为 NULL
+/// @return 字符串区偏移；0 表示空字符串（含分配失败）
+uint32_t dp_string_arena_intern(const char* string, size_t length, uint16_t* outLength);
+
+/// 释放字符串区全部内存（仅用于重置，调用方需持有 PreMain 模块互斥锁）
+void dp_string_arena_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DPPreMainInternal_h */
@@ -0,0 +1,540 @@
+//
+//  DPPreMainLaunchHistory.c
+//  DebugProbe
+//
+//  启动历史：固定大小的 mmap 环形文件，保留最近 DP_LAUNCH_HISTORY_CAPACITY 次启动的记录
+//
+//  文件布局（本机字节序，大小固定）：
+//  - 文件头 DPLaunchHistoryFileHeader（64 字节）
+//  - 名称哈希桶 uint32_t[DP_LAUNCH_HISTORY_NAME_BUCKETS]（开放寻址，值为名称表偏移，0 为空位）
+//  - 名称表 char[DP_LAUNCH_HISTORY_NAME_BYTES]（NUL 结尾字符串，偏移 0 为空字符串，跨启动共享）
+//  - 记录槽位 DP_LAUNCH_HISTORY_CAPACITY 个，每个为 DPLaunchHistoryRecord + DP_LAUNCH_HISTORY_MAX_IMAGES 个镜像
+//
+//  写入（每次启动一次，在 main 标记之后由后台线程完成，不阻塞主线程，也不影响已记录的时间）：
+//  1. 先复制快照与 main() 之前加载的最慢镜像（含名称解析），再打开文件并加 flock 排他锁，持锁期间只做内存写入
+//  2. 槽位 sequence 先清零，写完字段后 release 写入新序号，最后递增文件头 launchCount
+//  3. 读取方只读映射同一文件，槽位 sequence 与期望序号一致才采用
+//  名称表写满后新名称记为未命名（偏移 0），格式或容量不符时整体重建
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "DPPreMainInternal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if (DP_LAUNCH_HISTORY_NAME_BUCKETS & (DP_LAUNCH_HISTORY_NAME_BUCKETS - 1)) != 0
+#error "DP_LAUNCH_HISTORY_NAME_BUCKETS must be a power of two"
+#endif
+
+// MARK: - 文件格式
+
+/// 文件魔数（'DPLH'）与格式版本
+#define DP_LAUNCH_HISTORY_MAGIC 0x484C5044u
+#define DP_LAUNCH_HISTORY_VERSION 2
+
+/// 默认文件名前缀与后缀（位于平台缓存目录下，中间为可执行文件名与路径哈希，避免不同程序共用同一文件）
+#define DP_LAUNCH_HISTORY_FILENAME_PREFIX "DPLaunchHistory"
+#define DP_LAUNCH_HISTORY_FILENAME_SUFFIX ".bin"
+
+/// 文件名中可执行文件名的最大长度
+#define DP_LAUNCH_HISTORY_EXECUTABLE_NAME_MAX 64
+
+/// 文件头
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    /// 以下字段与编译期常量一致才视为有效，否则重建
+    uint32_t capacity;
+    uint32_t maxImages;
+    uint32_t recordSize;
+    uint32_t nameBytes;
+    uint32_t nameBucketCount;
+    /// 名称表已使用字节数（含偏移 0 处的空字符串）
+    uint32_t nameBytesUsed;
+    /// 已写入的启动总数（下一条记录的槽位 = launchCount % capacity）
+    uint64_t launchCount;
+    uint64_t reserved[3];
+} DPLaunchHistoryFileHeader;
+
+/// 各区域偏移与文件总大小
+#define DP_LH_RECORD_SIZE \
+    (sizeof(DPLaunchHistoryRecord) + DP_LAUNCH_HISTORY_MAX_IMAGES * sizeof(DPLaunchHistoryImage))
+#define DP_LH_BUCKETS_OFFSET sizeof(DPLaunchHistoryFileHeader)
+#define DP_LH_NAMES_OFFSET (DP_LH_BUCKETS_OFFSET + DP_LAUNCH_HISTORY_NAME_BUCKETS * sizeof(uint32_t))
+#define DP_LH_RECORDS_OFFSET (DP_LH_NAMES_OFFSET + DP_LAUNCH_HISTORY_NAME_BYTES)
+#define DP_LH_FILE_SIZE (DP_LH_RECORDS_OFFSET + (size_t)DP_LAUNCH_HISTORY_CAPACITY * DP_LH_RECORD_SIZE)
+
+_Static_assert(sizeof(DPLaunchHistoryFileHeader) == 64, "unexpected header size");
+_Static_assert(sizeof(DPLaunchHistoryRecord) % 8 == 0, "records must stay 8-byte aligned");
+
+/// 只读映射句柄
+struct DPLaunchHistory {
+    const uint8_t* base;
+    size_t size;
+};
+
+// MARK: - 全局数据
+
+/// 路径状态
+typedef enum {
+    /// 未设置：使用环境变量或默认路径
+    DPLaunchHistoryPathDefault = 0,
+    /// 已通过 DPPreMainSetLaunchHistoryPath 设置
+    DPLaunchHistoryPathCustom,
+    /// 已关闭
+    DPLaunchHistoryPathDisabled,
+} DPLaunchHistoryPathState;
+
+static pthread_mutex_t g_historyMutex = PTHREAD_MUTEX_INITIALIZER;
+static DPLaunchHistoryPathState g_historyPathState = DPLaunchHistoryPathDefault;
+static char g_historyPath[PATH_MAX];
+
+// MARK: - 文件区域访问
+
+static DPLaunchHistoryFileHeader* dp_lh_header(uint8_t* base) {
+    return (DPLaunchHistoryFileHeader*)base;
+}
+
+static uint32_t* dp_lh_buckets(uint8_t* base) {
+    return (uint32_t*)(base + DP_LH_BUCKETS_OFFSET);
+}
+
+static DPLaunchHistoryRecord* dp_lh_record_at_slot(const uint8_t* base, uint64_t slot) {
+    return (DPLaunchHistoryRecord*)(base + DP_LH_RECORDS_OFFSET + slot * DP_LH_RECORD_SIZE);
+}
+
+/// 文件头与编译期布局是否一致
+static bool dp_lh_header_valid(const DPLaunchHistoryFileHeader* header) {
+    return header->magic == DP_LAUNCH_HISTORY_MAGIC
+        && header->version == DP_LAUNCH_HISTORY_VERSION
+        && header->capacity == DP_LAUNCH_HISTORY_CAPACITY
+        && header->maxImages == DP_LAUNCH_HISTORY_MAX_IMAGES
+        && header->recordSize == DP_LH_RECORD_SIZE
+        && header->nameBytes == DP_LAUNCH_HISTORY_NAME_BYTES
+        && header->nameBucketCount == DP_LAUNCH_HISTORY_NAME_BUCKETS
+        && header->nameBytesUsed >= 1
+        && header->nameBytesUsed <= DP_LAUNCH_HISTORY_NAME_BYTES;
+}
+
+/// 初始化空文件头（其余区域已为 0）
+static void dp_lh_format(uint8_t* base) {
+    memset(base, 0, DP_LH_RECORDS_OFFSET);
+    DPLaunchHistoryFileHeader* header = dp_lh_header(base);
+    header->magic = DP_LAUNCH_HISTORY_MAGIC;
+    header->version = DP_LAUNCH_HISTORY_VERSION;
+    header->capacity = DP_LAUNCH_HISTORY_CAPACITY;
+    header->maxImages = DP_LAUNCH_HISTORY_MAX_IMAGES;
+    header->recordSize = (uint32_t)DP_LH_RECORD_SIZE;
+    header->nameBytes = DP_LAUNCH_HISTORY_NAME_BYTES;
+    header->nameBucketCount = DP_LAUNCH_HISTORY_NAME_BUCKETS;
+    header->nameBytesUsed = 1;
+}
+
+/// 驻留名称到文件名称表
+/// @return 名称表偏移；空名称、名称表写满或哈希桶已满时返回 0
+static uint32_t dp_lh_intern(uint8_t* base, const char* name) {
+    size_t length = strlen(name);
+    if (length == 0) {
+        return 0;
+    }
+
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+
+    DPLaunchHistoryFileHeader* header = dp_lh_header(base);
+    uint32_t* buckets = dp_lh_buckets(base);
+    char* names = (char*)(base + DP_LH_NAMES_OFFSET);
+
+    for (uint32_t probe = 0; probe < DP_LAUNCH_HISTORY_NAME_BUCKETS; probe++) {
+        uint32_t* bucket = &buckets[(hash + probe) & (DP_LAUNCH_HISTORY_NAME_BUCKETS - 1)];
+        uint32_t offset = *bucket;
+
+        if (offset == 0) {
+            if (header->nameBytesUsed + length + 1 > DP_LAUNCH_HISTORY_NAME_BYTES) {
+                return 0;
+            }
+            offset = header->nameBytesUsed;
+            memcpy(names + offset, name, length + 1);
+            header->nameBytesUsed += (uint32_t)length + 1;
+            *bucket = offset;
+            return offset;
+        }
+
+        // 越界偏移视为损坏的表项，跳过
+        if (offset + length + 1 <= header->nameBytesUsed && memcmp(names + offset, name, length + 1) == 0) {
+            return offset;
+        }
+    }
+    return 0;
+}
+
+// MARK: - 路径
+
+/// 写入默认文件名：DPLaunchHistory-<可执行文件名>-<路径 FNV-1a 哈希>.bin，无法获取可执行文件路径时省略中间部分
+/// @return 写入的长度，缓冲区不足时返回 0
+static size_t dp_lh_default_filename(char* buffer, size_t bufferSize) {
+    char executablePath[PATH_MAX];
+    size_t pathLength = dp_platform_executable_path(executablePath, sizeof(executablePath));
+
+    int written;
+    if (pathLength == 0) {
+        written = snprintf(buffer, bufferSize, DP_LAUNCH_HISTORY_FILENAME_PREFIX DP_LAUNCH_HISTORY_FILENAME_SUFFIX);
+    } else {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < pathLength; i++) {
+            hash = (hash ^ (uint8_t)executablePath[i]) * 16777619u;
+        }
+
+        // 文件名只保留可移植字符，其余替换为下划线
+        const char* name = strrchr(executablePath, '/');
+        name = name != NULL ? name + 1 : executablePath;
+        char safeName[DP_LAUNCH_HISTORY_EXECUTABLE_NAME_MAX + 1];
+        size_t nameLength = 0;
+        for (; name[nameLength] != '\0' && nameLength < DP_LAUNCH_HISTORY_EXECUTABLE_NAME_MAX; nameLength++) {
+            char c = name[nameLength];
+            bool portable = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+                || c == '.' || c == '_' || c == '-';
+            safeName[nameLength] = portable ? c : '_';
+        }
+        safeName[nameLength] = '\0';
+
+        written = snprintf(buffer, bufferSize, DP_LAUNCH_HISTORY_FILENAME_PREFIX "-%s-%08x" DP_LAUNCH_HISTORY_FILENAME_SUFFIX,
+                           safeName, hash);
+    }
+    return written > 0 && (size_t)written < bufferSize ? (size_t)written : 0;
+}
+
+/// 解析当前生效的路径
+/// @return 路径长度，已关闭或无法获取时返回 0
+static size_t dp_lh_resolve_path(char* buffer, size_t bufferSize) {
+    size_t length = 0;
+
+    pthread_mutex_lock(&g_historyMutex);
+    if (g_historyPathState == DPLaunchHistoryPathCustom) {
+        length = strlen(g_historyPath);
+        if (length < bufferSize) {
+            memcpy(buffer, g_historyPath, length + 1);
+        } else {
+            length = 0;
+        }
+    } else if (g_historyPathState == DPLaunchHistoryPathDefault) {
+        const char* disabled = getenv("DP_PREMAIN_DISABLE_LAUNCH_HISTORY");
+        const char* overridePath = getenv("DP_PREMAIN_LAUNCH_HISTORY_PATH");
+
+        if (disabled != NULL && disabled[0] != '\0' && disabled[0] != '0') {
+            length = 0;
+        } else if (overridePath != NULL && overridePath[0] != '\0') {
+            int written = snprintf(buffer, bufferSize, "%s", overridePath);
+            length = written > 0 && (size_t)written < bufferSize ? (size_t)written : 0;
+        } else {
+            size_t directoryLength = dp_platform_cache_directory(buffer, bufferSize);
+            if (directoryLength > 0 && directoryLength + 1 < bufferSize) {
+                buffer[directoryLength] = '/';
+                size_t nameLength = dp_lh_default_filename(buffer + directoryLength + 1,
+                                                           bufferSize - directoryLength - 1);
+                length = nameLength > 0 ? directoryLength + 1 + nameLength : 0;
+            }
+        }
+    }
+    pthread_mutex_unlock(&g_historyMutex);
+
+    return length;
+}
+
+/// 打开（必要时创建）历史文件，父目录不存在时创建一级目录后重试
+static int dp_lh_open_for_write(char* path) {
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0 && errno == ENOENT) {
+        char* separator = strrchr(path, '/');
+        if (separator != NULL && separator != path) {
+            *separator = '\0';
+            mkdir(path, 0755);
+            *separator = '/';
+            fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        }
+    }
+    return fd;
+}
+
+/// 以写零的方式把文件扩展到固定大小
+/// 先实际分配磁盘块，避免磁盘已满时写入稀疏映射页触发 SIGBUS
+static bool dp_lh_allocate(int fd) {
+    static const char zeros[4096];
+
+    if (ftruncate(fd, 0) != 0) {
+        return false;
+    }
+    size_t remaining = DP_LH_FILE_SIZE;
+    while (remaining > 0) {
+        size_t chunk = remaining < sizeof(zeros) ? remaining : sizeof(zeros);
+        ssize_t written = write(fd, zeros, chunk);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        remaining -= (size_t)written;
+    }
+    return true;
+}
+
+// MARK: - 写入
+
+/// 阶段耗时（毫秒）转换为纳秒
+static uint64_t dp_lh_nanos(double millis) {
+    return millis > 0 ? (uint64_t)(millis * 1e6) : 0;
+}
+
+/// 写入一条启动记录（后台线程）
+static void dp_lh_write(char* path) {
+    // 先收集数据，持有文件锁期间只做内存写入
+    DPPreMainData data;
+    DPPreMainCopySnapshot(&data, NULL);
+    // 按启动开销（加载 + 已计时初始化器）排序，开销为 0 的镜像也写入，作为之后出现开销时的基线
+    DPDylibLoadInfo slowest[DP_LAUNCH_HISTORY_MAX_IMAGES];
+    uint32_t slowestCount = DPPreMainGetSlowestDylibs(slowest, DP_LAUNCH_HISTORY_MAX_IMAGES);
+
+    // 只保留 main() 之前加载的镜像（后台线程开始前可能已有新的 dlopen），保持降序
+    uint32_t imageCount = 0;
+    for (uint32_t i = 0; i < slowestCount; i++) {
+        if (slowest[i].loadMachTime <= data.timestamps.mainExecutedMachTime) {
+            slowest[imageCount++] = slowest[i];
+        }
+    }
+
+    int fd = dp_lh_open_for_write(path);
+    if (fd < 0) {
+        return;
+    }
+    if (flock(fd, LOCK_EX) != 0) {
+        close(fd);
+        return;
+    }
+
+    struct stat st;
+    bool fresh = fstat(fd, &st) != 0 || (size_t)st.st_size != DP_LH_FILE_SIZE;
+    if (fresh && !dp_lh_allocate(fd)) {
+        close(fd);
+        return;
+    }
+
+    uint8_t* base = mmap(NULL, DP_LH_FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return;
+    }
+
+    DPLaunchHistoryFileHeader* header = dp_lh_header(base);
+    if (fresh || !dp_lh_header_valid(header)) {
+        if (!fresh) {
+            memset(base, 0, DP_LH_FILE_SIZE);
+        }
+        dp_lh_format(base);
+    }
+
+    uint64_t sequence = header->launchCount;
+    DPLaunchHistoryRecord* record = dp_lh_record_at_slot(base, sequence % DP_LAUNCH_HISTORY_CAPACITY);
+    DPLaunchHistoryImage* images = (DPLaunchHistoryImage*)(record + 1);
+
+    __atomic_store_n(&record->sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    const DPPreMainDurations* durations = &data.durations;
+    record->processStartUnixMicros = data.timestamps.processStartTimeUnixMicros;
+    record->totalPreMainNanos = dp_lh_nanos(durations->totalPreMainMs);
+    record->dylibLoadingNanos = dp_lh_nanos(durations->dylibLoadingMs);
+    record->staticInitializerNanos = dp_lh_nanos(durations->staticInitializerMs);
+    record->postDyldToMainNanos = dp_lh_nanos(durations->postDyldToMainMs);
+    record->objcLoadNanos = dp_lh_nanos(durations->objcLoadMs);
+    record->estimatedKernelToConstructorNanos = dp_lh_nanos(durations->estimatedKernelToConstructorMs);
+    record->phaseFaults = data.phaseFaults;
+    record->dylibCount = data.dylibCount;
+    record->userDylibCount = data.userDylibCount;
+    record->imageCount = imageCount;
+    record->reserved = 0;
+
+    for (uint32_t i = 0; i < imageCount; i++) {
+        images[i] = (DPLaunchHistoryImage){
+            .nameOffset = dp_lh_intern(base, DPPreMainGetInternedString(slowest[i].nameOffset)),
+            .flags = slowest[i].isSystemLibrary ? DP_LAUNCH_HISTORY_IMAGE_SYSTEM : 0,
+            .minorFaults = slowest[i].minorFaults,
+            .majorFaults = slowest[i].majorFaults,
+            .loadDurationNanos = slowest[i].loadDurationNanos,
+            .initializerNanos = slowest[i].initializerNanos,
+        };
+    }
+
+    __atomic_store_n(&record->sequence, sequence + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&header->launchCount, sequence + 1, __ATOMIC_RELEASE);
+
+    // 共享映射的修改由内核回写，无需 msync
+    munmap(base, DP_LH_FILE_SIZE);
+    close(fd);
+}
+
+/// 后台写入线程
+static void* dp_lh_write_thread(void* argument) {
+    char* path = argument;
+    dp_lh_write(path);
+    free(path);
+    return NULL;
+}
+
+void dp_launch_history_record(void) {
+    char* path = malloc(PATH_MAX);
+    if (path == NULL) {
+        return;
+    }
+    if (dp_lh_resolve_path(path, PATH_MAX) == 0) {
+        free(path);
+        return;
+    }
+
+    // 镜像解析（Apple 上需读取磁盘文件）、flock 等待与首次创建时的整文件写零都不应阻塞主线程；
+    // 线程创建失败时放弃本次记录
+    pthread_attr_t attributes;
+    pthread_t thread;
+    bool started = false;
+    if (pthread_attr_init(&attributes) == 0) {
+        pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+        started = pthread_create(&thread, &attributes, dp_lh_write_thread, path) == 0;
+        pthread_attr_destroy(&attributes);
+    }
+    if (!started) {
+        free(path);
+    }
+}
+
+// MARK: - 公开 API 实现
+
+void DPPreMainSetLaunchHistoryPath(const char* path) {
+    pthread_mutex_lock(&g_historyMutex);
+    if (path == NULL || path[0] == '\0' || strlen(path) >= sizeof(g_historyPath)) {
+        g_historyPathState = DPLaunchHistoryPathDisabled;
+        g_historyPath[0] = '\0';
+    } else {
+        g_historyPathState = DPLaunchHistoryPathCustom;
+        strcpy(g_historyPath, path);
+    }
+    pthread_mutex_unlock(&g_historyMutex);
+}
+
+size_t DPPreMainGetLaunchHistoryPath(char* buffer, size_t bufferSize) {
+    if (buffer == NULL || bufferSize == 0) {
+        return 0;
+    }
+    size_t length = dp_lh_resolve_path(buffer, bufferSize);
+    if (length == 0) {
+        buffer[0] = '\0';
+    }
+    return length;
+}
+
+DPLaunchHistory* DPLaunchHistoryOpen(const char* path) {
+    char resolvedPath[PATH_MAX];
+    if (path == NULL) {
+        if (dp_lh_resolve_path(resolvedPath, sizeof(resolvedPath)) == 0) {
+            return NULL;
+        }
+        path = resolvedPath;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != DP_LH_FILE_SIZE) {
+        close(fd);
+        return NULL;
+    }
+
+    void* base = mmap(NULL, DP_LH_FILE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+
+    DPLaunchHistory* history = malloc(sizeof(DPLaunchHistory));
+    if (history == NULL || !dp_lh_header_valid(base)) {
+        free(history);
+        munmap(base, DP_LH_FILE_SIZE);
+        return NULL;
+    }
+
+    history->base = base;
+    history->size = DP_LH_FILE_SIZE;
+    return history;
+}
+
+void DPLaunchHistoryClose(DPLaunchHistory* history) {
+    if (history == NULL) {
+        return;
+    }
+    munmap((void*)history->base, history->size);
+    free(history);
+}
+
+uint32_t DPLaunchHistoryGetCount(const DPLaunchHistory* history) {
+    if (history == NULL) {
+        return 0;
+    }
+    const DPLaunchHistoryFileHeader* header = (const DPLaunchHistoryFileHeader*)history->base;
+    uint64_t launchCount = __atomic_load_n(&header->launchCount, __ATOMIC_ACQUIRE);
+    return launchCount < DP_LAUNCH_HISTORY_CAPACITY ? (uint32_t)launchCount : DP_LAUNCH_HISTORY_CAPACITY;
+}
+
+const DPLaunchHistoryRecord* DPLaunchHistoryGetRecord(const DPLaunchHistory* history, uint32_t index) {
+    if (history == NULL) {
+        return NULL;
+    }
+    const DPLaunchHistoryFileHeader* header = (const DPLaunchHistoryFileHeader*)history->base;
+    uint64_t launchCount = __atomic_load_n(&header->launchCount, __ATOMIC_ACQUIRE);
+    uint64_t count = launchCount < DP_LAUNCH_HISTORY_CAPACITY ? launchCount : DP_LAUNCH_HISTORY_CAPACITY;
+    if (index >= count) {
+        return NULL;
+    }
+
+    uint64_t sequence = launchCount - count + index;
+    const DPLaunchHistoryRecord* record = dp_lh_record_at_slot(history->base, sequence % DP_LAUNCH_HISTORY_CAPACITY);
+    if (__atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) != sequence + 1
+        || record->imageCount > DP_LAUNCH_HISTORY_MAX_IMAGES) {
+        return NULL;
+    }
+    return record;
+}
+
+const DPLaunchHistoryImage* DPLaunchHistoryGetImages(const DPLaunchHistoryRecord* record) {
+    return record != NULL ? (const DPLaunchHistoryImage*)(record + 1) : NULL;
+}
+
+const char* DPLaunchHistoryGetName(const DPLaunchHistory* history, uint32_t nameOffset) {
+    if (history == NULL || nameOffset == 0 || nameOffset >= DP_LAUNCH_HISTORY_NAME_BYTES) {
+        return "";
+    }
+    const char* names = (const char*)(history->base + DP_LH_NAMES_OFFSET);
+    // 损坏的文件中字符串可能不以 NUL 结尾
+    if (memchr(names + nameOffset, '\0', DP_LAUNCH_HISTORY_NAME_BYTES - nameOffset) == NULL) {
+        return "";
+    }
+    return names + nameOffset;
+}
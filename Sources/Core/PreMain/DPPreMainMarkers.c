@@ -0,0 +1,161 @@
+//
+//  DPPreMainMarkers.c
+//  DebugProbe
+//
+//  自定义启动标记（DPMark / DPMarkBegin / DPMarkEnd）
+//  多生产者无锁环形缓冲区：
+//  1. 写入方 atomic_fetch_add 认领全局序号，序号 & (容量 - 1) 即槽位，写满后覆盖最旧的槽位
+//  2. 每个槽位带版本号：写入前置为 序号*2+1（写入中），写完 release 置为 序号*2+2
+//  3. 读取方无锁复制，复制前后版本号一致且等于期望值才采用，否则跳过该槽位
+//  槽位字段均为 relaxed 原子变量，在 x86 / arm64 上等同普通读写
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#include "DPPreMainInternal.h"
+
+#include <stdatomic.h>
+
+#if (DP_MARK_RING_CAPACITY & (DP_MARK_RING_CAPACITY - 1)) != 0
+#error "DP_MARK_RING_CAPACITY must be a power of two"
+#endif
+
+// MARK: - 全局数据
+
+/// 环形缓冲区槽位
+typedef struct {
+    /// 版本号：0 为空，奇数为写入中，偶数 序号*2+2 为已发布
+    _Atomic uint64_t version;
+    _Atomic(const char*) name;
+    _Atomic uint64_t machTime;
+    _Atomic uint64_t threadId;
+    _Atomic uint32_t kind;
+    atomic_bool isMainThread;
+} DPMarkSlot;
+
+/// 环形缓冲区（静态分配，无需初始化即可使用）
+static DPMarkSlot g_markSlots[DP_MARK_RING_CAPACITY];
+
+/// 下一个写入序号
+static _Atomic uint64_t g_markHead = 0;
+
+/// 线程信息缓存（每个线程首次标记时获取）
+static _Thread_local uint64_t t_markThreadId = 0;
+static _Thread_local bool t_markIsMainThread = false;
+
+// MARK: - 写入
+
+/// 写入一条标记
+static void dp_mark_record(const char* name, DPMarkKind kind) {
+    uint64_t machTime = dp_platform_now();
+
+    if (t_markThreadId == 0) {
+        t_markThreadId = dp_platform_thread_id();
+        t_markIsMainThread = dp_platform_is_main_thread();
+    }
+
+    uint64_t sequence = atomic_fetch_add_explicit(&g_markHead, 1, memory_order_relaxed);
+    DPMarkSlot* slot = &g_markSlots[sequence & (DP_MARK_RING_CAPACITY - 1)];
+
+    atomic_store_explicit(&slot->version, sequence * 2 + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&slot->name, name, memory_order_relaxed);
+    atomic_store_explicit(&slot->machTime, machTime, memory_order_relaxed);
+    atomic_store_explicit(&slot->threadId, t_markThreadId, memory_order_relaxed);
+    atomic_store_explicit(&slot->kind, (uint32_t)kind, memory_order_relaxed);
+    atomic_store_explicit(&slot->isMainThread, t_markIsMainThread, memory_order_relaxed);
+
+    atomic_store_explicit(&slot->version, sequence * 2 + 2, memory_order_release);
+}
+
+// MARK: - 内部 API
+
+uint32_t dp_markers_visit(uint64_t maxCount, dp_mark_visitor_t visitor, void* context) {
+    uint64_t head = atomic_load_explicit(&g_markHead, memory_order_acquire);
+    uint64_t oldest = head > DP_MARK_RING_CAPACITY ? head - DP_MARK_RING_CAPACITY : 0;
+    if (head - oldest > maxCount) {
+        oldest = head - maxCount;
+    }
+
+    uint32_t visited = 0;
+    for (uint64_t sequence = oldest; sequence < head; sequence++) {
+        const DPMarkSlot* slot = &g_markSlots[sequence & (DP_MARK_RING_CAPACITY - 1)];
+        uint64_t expected = sequence * 2 + 2;
+
+        if (atomic_load_explicit(&slot->version, memory_order_acquire) != expected) {
+            continue;
+        }
+
+        DPMarkEvent event = {
+            .name = atomic_load_explicit(&slot->name, memory_order_relaxed),
+            .machTime = atomic_load_explicit(&slot->machTime, memory_order_relaxed),
+            .threadId = atomic_load_explicit(&slot->threadId, memory_order_relaxed),
+            .sequence = sequence,
+            .kind = atomic_load_explicit(&slot->kind, memory_order_relaxed),
+            .isMainThread = atomic_load_explicit(&slot->isMainThread, memory_order_relaxed),
+        };
+
+        // 复制期间被新一轮写入覆盖则丢弃
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&slot->version, memory_order_relaxed) != expected) {
+            continue;
+        }
+
+        visited++;
+        if (!visitor(&event, context)) {
+            break;
+        }
+    }
+
+    return visited;
+}
+
+void dp_markers_reset(void) {
+    atomic_store_explicit(&g_markHead, 0, memory_order_relaxed);
+    for (uint32_t i = 0; i < DP_MARK_RING_CAPACITY; i++) {
+        atomic_store_explicit(&g_markSlots[i].version, 0, memory_order_relaxed);
+    }
+}
+
+// MARK: - 公开 API 实现
+
+void DPMark(const char* staticName) {
+    dp_mark_record(staticName, DPMarkKindInstant);
+}
+
+void DPMarkBegin(const char* staticName) {
+    dp_mark_record(staticName, DPMarkKindBegin);
+}
+
+void DPMarkEnd(const char* staticName) {
+    dp_mark_record(staticName, DPMarkKindEnd);
+}
+
+/// DPMarkCopyEvents 遍历上下文
+typedef struct {
+    DPMarkEvent* buffer;
+    uint32_t copied;
+} DPMarkCopyContext;
+
+/// 复制到输出缓冲区
+static bool dp_mark_copy_visitor(const DPMarkEvent* event, void* context) {
+    DPMarkCopyContext* copyContext = context;
+    copyContext->buffer[copyContext->copied++] = *event;
+    return true;
+}
+
+uint32_t DPMarkCopyEvents(DPMarkEvent* outBuffer, uint32_t bufferSize, uint64_t* outOverwrittenCount) {
+    if (outOverwrittenCount != NULL) {
+        uint64_t head = atomic_load_explicit(&g_markHead, memory_order_acquire);
+        *outOverwrittenCount = head > DP_MARK_RING_CAPACITY ? head - DP_MARK_RING_CAPACITY : 0;
+    }
+    if (outBuffer == NULL || bufferSize == 0) {
+        return 0;
+    }
+
+    DPMarkCopyContext context = { outBuffer, 0 };
+    dp_markers_visit(bufferSize, dp_mark_copy_visitor, &context);
+    return context.copied;
+}
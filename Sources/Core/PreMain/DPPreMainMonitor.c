@@ -4,27 +4,31 @@
 //
 //  PreMain 阶段精确时间监控实现
 //  使用 dyld 回调 + mach_absolute_time 实现纳秒级精度
+//  时钟与镜像加载通知由平台层提供（DPPreMainPlatformDarwin.c / DPPreMainPlatformLinux.c）
 //
 //  执行时机说明：
 //  1. __attribute__((constructor)) 在所有 +load 之后、main() 之前执行
-//  2. _dyld_register_func_for_add_image 回调在每个镜像加载时触发
-//  3. 通过 sysctl 获取进程真正的启动时间来估算 kernel -> constructor 的时间
+//  2. _dyld_register_func_for_add_image 回调在每个镜像加载时触发（Linux 为 dl_iterate_phdr + dlopen 钩子）
+//  3. 读取内核记录的进程启动时刻并对齐到单调时钟，估算 kernel -> constructor 的时间及误差上界
+//     （Apple 为 proc_pid_rusage，Linux 为 /proc/self/stat；不可用时对齐 sysctl 获取的墙上时间）
 //
 //  Created by Sun on 2025/12/18.
 //  Copyright © 2025 Sun. All rights reserved.
 //
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "DPPreMainMonitor.h"
+#include "DPPreMainInternal.h"
 
-#include <mach-o/dyld.h>
-#include <mach/mach_time.h>
-#include <sys/sysctl.h>
+#include <sys/resource.h>
 #include <sys/time.h>
 #include <unistd.h>
 #include <string.h>
 #include <stdlib.h>
 #include <pthread.h>
-#include <libkern/OSAtomic.h>
 #include <stdatomic.h>
 #include <dlfcn.h>
 
@@ -33,42 +37,262 @@
 /// 全局 PreMain 数据
 static DPPreMainData g_preMainData = {0};
 
-/// dylib 加载信息数组
-static DPDylibLoadInfo g_dylibLoadInfos[DP_MAX_DYLIB_COUNT] = {0};
+/// dylib 加载记录
+/// dyld 回调热路径只写入 header / slide / 时间戳 / 标志并发布 ready，
+/// 名称、系统库分类与耗时在首次查询时解析
+typedef struct {
+    /// 对外公开的加载信息
+    DPDylibLoadInfo info;
+    /// 回调时的进程累计资源使用（仅启用逐镜像缺页统计时写入）
+    DPResourceUsage usage;
+    /// dlopen 入口时的进程累计资源使用（仅 dlopen 计时的镜像且启用逐镜像缺页统计时写入）
+    DPResourceUsage entryUsage;
+    /// usage 是否有效
+    bool hasUsage;
+    /// entryUsage 是否有效
+    bool hasEntryUsage;
+    /// info 中的名称、系统库分类与镜像静态统计是否已解析（受 g_mutex 保护，每条记录只解析一次）
+    bool staticResolved;
+    /// 回调是否已写入完成（release 发布，acquire 读取）
+    atomic_bool ready;
+} DPDylibRecord;
+
+/// dylib 记录块
+/// 固定大小的块通过原子指针串成链表，追加新块时已有记录不会移动或重新分配
+typedef struct DPDylibChunk {
+    /// 块内首条记录的全局索引
+    uint32_t baseIndex;
+    /// 下一个块（CAS 追加）
+    _Atomic(struct DPDylibChunk*) next;
+    /// 块内记录
+    DPDylibRecord records[DP_DYLIB_CHUNK_CAPACITY];
+} DPDylibChunk;
+
+/// 首个记录块静态分配，常规启动过程无需堆分配
+static DPDylibChunk g_firstDylibChunk;
+
+/// 当前尾部记录块（热路径从这里开始查找）
+static _Atomic(DPDylibChunk*) g_tailDylibChunk = &g_firstDylibChunk;
+
+/// 动态分配记录块占用的字节数
+static _Atomic size_t g_dylibChunkBytes = 0;
 
-/// 当前 dylib 记录索引（原子操作保证线程安全）
+/// 记录块总内存上限（含静态首块）
+static _Atomic size_t g_dylibMemoryLimitBytes = DP_DEFAULT_DYLIB_MEMORY_LIMIT;
+
+/// 是否已因内存上限停止记录（置位后不再分配新块）
+static atomic_bool g_dylibCaptureSaturated = false;
+
+/// 因内存上限未能记录的 dylib 数量
+static atomic_uint g_droppedDylibCount = 0;
+
+/// 当前 dylib 槽位索引（atomic_fetch_add 认领槽位）
 static atomic_uint g_dylibIndex = 0;
 
+/// 已解析的记录数量（受 g_mutex 保护）
+static uint32_t g_resolvedDylibCount = 0;
+
+/// 镜像静态统计缓存槽位数量（直接映射，须为 2 的幂）
+#define DP_IMAGE_STATS_CACHE_CAPACITY 256
+
+/// 镜像静态统计缓存项：同一镜像卸载后重新加载到相同地址时复用统计，避免再次解析（可能需要映射磁盘文件）
+typedef struct {
+    const void* header;
+    uint32_t nameOffset;
+    DPImageStats stats;
+} DPImageStatsCacheEntry;
+
+/// 镜像静态统计缓存（受 g_mutex 保护，按 header 地址直接映射，冲突时覆盖）
+static DPImageStatsCacheEntry g_imageStatsCache[DP_IMAGE_STATS_CACHE_CAPACITY];
+
+/// 首次 / 最后一次 dyld 回调时间（relaxed 原子变量，回调中无锁更新）
+static _Atomic uint64_t g_firstDyldCallbackMachTime = 0;
+static _Atomic uint64_t g_lastDyldCallbackMachTime = 0;
+
+/// 是否启用 dylib 细分记录（回调中无锁读取）
+static atomic_bool g_dylibDetailEnabled = true;
+
+/// 是否启用逐镜像缺页统计（回调中无锁读取）
+static atomic_bool g_perImageFaultsEnabled = false;
+
+/// 首次 dyld 回调时的资源使用（由赢得首次回调 CAS 的线程写入，随后 release 发布）
+static DPResourceUsage g_firstDyldCallbackUsage;
+static atomic_bool g_firstDyldCallbackUsageReady = false;
+
+/// 注册镜像回调返回时的资源使用（启动批次镜像已全部通知）
+static DPResourceUsage g_registrationUsage;
+
+/// 是否正在注册镜像回调（期间的回调是平台层对已加载镜像的补发，没有单独的加载耗时）
+static atomic_bool g_registeringImageCallback = false;
+
+/// 正在执行的已挂接 dlopen 数量（为 0 时回调不访问线程局部变量）
+static atomic_uint g_dlopenInFlightCount = 0;
+
+/// 本线程最外层 dlopen 的入口时间（由该次 dlopen 带入的首个镜像消费后清零）
+static _Thread_local uint64_t t_dlopenEntryMachTime = 0;
+/// 本线程 dlopen 嵌套深度
+static _Thread_local uint32_t t_dlopenDepth = 0;
+/// 本线程 dlopen 入口时的资源使用（仅启用逐镜像缺页统计时写入）
+static _Thread_local DPResourceUsage t_dlopenEntryUsage;
+static _Thread_local bool t_dlopenHasEntryUsage = false;
+
 /// 初始化完成标志
 static atomic_bool g_initialized = false;
 
-/// 互斥锁用于数据访问
+/// 互斥锁用于数据访问（仅查询路径使用，dyld 回调不加锁）
 static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+/// 顺序锁序号：写入方持有 g_mutex 修改 g_preMainData / 已解析记录前后各递增一次（写入中为奇数），
+/// DPPreMainCopySnapshot 无锁复制并校验序号，不一致时重试
+static _Atomic uint64_t g_sequence = 0;
+
+/// 快照读取最大重试次数（超出后退化为加锁复制）
+#define DP_SNAPSHOT_MAX_RETRIES 64
+
 // MARK: - 内部函数声明
 
-static void dp_dyld_image_added_callback(const struct mach_header *mh, intptr_t slide);
 static void dp_initialize_timebase(void);
-static uint64_t dp_get_process_start_time_unix_micros(void);
 static void dp_calculate_durations(void);
+static void dp_calculate_phase_faults(void);
+static void dp_sync_dyld_timestamps_locked(void);
+static void dp_resolve_pending_dylibs_locked(void);
+static DPDylibRecord* dp_dylib_record_at(uint32_t index, bool create);
 static const char* dp_extract_filename(const char* path);
-static bool dp_is_system_library(const char* path);
+
+// MARK: - 顺序锁
+
+/// 开始写入（调用方持有 g_mutex）
+static inline void dp_seqlock_write_begin(void) {
+    uint64_t sequence = atomic_load_explicit(&g_sequence, memory_order_relaxed);
+    atomic_store_explicit(&g_sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+/// 结束写入（调用方持有 g_mutex）
+static inline void dp_seqlock_write_end(void) {
+    uint64_t sequence = atomic_load_explicit(&g_sequence, memory_order_relaxed);
+    atomic_store_explicit(&g_sequence, sequence + 1, memory_order_release);
+}
 
 // MARK: - 时间转换
 
-/// 初始化时间基准
+/// 时间换算模式
+typedef enum {
+    /// 尚未初始化（首次调用时初始化）
+    DPTimebaseModeUninitialized = 0,
+    /// numer == denom，计数即纳秒
+    DPTimebaseModeIdentity,
+    /// 64.64 定点乘法
+    DPTimebaseModeFixedPoint,
+} DPTimebaseMode;
+
+/// 预计算的 64.64 定点换算系数：纳秒 = 计数 * integer + (计数 * fraction) >> 64
+static struct {
+    DPTimebaseMode mode;
+    uint64_t integer;
+    uint64_t fraction;
+} g_timebase = { DPTimebaseModeUninitialized, 0, 0 };
+
+/// 64 位乘法的高 64 位
+static inline uint64_t dp_mul_hi64(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    return (uint64_t)(((unsigned __int128)a * b) >> 64);
+#else
+    uint64_t aLo = (uint32_t)a, aHi = a >> 32;
+    uint64_t bLo = (uint32_t)b, bHi = b >> 32;
+    uint64_t loLo = aLo * bLo;
+    uint64_t hiLo = aHi * bLo;
+    uint64_t loHi = aLo * bHi;
+    uint64_t cross = (loLo >> 32) + (uint32_t)hiLo + loHi;
+    return aHi * bHi + (hiLo >> 32) + (cross >> 32);
+#endif
+}
+
+/// 定点换算（调用方保证已初始化）
+static inline uint64_t dp_fixed_point_to_nanos(uint64_t machTime) {
+    return machTime * g_timebase.integer + dp_mul_hi64(machTime, g_timebase.fraction);
+}
+
+/// 按换算比例预计算定点换算系数
+static void dp_configure_timebase(uint32_t numer, uint32_t denom) {
+    if (numer == 0 || denom == 0) {
+        numer = 1;
+        denom = 1;
+    }
+    
+    g_preMainData.timebaseNumer = numer;
+    g_preMainData.timebaseDenom = denom;
+    
+    if (numer == denom) {
+        g_timebase.integer = 1;
+        g_timebase.fraction = 0;
+        g_timebase.mode = DPTimebaseModeIdentity;
+        return;
+    }
+    
+    // fraction = ceil(remainder * 2^64 / denom)，remainder < denom <= 2^32，分两次 32 位长除法完成
+    // 向上取整的误差小于 计数 / 2^64，计数 < 2^64 / denom 时结果与 计数 * numer / denom 向下取整完全一致
+    uint64_t remainder = numer % denom;
+    uint64_t high = (remainder << 32) / denom;
+    uint64_t rest = (remainder << 32) % denom;
+    uint64_t low = (rest << 32) / denom;
+    bool inexact = ((rest << 32) % denom) != 0;
+    
+    g_timebase.integer = numer / denom;
+    g_timebase.fraction = (high << 32) + low + (inexact ? 1 : 0);
+    g_timebase.mode = DPTimebaseModeFixedPoint;
+}
+
+/// 初始化时间基准（平台换算比例）
 static void dp_initialize_timebase(void) {
-    mach_timebase_info_data_t timebaseInfo;
-    mach_timebase_info(&timebaseInfo);
-    g_preMainData.timebaseNumer = timebaseInfo.numer;
-    g_preMainData.timebaseDenom = timebaseInfo.denom;
+    uint32_t numer = 1;
+    uint32_t denom = 1;
+    dp_platform_timebase(&numer, &denom);
+    dp_configure_timebase(numer, denom);
+}
+
+void dp_timebase_override(uint32_t numer, uint32_t denom) {
+    if (numer == 0 || denom == 0) {
+        dp_initialize_timebase();
+    } else {
+        dp_configure_timebase(numer, denom);
+    }
 }
 
 uint64_t DPMachTimeToNanos(uint64_t machTime) {
-    if (g_preMainData.timebaseDenom == 0) {
+    if (g_timebase.mode == DPTimebaseModeIdentity) {
+        return machTime;
+    }
+    if (__builtin_expect(g_timebase.mode == DPTimebaseModeUninitialized, 0)) {
+        dp_initialize_timebase();
+        if (g_timebase.mode == DPTimebaseModeIdentity) {
+            return machTime;
+        }
+    }
+    return dp_fixed_point_to_nanos(machTime);
+}
+
+void DPMachTimesToNanos(const uint64_t* machTimes, uint64_t* outNanos, size_t count) {
+    if (machTimes == NULL || outNanos == NULL || count == 0) {
+        return;
+    }
+    if (__builtin_expect(g_timebase.mode == DPTimebaseModeUninitialized, 0)) {
         dp_initialize_timebase();
     }
-    return machTime * g_preMainData.timebaseNumer / g_preMainData.timebaseDenom;
+    
+    if (g_timebase.mode == DPTimebaseModeIdentity) {
+        if (machTimes != outNanos) {
+            memmove(outNanos, machTimes, count * sizeof(uint64_t));
+        }
+        return;
+    }
+    
+    uint64_t integer = g_timebase.integer;
+    uint64_t fraction = g_timebase.fraction;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t machTime = machTimes[i];
+        outNanos[i] = machTime * integer + dp_mul_hi64(machTime, fraction);
+    }
 }
 
 double DPMachTimeToMillis(uint64_t machTime) {
@@ -76,23 +300,60 @@ double DPMachTimeToMillis(uint64_t machTime) {
 }
 
 uint64_t DPGetCurrentMachTime(void) {
-    return mach_absolute_time();
+    return dp_platform_now();
 }
 
-// MARK: - 进程启动时间获取
+// MARK: - 时钟对齐
 
-/// 通过 sysctl 获取进程启动时间（Unix 时间戳，微秒）
-static uint64_t dp_get_process_start_time_unix_micros(void) {
-    struct kinfo_proc kinfo;
-    size_t size = sizeof(kinfo);
-    int mib[4] = { CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid() };
+/// 对齐采样次数（单次采样约 3 次 vDSO / commpage 调用）
+#define DP_CLOCK_ALIGN_SAMPLES 16
+
+bool dp_clock_align(int clock, int64_t* outOffsetNanos, uint64_t* outErrorNanos) {
+    uint64_t bestWidth = UINT64_MAX;
+    int64_t bestOffset = 0;
     
-    if (sysctl(mib, 4, &kinfo, &size, NULL, 0) != 0) {
-        return 0;
+    for (int i = 0; i < DP_CLOCK_ALIGN_SAMPLES; i++) {
+        struct timespec target;
+        uint64_t before = dp_platform_now();
+        if (clock_gettime((clockid_t)clock, &target) != 0) {
+            return false;
+        }
+        uint64_t after = dp_platform_now();
+        
+        // 被调度打断的采样间隔较大，只保留最紧的一对，目标读数视为位于区间中点
+        uint64_t beforeNanos = DPMachTimeToNanos(before);
+        uint64_t width = DPMachTimeToNanos(after) - beforeNanos;
+        if (width < bestWidth) {
+            bestWidth = width;
+            uint64_t targetNanos = (uint64_t)target.tv_sec * 1000000000ull + (uint64_t)target.tv_nsec;
+            bestOffset = (int64_t)(targetNanos - (beforeNanos + width / 2));
+        }
+    }
+    
+    *outOffsetNanos = bestOffset;
+    *outErrorNanos = (bestWidth + 1) / 2;
+    return true;
+}
+
+/// 定位进程启动时刻：优先使用平台提供的单调时钟启动时刻，否则将墙上时间启动时刻对齐到单调时钟
+static void dp_resolve_process_start(DPPreMainTimestamps* ts) {
+    uint64_t startNanos = 0;
+    uint64_t errorNanos = 0;
+    if (dp_platform_process_start_nanos(&startNanos, &errorNanos)) {
+        ts->processStartNanos = startNanos;
+        ts->processStartErrorNanos = errorNanos;
+        return;
     }
     
-    struct timeval startTime = kinfo.kp_proc.p_starttime;
-    return (uint64_t)startTime.tv_sec * 1000000 + (uint64_t)startTime.tv_usec;
+    // 墙上时间可能被 NTP 调整，误差上界只包含对齐误差与微秒精度
+    int64_t offsetNanos = 0;
+    if (ts->processStartTimeUnixMicros > 0 && dp_clock_align(CLOCK_REALTIME, &offsetNanos, &errorNanos)) {
+        int64_t monotonicStart = (int64_t)(ts->processStartTimeUnixMicros * 1000) - offsetNanos;
+        if (monotonicStart > 0) {
+            ts->processStartNanos = (uint64_t)monotonicStart;
+            ts->processStartErrorNanos = errorNanos + 1000;
+        }
+    }
 }
 
 // MARK: - 路径处理
@@ -108,99 +369,374 @@ static const char* dp_extract_filename(const char* path) {
     return path;
 }
 
-/// 判断是否为系统库
-static bool dp_is_system_library(const char* path) {
-    if (path == NULL) return false;
+// MARK: - 记录块
+
+/// 分配新的记录块（超出内存上限时返回 NULL 并停止后续分配）
+static DPDylibChunk* dp_dylib_chunk_allocate(uint32_t baseIndex) {
+    if (atomic_load_explicit(&g_dylibCaptureSaturated, memory_order_relaxed)) {
+        return NULL;
+    }
+    
+    size_t limit = atomic_load_explicit(&g_dylibMemoryLimitBytes, memory_order_relaxed);
+    size_t used = atomic_fetch_add_explicit(&g_dylibChunkBytes, sizeof(DPDylibChunk), memory_order_relaxed);
+    if (sizeof(g_firstDylibChunk) + used + sizeof(DPDylibChunk) > limit) {
+        atomic_fetch_sub_explicit(&g_dylibChunkBytes, sizeof(DPDylibChunk), memory_order_relaxed);
+        atomic_store_explicit(&g_dylibCaptureSaturated, true, memory_order_relaxed);
+        return NULL;
+    }
+    
+    DPDylibChunk* chunk = calloc(1, sizeof(DPDylibChunk));
+    if (chunk == NULL) {
+        atomic_fetch_sub_explicit(&g_dylibChunkBytes, sizeof(DPDylibChunk), memory_order_relaxed);
+        atomic_store_explicit(&g_dylibCaptureSaturated, true, memory_order_relaxed);
+        return NULL;
+    }
+    chunk->baseIndex = baseIndex;
+    return chunk;
+}
+
+/// 获取指定索引的记录
+/// @param index 全局记录索引
+/// @param create 记录块不存在时是否追加（仅 dyld 回调传 true）
+/// @return 记录指针；记录块不存在且未创建时返回 NULL
+static DPDylibRecord* dp_dylib_record_at(uint32_t index, bool create) {
+    DPDylibChunk* chunk = atomic_load_explicit(&g_tailDylibChunk, memory_order_acquire);
+    if (index < chunk->baseIndex) {
+        chunk = &g_firstDylibChunk;
+    }
     
-    // 系统库路径前缀
-    static const char* systemPrefixes[] = {
-        "/usr/lib/",
-        "/System/",
-        "/Library/Apple/",
-        "/private/var/db/dyld/",
-        "/AppleInternal/",
-        NULL
-    };
+    while (index - chunk->baseIndex >= DP_DYLIB_CHUNK_CAPACITY) {
+        DPDylibChunk* next = atomic_load_explicit(&chunk->next, memory_order_acquire);
+        if (next == NULL) {
+            if (!create) {
+                return NULL;
+            }
+            next = dp_dylib_chunk_allocate(chunk->baseIndex + DP_DYLIB_CHUNK_CAPACITY);
+            if (next == NULL) {
+                return NULL;
+            }
+            
+            DPDylibChunk* expected = NULL;
+            if (atomic_compare_exchange_strong_explicit(&chunk->next, &expected, next,
+                                                        memory_order_acq_rel, memory_order_acquire)) {
+                // 推进尾指针（只前进不后退）
+                DPDylibChunk* tail = atomic_load_explicit(&g_tailDylibChunk, memory_order_relaxed);
+                while (tail->baseIndex < next->baseIndex &&
+                       !atomic_compare_exchange_weak_explicit(&g_tailDylibChunk, &tail, next,
+                                                              memory_order_release, memory_order_relaxed)) {
+                }
+            } else {
+                // 其他线程已追加，使用对方的块
+                free(next);
+                atomic_fetch_sub_explicit(&g_dylibChunkBytes, sizeof(DPDylibChunk), memory_order_relaxed);
+                next = expected;
+            }
+        }
+        chunk = next;
+    }
     
-    for (int i = 0; systemPrefixes[i] != NULL; i++) {
-        if (strncmp(path, systemPrefixes[i], strlen(systemPrefixes[i])) == 0) {
-            return true;
+    return &chunk->records[index - chunk->baseIndex];
+}
+
+/// 按顺序复制已解析的记录（调用方持有 g_mutex）
+static void dp_copy_dylib_infos_locked(DPDylibLoadInfo* outBuffer, uint32_t count) {
+    uint32_t copied = 0;
+    for (DPDylibChunk* chunk = &g_firstDylibChunk; chunk != NULL && copied < count;
+         chunk = atomic_load_explicit(&chunk->next, memory_order_acquire)) {
+        for (uint32_t i = 0; i < DP_DYLIB_CHUNK_CAPACITY && copied < count; i++) {
+            outBuffer[copied++] = chunk->records[i].info;
         }
     }
+}
+
+/// 释放动态分配的记录块并清空首块（仅用于重置，调用方持有 g_mutex）
+static void dp_free_dylib_chunks(void) {
+    DPDylibChunk* chunk = atomic_load_explicit(&g_firstDylibChunk.next, memory_order_acquire);
+    while (chunk != NULL) {
+        DPDylibChunk* next = atomic_load_explicit(&chunk->next, memory_order_acquire);
+        free(chunk);
+        chunk = next;
+    }
+    
+    memset(&g_firstDylibChunk, 0, sizeof(g_firstDylibChunk));
+    atomic_store(&g_tailDylibChunk, &g_firstDylibChunk);
+    atomic_store(&g_dylibChunkBytes, 0);
+}
+
+// MARK: - 资源使用
+
+/// 读取进程累计资源使用
+static void dp_read_resource_usage(DPResourceUsage* outUsage) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        memset(outUsage, 0, sizeof(*outUsage));
+        return;
+    }
+    outUsage->minorFaults = (uint64_t)usage.ru_minflt;
+    outUsage->majorFaults = (uint64_t)usage.ru_majflt;
+    outUsage->blockInputOps = (uint64_t)usage.ru_inblock;
+}
+
+/// 两个快照的差值（end - start，任一字段回退时取 0）
+static DPResourceUsage dp_resource_usage_delta(const DPResourceUsage* start, const DPResourceUsage* end) {
+    DPResourceUsage delta;
+    delta.minorFaults = end->minorFaults > start->minorFaults ? end->minorFaults - start->minorFaults : 0;
+    delta.majorFaults = end->majorFaults > start->majorFaults ? end->majorFaults - start->majorFaults : 0;
+    delta.blockInputOps = end->blockInputOps > start->blockInputOps ? end->blockInputOps - start->blockInputOps : 0;
+    return delta;
+}
+
+// MARK: - dlopen 入口
+
+uint64_t dp_dlopen_enter(void) {
+    uint64_t now = dp_platform_now();
+    atomic_fetch_add_explicit(&g_dlopenInFlightCount, 1, memory_order_relaxed);
     
-    return false;
+    // 嵌套 dlopen（如被加载镜像的初始化器中再次 dlopen）发生在外层镜像通知之后，直接覆盖入口
+    t_dlopenDepth++;
+    t_dlopenEntryMachTime = now;
+    t_dlopenHasEntryUsage = atomic_load_explicit(&g_perImageFaultsEnabled, memory_order_relaxed);
+    if (t_dlopenHasEntryUsage) {
+        dp_read_resource_usage(&t_dlopenEntryUsage);
+    }
+    return now;
+}
+
+void dp_dlopen_exit(void) {
+    if (t_dlopenDepth > 0 && --t_dlopenDepth == 0) {
+        t_dlopenEntryMachTime = 0;
+        t_dlopenHasEntryUsage = false;
+    }
+    atomic_fetch_sub_explicit(&g_dlopenInFlightCount, 1, memory_order_relaxed);
 }
 
 // MARK: - dyld 回调
 
 /// dyld 镜像加载回调
-static void dp_dyld_image_added_callback(const struct mach_header *mh, intptr_t slide) {
-    uint64_t currentMachTime = mach_absolute_time();
+/// 热路径：不加锁、不分配内存、不做字符串处理，只认领槽位并写入回调参数与时间戳
+/// 加载耗时只对已挂接的 dlopen 中带入的首个镜像有效（dlopen 入口 -> 回调）；
+/// 注册回调时补发的镜像在 constructor 之前已加载完成，相邻回调的间隔只反映补发循环本身，不记录耗时
+void dp_dyld_image_added_callback(const void* mh, intptr_t slide) {
+    uint64_t currentMachTime = dp_platform_now();
     
     // 记录首次和最后一次回调时间
-    pthread_mutex_lock(&g_mutex);
-    
-    if (g_preMainData.timestamps.firstDyldCallbackMachTime == 0) {
-        g_preMainData.timestamps.firstDyldCallbackMachTime = currentMachTime;
+    if (atomic_load_explicit(&g_firstDyldCallbackMachTime, memory_order_relaxed) == 0) {
+        uint64_t expected = 0;
+        if (atomic_compare_exchange_strong_explicit(&g_firstDyldCallbackMachTime, &expected, currentMachTime,
+                                                    memory_order_relaxed, memory_order_relaxed)) {
+            // 仅首次回调读取一次，开销不影响后续回调
+            dp_read_resource_usage(&g_firstDyldCallbackUsage);
+            atomic_store_explicit(&g_firstDyldCallbackUsageReady, true, memory_order_release);
+        }
     }
-    g_preMainData.timestamps.lastDyldCallbackMachTime = currentMachTime;
-    
-    pthread_mutex_unlock(&g_mutex);
+    atomic_store_explicit(&g_lastDyldCallbackMachTime, currentMachTime, memory_order_relaxed);
     
     // 如果禁用了细分记录，直接返回
-    if (!g_preMainData.dylibDetailEnabled) {
-        atomic_fetch_add(&g_dylibIndex, 1);
+    if (!atomic_load_explicit(&g_dylibDetailEnabled, memory_order_relaxed)) {
         return;
     }
     
-    // 获取当前索引并递增
-    uint32_t index = atomic_fetch_add(&g_dylibIndex, 1);
+    // 认领槽位
+    uint32_t index = atomic_fetch_add_explicit(&g_dylibIndex, 1, memory_order_relaxed);
     
-    // 检查是否超出最大记录数
-    if (index >= DP_MAX_DYLIB_COUNT) {
+    // 定位记录（跨块时追加新块，超出内存上限时丢弃）
+    DPDylibRecord* record = dp_dylib_record_at(index, true);
+    if (record == NULL) {
+        atomic_fetch_add_explicit(&g_droppedDylibCount, 1, memory_order_relaxed);
         return;
     }
     
-    // 获取镜像路径
-    Dl_info info;
-    const char* imagePath = NULL;
-    if (dladdr(mh, &info) && info.dli_fname != NULL) {
-        imagePath = info.dli_fname;
+    record->info.header = mh;
+    record->info.slide = slide;
+    record->info.loadStartMachTime = currentMachTime;
+    record->info.loadMachTime = currentMachTime;
+    record->info.loadFlags = 0;
+    record->info.initializerNanos = 0;
+    record->hasEntryUsage = false;
+    record->staticResolved = false;
+    
+    // dyld 在调用 dlopen 的线程上通知新镜像（Linux 由 dlopen 钩子在同一线程补扫）；
+    // 没有进行中的 dlopen 时不访问线程局部变量（Apple 上首次访问会分配存储）
+    if (atomic_load_explicit(&g_dlopenInFlightCount, memory_order_relaxed) > 0 && t_dlopenEntryMachTime != 0) {
+        record->info.loadStartMachTime = t_dlopenEntryMachTime;
+        record->info.loadFlags = DP_DYLIB_LOAD_TIMED;
+        record->hasEntryUsage = t_dlopenHasEntryUsage;
+        if (t_dlopenHasEntryUsage) {
+            record->entryUsage = t_dlopenEntryUsage;
+        }
+        // 同一次 dlopen 带入的依赖镜像在同一批通知中，与首个镜像共享入口，不再单独计时
+        t_dlopenEntryMachTime = 0;
+    } else if (atomic_load_explicit(&g_registeringImageCallback, memory_order_relaxed)) {
+        record->info.loadFlags = DP_DYLIB_LOAD_REPLAYED;
     }
     
-    // 填充 dylib 信息
-    DPDylibLoadInfo* dylibInfo = &g_dylibLoadInfos[index];
-    dylibInfo->loadMachTime = currentMachTime;
-    dylibInfo->slide = slide;
+    record->hasUsage = atomic_load_explicit(&g_perImageFaultsEnabled, memory_order_relaxed);
+    if (record->hasUsage) {
+        dp_read_resource_usage(&record->usage);
+    }
+    atomic_store_explicit(&record->ready, true, memory_order_release);
+}
+
+// MARK: - 延迟解析
+
+/// 将原子变量中的 dyld 回调时间与初始化器计数同步到 g_preMainData（调用方持有 g_mutex）
+static void dp_sync_dyld_timestamps_locked(void) {
+    g_preMainData.timestamps.firstDyldCallbackMachTime =
+        atomic_load_explicit(&g_firstDyldCallbackMachTime, memory_order_relaxed);
+    g_preMainData.timestamps.lastDyldCallbackMachTime =
+        atomic_load_explicit(&g_lastDyldCallbackMachTime, memory_order_relaxed);
+    dp_initializers_get_counts(g_preMainData.mainExecutedMarked,
+                               &g_preMainData.timedInitializerCount, &g_preMainData.untimedInitializerCount);
+}
+
+/// 把已计时的初始化器耗时归到所属镜像的记录（调用方持有 g_mutex 且处于写入区）
+/// 同一地址先后加载过多个镜像时归到最后一条记录（初始化器属于当前映射的镜像）
+static void dp_attribute_initializer_costs_locked(void) {
+    dp_image_initializer_cost_t costs[DP_MAX_TIMED_INITIALIZERS];
+    DPDylibLoadInfo* owners[DP_MAX_TIMED_INITIALIZERS];
+    uint32_t costCount = dp_initializers_image_costs(costs, DP_MAX_TIMED_INITIALIZERS);
+    memset(owners, 0, sizeof(owners));
+
+    uint32_t remaining = g_resolvedDylibCount;
+    for (DPDylibChunk* chunk = &g_firstDylibChunk; chunk != NULL && remaining > 0;
+         chunk = atomic_load_explicit(&chunk->next, memory_order_acquire)) {
+        for (uint32_t i = 0; i < DP_DYLIB_CHUNK_CAPACITY && remaining > 0; i++, remaining--) {
+            DPDylibLoadInfo* info = &chunk->records[i].info;
+            info->initializerNanos = 0;
+            for (uint32_t j = 0; j < costCount; j++) {
+                if (costs[j].header == info->header) {
+                    owners[j] = info;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (uint32_t j = 0; j < costCount; j++) {
+        if (owners[j] != NULL) {
+            owners[j]->initializerNanos = costs[j].nanos;
+        }
+    }
+}
+
+/// 解析镜像静态统计：同一地址、同名镜像复用缓存，否则解析并写入缓存（调用方持有 g_mutex）
+static void dp_resolve_image_stats(DPDylibLoadInfo* dylibInfo, const char* imagePath) {
+    uintptr_t key = (uintptr_t)dylibInfo->header;
+    DPImageStatsCacheEntry* entry = &g_imageStatsCache[(key >> 12 ^ key >> 20) & (DP_IMAGE_STATS_CACHE_CAPACITY - 1)];
+    if (entry->header == dylibInfo->header && entry->nameOffset == dylibInfo->nameOffset) {
+        dylibInfo->imageStats = entry->stats;
+        return;
+    }
+    dp_platform_image_stats(dylibInfo->header, imagePath, &dylibInfo->imageStats);
+    entry->header = dylibInfo->header;
+    entry->nameOffset = dylibInfo->nameOffset;
+    entry->stats = dylibInfo->imageStats;
+}
+
+/// 解析尚未处理的槽位：镜像名称、系统库分类、相对耗时、静态统计（调用方持有 g_mutex）
+static void dp_resolve_pending_dylibs_locked(void) {
+    // 补发平台层尚未通知的镜像（仅 Linux 未挂接 dlopen 钩子时有效）
+    dp_platform_poll_images();
     
-    // 计算相对于 constructor 执行时的耗时
-    if (g_preMainData.timestamps.constructorMachTime > 0) {
-        uint64_t elapsed = currentMachTime - g_preMainData.timestamps.constructorMachTime;
-        dylibInfo->loadDurationNanos = DPMachTimeToNanos(elapsed);
-    } else {
-        dylibInfo->loadDurationNanos = 0;
+    uint32_t claimed = atomic_load_explicit(&g_dylibIndex, memory_order_acquire);
+    uint32_t dropped = atomic_load_explicit(&g_droppedDylibCount, memory_order_relaxed);
+
+    // 达到内存上限后丢弃的槽位永远不会被解析，只与有记录的槽位数量比较，
+    // 否则之后每次查询都会进入写入区，使快照读取方持续重试
+    uint32_t recordable = claimed > dropped ? claimed - dropped : 0;
+
+    // 只统计已执行完成的包装，计数随初始化器执行变化
+    uint32_t timedInitializers = 0;
+    uint32_t untimedInitializers = 0;
+    dp_initializers_get_counts(g_preMainData.mainExecutedMarked, &timedInitializers, &untimedInitializers);
+    
+    // 无新数据时不进入写入区，避免快照读取方无谓重试
+    bool changed = recordable != g_resolvedDylibCount
+        || timedInitializers != g_preMainData.timedInitializerCount
+        || untimedInitializers != g_preMainData.untimedInitializerCount
+        || dropped != g_preMainData.droppedDylibCount
+        || atomic_load_explicit(&g_firstDyldCallbackMachTime, memory_order_relaxed)
+               != g_preMainData.timestamps.firstDyldCallbackMachTime
+        || atomic_load_explicit(&g_lastDyldCallbackMachTime, memory_order_relaxed)
+               != g_preMainData.timestamps.lastDyldCallbackMachTime;
+    if (!changed) {
+        return;
     }
     
-    // 记录名称
-    if (imagePath != NULL) {
-        const char* filename = dp_extract_filename(imagePath);
-        strncpy(dylibInfo->name, filename, DP_MAX_DYLIB_NAME_LENGTH - 1);
-        dylibInfo->name[DP_MAX_DYLIB_NAME_LENGTH - 1] = '\0';
-        dylibInfo->isSystemLibrary = dp_is_system_library(imagePath);
-    } else {
-        strncpy(dylibInfo->name, "unknown", DP_MAX_DYLIB_NAME_LENGTH - 1);
-        dylibInfo->isSystemLibrary = false;
+    // 路径、名称与镜像静态统计（可能需要读取磁盘文件）在写入区之外解析，避免快照读取方长时间重试；
+    // 未解析的槽位不会被读取方访问，此处写入是安全的；之后只解析已完成准备的槽位
+    uint32_t prepared = g_resolvedDylibCount;
+    while (prepared < claimed) {
+        DPDylibRecord* record = dp_dylib_record_at(prepared, false);
+        if (record == NULL || !atomic_load_explicit(&record->ready, memory_order_acquire)) {
+            break;
+        }
+        if (record->staticResolved) {
+            prepared++;
+            continue;
+        }
+        DPDylibLoadInfo* dylibInfo = &record->info;
+        
+        // 每个镜像只调用一次 dladdr，路径同时用于名称、系统库分类与静态统计
+        Dl_info info;
+        const char* imagePath = NULL;
+        if (dladdr(dylibInfo->header, &info) && info.dli_fname != NULL) {
+            imagePath = info.dli_fname;
+        }
+        
+        // 记录名称（驻留到字符串区）
+        const char* filename = imagePath != NULL ? dp_extract_filename(imagePath) : "unknown";
+        dylibInfo->nameOffset = dp_string_arena_intern(filename, strlen(filename), &dylibInfo->nameLength);
+        dylibInfo->isSystemLibrary = dp_platform_is_system_path(imagePath);
+        dp_resolve_image_stats(dylibInfo, imagePath);
+        record->staticResolved = true;
+        prepared++;
     }
     
-    // 更新统计
-    pthread_mutex_lock(&g_mutex);
-    g_preMainData.dylibCount = index + 1;
-    if (dylibInfo->isSystemLibrary) {
-        g_preMainData.systemDylibCount++;
-    } else {
-        g_preMainData.userDylibCount++;
+    dp_seqlock_write_begin();
+    
+    dp_sync_dyld_timestamps_locked();
+    
+    while (g_resolvedDylibCount < prepared) {
+        DPDylibRecord* record = dp_dylib_record_at(g_resolvedDylibCount, false);
+        
+        // 记录块不存在（已达内存上限），或记录已认领但仍在写入中，留待下次查询
+        if (record == NULL || !atomic_load_explicit(&record->ready, memory_order_acquire)) {
+            break;
+        }
+        
+        DPDylibLoadInfo* dylibInfo = &record->info;
+        
+        // 加载耗时：仅 dlopen 计时的镜像有效（dlopen 入口 -> 回调），补发与未挂接钩子的镜像为 0
+        if ((dylibInfo->loadFlags & DP_DYLIB_LOAD_TIMED) && dylibInfo->loadMachTime >= dylibInfo->loadStartMachTime) {
+            dylibInfo->loadDurationNanos = DPMachTimeToNanos(dylibInfo->loadMachTime - dylibInfo->loadStartMachTime);
+        } else {
+            dylibInfo->loadDurationNanos = 0;
+        }
+        
+        // 逐镜像缺页：同样只统计 dlopen 入口 -> 回调之间
+        if (record->hasUsage && record->hasEntryUsage) {
+            DPResourceUsage delta = dp_resource_usage_delta(&record->entryUsage, &record->usage);
+            dylibInfo->minorFaults = delta.minorFaults > UINT32_MAX ? UINT32_MAX : (uint32_t)delta.minorFaults;
+            dylibInfo->majorFaults = delta.majorFaults > UINT32_MAX ? UINT32_MAX : (uint32_t)delta.majorFaults;
+        }
+        
+        // 更新统计
+        if (dylibInfo->isSystemLibrary) {
+            g_preMainData.systemDylibCount++;
+        } else {
+            g_preMainData.userDylibCount++;
+        }
+        g_resolvedDylibCount++;
     }
-    pthread_mutex_unlock(&g_mutex);
+    
+    // 初始化器可能在其镜像记录解析之后才执行，每次进入写入区都重新归属
+    dp_attribute_initializer_costs_locked();
+    
+    g_preMainData.dylibCount = g_resolvedDylibCount;
+    g_preMainData.droppedDylibCount = dropped;
+    
+    dp_seqlock_write_end();
 }
 
 // MARK: - 耗时计算
@@ -245,28 +781,44 @@ static void dp_calculate_durations(void) {
         dur->postDyldToMainMs = DPMachTimeToMillis(postDyldMachTime);
     }
     
-    // 估算 kernel 到 constructor 的时间
-    // 使用进程启动的 Unix 时间与当前 Unix 时间的差值，再减去已测量的时间
-    if (ts->processStartTimeUnixMicros > 0) {
-        struct timeval now;
-        gettimeofday(&now, NULL);
-        uint64_t nowUnixMicros = (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_usec;
-        
-        // 从进程启动到现在的总时间（毫秒）
-        double totalSinceStartMs = (double)(nowUnixMicros - ts->processStartTimeUnixMicros) / 1000.0;
+    // 估算 kernel 到 constructor 的时间：启动时刻已在 constructor 中对齐到单调时钟，直接求差
+    if (ts->processStartNanos > 0 && ts->constructorMachTime > 0) {
+        int64_t kernelToConstructorNanos =
+            (int64_t)DPMachTimeToNanos(ts->constructorMachTime) - (int64_t)ts->processStartNanos;
         
-        // 从 constructor 到现在的时间
-        uint64_t constructorToNowNanos = DPMachTimeToNanos(mach_absolute_time() - ts->constructorMachTime);
-        double constructorToNowMs = (double)constructorToNowNanos / 1000000.0;
-        
-        // 估算 kernel 到 constructor 的时间
-        dur->estimatedKernelToConstructorMs = totalSinceStartMs - constructorToNowMs;
-        
-        // 防止负数（时钟漂移等原因）
-        if (dur->estimatedKernelToConstructorMs < 0) {
-            dur->estimatedKernelToConstructorMs = 0;
+        // 误差范围内可能为负，截断为 0
+        dur->estimatedKernelToConstructorMs = kernelToConstructorNanos > 0
+            ? (double)kernelToConstructorNanos / 1000000.0
+            : 0;
+        dur->estimatedKernelToConstructorErrorMs = (double)ts->processStartErrorNanos / 1000000.0;
+    }
+}
+
+/// 同步各时间点资源快照并计算阶段差值（调用方持有 g_mutex，main 标记后调用）
+static void dp_calculate_phase_faults(void) {
+    DPPreMainResourceSnapshots* snapshots = &g_preMainData.resourceSnapshots;
+    DPPreMainPhaseFaults* faults = &g_preMainData.phaseFaults;
+    
+    if (atomic_load_explicit(&g_firstDyldCallbackUsageReady, memory_order_acquire)) {
+        snapshots->firstDyldCallback = g_firstDyldCallbackUsage;
+    } else {
+        snapshots->firstDyldCallback = snapshots->constructor;
+    }
+    
+    // 最后一次回调：优先使用最新镜像记录的快照，否则使用注册返回时的快照
+    snapshots->lastDyldCallback = g_registrationUsage;
+    uint32_t claimed = atomic_load_explicit(&g_dylibIndex, memory_order_acquire);
+    if (claimed > 0) {
+        DPDylibRecord* latest = dp_dylib_record_at(claimed - 1, false);
+        if (latest != NULL && atomic_load_explicit(&latest->ready, memory_order_acquire) && latest->hasUsage) {
+            snapshots->lastDyldCallback = latest->usage;
         }
     }
+    
+    faults->total = dp_resource_usage_delta(&snapshots->constructor, &snapshots->mainExecuted);
+    faults->staticInitializer = dp_resource_usage_delta(&snapshots->constructor, &snapshots->firstDyldCallback);
+    faults->dylibLoading = dp_resource_usage_delta(&snapshots->firstDyldCallback, &snapshots->lastDyldCallback);
+    faults->postDyldToMain = dp_resource_usage_delta(&snapshots->lastDyldCallback, &snapshots->mainExecuted);
 }
 
 // MARK: - 模块初始化
@@ -286,46 +838,186 @@ static void dp_premain_init(void) {
     dp_initialize_timebase();
     
     // 记录 constructor 执行时间
-    g_preMainData.timestamps.constructorMachTime = mach_absolute_time();
+    g_preMainData.timestamps.constructorMachTime = dp_platform_now();
+    
+    // 记录 constructor 时的资源使用（缺页、读盘）
+    dp_read_resource_usage(&g_preMainData.resourceSnapshots.constructor);
+    
+    // 获取进程启动时间，并尽早对齐到单调时钟（离启动越近，时钟间漂移越小）
+    g_preMainData.timestamps.processStartTimeUnixMicros = dp_platform_process_start_unix_micros();
+    dp_resolve_process_start(&g_preMainData.timestamps);
+    
+    // 逐镜像缺页统计需在注册回调前决定（启动批次镜像在注册时同步回调）
+    const char* perImageFaults = getenv("DP_PREMAIN_PER_IMAGE_FAULTS");
+    if (perImageFaults != NULL && perImageFaults[0] != '\0' && perImageFaults[0] != '0') {
+        atomic_store(&g_perImageFaultsEnabled, true);
+    }
+    
+    // dlopen 计时需尽早开启，才能覆盖 main() 之前其他初始化器发起的 dlopen
+    const char* traceDlopen = getenv("DP_PREMAIN_TRACE_DLOPEN");
+    if (traceDlopen != NULL && traceDlopen[0] != '\0' && traceDlopen[0] != '0') {
+        DPPreMainSetDlopenTracingEnabled(true);
+    }
     
-    // 获取进程启动时间
-    g_preMainData.timestamps.processStartTimeUnixMicros = dp_get_process_start_time_unix_micros();
+    const char* pageTrace = getenv("DP_PREMAIN_PAGE_TRACE");
+    if (pageTrace != NULL && pageTrace[0] != '\0' && pageTrace[0] != '0') {
+        DPPreMainSetPageTraceEnabled(true);
+    }
+    
+    // 启动采样越早开始越能覆盖其他镜像的初始化器
+    const char* sampleLaunch = getenv("DP_PREMAIN_SAMPLE_LAUNCH");
+    if (sampleLaunch != NULL && sampleLaunch[0] != '\0' && sampleLaunch[0] != '0') {
+        const char* interval = getenv("DP_PREMAIN_SAMPLE_INTERVAL_US");
+        DPPreMainStartLaunchSampler(interval != NULL ? (uint32_t)strtoul(interval, NULL, 10) : 0);
+    }
     
     // 默认启用 dylib 细分记录
-    g_preMainData.dylibDetailEnabled = true;
+    g_preMainData.dylibDetailEnabled = atomic_load(&g_dylibDetailEnabled);
     
-    // 注册 dyld 镜像加载回调
-    // 注意：此回调会被所有已加载的镜像触发一次，然后监听新加载的镜像
-    _dyld_register_func_for_add_image(dp_dyld_image_added_callback);
+    // 注册镜像加载回调
+    // 注意：此回调会被所有已加载的镜像触发一次（标记为补发），然后监听新加载的镜像
+    atomic_store(&g_registeringImageCallback, true);
+    dp_platform_register_image_callback(dp_dyld_image_added_callback);
+    atomic_store(&g_registeringImageCallback, false);
+    dp_read_resource_usage(&g_registrationUsage);
+    
+    // 包装用户镜像的静态初始化器（放在回调注册之后，避免计入首次 dyld 回调之前的阶段）
+    dp_initializers_install();
+    dp_initializers_get_counts(false, &g_preMainData.timedInitializerCount, &g_preMainData.untimedInitializerCount);
 }
 
 // MARK: - 公开 API 实现
 
+void dp_premain_lock(void) {
+    pthread_mutex_lock(&g_mutex);
+}
+
+void dp_premain_unlock(void) {
+    pthread_mutex_unlock(&g_mutex);
+}
+
 const DPPreMainData* DPPreMainGetData(void) {
+    pthread_mutex_lock(&g_mutex);
+    dp_resolve_pending_dylibs_locked();
+    pthread_mutex_unlock(&g_mutex);
+    
     return &g_preMainData;
 }
 
+/// 按列复制前 count 条已解析记录（读取方无锁调用，结果由顺序锁校验）
+static void dp_copy_dylib_columns(DPDylibColumns* columns, uint32_t count) {
+    uint32_t copied = 0;
+    for (DPDylibChunk* chunk = &g_firstDylibChunk; chunk != NULL && copied < count;
+         chunk = atomic_load_explicit(&chunk->next, memory_order_acquire)) {
+        for (uint32_t i = 0; i < DP_DYLIB_CHUNK_CAPACITY && copied < count; i++, copied++) {
+            const DPDylibLoadInfo* info = &chunk->records[i].info;
+            if (columns->headers != NULL) columns->headers[copied] = info->header;
+            if (columns->loadStartMachTimes != NULL) columns->loadStartMachTimes[copied] = info->loadStartMachTime;
+            if (columns->loadMachTimes != NULL) columns->loadMachTimes[copied] = info->loadMachTime;
+            if (columns->loadDurationNanos != NULL) columns->loadDurationNanos[copied] = info->loadDurationNanos;
+            if (columns->nameOffsets != NULL) columns->nameOffsets[copied] = info->nameOffset;
+            if (columns->isSystemLibrary != NULL) columns->isSystemLibrary[copied] = info->isSystemLibrary;
+            if (columns->slides != NULL) columns->slides[copied] = info->slide;
+            if (columns->loadFlags != NULL) columns->loadFlags[copied] = info->loadFlags;
+            if (columns->initializerNanos != NULL) columns->initializerNanos[copied] = info->initializerNanos;
+            if (columns->minorFaults != NULL) columns->minorFaults[copied] = info->minorFaults;
+            if (columns->majorFaults != NULL) columns->majorFaults[copied] = info->majorFaults;
+            if (columns->imageStats != NULL) columns->imageStats[copied] = info->imageStats;
+        }
+    }
+}
+
+/// 复制全局数据与列视图（读取方持有快照区间或 g_mutex）
+static void dp_copy_snapshot(DPPreMainData* outData, DPDylibColumns* outDylibs) {
+    memcpy(outData, &g_preMainData, sizeof(*outData));
+    
+    if (outDylibs != NULL) {
+        uint32_t total = g_resolvedDylibCount;
+        uint32_t count = total < outDylibs->capacity ? total : outDylibs->capacity;
+        dp_copy_dylib_columns(outDylibs, count);
+        outDylibs->count = count;
+        outDylibs->totalCount = total;
+    }
+}
+
+uint64_t DPPreMainCopySnapshot(DPPreMainData* outData, DPDylibColumns* outDylibs) {
+    if (outData == NULL) {
+        return 0;
+    }
+    
+    // 顺带解析新镜像；其他线程正在解析时不等待，直接读取上一次发布的状态
+    if (pthread_mutex_trylock(&g_mutex) == 0) {
+        dp_resolve_pending_dylibs_locked();
+        pthread_mutex_unlock(&g_mutex);
+    }
+    
+    for (int attempt = 0; attempt < DP_SNAPSHOT_MAX_RETRIES; attempt++) {
+        uint64_t begin = atomic_load_explicit(&g_sequence, memory_order_acquire);
+        if (begin & 1) {
+            continue;
+        }
+        
+        dp_copy_snapshot(outData, outDylibs);
+        
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&g_sequence, memory_order_relaxed) == begin) {
+            return begin / 2;
+        }
+    }
+    
+    // 写入持续竞争时退化为加锁复制
+    pthread_mutex_lock(&g_mutex);
+    dp_copy_snapshot(outData, outDylibs);
+    uint64_t sequence = atomic_load_explicit(&g_sequence, memory_order_relaxed);
+    pthread_mutex_unlock(&g_mutex);
+    
+    return sequence / 2;
+}
+
 void DPPreMainMarkMainExecuted(void) {
-    uint64_t mainMachTime = mach_absolute_time();
+    uint64_t mainMachTime = dp_platform_now();
+    DPResourceUsage mainUsage;
+    dp_read_resource_usage(&mainUsage);
+    
+    dp_platform_poll_images();
     
     pthread_mutex_lock(&g_mutex);
     
     // 防止重复标记
-    if (!g_preMainData.mainExecutedMarked) {
+    bool markedNow = !g_preMainData.mainExecutedMarked;
+    if (markedNow) {
+        dp_seqlock_write_begin();
+        
         g_preMainData.timestamps.mainExecutedMachTime = mainMachTime;
+        g_preMainData.resourceSnapshots.mainExecuted = mainUsage;
         g_preMainData.mainExecutedMarked = true;
         
+        // 仅同步回调时间戳，名称解析留到首次查询
+        dp_sync_dyld_timestamps_locked();
+        
         // 计算各阶段耗时
         dp_calculate_durations();
+        dp_calculate_phase_faults();
+        
+        dp_seqlock_write_end();
     }
     
     pthread_mutex_unlock(&g_mutex);
+    
+    // 时间已记录，之后的采样与文件写入不计入 PreMain
+    // 代码页先于历史写入采样，避免把写入路径的代码计入启动页
+    if (markedNow) {
+        dp_page_trace_capture_main();
+        dp_launch_history_record();
+    }
 }
 
 void DPPreMainMarkObjCLoadStart(void) {
     pthread_mutex_lock(&g_mutex);
     if (g_preMainData.timestamps.objcLoadStartMachTime == 0) {
-        g_preMainData.timestamps.objcLoadStartMachTime = mach_absolute_time();
+        dp_seqlock_write_begin();
+        g_preMainData.timestamps.objcLoadStartMachTime = dp_platform_now();
+        dp_seqlock_write_end();
     }
     pthread_mutex_unlock(&g_mutex);
 }
@@ -333,16 +1025,23 @@ void DPPreMainMarkObjCLoadStart(void) {
 void DPPreMainMarkObjCLoadEnd(void) {
     pthread_mutex_lock(&g_mutex);
     if (g_preMainData.timestamps.objcLoadEndMachTime == 0) {
-        g_preMainData.timestamps.objcLoadEndMachTime = mach_absolute_time();
+        dp_seqlock_write_begin();
+        g_preMainData.timestamps.objcLoadEndMachTime = dp_platform_now();
+        dp_seqlock_write_end();
     }
     pthread_mutex_unlock(&g_mutex);
 }
 
 const DPDylibLoadInfo* DPPreMainGetDylibInfo(uint32_t index) {
-    if (index >= g_preMainData.dylibCount || index >= DP_MAX_DYLIB_COUNT) {
+    pthread_mutex_lock(&g_mutex);
+    dp_resolve_pending_dylibs_locked();
+    uint32_t resolvedCount = g_resolvedDylibCount;
+    pthread_mutex_unlock(&g_mutex);
+    
+    if (index >= resolvedCount) {
         return NULL;
     }
-    return &g_dylibLoadInfos[index];
+    return &dp_dylib_record_at(index, false)->info;
 }
 
 uint32_t DPPreMainGetAllDylibs(DPDylibLoadInfo* outBuffer, uint32_t bufferSize) {
@@ -352,29 +1051,72 @@ uint32_t DPPreMainGetAllDylibs(DPDylibLoadInfo* outBuffer, uint32_t bufferSize)
     
     pthread_mutex_lock(&g_mutex);
     
-    uint32_t count = g_preMainData.dylibCount;
+    dp_resolve_pending_dylibs_locked();
+    
+    uint32_t count = g_resolvedDylibCount;
     if (count > bufferSize) {
         count = bufferSize;
     }
-    if (count > DP_MAX_DYLIB_COUNT) {
-        count = DP_MAX_DYLIB_COUNT;
-    }
     
-    memcpy(outBuffer, g_dylibLoadInfos, count * sizeof(DPDylibLoadInfo));
+    dp_copy_dylib_infos_locked(outBuffer, count);
     
     pthread_mutex_unlock(&g_mutex);
     
     return count;
 }
 
-/// 比较函数用于排序（按耗时降序）
-static int dp_compare_dylib_by_duration(const void* a, const void* b) {
-    const DPDylibLoadInfo* infoA = (const DPDylibLoadInfo*)a;
-    const DPDylibLoadInfo* infoB = (const DPDylibLoadInfo*)b;
-    
-    if (infoA->loadDurationNanos > infoB->loadDurationNanos) return -1;
-    if (infoA->loadDurationNanos < infoB->loadDurationNanos) return 1;
-    return 0;
+/// 镜像启动开销排序：a 的开销是否低于 b（加载耗时 + 初始化器耗时，相同时依次比较修正数量与段大小）
+static bool dp_dylib_cost_less(const DPDylibLoadInfo* a, const DPDylibLoadInfo* b) {
+    uint64_t costA = a->loadDurationNanos + a->initializerNanos;
+    uint64_t costB = b->loadDurationNanos + b->initializerNanos;
+    if (costA != costB) {
+        return costA < costB;
+    }
+    uint64_t fixupsA = (uint64_t)a->imageStats.rebaseCount + a->imageStats.bindCount;
+    uint64_t fixupsB = (uint64_t)b->imageStats.rebaseCount + b->imageStats.bindCount;
+    if (fixupsA != fixupsB) {
+        return fixupsA < fixupsB;
+    }
+    return a->imageStats.textSize + a->imageStats.dataSize < b->imageStats.textSize + b->imageStats.dataSize;
+}
+
+/// 小顶堆下沉（按启动开销，堆顶为当前 Top-N 中开销最小者）
+static void dp_dylib_heap_sift_down(DPDylibLoadInfo* heap, uint32_t size, uint32_t index) {
+    while (true) {
+        uint32_t smallest = index;
+        uint32_t left = index * 2 + 1;
+        uint32_t right = left + 1;
+        
+        if (left < size && dp_dylib_cost_less(&heap[left], &heap[smallest])) {
+            smallest = left;
+        }
+        if (right < size && dp_dylib_cost_less(&heap[right], &heap[smallest])) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            return;
+        }
+        
+        DPDylibLoadInfo tmp = heap[index];
+        heap[index] = heap[smallest];
+        heap[smallest] = tmp;
+        index = smallest;
+    }
+}
+
+/// 小顶堆上浮
+static void dp_dylib_heap_sift_up(DPDylibLoadInfo* heap, uint32_t index) {
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (!dp_dylib_cost_less(&heap[index], &heap[parent])) {
+            return;
+        }
+        
+        DPDylibLoadInfo tmp = heap[index];
+        heap[index] = heap[parent];
+        heap[parent] = tmp;
+        index = parent;
+    }
 }
 
 uint32_t DPPreMainGetSlowestDylibs(DPDylibLoadInfo* outBuffer, uint32_t count) {
@@ -382,52 +1124,88 @@ uint32_t DPPreMainGetSlowestDylibs(DPDylibLoadInfo* outBuffer, uint32_t count) {
         return 0;
     }
     
+    // 直接以输出缓冲区作为大小为 count 的小顶堆，O(n log k)，无需额外分配
+    uint32_t heapSize = 0;
+    
     pthread_mutex_lock(&g_mutex);
     
-    uint32_t totalCount = g_preMainData.dylibCount;
-    if (totalCount > DP_MAX_DYLIB_COUNT) {
-        totalCount = DP_MAX_DYLIB_COUNT;
-    }
+    dp_resolve_pending_dylibs_locked();
     
-    // 复制到临时缓冲区进行排序
-    DPDylibLoadInfo* tempBuffer = malloc(totalCount * sizeof(DPDylibLoadInfo));
-    if (tempBuffer == NULL) {
-        pthread_mutex_unlock(&g_mutex);
-        return 0;
+    uint32_t remaining = g_resolvedDylibCount;
+    for (DPDylibChunk* chunk = &g_firstDylibChunk; chunk != NULL && remaining > 0;
+         chunk = atomic_load_explicit(&chunk->next, memory_order_acquire)) {
+        for (uint32_t i = 0; i < DP_DYLIB_CHUNK_CAPACITY && remaining > 0; i++, remaining--) {
+            const DPDylibLoadInfo* info = &chunk->records[i].info;
+            
+            if (heapSize < count) {
+                outBuffer[heapSize] = *info;
+                dp_dylib_heap_sift_up(outBuffer, heapSize);
+                heapSize++;
+            } else if (dp_dylib_cost_less(&outBuffer[0], info)) {
+                outBuffer[0] = *info;
+                dp_dylib_heap_sift_down(outBuffer, heapSize, 0);
+            }
+        }
     }
     
-    memcpy(tempBuffer, g_dylibLoadInfos, totalCount * sizeof(DPDylibLoadInfo));
-    
     pthread_mutex_unlock(&g_mutex);
     
-    // 排序
-    qsort(tempBuffer, totalCount, sizeof(DPDylibLoadInfo), dp_compare_dylib_by_duration);
-    
-    // 复制结果
-    uint32_t resultCount = (count < totalCount) ? count : totalCount;
-    memcpy(outBuffer, tempBuffer, resultCount * sizeof(DPDylibLoadInfo));
-    
-    free(tempBuffer);
+    // 堆排序：依次将堆顶（最小值）交换到末尾，得到按开销降序的结果
+    for (uint32_t end = heapSize; end > 1; end--) {
+        DPDylibLoadInfo tmp = outBuffer[0];
+        outBuffer[0] = outBuffer[end - 1];
+        outBuffer[end - 1] = tmp;
+        dp_dylib_heap_sift_down(outBuffer, end - 1, 0);
+    }
     
-    return resultCount;
+    return heapSize;
 }
 
 void DPPreMainSetDylibDetailEnabled(bool enabled) {
+    atomic_store(&g_dylibDetailEnabled, enabled);
+    
     pthread_mutex_lock(&g_mutex);
+    dp_seqlock_write_begin();
     g_preMainData.dylibDetailEnabled = enabled;
+    dp_seqlock_write_end();
     pthread_mutex_unlock(&g_mutex);
 }
 
+void DPPreMainSetPerImageFaultsEnabled(bool enabled) {
+    atomic_store(&g_perImageFaultsEnabled, enabled);
+}
+
+void DPPreMainSetDylibMemoryLimit(size_t maxBytes) {
+    atomic_store(&g_dylibMemoryLimitBytes, maxBytes);
+}
+
 void DPPreMainReset(void) {
     pthread_mutex_lock(&g_mutex);
+    dp_seqlock_write_begin();
     
     memset(&g_preMainData, 0, sizeof(g_preMainData));
-    memset(g_dylibLoadInfos, 0, sizeof(g_dylibLoadInfos));
+    dp_free_dylib_chunks();
+    dp_string_arena_reset();
+    dp_initializers_reset_locked();
+    dp_markers_reset();
+    dp_dlopen_reset_locked();
+    dp_page_trace_reset();
     atomic_store(&g_dylibIndex, 0);
+    atomic_store(&g_firstDyldCallbackMachTime, 0);
+    atomic_store(&g_lastDyldCallbackMachTime, 0);
+    atomic_store(&g_firstDyldCallbackUsageReady, false);
+    memset(&g_registrationUsage, 0, sizeof(g_registrationUsage));
+    atomic_store(&g_dylibDetailEnabled, true);
+    atomic_store(&g_dylibCaptureSaturated, false);
+    atomic_store(&g_droppedDylibCount, 0);
+    g_resolvedDylibCount = 0;
+    memset(g_imageStatsCache, 0, sizeof(g_imageStatsCache));
     g_preMainData.dylibDetailEnabled = true;
+    dp_initializers_get_counts(false, &g_preMainData.timedInitializerCount, &g_preMainData.untimedInitializerCount);
     
     // 重新初始化时间基准
     dp_initialize_timebase();
     
+    dp_seqlock_write_end();
     pthread_mutex_unlock(&g_mutex);
 }
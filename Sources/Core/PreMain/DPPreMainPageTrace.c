@@ -0,0 +1,420 @@
+//
+//  DPPreMainPageTrace.c
+//  DebugProbe
+//
+//  代码页访问追踪与 order file 生成
+//  main() 标记与启动完成标记时对用户镜像的可执行段调用 mincore，记录每页在两个时刻的常驻状态；
+//  导出时才读取符号表，将常驻页映射回函数并按首次常驻的阶段排序，采样路径不解析符号
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "DPPreMainInternal.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// MARK: - 类型定义
+
+/// 页状态位
+#define DP_PAGE_RESIDENT_AT_MAIN 0x1u
+#define DP_PAGE_RESIDENT_AT_LAUNCH_COMPLETE 0x2u
+
+/// 一个可执行段的采样结果
+typedef struct {
+    /// 所属镜像头地址（同一镜像的多个段相邻存放）
+    const void* header;
+    /// 镜像路径（堆上副本）
+    char* path;
+    /// 按页对齐的起止地址
+    uintptr_t start;
+    uintptr_t end;
+    /// 每页的状态位
+    uint8_t* pages;
+} dp_page_trace_segment_t;
+
+/// 导出时收集的符号
+typedef struct {
+    uintptr_t address;
+    size_t size;
+    /// 名称在名称缓冲区中的偏移
+    size_t nameOffset;
+    /// 所属镜像序号（保持镜像加载顺序）
+    uint32_t imageIndex;
+    /// 首次常驻的阶段：0 为 main()，1 为启动完成，UINT8_MAX 为未常驻
+    uint8_t phase;
+} dp_order_symbol_t;
+
+/// 导出时的符号收集状态
+typedef struct {
+    dp_order_symbol_t* symbols;
+    size_t count;
+    size_t capacity;
+    char* names;
+    size_t namesLength;
+    size_t namesCapacity;
+    uint32_t imageIndex;
+    bool failed;
+} dp_order_collector_t;
+
+// MARK: - 全局数据
+
+/// 是否已开启追踪
+static atomic_bool g_pageTraceEnabled = false;
+
+/// 采样数据（受 g_pageTraceMutex 保护）
+static pthread_mutex_t g_pageTraceMutex = PTHREAD_MUTEX_INITIALIZER;
+static dp_page_trace_segment_t* g_segments = NULL;
+static uint32_t g_segmentCount = 0;
+static uint32_t g_segmentCapacity = 0;
+static uintptr_t g_pageSize = 0;
+static bool g_mainCaptured = false;
+static bool g_launchCompleteCaptured = false;
+
+// MARK: - 采样
+
+static size_t dp_segment_page_count(const dp_page_trace_segment_t* segment) {
+    return (segment->end - segment->start) / g_pageSize;
+}
+
+/// 对段调用 mincore，将常驻页的状态位置为 flag
+/// @param scratch 至少 dp_segment_page_count 字节的临时缓冲区
+static void dp_segment_sample(dp_page_trace_segment_t* segment, uint8_t flag, uint8_t* scratch) {
+    size_t pageCount = dp_segment_page_count(segment);
+    if (mincore((void*)segment->start, segment->end - segment->start, (void*)scratch) != 0) {
+        // 段内存在未映射的空洞时整段视为未常驻
+        return;
+    }
+    for (size_t i = 0; i < pageCount; i++) {
+        if (scratch[i] & 0x1) {
+            segment->pages[i] |= flag;
+        }
+    }
+}
+
+/// dp_platform_enumerate_text_segments 回调：登记用户镜像的可执行段（调用方持有 g_pageTraceMutex）
+static void dp_page_trace_add_segment(const void* header, const char* path, uintptr_t start, size_t size,
+                                      void* context) {
+    (void)context;
+    if (size == 0 || dp_platform_is_system_path(path)) {
+        return;
+    }
+
+    if (g_segmentCount == g_segmentCapacity) {
+        uint32_t capacity = g_segmentCapacity > 0 ? g_segmentCapacity * 2 : 64;
+        dp_page_trace_segment_t* segments = realloc(g_segments, capacity * sizeof(dp_page_trace_segment_t));
+        if (segments == NULL) {
+            return;
+        }
+        g_segments = segments;
+        g_segmentCapacity = capacity;
+    }
+
+    dp_page_trace_segment_t segment = {
+        .header = header,
+        .start = start & ~(g_pageSize - 1),
+        .end = (start + size + g_pageSize - 1) & ~(g_pageSize - 1),
+    };
+    segment.pages = calloc(dp_segment_page_count(&segment), 1);
+    segment.path = strdup(path != NULL ? path : "");
+    if (segment.pages == NULL || segment.path == NULL) {
+        free(segment.pages);
+        free(segment.path);
+        return;
+    }
+    g_segments[g_segmentCount++] = segment;
+}
+
+/// 对全部已登记的段采样（调用方持有 g_pageTraceMutex）
+static void dp_page_trace_sample_locked(uint8_t flag) {
+    size_t maxPages = 0;
+    for (uint32_t i = 0; i < g_segmentCount; i++) {
+        size_t pageCount = dp_segment_page_count(&g_segments[i]);
+        if (pageCount > maxPages) maxPages = pageCount;
+    }
+    uint8_t* scratch = maxPages > 0 ? malloc(maxPages) : NULL;
+    if (scratch == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < g_segmentCount; i++) {
+        dp_segment_sample(&g_segments[i], flag, scratch);
+    }
+    free(scratch);
+}
+
+// MARK: - 内部 API
+
+void dp_page_trace_capture_main(void) {
+    if (!atomic_load_explicit(&g_pageTraceEnabled, memory_order_relaxed)) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_pageTraceMutex);
+    if (!g_mainCaptured) {
+        g_pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+        dp_platform_enumerate_text_segments(dp_page_trace_add_segment, NULL);
+        dp_page_trace_sample_locked(DP_PAGE_RESIDENT_AT_MAIN);
+        g_mainCaptured = true;
+    }
+    pthread_mutex_unlock(&g_pageTraceMutex);
+}
+
+void dp_page_trace_reset(void) {
+    pthread_mutex_lock(&g_pageTraceMutex);
+    for (uint32_t i = 0; i < g_segmentCount; i++) {
+        free(g_segments[i].pages);
+        free(g_segments[i].path);
+    }
+    free(g_segments);
+    g_segments = NULL;
+    g_segmentCount = 0;
+    g_segmentCapacity = 0;
+    g_mainCaptured = false;
+    g_launchCompleteCaptured = false;
+    pthread_mutex_unlock(&g_pageTraceMutex);
+}
+
+// MARK: - 符号映射
+
+/// dp_platform_enumerate_function_symbols 回调：复制符号名并追加到收集器
+static void dp_order_collect_symbol(const char* name, uintptr_t address, size_t size, void* context) {
+    dp_order_collector_t* collector = context;
+    if (collector->failed || name == NULL || name[0] == '\0') {
+        return;
+    }
+
+    if (collector->count == collector->capacity) {
+        size_t capacity = collector->capacity > 0 ? collector->capacity * 2 : 4096;
+        dp_order_symbol_t* symbols = realloc(collector->symbols, capacity * sizeof(dp_order_symbol_t));
+        if (symbols == NULL) {
+            collector->failed = true;
+            return;
+        }
+        collector->symbols = symbols;
+        collector->capacity = capacity;
+    }
+
+    size_t length = strlen(name) + 1;
+    if (collector->namesLength + length > collector->namesCapacity) {
+        size_t capacity = collector->namesCapacity > 0 ? collector->namesCapacity * 2 : 64 * 1024;
+        while (capacity < collector->namesLength + length) capacity *= 2;
+        char* names = realloc(collector->names, capacity);
+        if (names == NULL) {
+            collector->failed = true;
+            return;
+        }
+        collector->names = names;
+        collector->namesCapacity = capacity;
+    }
+    memcpy(collector->names + collector->namesLength, name, length);
+
+    collector->symbols[collector->count++] = (dp_order_symbol_t){
+        .address = address,
+        .size = size,
+        .nameOffset = collector->namesLength,
+        .imageIndex = collector->imageIndex,
+        .phase = UINT8_MAX,
+    };
+    collector->namesLength += length;
+}
+
+static int dp_order_compare_address(const void* lhs, const void* rhs) {
+    const dp_order_symbol_t* a = lhs;
+    const dp_order_symbol_t* b = rhs;
+    if (a->address != b->address) return a->address < b->address ? -1 : 1;
+    return 0;
+}
+
+static int dp_order_compare_rank(const void* lhs, const void* rhs) {
+    const dp_order_symbol_t* a = lhs;
+    const dp_order_symbol_t* b = rhs;
+    if (a->phase != b->phase) return a->phase < b->phase ? -1 : 1;
+    if (a->imageIndex != b->imageIndex) return a->imageIndex < b->imageIndex ? -1 : 1;
+    return dp_order_compare_address(lhs, rhs);
+}
+
+/// 符号覆盖的各页状态位之并
+static uint8_t dp_symbol_page_flags(const dp_page_trace_segment_t* segments, uint32_t segmentCount,
+                                    uintptr_t start, uintptr_t end) {
+    uint8_t flags = 0;
+    for (uint32_t i = 0; i < segmentCount; i++) {
+        const dp_page_trace_segment_t* segment = &segments[i];
+        if (end <= segment->start || start >= segment->end) continue;
+
+        uintptr_t first = (start > segment->start ? start : segment->start) - segment->start;
+        uintptr_t last = (end < segment->end ? end : segment->end) - 1 - segment->start;
+        for (uintptr_t page = first / g_pageSize; page <= last / g_pageSize; page++) {
+            flags |= segment->pages[page];
+        }
+    }
+    return flags;
+}
+
+/// 按地址排序一个镜像的符号，推算缺失的大小并标记阶段；别名与未常驻的符号移到末尾丢弃
+/// @return 保留的符号数量
+static size_t dp_order_classify_image(dp_order_symbol_t* symbols, size_t count,
+                                      const dp_page_trace_segment_t* segments, uint32_t segmentCount) {
+    qsort(symbols, count, sizeof(dp_order_symbol_t), dp_order_compare_address);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        dp_order_symbol_t symbol = symbols[i];
+        // 同地址的别名只保留第一个
+        if (kept > 0 && symbols[kept - 1].address == symbol.address) continue;
+
+        // Mach-O 符号表不含大小，按下一个符号的地址推算
+        if (symbol.size == 0) {
+            size_t next = i + 1;
+            while (next < count && symbols[next].address == symbol.address) next++;
+            symbol.size = next < count ? symbols[next].address - symbol.address : 1;
+        }
+        uint8_t flags = dp_symbol_page_flags(segments, segmentCount, symbol.address, symbol.address + symbol.size);
+        if (flags & DP_PAGE_RESIDENT_AT_MAIN) {
+            symbol.phase = 0;
+        } else if (flags & DP_PAGE_RESIDENT_AT_LAUNCH_COMPLETE) {
+            symbol.phase = 1;
+        } else {
+            continue;
+        }
+        symbols[kept++] = symbol;
+    }
+    return kept;
+}
+
+static bool dp_path_has_suffix(const char* path, const char* suffix) {
+    size_t pathLength = strlen(path);
+    size_t suffixLength = strlen(suffix);
+    return suffixLength <= pathLength && strcmp(path + pathLength - suffixLength, suffix) == 0;
+}
+
+/// 写出全部数据（处理部分写入与 EINTR）
+static bool dp_write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+// MARK: - 公开 API 实现
+
+void DPPreMainSetPageTraceEnabled(bool enabled) {
+    atomic_store_explicit(&g_pageTraceEnabled, enabled, memory_order_relaxed);
+}
+
+void DPPreMainMarkLaunchComplete(void) {
+    // 启动采样以同一时刻为终点
+    DPPreMainStopLaunchSampler();
+
+    pthread_mutex_lock(&g_pageTraceMutex);
+    if (g_mainCaptured && !g_launchCompleteCaptured) {
+        dp_page_trace_sample_locked(DP_PAGE_RESIDENT_AT_LAUNCH_COMPLETE);
+        g_launchCompleteCaptured = true;
+    }
+    pthread_mutex_unlock(&g_pageTraceMutex);
+}
+
+bool DPPreMainGetPageTraceStats(DPPageTraceStats* outStats) {
+    if (outStats == NULL) return false;
+    memset(outStats, 0, sizeof(*outStats));
+
+    pthread_mutex_lock(&g_pageTraceMutex);
+    bool captured = g_mainCaptured;
+    if (captured) {
+        outStats->pageSize = (uint32_t)g_pageSize;
+        outStats->launchCompleteCaptured = g_launchCompleteCaptured;
+        for (uint32_t i = 0; i < g_segmentCount; i++) {
+            const dp_page_trace_segment_t* segment = &g_segments[i];
+            if (i == 0 || segment->header != g_segments[i - 1].header) {
+                outStats->imageCount++;
+            }
+            size_t pageCount = dp_segment_page_count(segment);
+            outStats->textPageCount += (uint32_t)pageCount;
+            for (size_t page = 0; page < pageCount; page++) {
+                if (segment->pages[page] & DP_PAGE_RESIDENT_AT_MAIN) {
+                    outStats->residentAtMainCount++;
+                }
+                if (segment->pages[page] & (DP_PAGE_RESIDENT_AT_MAIN | DP_PAGE_RESIDENT_AT_LAUNCH_COMPLETE)) {
+                    outStats->residentAtLaunchCompleteCount++;
+                }
+            }
+        }
+    }
+    pthread_mutex_unlock(&g_pageTraceMutex);
+    return captured;
+}
+
+int64_t DPPreMainExportOrderFileToFileDescriptor(int fd, const char* imageName) {
+    pthread_mutex_lock(&g_pageTraceMutex);
+    if (!g_mainCaptured) {
+        pthread_mutex_unlock(&g_pageTraceMutex);
+        return -1;
+    }
+
+    // 逐镜像收集符号并就地分类（同一镜像的段相邻）
+    dp_order_collector_t collector = { 0 };
+    size_t keptCount = 0;
+    for (uint32_t first = 0; first < g_segmentCount && !collector.failed;) {
+        uint32_t last = first + 1;
+        while (last < g_segmentCount && g_segments[last].header == g_segments[first].header) last++;
+
+        const dp_page_trace_segment_t* segments = &g_segments[first];
+        if (imageName == NULL || dp_path_has_suffix(segments->path, imageName)) {
+            collector.count = keptCount;
+            dp_platform_enumerate_function_symbols(segments->header, segments->path, dp_order_collect_symbol,
+                                                   &collector);
+            keptCount += dp_order_classify_image(collector.symbols + keptCount, collector.count - keptCount,
+                                                 segments, last - first);
+            collector.imageIndex++;
+        }
+        first = last;
+    }
+    pthread_mutex_unlock(&g_pageTraceMutex);
+
+    int64_t result = -1;
+    if (!collector.failed) {
+        qsort(collector.symbols, keptCount, sizeof(dp_order_symbol_t), dp_order_compare_rank);
+
+        // 逐行写出，经固定大小缓冲区分块
+        char buffer[4096];
+        size_t used = 0;
+        bool ok = true;
+        for (size_t i = 0; i < keptCount && ok; i++) {
+            const char* name = collector.names + collector.symbols[i].nameOffset;
+            size_t length = strlen(name);
+            if (used + length + 1 > sizeof(buffer)) {
+                ok = dp_write_all(fd, buffer, used);
+                used = 0;
+            }
+            if (length + 1 > sizeof(buffer)) {
+                ok = ok && dp_write_all(fd, name, length) && dp_write_all(fd, "\n", 1);
+                continue;
+            }
+            memcpy(buffer + used, name, length);
+            buffer[used + length] = '\n';
+            used += length + 1;
+        }
+        if (ok && dp_write_all(fd, buffer, used)) {
+            result = (int64_t)keptCount;
+        }
+    }
+
+    free(collector.symbols);
+    free(collector.names);
+    return result;
+}
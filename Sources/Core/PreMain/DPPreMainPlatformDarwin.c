@@ -0,0 +1,838 @@
+//
+//  DPPreMainPlatformDarwin.c
+//  DebugProbe
+//
+//  PreMain 监控平台层：Apple 实现
+//  mach_absolute_time + _dyld_register_func_for_add_image + sysctl(KERN_PROC)
+//  以 DP_PREMAIN_DLOPEN_INTERPOSE=1 编译时通过 __DATA,__interpose 挂接 dlopen / dlclose 记录阻塞耗时
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#if defined(__APPLE__)
+
+#include "DPPreMainInternal.h"
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <libkern/OSByteOrder.h>
+#include <mach-o/dyld.h>
+#include <mach-o/fat.h>
+#include <mach-o/fixup-chains.h>
+#include <mach-o/getsect.h>
+#include <mach-o/loader.h>
+#include <mach-o/nlist.h>
+#include <mach/mach.h>
+#include <mach/mach_time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/sysctl.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <string.h>
+
+// MARK: - 全局数据
+
+/// 核心模块注册的镜像加载回调
+static dp_image_added_callback_t g_imageAddedCallback = NULL;
+
+// MARK: - 时钟
+
+uint64_t dp_platform_now(void) {
+    return mach_absolute_time();
+}
+
+void dp_platform_timebase(uint32_t* outNumer, uint32_t* outDenom) {
+    mach_timebase_info_data_t timebaseInfo;
+    mach_timebase_info(&timebaseInfo);
+    *outNumer = timebaseInfo.numer;
+    *outDenom = timebaseInfo.denom;
+}
+
+// MARK: - 线程
+
+uint64_t dp_platform_thread_id(void) {
+    uint64_t threadId = 0;
+    pthread_threadid_np(NULL, &threadId);
+    return threadId;
+}
+
+bool dp_platform_is_main_thread(void) {
+    return pthread_main_np() != 0;
+}
+
+// MARK: - 缓存目录
+
+size_t dp_platform_cache_directory(char* buffer, size_t bufferSize) {
+    // iOS 沙盒中 HOME 为应用容器目录，Library/Caches 始终存在
+    const char* home = getenv("HOME");
+    if (home == NULL || home[0] == '\0') {
+        return 0;
+    }
+    int length = snprintf(buffer, bufferSize, "%s/Library/Caches", home);
+    return length > 0 && (size_t)length < bufferSize ? (size_t)length : 0;
+}
+
+size_t dp_platform_executable_path(char* buffer, size_t bufferSize) {
+    uint32_t size = bufferSize > UINT32_MAX ? UINT32_MAX : (uint32_t)bufferSize;
+    if (size == 0 || _NSGetExecutablePath(buffer, &size) != 0) {
+        return 0;
+    }
+    return strlen(buffer);
+}
+
+// MARK: - 进程启动时间
+
+/// 通过 sysctl 获取进程启动时间（Unix 时间戳，微秒）
+uint64_t dp_platform_process_start_unix_micros(void) {
+    struct kinfo_proc kinfo;
+    size_t size = sizeof(kinfo);
+    int mib[4] = { CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid() };
+
+    if (sysctl(mib, 4, &kinfo, &size, NULL, 0) != 0) {
+        return 0;
+    }
+
+    struct timeval startTime = kinfo.kp_proc.p_starttime;
+    return (uint64_t)startTime.tv_sec * 1000000 + (uint64_t)startTime.tv_usec;
+}
+
+/// libproc.h 不在 iOS SDK 中，函数本身由 libsystem_kernel 导出
+int proc_pid_rusage(int pid, int flavor, rusage_info_t* buffer);
+
+/// 内核在创建进程时以 mach_absolute_time 记录启动时刻，与 dp_platform_now 同一时钟，无需对齐
+bool dp_platform_process_start_nanos(uint64_t* outStartNanos, uint64_t* outErrorNanos) {
+    struct rusage_info_v2 info;
+    if (proc_pid_rusage(getpid(), RUSAGE_INFO_V2, (rusage_info_t*)&info) != 0 || info.ri_proc_start_abstime == 0) {
+        return false;
+    }
+    *outStartNanos = DPMachTimeToNanos(info.ri_proc_start_abstime);
+    // 误差仅为一个时钟计数
+    *outErrorNanos = DPMachTimeToNanos(1) + 1;
+    return true;
+}
+
+// MARK: - 镜像加载通知
+
+/// 是否正在注册回调（期间的通知是对已加载镜像的补发）
+static bool g_registeringImageCallback = false;
+
+/// dyld 回调适配：转发到核心模块回调
+static void dp_darwin_dyld_image_added(const struct mach_header* mh, intptr_t slide) {
+    g_imageAddedCallback(mh, slide);
+
+    // 运行时加载的镜像在通知之后才执行初始化器，此时包装其初始化器表即可计时
+    if (!g_registeringImageCallback) {
+        dp_initializers_image_added(mh);
+    }
+}
+
+void dp_platform_register_image_callback(dp_image_added_callback_t callback) {
+    g_imageAddedCallback = callback;
+
+    // 注意：此回调会被所有已加载的镜像触发一次，然后监听新加载的镜像
+    g_registeringImageCallback = true;
+    _dyld_register_func_for_add_image(dp_darwin_dyld_image_added);
+    g_registeringImageCallback = false;
+}
+
+void dp_platform_poll_images(void) {
+    // dyld 实时通知，无需补扫
+}
+
+// MARK: - 静态初始化器表
+
+#ifndef __has_feature
+#define __has_feature(x) 0
+#endif
+
+#if __LP64__
+typedef struct mach_header_64 dp_mach_header_t;
+typedef struct segment_command_64 dp_segment_command_t;
+typedef struct section_64 dp_section_t;
+typedef struct nlist_64 dp_nlist_t;
+#define DP_LC_SEGMENT LC_SEGMENT_64
+#else
+typedef struct mach_header dp_mach_header_t;
+typedef struct segment_command dp_segment_command_t;
+typedef struct section dp_section_t;
+typedef struct nlist dp_nlist_t;
+#define DP_LC_SEGMENT LC_SEGMENT
+#endif
+
+/// 访问单个镜像的初始化器表
+static void dp_darwin_visit_initializers(const dp_mach_header_t* header, const char* path,
+                                         dp_initializer_table_visitor_t visitor, void* context) {
+    // __mod_init_func 可能位于的段，及该段在 dyld 完成修正后是否只读
+    static const struct {
+        const char* segment;
+        bool isReadOnly;
+    } initializerSegments[] = {
+        { "__DATA_CONST", true },
+        { "__AUTH_CONST", true },
+        { "__DATA", false },
+    };
+
+    // __init_offsets（链接器 -fixup_chains 生成的 32 位偏移表）由 dyld 直接解析调用，无法替换
+    unsigned long offsetsSize = 0;
+    uint32_t untimedCount = 0;
+    if (getsectiondata(header, "__TEXT", "__init_offsets", &offsetsSize) != NULL) {
+        untimedCount = (uint32_t)(offsetsSize / sizeof(uint32_t));
+    }
+
+    bool visited = false;
+    for (size_t s = 0; s < sizeof(initializerSegments) / sizeof(initializerSegments[0]); s++) {
+        unsigned long size = 0;
+        uint8_t* data = getsectiondata(header, initializerSegments[s].segment, "__mod_init_func", &size);
+        if (data == NULL || size == 0) continue;
+
+        size_t count = size / sizeof(void*);
+#if __has_feature(ptrauth_calls)
+        // arm64e 表项为签名指针，写入未签名的包装函数会导致调用时校验失败
+        visitor(header, path, NULL, 0, false, untimedCount + (uint32_t)count, context);
+#else
+        visitor(header, path, (void**)data, count, initializerSegments[s].isReadOnly, untimedCount, context);
+#endif
+        untimedCount = 0;
+        visited = true;
+    }
+
+    if (!visited && untimedCount > 0) {
+        visitor(header, path, NULL, 0, false, untimedCount, context);
+    }
+}
+
+void dp_platform_enumerate_initializer_tables(dp_initializer_table_visitor_t visitor, void* context) {
+    uint32_t imageCount = _dyld_image_count();
+    for (uint32_t i = 0; i < imageCount; i++) {
+        const dp_mach_header_t* header = (const dp_mach_header_t*)_dyld_get_image_header(i);
+        const char* path = _dyld_get_image_name(i);
+        if (header == NULL) continue;
+        dp_darwin_visit_initializers(header, path, visitor, context);
+    }
+}
+
+void dp_platform_visit_image_initializers(const void* header, dp_initializer_table_visitor_t visitor, void* context) {
+    Dl_info info;
+    const char* path = dladdr(header, &info) && info.dli_fname != NULL ? info.dli_fname : "";
+    dp_darwin_visit_initializers(header, path, visitor, context);
+}
+
+/// 镜像安装名（LC_ID_DYLIB），主程序与 bundle 没有安装名时返回 NULL
+static const char* dp_darwin_install_name(const dp_mach_header_t* mh) {
+    const struct load_command* command = (const struct load_command*)(mh + 1);
+    for (uint32_t i = 0; i < mh->ncmds; i++) {
+        if (command->cmd == LC_ID_DYLIB) {
+            const struct dylib_command* dylib = (const struct dylib_command*)command;
+            return (const char*)command + dylib->dylib.name.offset;
+        }
+        command = (const struct load_command*)((const uint8_t*)command + command->cmdsize);
+    }
+    return NULL;
+}
+
+bool dp_platform_image_depends_on(const void* header, const void* dependency) {
+    const char* installName = dp_darwin_install_name(dependency);
+    if (installName == NULL) {
+        return false;
+    }
+
+    // 向上依赖（LC_LOAD_UPWARD_DYLIB）不约束初始化顺序，不计入
+    const dp_mach_header_t* mh = header;
+    const struct load_command* command = (const struct load_command*)(mh + 1);
+    for (uint32_t i = 0; i < mh->ncmds; i++) {
+        if (command->cmd == LC_LOAD_DYLIB || command->cmd == LC_LOAD_WEAK_DYLIB
+            || command->cmd == LC_REEXPORT_DYLIB || command->cmd == LC_LAZY_LOAD_DYLIB) {
+            const struct dylib_command* dylib = (const struct dylib_command*)command;
+            if (strcmp((const char*)command + dylib->dylib.name.offset, installName) == 0) {
+                return true;
+            }
+        }
+        command = (const struct load_command*)((const uint8_t*)command + command->cmdsize);
+    }
+    return false;
+}
+
+bool dp_platform_is_main_executable(const void* header) {
+    return ((const dp_mach_header_t*)header)->filetype == MH_EXECUTE;
+}
+
+// MARK: - 可执行段与符号
+
+void dp_platform_enumerate_text_segments(dp_text_segment_visitor_t visitor, void* context) {
+    uint32_t imageCount = _dyld_image_count();
+    for (uint32_t i = 0; i < imageCount; i++) {
+        const dp_mach_header_t* header = (const dp_mach_header_t*)_dyld_get_image_header(i);
+        if (header == NULL) continue;
+
+        unsigned long size = 0;
+        uint8_t* start = getsegmentdata(header, "__TEXT", &size);
+        if (start != NULL && size > 0) {
+            visitor(header, _dyld_get_image_name(i), (uintptr_t)start, size, context);
+        }
+    }
+}
+
+bool dp_platform_enumerate_function_symbols(const void* header, const char* path,
+                                            dp_symbol_visitor_t visitor, void* context) {
+    (void)path;
+    const dp_mach_header_t* mh = header;
+
+    const dp_segment_command_t* text = NULL;
+    const dp_segment_command_t* linkedit = NULL;
+    const struct symtab_command* symtab = NULL;
+    // 含指令的节（n_sect 从 1 开始按加载命令中节的出现顺序编号）
+    bool codeSections[256] = { false };
+    uint32_t sectionOrdinal = 0;
+
+    const struct load_command* command = (const struct load_command*)(mh + 1);
+    for (uint32_t i = 0; i < mh->ncmds; i++) {
+        if (command->cmd == DP_LC_SEGMENT) {
+            const dp_segment_command_t* segment = (const dp_segment_command_t*)command;
+            if (strcmp(segment->segname, SEG_TEXT) == 0) {
+                text = segment;
+            } else if (strcmp(segment->segname, SEG_LINKEDIT) == 0) {
+                linkedit = segment;
+            }
+            const dp_section_t* sections = (const dp_section_t*)(segment + 1);
+            for (uint32_t s = 0; s < segment->nsects; s++) {
+                if (++sectionOrdinal < 256 && (sections[s].flags & S_ATTR_SOME_INSTRUCTIONS) != 0) {
+                    codeSections[sectionOrdinal] = true;
+                }
+            }
+        } else if (command->cmd == LC_SYMTAB) {
+            symtab = (const struct symtab_command*)command;
+        }
+        command = (const struct load_command*)((const uint8_t*)command + command->cmdsize);
+    }
+    if (text == NULL || linkedit == NULL || symtab == NULL) {
+        return false;
+    }
+
+    // __LINKEDIT 随镜像映射，符号表可直接在内存中读取
+    uintptr_t slide = (uintptr_t)mh - (uintptr_t)text->vmaddr;
+    uintptr_t linkeditBase = slide + (uintptr_t)linkedit->vmaddr - (uintptr_t)linkedit->fileoff;
+    const dp_nlist_t* symbols = (const dp_nlist_t*)(linkeditBase + symtab->symoff);
+    const char* strings = (const char*)(linkeditBase + symtab->stroff);
+
+    for (uint32_t i = 0; i < symtab->nsyms; i++) {
+        const dp_nlist_t* symbol = &symbols[i];
+        if ((symbol->n_type & N_STAB) != 0 || (symbol->n_type & N_TYPE) != N_SECT ||
+            !codeSections[symbol->n_sect] || symbol->n_un.n_strx == 0 || symbol->n_un.n_strx >= symtab->strsize) {
+            continue;
+        }
+        // Mach-O 符号表不含大小，由调用方按相邻符号推算
+        visitor(strings + symbol->n_un.n_strx, (uintptr_t)symbol->n_value + slide, 0, context);
+    }
+    return true;
+}
+
+// MARK: - 镜像静态统计
+
+#ifndef MH_DYLIB_IN_CACHE
+#define MH_DYLIB_IN_CACHE 0x80000000
+#endif
+
+#ifndef S_INIT_FUNC_OFFSETS
+#define S_INIT_FUNC_OFFSETS 0x16
+#endif
+
+/// 记录文件偏移的段数量上限（链式修正按段序号索引）
+#define DP_MAX_SEGMENTS 32
+
+/// 读取 ULEB128（SLEB128 的字节结构相同，也可用于跳过）
+static uint64_t dp_read_uleb128(const uint8_t** cursor, const uint8_t* end) {
+    uint64_t value = 0;
+    unsigned shift = 0;
+    while (*cursor < end) {
+        uint8_t byte = *(*cursor)++;
+        if (shift < 64) {
+            value |= (uint64_t)(byte & 0x7f) << shift;
+        }
+        shift += 7;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+    return value;
+}
+
+/// 统计 LC_DYLD_INFO rebase 操作码流中的 rebase 数量
+static uint64_t dp_count_rebase_opcodes(const uint8_t* cursor, const uint8_t* end) {
+    uint64_t count = 0;
+    while (cursor < end) {
+        uint8_t opcode = *cursor & REBASE_OPCODE_MASK;
+        uint8_t immediate = *cursor & REBASE_IMMEDIATE_MASK;
+        cursor++;
+        switch (opcode) {
+            case REBASE_OPCODE_DONE:
+                return count;
+            case REBASE_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB:
+            case REBASE_OPCODE_ADD_ADDR_ULEB:
+                dp_read_uleb128(&cursor, end);
+                break;
+            case REBASE_OPCODE_DO_REBASE_IMM_TIMES:
+                count += immediate;
+                break;
+            case REBASE_OPCODE_DO_REBASE_ULEB_TIMES:
+                count += dp_read_uleb128(&cursor, end);
+                break;
+            case REBASE_OPCODE_DO_REBASE_ADD_ADDR_ULEB:
+                count++;
+                dp_read_uleb128(&cursor, end);
+                break;
+            case REBASE_OPCODE_DO_REBASE_ULEB_TIMES_SKIPPING_ULEB:
+                count += dp_read_uleb128(&cursor, end);
+                dp_read_uleb128(&cursor, end);
+                break;
+            default:
+                // SET_TYPE_IMM / ADD_ADDR_IMM_SCALED 不带操作数
+                break;
+        }
+    }
+    return count;
+}
+
+/// 统计 LC_DYLD_INFO bind 操作码流中的 bind 数量
+/// @param isLazy lazy bind 表以 DONE 分隔各条目，读到 DONE 不结束
+static uint64_t dp_count_bind_opcodes(const uint8_t* cursor, const uint8_t* end, bool isLazy) {
+    uint64_t count = 0;
+    while (cursor < end) {
+        uint8_t opcode = *cursor & BIND_OPCODE_MASK;
+        uint8_t immediate = *cursor & BIND_IMMEDIATE_MASK;
+        cursor++;
+        switch (opcode) {
+            case BIND_OPCODE_DONE:
+                if (!isLazy) {
+                    return count;
+                }
+                break;
+            case BIND_OPCODE_SET_DYLIB_ORDINAL_ULEB:
+            case BIND_OPCODE_SET_ADDEND_SLEB:
+            case BIND_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB:
+            case BIND_OPCODE_ADD_ADDR_ULEB:
+                dp_read_uleb128(&cursor, end);
+                break;
+            case BIND_OPCODE_SET_SYMBOL_TRAILING_FLAGS_IMM:
+                while (cursor < end && *cursor++ != '\0') {
+                }
+                break;
+            case BIND_OPCODE_DO_BIND:
+            case BIND_OPCODE_DO_BIND_ADD_ADDR_IMM_SCALED:
+                count++;
+                break;
+            case BIND_OPCODE_DO_BIND_ADD_ADDR_ULEB:
+                count++;
+                dp_read_uleb128(&cursor, end);
+                break;
+            case BIND_OPCODE_DO_BIND_ULEB_TIMES_SKIPPING_ULEB:
+                count += dp_read_uleb128(&cursor, end);
+                dp_read_uleb128(&cursor, end);
+                break;
+            case BIND_OPCODE_THREADED:
+                // 线程化 bind 的数量需遍历内存中的指针链，这里只跳过操作数
+                if (immediate == BIND_SUBOPCODE_THREADED_SET_BIND_ORDINAL_TABLE_SIZE_ULEB) {
+                    dp_read_uleb128(&cursor, end);
+                }
+                break;
+            default:
+                // SET_DYLIB_ORDINAL_IMM / SET_DYLIB_SPECIAL_IMM / SET_TYPE_IMM 不带操作数
+                break;
+        }
+    }
+    return count;
+}
+
+/// 在磁盘文件中定位与内存镜像架构一致的切片（非 fat 文件为 0）
+static bool dp_darwin_slice_offset(const uint8_t* file, size_t fileSize, const dp_mach_header_t* mh,
+                                   uint64_t* outOffset) {
+    uint32_t magic = OSSwapBigToHostInt32(((const struct fat_header*)file)->magic);
+    if (magic != FAT_MAGIC && magic != FAT_MAGIC_64) {
+        *outOffset = 0;
+        return true;
+    }
+
+    uint32_t archCount = OSSwapBigToHostInt32(((const struct fat_header*)file)->nfat_arch);
+    size_t archSize = magic == FAT_MAGIC_64 ? sizeof(struct fat_arch_64) : sizeof(struct fat_arch);
+    for (uint32_t i = 0; i < archCount; i++) {
+        size_t archOffset = sizeof(struct fat_header) + (size_t)i * archSize;
+        if (archOffset + archSize > fileSize) {
+            break;
+        }
+        // fat_arch 与 fat_arch_64 的 cputype / cpusubtype 位于相同偏移
+        const struct fat_arch* arch = (const struct fat_arch*)(file + archOffset);
+        if ((cpu_type_t)OSSwapBigToHostInt32((uint32_t)arch->cputype) != mh->cputype ||
+            ((cpu_subtype_t)OSSwapBigToHostInt32((uint32_t)arch->cpusubtype) & ~CPU_SUBTYPE_MASK) !=
+                (mh->cpusubtype & ~CPU_SUBTYPE_MASK)) {
+            continue;
+        }
+        *outOffset = magic == FAT_MAGIC_64
+            ? OSSwapBigToHostInt64(((const struct fat_arch_64*)arch)->offset)
+            : OSSwapBigToHostInt32(arch->offset);
+        return *outOffset + sizeof(dp_mach_header_t) <= fileSize;
+    }
+    return false;
+}
+
+/// 统计链式修正中的 rebase / bind 数量
+/// 内存中的指针链在 dyld 修正后已被目标地址覆盖，需从磁盘文件读取原始链
+static bool dp_darwin_count_chained_fixups(const dp_mach_header_t* mh, const char* path,
+                                           const struct dyld_chained_fixups_header* fixups,
+                                           const uint64_t* segmentFileOffsets, uint32_t segmentCount,
+                                           DPImageStats* stats) {
+    if (path == NULL || fixups->fixups_version != 0) {
+        return false;
+    }
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || (size_t)fileStat.st_size < sizeof(struct fat_header)) {
+        close(fd);
+        return false;
+    }
+    size_t fileSize = (size_t)fileStat.st_size;
+    const uint8_t* file = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED) {
+        return false;
+    }
+
+    uint64_t sliceOffset = 0;
+    bool found = dp_darwin_slice_offset(file, fileSize, mh, &sliceOffset);
+    uint64_t rebaseCount = 0;
+    uint64_t bindCount = 0;
+
+    const struct dyld_chained_starts_in_image* image =
+        (const struct dyld_chained_starts_in_image*)((const uint8_t*)fixups + fixups->starts_offset);
+    for (uint32_t s = 0; found && s < image->seg_count && s < segmentCount; s++) {
+        if (image->seg_info_offset[s] == 0) {
+            continue;
+        }
+        const struct dyld_chained_starts_in_segment* segment =
+            (const struct dyld_chained_starts_in_segment*)((const uint8_t*)image + image->seg_info_offset[s]);
+
+        // 只支持 64 位格式：arm64e 链步长 8 字节、bind 位为 62，其余步长 4 字节、bind 位为 63
+        uint32_t stride;
+        unsigned bindBit;
+        uint64_t nextMask;
+        switch (segment->pointer_format) {
+            case DYLD_CHAINED_PTR_ARM64E:
+            case DYLD_CHAINED_PTR_ARM64E_USERLAND:
+            case DYLD_CHAINED_PTR_ARM64E_USERLAND24:
+                stride = 8;
+                bindBit = 62;
+                nextMask = 0x7FF;
+                break;
+            case DYLD_CHAINED_PTR_64:
+            case DYLD_CHAINED_PTR_64_OFFSET:
+                stride = 4;
+                bindBit = 63;
+                nextMask = 0xFFF;
+                break;
+            default:
+                continue;
+        }
+
+        for (uint16_t page = 0; page < segment->page_count; page++) {
+            uint16_t start = segment->page_start[page];
+            if (start == DYLD_CHAINED_PTR_START_NONE) {
+                continue;
+            }
+            uint64_t offset = sliceOffset + segmentFileOffsets[s] + (uint64_t)page * segment->page_size + start;
+            uint64_t pageEnd = offset - start + segment->page_size;
+            while (offset + sizeof(uint64_t) <= fileSize && offset < pageEnd) {
+                uint64_t raw;
+                memcpy(&raw, file + offset, sizeof(raw));
+                if ((raw >> bindBit) & 1) {
+                    bindCount++;
+                } else {
+                    rebaseCount++;
+                }
+                uint64_t next = (raw >> 51) & nextMask;
+                if (next == 0) {
+                    break;
+                }
+                offset += next * stride;
+            }
+        }
+    }
+
+    munmap((void*)file, fileSize);
+    stats->rebaseCount = rebaseCount > UINT32_MAX ? UINT32_MAX : (uint32_t)rebaseCount;
+    stats->bindCount = bindCount > UINT32_MAX ? UINT32_MAX : (uint32_t)bindCount;
+    return found;
+}
+
+void dp_platform_image_stats(const void* header, const char* path, DPImageStats* outStats) {
+    memset(outStats, 0, sizeof(*outStats));
+    const dp_mach_header_t* mh = header;
+    if (mh == NULL) {
+        return;
+    }
+
+    const dp_segment_command_t* text = NULL;
+    const dp_segment_command_t* linkedit = NULL;
+    const struct dyld_info_command* dyldInfo = NULL;
+    const struct linkedit_data_command* chainedFixups = NULL;
+    uint64_t segmentFileOffsets[DP_MAX_SEGMENTS];
+    uint32_t segmentCount = 0;
+
+    const struct load_command* command = (const struct load_command*)(mh + 1);
+    for (uint32_t i = 0; i < mh->ncmds; i++) {
+        if (command->cmd == DP_LC_SEGMENT) {
+            const dp_segment_command_t* segment = (const dp_segment_command_t*)command;
+            if (segmentCount < DP_MAX_SEGMENTS) {
+                segmentFileOffsets[segmentCount++] = segment->fileoff;
+            }
+            if (strcmp(segment->segname, SEG_TEXT) == 0) {
+                text = segment;
+                outStats->textSize = segment->vmsize;
+            } else if (strcmp(segment->segname, SEG_LINKEDIT) == 0) {
+                linkedit = segment;
+            } else if (strncmp(segment->segname, "__DATA", 6) == 0 || strncmp(segment->segname, "__AUTH", 6) == 0) {
+                outStats->dataSize += segment->vmsize;
+            }
+
+            const dp_section_t* sections = (const dp_section_t*)(segment + 1);
+            for (uint32_t s = 0; s < segment->nsects; s++) {
+                uint32_t type = sections[s].flags & SECTION_TYPE;
+                if (type == S_MOD_INIT_FUNC_POINTERS) {
+                    outStats->initializerCount += (uint32_t)(sections[s].size / sizeof(void*));
+                } else if (type == S_INIT_FUNC_OFFSETS) {
+                    outStats->initializerCount += (uint32_t)(sections[s].size / sizeof(uint32_t));
+                }
+            }
+        } else if (command->cmd == LC_DYLD_INFO || command->cmd == LC_DYLD_INFO_ONLY) {
+            dyldInfo = (const struct dyld_info_command*)command;
+        } else if (command->cmd == LC_DYLD_CHAINED_FIXUPS) {
+            chainedFixups = (const struct linkedit_data_command*)command;
+        }
+        command = (const struct load_command*)((const uint8_t*)command + command->cmdsize);
+    }
+
+    // 共享缓存中的镜像在构建缓存时已完成修正，加载时没有 rebase / bind 开销
+    if ((mh->flags & MH_DYLIB_IN_CACHE) != 0) {
+        outStats->flags = DP_IMAGE_STATS_AVAILABLE | DP_IMAGE_STATS_SHARED_CACHE;
+        return;
+    }
+    if (text == NULL || linkedit == NULL) {
+        return;
+    }
+
+    // 修正信息位于 __LINKEDIT，随镜像映射且不会被 dyld 改写
+    uintptr_t slide = (uintptr_t)mh - (uintptr_t)text->vmaddr;
+    uintptr_t linkeditBase = slide + (uintptr_t)linkedit->vmaddr - (uintptr_t)linkedit->fileoff;
+
+    if (dyldInfo != NULL) {
+        const uint8_t* rebase = (const uint8_t*)(linkeditBase + dyldInfo->rebase_off);
+        uint64_t rebaseCount = dp_count_rebase_opcodes(rebase, rebase + dyldInfo->rebase_size);
+
+        const uint8_t* bind = (const uint8_t*)(linkeditBase + dyldInfo->bind_off);
+        const uint8_t* weakBind = (const uint8_t*)(linkeditBase + dyldInfo->weak_bind_off);
+        const uint8_t* lazyBind = (const uint8_t*)(linkeditBase + dyldInfo->lazy_bind_off);
+        uint64_t bindCount = dp_count_bind_opcodes(bind, bind + dyldInfo->bind_size, false)
+            + dp_count_bind_opcodes(weakBind, weakBind + dyldInfo->weak_bind_size, false)
+            + dp_count_bind_opcodes(lazyBind, lazyBind + dyldInfo->lazy_bind_size, true);
+
+        outStats->rebaseCount = rebaseCount > UINT32_MAX ? UINT32_MAX : (uint32_t)rebaseCount;
+        outStats->bindCount = bindCount > UINT32_MAX ? UINT32_MAX : (uint32_t)bindCount;
+        outStats->flags = DP_IMAGE_STATS_AVAILABLE;
+    } else if (chainedFixups != NULL) {
+        const struct dyld_chained_fixups_header* fixups =
+            (const struct dyld_chained_fixups_header*)(linkeditBase + chainedFixups->dataoff);
+        outStats->flags = DP_IMAGE_STATS_CHAINED_FIXUPS;
+        if (dp_darwin_count_chained_fixups(mh, path, fixups, segmentFileOffsets, segmentCount, outStats)) {
+            outStats->flags |= DP_IMAGE_STATS_AVAILABLE;
+        }
+    } else {
+        // 没有修正信息（如完全静态链接），段大小与初始化器数量仍然有效
+        outStats->flags = DP_IMAGE_STATS_AVAILABLE;
+    }
+}
+
+// MARK: - 启动采样
+
+/// 采样线程状态
+static pthread_t g_samplerThread;
+static atomic_bool g_samplerThreadRunning = false;
+static uint32_t g_samplerIntervalMicros = 0;
+
+/// 被采样的主线程及其栈范围
+static thread_act_t g_sampledThread = MACH_PORT_NULL;
+static uint64_t g_sampledThreadId = 0;
+static uintptr_t g_sampledStackLow = 0;
+static uintptr_t g_sampledStackHigh = 0;
+
+/// 采样线程：定时挂起主线程，读取寄存器并回溯栈后恢复
+/// 主线程挂起期间可能持有 malloc 等锁，此时只读取内存，不加锁、不分配
+static void* dp_darwin_sampler_main(void* context) {
+    (void)context;
+    pthread_setname_np("com.sunimp.debugprobe.launch-sampler");
+
+    while (atomic_load_explicit(&g_samplerThreadRunning, memory_order_acquire)) {
+        usleep(g_samplerIntervalMicros);
+        if (thread_suspend(g_sampledThread) != KERN_SUCCESS) {
+            break;
+        }
+
+#if defined(__arm64__)
+        arm_thread_state64_t state;
+        mach_msg_type_number_t count = ARM_THREAD_STATE64_COUNT;
+        if (thread_get_state(g_sampledThread, ARM_THREAD_STATE64, (thread_state_t)&state, &count) == KERN_SUCCESS) {
+            dp_launch_sampler_record((uintptr_t)arm_thread_state64_get_pc(state),
+                                     (uintptr_t)arm_thread_state64_get_fp(state),
+                                     g_sampledStackLow, g_sampledStackHigh, g_sampledThreadId, true);
+        }
+#elif defined(__x86_64__)
+        x86_thread_state64_t state;
+        mach_msg_type_number_t count = x86_THREAD_STATE64_COUNT;
+        if (thread_get_state(g_sampledThread, x86_THREAD_STATE64, (thread_state_t)&state, &count) == KERN_SUCCESS) {
+            dp_launch_sampler_record((uintptr_t)state.__rip, (uintptr_t)state.__rbp,
+                                     g_sampledStackLow, g_sampledStackHigh, g_sampledThreadId, true);
+        }
+#endif
+
+        thread_resume(g_sampledThread);
+    }
+    return NULL;
+}
+
+bool dp_platform_sampler_start(uint32_t intervalMicros) {
+#if !defined(__arm64__) && !defined(__x86_64__)
+    (void)intervalMicros;
+    return false;
+#else
+    // 需要在主线程上获取其 mach 端口与栈范围
+    if (pthread_main_np() == 0 || atomic_load(&g_samplerThreadRunning)) {
+        return false;
+    }
+
+    pthread_t mainThread = pthread_self();
+    g_sampledThread = pthread_mach_thread_np(mainThread);
+    g_sampledThreadId = dp_platform_thread_id();
+    g_sampledStackHigh = (uintptr_t)pthread_get_stackaddr_np(mainThread);
+    g_sampledStackLow = g_sampledStackHigh - pthread_get_stacksize_np(mainThread);
+    g_samplerIntervalMicros = intervalMicros;
+
+    atomic_store_explicit(&g_samplerThreadRunning, true, memory_order_release);
+    if (pthread_create(&g_samplerThread, NULL, dp_darwin_sampler_main, NULL) != 0) {
+        atomic_store_explicit(&g_samplerThreadRunning, false, memory_order_release);
+        return false;
+    }
+    return true;
+#endif
+}
+
+void dp_platform_sampler_stop(void) {
+    if (!atomic_exchange(&g_samplerThreadRunning, false)) {
+        return;
+    }
+    // 等待采样线程退出，确保返回后主线程不会再被挂起
+    pthread_join(g_samplerThread, NULL);
+}
+
+bool dp_platform_read_memory(uintptr_t address, void* buffer, size_t size) {
+    vm_size_t copied = 0;
+    kern_return_t result = vm_read_overwrite(mach_task_self(), (vm_address_t)address, (vm_size_t)size,
+                                             (vm_address_t)buffer, &copied);
+    return result == KERN_SUCCESS && copied == size;
+}
+
+// MARK: - 路径处理
+
+bool dp_platform_is_system_path(const char* path) {
+    if (path == NULL) return false;
+
+    // 系统库路径前缀
+    static const char* systemPrefixes[] = {
+        "/usr/lib/",
+        "/System/",
+        "/Library/Apple/",
+        "/private/var/db/dyld/",
+        "/AppleInternal/",
+        NULL
+    };
+
+    for (int i = 0; systemPrefixes[i] != NULL; i++) {
+        if (strncmp(path, systemPrefixes[i], strlen(systemPrefixes[i])) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// MARK: - dlopen / dlclose 挂接
+
+bool dp_platform_dlopen_hooks_installed(void) {
+#if DP_PREMAIN_DLOPEN_INTERPOSE
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if DP_PREMAIN_DLOPEN_INTERPOSE
+
+#if __has_feature(ptrauth_calls)
+#include <ptrauth.h>
+#endif
+
+/// dyld 私有接口：以指定调用地址解析 @rpath / @loader_path
+/// 直接在挂接函数中调用 dlopen 会以本镜像作为调用方，导致宿主镜像的 @rpath 查找失败
+typedef void* (*dp_dlopen_from_t)(const char* path, int mode, void* callerAddress);
+
+static void* dp_interposed_dlopen(const char* path, int mode) {
+    static dp_dlopen_from_t dlopenFrom = NULL;
+    static bool resolved = false;
+    if (!resolved) {
+        dlopenFrom = (dp_dlopen_from_t)dlsym(RTLD_DEFAULT, "dlopen_from");
+        resolved = true;
+    }
+
+    void* caller = __builtin_return_address(0);
+#if __has_feature(ptrauth_calls)
+    caller = ptrauth_strip(caller, ptrauth_key_return_address);
+#endif
+
+    // dyld 在调用线程上通知新镜像，入口时间同时作为本次带入的首个新镜像的加载起点
+    bool tracing = dp_dlopen_tracing_enabled();
+    uint64_t start = dp_dlopen_enter();
+    void* handle = dlopenFrom != NULL ? dlopenFrom(path, mode, caller) : dlopen(path, mode);
+    dp_dlopen_exit();
+    if (tracing) {
+        dp_dlopen_record(DPDlopenKindOpen, path, handle, start, mach_absolute_time(), handle != NULL);
+    }
+    return handle;
+}
+
+static int dp_interposed_dlclose(void* handle) {
+    if (!dp_dlopen_tracing_enabled()) {
+        return dlclose(handle);
+    }
+    uint64_t start = mach_absolute_time();
+    int result = dlclose(handle);
+    dp_dlopen_record(DPDlopenKindClose, NULL, handle, start, mach_absolute_time(), result == 0);
+    return result;
+}
+
+/// dyld 在绑定其他镜像时按此表替换符号（本镜像内的调用不受影响）
+__attribute__((used)) static const struct {
+    const void* replacement;
+    const void* original;
+} dp_dlopen_interposers[] __attribute__((section("__DATA,__interpose"))) = {
+    { (const void*)dp_interposed_dlopen, (const void*)dlopen },
+    { (const void*)dp_interposed_dlclose, (const void*)dlclose },
+};
+
+#endif /* DP_PREMAIN_DLOPEN_INTERPOSE */
+
+#endif /* __APPLE__ */
@@ -0,0 +1,924 @@
+//
+//  DPPreMainPlatformLinux.c
+//  DebugProbe
+//
+//  PreMain 监控平台层：Linux 实现
+//  clock_gettime(CLOCK_MONOTONIC_RAW) + dl_iterate_phdr + /proc/self/stat
+//
+//  镜像加载通知说明：
+//  1. 注册时通过 dl_iterate_phdr 对已加载的对象逐个回调
+//  2. 之后的 dlopen 通过 __wrap_dlopen 钩子实时补扫（需以 -Wl,--wrap=dlopen 链接），同时可记录 dlopen / dlclose 阻塞耗时
+//  3. 未挂接钩子时，查询路径调用 dp_platform_poll_images 补扫，此时时间戳为补扫时间
+//  LD_AUDIT 审计库运行在独立的链接命名空间中，无法写入本模块的全局数据，因此采用链接期包装
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#if defined(__linux__)
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "DPPreMainInternal.h"
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <link.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+// MARK: - 全局数据
+
+/// 核心模块注册的镜像加载回调
+static dp_image_added_callback_t g_imageAddedCallback = NULL;
+
+/// 补扫互斥锁（dl_iterate_phdr 期间持有）
+static pthread_mutex_t g_scanMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/// 已通知的镜像头地址集合（开放寻址，NULL 表示空位）
+static const void** g_seenHeaders = NULL;
+static size_t g_seenCapacity = 0;
+static size_t g_seenCount = 0;
+
+/// 上次补扫时的 dlpi_adds / dlpi_subs，未变化时跳过遍历
+static unsigned long long g_lastAdds = 0;
+static unsigned long long g_lastSubs = 0;
+
+// MARK: - 时钟
+
+uint64_t dp_platform_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void dp_platform_timebase(uint32_t* outNumer, uint32_t* outDenom) {
+    // 时钟计数即纳秒
+    *outNumer = 1;
+    *outDenom = 1;
+}
+
+// MARK: - 线程
+
+uint64_t dp_platform_thread_id(void) {
+    return (uint64_t)syscall(SYS_gettid);
+}
+
+bool dp_platform_is_main_thread(void) {
+    // 主线程的线程 ID 与进程 ID 相同
+    return (pid_t)syscall(SYS_gettid) == getpid();
+}
+
+// MARK: - 缓存目录
+
+size_t dp_platform_cache_directory(char* buffer, size_t bufferSize) {
+    const char* xdgCacheHome = getenv("XDG_CACHE_HOME");
+    int length;
+    if (xdgCacheHome != NULL && xdgCacheHome[0] == '/') {
+        length = snprintf(buffer, bufferSize, "%s", xdgCacheHome);
+    } else {
+        const char* home = getenv("HOME");
+        if (home == NULL || home[0] == '\0') {
+            return 0;
+        }
+        length = snprintf(buffer, bufferSize, "%s/.cache", home);
+    }
+    return length > 0 && (size_t)length < bufferSize ? (size_t)length : 0;
+}
+
+size_t dp_platform_executable_path(char* buffer, size_t bufferSize) {
+    if (bufferSize < 2) {
+        return 0;
+    }
+    ssize_t length = readlink("/proc/self/exe", buffer, bufferSize - 1);
+    if (length <= 0 || (size_t)length >= bufferSize - 1) {
+        return 0;
+    }
+    buffer[length] = '\0';
+    return (size_t)length;
+}
+
+// MARK: - 进程启动时间
+
+/// 读取整个小文件到缓冲区（/proc 文件不支持 stat 获取大小）
+static ssize_t dp_read_small_file(const char* path, char* buffer, size_t bufferSize) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    size_t total = 0;
+    while (total < bufferSize - 1) {
+        ssize_t n = read(fd, buffer + total, bufferSize - 1 - total);
+        if (n <= 0) break;
+        total += (size_t)n;
+    }
+    close(fd);
+
+    buffer[total] = '\0';
+    return (ssize_t)total;
+}
+
+/// 读取 /proc/self/stat 中的 starttime（开机以来的时钟滴答数）
+static bool dp_read_process_start_ticks(unsigned long long* outTicks) {
+    char buffer[1024];
+    if (dp_read_small_file("/proc/self/stat", buffer, sizeof(buffer)) <= 0) {
+        return false;
+    }
+
+    // comm 字段可能包含空格和括号，从最后一个 ')' 之后开始解析
+    const char* cursor = strrchr(buffer, ')');
+    if (cursor == NULL) {
+        return false;
+    }
+    cursor++;
+
+    // ')' 之后依次为第 3 个字段（state）起，starttime 为第 22 个字段
+    for (int field = 3; field < 22; field++) {
+        while (*cursor == ' ') cursor++;
+        while (*cursor != ' ' && *cursor != '\0') cursor++;
+        if (*cursor == '\0') {
+            return false;
+        }
+    }
+
+    char* end = NULL;
+    *outTicks = strtoull(cursor, &end, 10);
+    return end != cursor;
+}
+
+/// 读取 /proc/stat 中的 btime（开机时间，Unix 秒）
+static bool dp_read_boot_time(unsigned long long* outBootTime) {
+    char buffer[8192];
+    if (dp_read_small_file("/proc/stat", buffer, sizeof(buffer)) <= 0) {
+        return false;
+    }
+
+    const char* line = strstr(buffer, "\nbtime ");
+    if (line == NULL) {
+        return false;
+    }
+
+    char* end = NULL;
+    *outBootTime = strtoull(line + 7, &end, 10);
+    return end != line + 7;
+}
+
+/// 通过 /proc 获取进程启动时间（Unix 时间戳，微秒）
+uint64_t dp_platform_process_start_unix_micros(void) {
+    unsigned long long startTicks = 0;
+    unsigned long long bootTime = 0;
+    long ticksPerSecond = sysconf(_SC_CLK_TCK);
+
+    if (ticksPerSecond <= 0 || !dp_read_process_start_ticks(&startTicks) || !dp_read_boot_time(&bootTime)) {
+        return 0;
+    }
+
+    return (uint64_t)bootTime * 1000000ull + (uint64_t)startTicks * 1000000ull / (uint64_t)ticksPerSecond;
+}
+
+/// 将 starttime 对齐到 CLOCK_MONOTONIC_RAW
+/// starttime 为 CLOCK_BOOTTIME 下取整到滴答的值，真实启动时刻位于 [ticks, ticks + 1) 个滴答之间，取中点
+bool dp_platform_process_start_nanos(uint64_t* outStartNanos, uint64_t* outErrorNanos) {
+    unsigned long long startTicks = 0;
+    long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    int64_t offsetNanos = 0;
+    uint64_t alignErrorNanos = 0;
+
+    if (ticksPerSecond <= 0 || !dp_read_process_start_ticks(&startTicks) ||
+        !dp_clock_align(CLOCK_BOOTTIME, &offsetNanos, &alignErrorNanos)) {
+        return false;
+    }
+
+    uint64_t tickNanos = 1000000000ull / (uint64_t)ticksPerSecond;
+    int64_t startNanos = (int64_t)(startTicks * tickNanos + tickNanos / 2) - offsetNanos;
+    if (startNanos <= 0) {
+        return false;
+    }
+    *outStartNanos = (uint64_t)startNanos;
+    *outErrorNanos = tickNanos / 2 + alignErrorNanos;
+    return true;
+}
+
+// MARK: - 已通知镜像集合
+
+/// 指针哈希
+static size_t dp_pointer_hash(const void* pointer) {
+    uint64_t value = (uint64_t)(uintptr_t)pointer;
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    return (size_t)value;
+}
+
+/// 查询或插入镜像头地址
+/// @return 已存在返回 true，新插入返回 false
+static bool dp_seen_headers_insert(const void* header) {
+    if ((g_seenCount + 1) * 2 > g_seenCapacity) {
+        size_t newCapacity = g_seenCapacity == 0 ? 256 : g_seenCapacity * 2;
+        const void** newTable = calloc(newCapacity, sizeof(const void*));
+        if (newTable == NULL) {
+            // 内存不足时按已存在处理，避免重复回调
+            return true;
+        }
+        for (size_t i = 0; i < g_seenCapacity; i++) {
+            if (g_seenHeaders[i] == NULL) continue;
+            size_t slot = dp_pointer_hash(g_seenHeaders[i]) & (newCapacity - 1);
+            while (newTable[slot] != NULL) {
+                slot = (slot + 1) & (newCapacity - 1);
+            }
+            newTable[slot] = g_seenHeaders[i];
+        }
+        free(g_seenHeaders);
+        g_seenHeaders = newTable;
+        g_seenCapacity = newCapacity;
+    }
+
+    size_t slot = dp_pointer_hash(header) & (g_seenCapacity - 1);
+    while (g_seenHeaders[slot] != NULL) {
+        if (g_seenHeaders[slot] == header) {
+            return true;
+        }
+        slot = (slot + 1) & (g_seenCapacity - 1);
+    }
+    g_seenHeaders[slot] = header;
+    g_seenCount++;
+    return false;
+}
+
+// MARK: - 镜像加载通知
+
+/// 计算对象的 ELF 头地址（文件偏移为 0 的 PT_LOAD 段）
+static const void* dp_elf_header_address(const struct dl_phdr_info* info) {
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)* phdr = &info->dlpi_phdr[i];
+        if (phdr->p_type == PT_LOAD && phdr->p_offset == 0) {
+            return (const void*)(info->dlpi_addr + phdr->p_vaddr);
+        }
+    }
+    return (const void*)info->dlpi_addr;
+}
+
+/// dl_iterate_phdr 遍历回调：对未通知过的对象发起回调
+static int dp_linux_scan_object(struct dl_phdr_info* info, size_t size, void* context) {
+    (void)context;
+
+    if (size >= offsetof(struct dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs)) {
+        g_lastAdds = info->dlpi_adds;
+        g_lastSubs = info->dlpi_subs;
+    }
+
+    const void* header = dp_elf_header_address(info);
+    if (!dp_seen_headers_insert(header)) {
+        g_imageAddedCallback(header, (intptr_t)info->dlpi_addr);
+    }
+    return 0;
+}
+
+/// dl_iterate_phdr 预检回调：只读取 dlpi_adds / dlpi_subs
+static int dp_linux_read_counters(struct dl_phdr_info* info, size_t size, void* context) {
+    unsigned long long* counters = context;
+    if (size >= offsetof(struct dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs)) {
+        counters[0] = info->dlpi_adds;
+        counters[1] = info->dlpi_subs;
+    }
+    return 1;
+}
+
+void dp_platform_register_image_callback(dp_image_added_callback_t callback) {
+    pthread_mutex_lock(&g_scanMutex);
+    g_imageAddedCallback = callback;
+    dl_iterate_phdr(dp_linux_scan_object, NULL);
+    pthread_mutex_unlock(&g_scanMutex);
+}
+
+void dp_platform_poll_images(void) {
+    pthread_mutex_lock(&g_scanMutex);
+
+    if (g_imageAddedCallback != NULL) {
+        unsigned long long counters[2] = { 0, 0 };
+        dl_iterate_phdr(dp_linux_read_counters, counters);
+
+        // 计数未变化时跳过遍历；libc 未提供计数（恒为 0）时每次完整遍历
+        // 注意：按头地址去重，对象卸载后同一地址加载的新对象不会再次回调
+        bool changed = counters[0] != g_lastAdds || counters[1] != g_lastSubs || counters[0] == 0;
+        if (changed) {
+            dl_iterate_phdr(dp_linux_scan_object, NULL);
+        }
+    }
+
+    pthread_mutex_unlock(&g_scanMutex);
+}
+
+/// 钩子是否被调用过（本模块以共享库提供、由宿主程序以 --wrap 链接时，本文件内的 dlopen 引用不会被替换）
+static atomic_bool g_dlopenHookEntered = false;
+
+/// dlopen 钩子（以 -Wl,--wrap=dlopen 链接时生效）
+/// 调用真实 dlopen 后立即补扫，新镜像以 dlopen 入口为加载起点；开启计时时同时记录阻塞耗时
+void* __wrap_dlopen(const char* filename, int flags);
+void* __wrap_dlopen(const char* filename, int flags) {
+    static void* (*realDlopen)(const char*, int) = NULL;
+    if (realDlopen == NULL) {
+        realDlopen = (void* (*)(const char*, int))dlsym(RTLD_NEXT, "dlopen");
+    }
+    atomic_store_explicit(&g_dlopenHookEntered, true, memory_order_relaxed);
+
+    bool tracing = dp_dlopen_tracing_enabled();
+    // 入口时间同时作为本次带入的首个新镜像的加载起点（补扫在同一线程进行）
+    uint64_t start = dp_dlopen_enter();
+    void* handle = realDlopen(filename, flags);
+    uint64_t end = tracing ? dp_platform_now() : 0;
+
+    if (handle != NULL) {
+        dp_platform_poll_images();
+    }
+    dp_dlopen_exit();
+    if (tracing) {
+        dp_dlopen_record(DPDlopenKindOpen, filename, handle, start, end, handle != NULL);
+    }
+    return handle;
+}
+
+/// dlclose 钩子（以 -Wl,--wrap=dlclose 链接时生效），仅在开启计时时记录耗时
+int __wrap_dlclose(void* handle);
+int __wrap_dlclose(void* handle) {
+    static int (*realDlclose)(void*) = NULL;
+    if (realDlclose == NULL) {
+        realDlclose = (int (*)(void*))dlsym(RTLD_NEXT, "dlclose");
+    }
+
+    if (!dp_dlopen_tracing_enabled()) {
+        return realDlclose(handle);
+    }
+    uint64_t start = dp_platform_now();
+    int result = realDlclose(handle);
+    dp_dlopen_record(DPDlopenKindClose, NULL, handle, start, dp_platform_now(), result == 0);
+    return result;
+}
+
+bool dp_platform_dlopen_hooks_installed(void) {
+    // 与本文件同一次链接指定了 --wrap=dlopen 时，这里对 dlopen 的引用会被解析为 __wrap_dlopen
+    // 经 volatile 读取，避免编译器假定两个不同符号的地址必然不等
+    void* (*volatile linked)(const char*, int) = dlopen;
+    return (void*)linked == (void*)__wrap_dlopen
+        || atomic_load_explicit(&g_dlopenHookEntered, memory_order_relaxed);
+}
+
+// MARK: - 静态初始化器表
+
+/// 动态段地址：glibc 已按加载偏移重定位，部分 libc（如 musl）保留链接地址，需补加偏移
+static uintptr_t dp_elf_dynamic_address(uintptr_t loadBias, ElfW(Addr) value) {
+    return value < loadBias ? loadBias + value : value;
+}
+
+/// dl_iterate_phdr 遍历回调：解析 PT_DYNAMIC 中的 DT_INIT_ARRAY / DT_INIT
+static int dp_linux_visit_initializers(struct dl_phdr_info* info, size_t size, void* context) {
+    (void)size;
+    void** visitorContext = context;
+    dp_initializer_table_visitor_t visitor = (dp_initializer_table_visitor_t)visitorContext[0];
+
+    const ElfW(Dyn)* dynamic = NULL;
+    uintptr_t relroStart = 0;
+    uintptr_t relroEnd = 0;
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)* phdr = &info->dlpi_phdr[i];
+        if (phdr->p_type == PT_DYNAMIC) {
+            dynamic = (const ElfW(Dyn)*)(info->dlpi_addr + phdr->p_vaddr);
+        } else if (phdr->p_type == PT_GNU_RELRO) {
+            relroStart = info->dlpi_addr + phdr->p_vaddr;
+            relroEnd = relroStart + phdr->p_memsz;
+        }
+    }
+    if (dynamic == NULL) {
+        return 0;
+    }
+
+    uintptr_t initArray = 0;
+    size_t initArrayBytes = 0;
+    uint32_t untimedCount = 0;
+    for (const ElfW(Dyn)* entry = dynamic; entry->d_tag != DT_NULL; entry++) {
+        if (entry->d_tag == DT_INIT_ARRAY) {
+            initArray = dp_elf_dynamic_address(info->dlpi_addr, entry->d_un.d_ptr);
+        } else if (entry->d_tag == DT_INIT_ARRAYSZ) {
+            initArrayBytes = entry->d_un.d_val;
+        } else if (entry->d_tag == DT_INIT) {
+            // 旧式 _init 由动态链接器直接调用，不经过可替换的表
+            untimedCount++;
+        }
+    }
+
+    size_t count = initArray != 0 ? initArrayBytes / sizeof(void*) : 0;
+    if (count == 0 && untimedCount == 0) {
+        return 0;
+    }
+
+    // RELRO 区域在重定位完成后被设为只读
+    bool isReadOnly = initArray >= relroStart && initArray < relroEnd;
+    visitor(dp_elf_header_address(info), info->dlpi_name != NULL ? info->dlpi_name : "",
+            count > 0 ? (void**)initArray : NULL, count, isReadOnly, untimedCount, visitorContext[1]);
+    return 0;
+}
+
+void dp_platform_enumerate_initializer_tables(dp_initializer_table_visitor_t visitor, void* context) {
+    void* visitorContext[2] = { (void*)visitor, context };
+    dl_iterate_phdr(dp_linux_visit_initializers, visitorContext);
+}
+
+/// dl_iterate_phdr 查找上下文：按镜像头地址定位对象
+typedef struct {
+    const void* header;
+    struct dl_phdr_info info;
+    bool found;
+    bool isFirst;
+} DPLinuxObjectLookup;
+
+/// dl_iterate_phdr 遍历回调：定位 header 对应的对象（首个对象为主程序）
+static int dp_linux_find_object(struct dl_phdr_info* info, size_t size, void* context) {
+    (void)size;
+    DPLinuxObjectLookup* lookup = context;
+    if (dp_elf_header_address(info) != lookup->header) {
+        lookup->isFirst = false;
+        return 0;
+    }
+    lookup->info = *info;
+    lookup->found = true;
+    return 1;
+}
+
+/// 按镜像头地址定位对象
+static bool dp_linux_lookup_object(const void* header, DPLinuxObjectLookup* lookup) {
+    memset(lookup, 0, sizeof(*lookup));
+    lookup->header = header;
+    lookup->isFirst = true;
+    dl_iterate_phdr(dp_linux_find_object, lookup);
+    return lookup->found;
+}
+
+void dp_platform_visit_image_initializers(const void* header, dp_initializer_table_visitor_t visitor, void* context) {
+    DPLinuxObjectLookup lookup;
+    if (!dp_linux_lookup_object(header, &lookup)) {
+        return;
+    }
+    void* visitorContext[2] = { (void*)visitor, context };
+    dp_linux_visit_initializers(&lookup.info, sizeof(lookup.info), visitorContext);
+}
+
+/// 对象的动态段与字符串表
+static const ElfW(Dyn)* dp_linux_dynamic(const struct dl_phdr_info* info, const char** outStrtab) {
+    const ElfW(Dyn)* dynamic = NULL;
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; i++) {
+        if (info->dlpi_phdr[i].p_type == PT_DYNAMIC) {
+            dynamic = (const ElfW(Dyn)*)(info->dlpi_addr + info->dlpi_phdr[i].p_vaddr);
+            break;
+        }
+    }
+    *outStrtab = NULL;
+    if (dynamic == NULL) {
+        return NULL;
+    }
+    for (const ElfW(Dyn)* entry = dynamic; entry->d_tag != DT_NULL; entry++) {
+        if (entry->d_tag == DT_STRTAB) {
+            *outStrtab = (const char*)dp_elf_dynamic_address(info->dlpi_addr, entry->d_un.d_ptr);
+        }
+    }
+    return *outStrtab != NULL ? dynamic : NULL;
+}
+
+bool dp_platform_image_depends_on(const void* header, const void* dependency) {
+    DPLinuxObjectLookup object;
+    DPLinuxObjectLookup target;
+    if (!dp_linux_lookup_object(header, &object) || !dp_linux_lookup_object(dependency, &target)) {
+        return false;
+    }
+
+    // DT_NEEDED 记录的是依赖的 DT_SONAME（没有时为链接时的文件名）
+    const char* targetStrtab = NULL;
+    const ElfW(Dyn)* targetDynamic = dp_linux_dynamic(&target.info, &targetStrtab);
+    const char* targetName = NULL;
+    for (const ElfW(Dyn)* entry = targetDynamic; entry != NULL && entry->d_tag != DT_NULL; entry++) {
+        if (entry->d_tag == DT_SONAME) {
+            targetName = targetStrtab + entry->d_un.d_val;
+            break;
+        }
+    }
+    if (targetName == NULL) {
+        const char* path = target.info.dlpi_name != NULL ? target.info.dlpi_name : "";
+        const char* slash = strrchr(path, '/');
+        targetName = slash != NULL ? slash + 1 : path;
+    }
+    if (targetName[0] == '\0') {
+        return false;
+    }
+
+    const char* strtab = NULL;
+    const ElfW(Dyn)* dynamic = dp_linux_dynamic(&object.info, &strtab);
+    for (const ElfW(Dyn)* entry = dynamic; entry != NULL && entry->d_tag != DT_NULL; entry++) {
+        if (entry->d_tag == DT_NEEDED && strcmp(strtab + entry->d_un.d_val, targetName) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool dp_platform_is_main_executable(const void* header) {
+    DPLinuxObjectLookup lookup;
+    return dp_linux_lookup_object(header, &lookup) && lookup.isFirst;
+}
+
+// MARK: - 可执行段与符号
+
+/// 主程序路径（dl_iterate_phdr 中主程序名称为空字符串）
+static const char* dp_linux_executable_path(void) {
+    static char path[PATH_MAX];
+    if (path[0] == '\0') {
+        ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+        if (length <= 0) {
+            return "/proc/self/exe";
+        }
+        path[length] = '\0';
+    }
+    return path;
+}
+
+/// dl_iterate_phdr 遍历回调：逐个报告带 PF_X 的 PT_LOAD 段
+static int dp_linux_visit_text_segments(struct dl_phdr_info* info, size_t size, void* context) {
+    (void)size;
+    void** visitorContext = context;
+    dp_text_segment_visitor_t visitor = (dp_text_segment_visitor_t)visitorContext[0];
+
+    const char* path = info->dlpi_name != NULL && info->dlpi_name[0] != '\0'
+        ? info->dlpi_name
+        : dp_linux_executable_path();
+    const void* header = dp_elf_header_address(info);
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)* phdr = &info->dlpi_phdr[i];
+        if (phdr->p_type == PT_LOAD && (phdr->p_flags & PF_X) != 0) {
+            visitor(header, path, info->dlpi_addr + phdr->p_vaddr, phdr->p_memsz, visitorContext[1]);
+        }
+    }
+    return 0;
+}
+
+void dp_platform_enumerate_text_segments(dp_text_segment_visitor_t visitor, void* context) {
+    void* visitorContext[2] = { (void*)visitor, context };
+    dl_iterate_phdr(dp_linux_visit_text_segments, visitorContext);
+}
+
+/// 在映射的 ELF 文件中查找指定类型的符号表
+static const ElfW(Shdr)* dp_elf_find_section(const ElfW(Shdr)* sections, ElfW(Half) count, ElfW(Word) type) {
+    for (ElfW(Half) i = 0; i < count; i++) {
+        if (sections[i].sh_type == type) {
+            return &sections[i];
+        }
+    }
+    return NULL;
+}
+
+bool dp_platform_enumerate_function_symbols(const void* header, const char* path,
+                                            dp_symbol_visitor_t visitor, void* context) {
+    // 运行时地址 = 加载偏移 + 符号值；加载偏移由内存中的程序头推算
+    const ElfW(Ehdr)* loadedHeader = header;
+    const ElfW(Phdr)* loadedPhdrs = (const ElfW(Phdr)*)((uintptr_t)header + loadedHeader->e_phoff);
+    uintptr_t loadBias = (uintptr_t)header;
+    for (ElfW(Half) i = 0; i < loadedHeader->e_phnum; i++) {
+        if (loadedPhdrs[i].p_type == PT_LOAD && loadedPhdrs[i].p_offset == 0) {
+            loadBias = (uintptr_t)header - loadedPhdrs[i].p_vaddr;
+            break;
+        }
+    }
+
+    // 节头表与 .symtab 不在加载段中，需读取磁盘文件
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || (size_t)fileStat.st_size < sizeof(ElfW(Ehdr))) {
+        close(fd);
+        return false;
+    }
+    size_t fileSize = (size_t)fileStat.st_size;
+    const uint8_t* file = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED) {
+        return false;
+    }
+
+    bool found = false;
+    const ElfW(Ehdr)* ehdr = (const ElfW(Ehdr)*)file;
+    if (memcmp(ehdr->e_ident, ELFMAG, SELFMAG) == 0 &&
+        ehdr->e_shentsize == sizeof(ElfW(Shdr)) &&
+        ehdr->e_shoff + (size_t)ehdr->e_shnum * sizeof(ElfW(Shdr)) <= fileSize) {
+        const ElfW(Shdr)* sections = (const ElfW(Shdr)*)(file + ehdr->e_shoff);
+        const ElfW(Shdr)* symtab = dp_elf_find_section(sections, ehdr->e_shnum, SHT_SYMTAB);
+        if (symtab == NULL) {
+            symtab = dp_elf_find_section(sections, ehdr->e_shnum, SHT_DYNSYM);
+        }
+
+        if (symtab != NULL && symtab->sh_link < ehdr->e_shnum &&
+            symtab->sh_offset + symtab->sh_size <= fileSize) {
+            const ElfW(Shdr)* strtab = &sections[symtab->sh_link];
+            if (strtab->sh_offset + strtab->sh_size <= fileSize) {
+                const ElfW(Sym)* symbols = (const ElfW(Sym)*)(file + symtab->sh_offset);
+                const char* strings = (const char*)(file + strtab->sh_offset);
+                size_t symbolCount = symtab->sh_size / sizeof(ElfW(Sym));
+                for (size_t i = 0; i < symbolCount; i++) {
+                    const ElfW(Sym)* symbol = &symbols[i];
+                    // ELF32_ST_TYPE 与 ELF64_ST_TYPE 定义相同
+                    if (ELF64_ST_TYPE(symbol->st_info) != STT_FUNC || symbol->st_shndx == SHN_UNDEF ||
+                        symbol->st_value == 0 || symbol->st_name == 0 || symbol->st_name >= strtab->sh_size) {
+                        continue;
+                    }
+                    // 名称须在字符串表内以 NUL 结尾
+                    const char* name = strings + symbol->st_name;
+                    if (memchr(name, '\0', strtab->sh_size - symbol->st_name) == NULL) {
+                        continue;
+                    }
+                    visitor(name, loadBias + symbol->st_value, symbol->st_size, context);
+                }
+                found = true;
+            }
+        }
+    }
+
+    munmap((void*)file, fileSize);
+    return found;
+}
+
+// MARK: - 镜像静态统计
+
+#ifndef DT_RELRSZ
+#define DT_RELRSZ 35
+#define DT_RELR 36
+#endif
+
+#if __SIZEOF_POINTER__ == 8
+#define DP_ELF_R_TYPE(info) ELF64_R_TYPE(info)
+#else
+#define DP_ELF_R_TYPE(info) ELF32_R_TYPE(info)
+#endif
+
+/// 只需加载偏移、不涉及符号查找的重定位类型（对应 Mach-O 的 rebase）
+static bool dp_elf_is_relative_relocation(uint32_t type) {
+#if defined(__x86_64__)
+    return type == R_X86_64_RELATIVE || type == R_X86_64_RELATIVE64;
+#elif defined(__aarch64__)
+    return type == R_AARCH64_RELATIVE;
+#elif defined(__i386__)
+    return type == R_386_RELATIVE;
+#elif defined(__arm__)
+    return type == R_ARM_RELATIVE;
+#elif defined(__riscv)
+    return type == R_RISCV_RELATIVE;
+#else
+    (void)type;
+    return false;
+#endif
+}
+
+/// 统计 REL / RELA 表中的 rebase 与 bind 数量
+static void dp_elf_count_relocations(uintptr_t table, size_t tableBytes, bool isRela, DPImageStats* stats) {
+    if (table == 0 || tableBytes == 0) {
+        return;
+    }
+    size_t entrySize = isRela ? sizeof(ElfW(Rela)) : sizeof(ElfW(Rel));
+    for (size_t offset = 0; offset + entrySize <= tableBytes; offset += entrySize) {
+        // Rela 以 Rel 的字段开头，r_info 偏移相同
+        const ElfW(Rel)* relocation = (const ElfW(Rel)*)(table + offset);
+        if (dp_elf_is_relative_relocation((uint32_t)DP_ELF_R_TYPE(relocation->r_info))) {
+            stats->rebaseCount++;
+        } else {
+            stats->bindCount++;
+        }
+    }
+}
+
+void dp_platform_image_stats(const void* header, const char* path, DPImageStats* outStats) {
+    (void)path;
+    memset(outStats, 0, sizeof(*outStats));
+    if (header == NULL) {
+        return;
+    }
+
+    // 程序头与动态段都在加载段中，直接读取内存，无需打开文件
+    const ElfW(Ehdr)* ehdr = header;
+    if (memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 || ehdr->e_phentsize != sizeof(ElfW(Phdr))) {
+        return;
+    }
+    const ElfW(Phdr)* phdrs = (const ElfW(Phdr)*)((uintptr_t)header + ehdr->e_phoff);
+    uintptr_t loadBias = (uintptr_t)header;
+    const ElfW(Phdr)* dynamicPhdr = NULL;
+    for (ElfW(Half) i = 0; i < ehdr->e_phnum; i++) {
+        const ElfW(Phdr)* phdr = &phdrs[i];
+        if (phdr->p_type == PT_LOAD) {
+            if (phdr->p_offset == 0) {
+                loadBias = (uintptr_t)header - phdr->p_vaddr;
+            }
+            if ((phdr->p_flags & PF_X) != 0) {
+                outStats->textSize += phdr->p_memsz;
+            } else if ((phdr->p_flags & PF_W) != 0) {
+                outStats->dataSize += phdr->p_memsz;
+            }
+        } else if (phdr->p_type == PT_DYNAMIC) {
+            dynamicPhdr = phdr;
+        }
+    }
+
+    if (dynamicPhdr != NULL) {
+        uintptr_t rela = 0, rel = 0, relr = 0, jmprel = 0;
+        size_t relaBytes = 0, relBytes = 0, relrBytes = 0, jmprelBytes = 0;
+        bool jmprelIsRela = sizeof(void*) == 8;
+        const ElfW(Dyn)* dynamic = (const ElfW(Dyn)*)(loadBias + dynamicPhdr->p_vaddr);
+        for (const ElfW(Dyn)* entry = dynamic; entry->d_tag != DT_NULL; entry++) {
+            switch (entry->d_tag) {
+                case DT_RELA: rela = dp_elf_dynamic_address(loadBias, entry->d_un.d_ptr); break;
+                case DT_RELASZ: relaBytes = entry->d_un.d_val; break;
+                case DT_REL: rel = dp_elf_dynamic_address(loadBias, entry->d_un.d_ptr); break;
+                case DT_RELSZ: relBytes = entry->d_un.d_val; break;
+                case DT_RELR: relr = dp_elf_dynamic_address(loadBias, entry->d_un.d_ptr); break;
+                case DT_RELRSZ: relrBytes = entry->d_un.d_val; break;
+                case DT_JMPREL: jmprel = dp_elf_dynamic_address(loadBias, entry->d_un.d_ptr); break;
+                case DT_PLTRELSZ: jmprelBytes = entry->d_un.d_val; break;
+                case DT_PLTREL: jmprelIsRela = entry->d_un.d_val == DT_RELA; break;
+                case DT_INIT: outStats->initializerCount++; break;
+                case DT_INIT_ARRAYSZ: outStats->initializerCount += (uint32_t)(entry->d_un.d_val / sizeof(void*)); break;
+                case DT_PREINIT_ARRAYSZ: outStats->initializerCount += (uint32_t)(entry->d_un.d_val / sizeof(void*)); break;
+                default: break;
+            }
+        }
+
+        dp_elf_count_relocations(rela, relaBytes, true, outStats);
+        dp_elf_count_relocations(rel, relBytes, false, outStats);
+        // PLT 重定位都需要符号查找（含延迟绑定）
+        dp_elf_count_relocations(jmprel, jmprelBytes, jmprelIsRela, outStats);
+
+        // RELR：偶数项为一个地址，奇数项为位图，除最低位外每个置位对应一个重定位
+        if (relr != 0) {
+            const ElfW(Addr)* entries = (const ElfW(Addr)*)relr;
+            for (size_t i = 0; i < relrBytes / sizeof(ElfW(Addr)); i++) {
+                outStats->rebaseCount += (entries[i] & 1) == 0 ? 1 : (uint32_t)__builtin_popcountll(entries[i]) - 1;
+            }
+        }
+    }
+
+    outStats->flags = DP_IMAGE_STATS_AVAILABLE;
+}
+
+// MARK: - 启动采样
+
+#if defined(__x86_64__) || defined(__aarch64__)
+
+/// 安装前的 SIGPROF 处理方式（停止时若为自定义处理函数则恢复）
+static struct sigaction g_previousSigprofAction;
+static bool g_sigprofHandlerInstalled = false;
+
+/// 主线程的栈范围（在主线程上开始采样时读取，否则为 0，主线程与其他线程一样逐帧以 process_vm_readv 读取）
+static uintptr_t g_mainStackLow = 0;
+static uintptr_t g_mainStackHigh = 0;
+
+/// SIGPROF 处理函数：从被打断的上下文读取 pc / fp
+static void dp_linux_sigprof_handler(int signal, siginfo_t* info, void* context) {
+    (void)signal;
+    (void)info;
+    int savedErrno = errno;
+
+    const ucontext_t* ucontext = context;
+#if defined(__x86_64__)
+    uintptr_t pc = (uintptr_t)ucontext->uc_mcontext.gregs[REG_RIP];
+    uintptr_t fp = (uintptr_t)ucontext->uc_mcontext.gregs[REG_RBP];
+#else
+    uintptr_t pc = (uintptr_t)ucontext->uc_mcontext.pc;
+    uintptr_t fp = (uintptr_t)ucontext->uc_mcontext.regs[29];
+#endif
+    pid_t tid = (pid_t)syscall(SYS_gettid);
+    bool isMainThread = tid == getpid();
+    dp_launch_sampler_record(pc, fp, isMainThread ? g_mainStackLow : 0, isMainThread ? g_mainStackHigh : 0,
+                             (uint64_t)tid, isMainThread);
+
+    errno = savedErrno;
+}
+
+bool dp_platform_sampler_start(uint32_t intervalMicros) {
+    // 主线程栈范围：glibc 按 RLIMIT_STACK 计算主线程栈的最低地址，范围内尚未映射的部分由内核按需扩展
+    if (dp_platform_is_main_thread() && g_mainStackHigh == 0) {
+        pthread_attr_t attributes;
+        if (pthread_getattr_np(pthread_self(), &attributes) == 0) {
+            void* stackAddress = NULL;
+            size_t stackSize = 0;
+            if (pthread_attr_getstack(&attributes, &stackAddress, &stackSize) == 0 && stackAddress != NULL) {
+                g_mainStackLow = (uintptr_t)stackAddress;
+                g_mainStackHigh = (uintptr_t)stackAddress + stackSize;
+            }
+            pthread_attr_destroy(&attributes);
+        }
+    }
+
+    if (!g_sigprofHandlerInstalled) {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = dp_linux_sigprof_handler;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, &g_previousSigprofAction) != 0) {
+            return false;
+        }
+        g_sigprofHandlerInstalled = true;
+    }
+
+    // ITIMER_PROF 按进程 CPU 时间（用户态 + 内核态）计时，到期时向正在运行的线程发送 SIGPROF
+    struct itimerval timer = {
+        .it_interval = { .tv_sec = intervalMicros / 1000000, .tv_usec = intervalMicros % 1000000 },
+        .it_value = { .tv_sec = intervalMicros / 1000000, .tv_usec = intervalMicros % 1000000 },
+    };
+    return setitimer(ITIMER_PROF, &timer, NULL) == 0;
+}
+
+void dp_platform_sampler_stop(void) {
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, NULL);
+
+    // 原处理方式为默认动作（终止进程）时保留本处理函数，以吸收停止前已发出但尚未递送的 SIGPROF
+    bool previousIsDefault = (g_previousSigprofAction.sa_flags & SA_SIGINFO) == 0 &&
+                             g_previousSigprofAction.sa_handler == SIG_DFL;
+    if (g_sigprofHandlerInstalled && !previousIsDefault) {
+        sigaction(SIGPROF, &g_previousSigprofAction, NULL);
+        g_sigprofHandlerInstalled = false;
+    }
+}
+
+#else
+
+bool dp_platform_sampler_start(uint32_t intervalMicros) {
+    (void)intervalMicros;
+    return false;
+}
+
+void dp_platform_sampler_stop(void) {
+}
+
+#endif
+
+/// 内核禁止 process_vm_readv（如 seccomp 过滤）后不再尝试
+static atomic_bool g_processVmReadvUnavailable = false;
+
+bool dp_platform_read_memory(uintptr_t address, void* buffer, size_t size) {
+    if (atomic_load_explicit(&g_processVmReadvUnavailable, memory_order_relaxed)) {
+        return false;
+    }
+    struct iovec local = { .iov_base = buffer, .iov_len = size };
+    struct iovec remote = { .iov_base = (void*)address, .iov_len = size };
+    int savedErrno = errno;
+    ssize_t copied = process_vm_readv(getpid(), &local, 1, &remote, 1, 0);
+    if (copied < 0 && (errno == ENOSYS || errno == EPERM)) {
+        atomic_store_explicit(&g_processVmReadvUnavailable, true, memory_order_relaxed);
+    }
+    errno = savedErrno;
+    return copied == (ssize_t)size;
+}
+
+// MARK: - 路径处理
+
+bool dp_platform_is_system_path(const char* path) {
+    if (path == NULL) return false;
+
+    // 系统库路径前缀
+    static const char* systemPrefixes[] = {
+        "/lib/",
+        "/lib64/",
+        "/lib32/",
+        "/usr/lib/",
+        "/usr/lib64/",
+        "/usr/lib32/",
+        "/usr/libexec/",
+        "linux-vdso",
+        "linux-gate",
+        NULL
+    };
+
+    for (int i = 0; systemPrefixes[i] != NULL; i++) {
+        if (strncmp(path, systemPrefixes[i], strlen(systemPrefixes[i])) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,516 @@
+//
+//  DPPreMainSampler.c
+//  DebugProbe
+//
+//  启动窗口统计采样
+//  平台层定时中断目标线程（Linux 为 SIGPROF，Apple 为挂起主线程）后调用 dp_launch_sampler_record，
+//  沿帧指针链把原始返回地址写入启动时一次性预留的缓冲区；导出时才读取镜像符号表并聚合为折叠调用栈
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "DPPreMainInternal.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifndef __has_feature
+#define __has_feature(x) 0
+#endif
+
+#if __has_feature(ptrauth_calls)
+#include <ptrauth.h>
+#endif
+
+// MARK: - 类型定义
+
+/// 默认采样间隔（微秒）
+#define DP_LAUNCH_SAMPLER_DEFAULT_INTERVAL 1000
+
+/// 样本标志：主线程
+#define DP_SAMPLE_FLAG_MAIN_THREAD 0x1u
+
+/// 一个样本（frameCount 最后以 release 写入，非 0 表示样本完整）
+typedef struct {
+    uint64_t machTime;
+    uint64_t threadId;
+    uint32_t frameCount;
+    uint32_t flags;
+    uintptr_t frames[DP_LAUNCH_SAMPLER_MAX_FRAMES];
+} dp_launch_sample_t;
+
+/// 导出时的函数符号
+typedef struct {
+    uintptr_t address;
+    size_t size;
+    /// 名称在所属镜像名称缓冲区中的偏移
+    size_t nameOffset;
+} dp_profile_symbol_t;
+
+/// 导出时的镜像（符号表按需加载）
+typedef struct {
+    const void* header;
+    /// 镜像路径（堆上副本）与其中的文件名
+    char* path;
+    const char* name;
+    /// 按地址排序的函数符号
+    dp_profile_symbol_t* symbols;
+    size_t symbolCount;
+    char* names;
+    size_t namesLength;
+    bool loaded;
+} dp_profile_image_t;
+
+/// 导出时的可执行段（按起始地址排序，用于定位地址所属镜像）
+typedef struct {
+    uintptr_t start;
+    uintptr_t end;
+    uint32_t imageIndex;
+} dp_profile_segment_t;
+
+/// 导出时的镜像与段表
+typedef struct {
+    dp_profile_image_t* images;
+    uint32_t imageCount;
+    uint32_t imageCapacity;
+    dp_profile_segment_t* segments;
+    uint32_t segmentCount;
+    uint32_t segmentCapacity;
+} dp_profile_images_t;
+
+/// 符号收集状态
+typedef struct {
+    dp_profile_image_t* image;
+    size_t capacity;
+    size_t namesCapacity;
+    bool failed;
+} dp_profile_symbol_collector_t;
+
+// MARK: - 全局数据
+
+/// 采样状态（控制路径受 g_samplerMutex 保护，采样路径只做原子操作）
+static pthread_mutex_t g_samplerMutex = PTHREAD_MUTEX_INITIALIZER;
+static atomic_bool g_samplerRunning = false;
+static bool g_samplerStarted = false;
+static uint32_t g_samplerIntervalMicros = 0;
+static uint64_t g_samplerStartMachTime = 0;
+static uint64_t g_samplerStopMachTime = 0;
+
+/// 预留的样本缓冲区（匿名映射，未写入的页不占物理内存）
+static dp_launch_sample_t* g_samples = NULL;
+static atomic_uint_fast32_t g_sampleClaimed = 0;
+static atomic_uint_fast32_t g_sampleDropped = 0;
+
+// MARK: - 采样路径
+
+void dp_launch_sampler_record(uintptr_t pc, uintptr_t fp, uintptr_t stackLow, uintptr_t stackHigh,
+                              uint64_t threadId, bool isMainThread) {
+    if (!atomic_load_explicit(&g_samplerRunning, memory_order_acquire)) {
+        return;
+    }
+    uint_fast32_t index = atomic_fetch_add_explicit(&g_sampleClaimed, 1, memory_order_relaxed);
+    if (index >= DP_LAUNCH_SAMPLER_CAPACITY) {
+        atomic_fetch_add_explicit(&g_sampleDropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    dp_launch_sample_t* sample = &g_samples[index];
+    sample->machTime = dp_platform_now();
+    sample->threadId = threadId;
+    sample->flags = isMainThread ? DP_SAMPLE_FLAG_MAIN_THREAD : 0;
+
+#if __has_feature(ptrauth_calls)
+    pc = (uintptr_t)ptrauth_strip((void*)pc, ptrauth_key_function_pointer);
+#endif
+    uint32_t count = 0;
+    sample->frames[count++] = pc;
+
+    // 栈范围已知时帧必须落在栈内后直接读取；范围未知时（如 SIGPROF 打断的非主线程）
+    // 以不会触发缺页异常的方式复制帧，fp 指向未映射或不可读的页（如栈保护页）时停止回溯
+    while (count < DP_LAUNCH_SAMPLER_MAX_FRAMES && fp != 0 && (fp & (sizeof(uintptr_t) - 1)) == 0) {
+        uintptr_t frame[2];
+        if (stackHigh != 0) {
+            if (fp < stackLow || fp > stackHigh - sizeof(frame)) break;
+            memcpy(frame, (const void*)fp, sizeof(frame));
+        } else if (!dp_platform_read_memory(fp, frame, sizeof(frame))) {
+            break;
+        }
+
+        uintptr_t next = frame[0];
+        uintptr_t returnAddress = frame[1];
+#if __has_feature(ptrauth_calls)
+        returnAddress = (uintptr_t)ptrauth_strip((void*)returnAddress, ptrauth_key_return_address);
+#endif
+        if (returnAddress == 0) break;
+        sample->frames[count++] = returnAddress;
+
+        // 栈向低地址增长，上一帧必然位于更高地址
+        if (next <= fp) break;
+        fp = next;
+    }
+
+    __atomic_store_n(&sample->frameCount, count, __ATOMIC_RELEASE);
+}
+
+// MARK: - 控制路径
+
+/// 停止采样（调用方持有 g_samplerMutex）
+static void dp_launch_sampler_stop_locked(void) {
+    if (!atomic_load_explicit(&g_samplerRunning, memory_order_relaxed)) {
+        return;
+    }
+    atomic_store_explicit(&g_samplerRunning, false, memory_order_release);
+    dp_platform_sampler_stop();
+    g_samplerStopMachTime = dp_platform_now();
+}
+
+bool DPPreMainStartLaunchSampler(uint32_t intervalMicros) {
+    pthread_mutex_lock(&g_samplerMutex);
+    if (g_samplerStarted) {
+        pthread_mutex_unlock(&g_samplerMutex);
+        return false;
+    }
+
+    void* buffer = mmap(NULL, sizeof(dp_launch_sample_t) * DP_LAUNCH_SAMPLER_CAPACITY,
+                        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (buffer == MAP_FAILED) {
+        pthread_mutex_unlock(&g_samplerMutex);
+        return false;
+    }
+    g_samples = buffer;
+    g_samplerIntervalMicros = intervalMicros > 0 ? intervalMicros : DP_LAUNCH_SAMPLER_DEFAULT_INTERVAL;
+    g_samplerStartMachTime = dp_platform_now();
+    atomic_store_explicit(&g_samplerRunning, true, memory_order_release);
+
+    if (!dp_platform_sampler_start(g_samplerIntervalMicros)) {
+        atomic_store_explicit(&g_samplerRunning, false, memory_order_release);
+        munmap(buffer, sizeof(dp_launch_sample_t) * DP_LAUNCH_SAMPLER_CAPACITY);
+        g_samples = NULL;
+        pthread_mutex_unlock(&g_samplerMutex);
+        return false;
+    }
+    g_samplerStarted = true;
+    pthread_mutex_unlock(&g_samplerMutex);
+    return true;
+}
+
+void DPPreMainStopLaunchSampler(void) {
+    pthread_mutex_lock(&g_samplerMutex);
+    dp_launch_sampler_stop_locked();
+    pthread_mutex_unlock(&g_samplerMutex);
+}
+
+bool DPPreMainGetLaunchSamplerStats(DPLaunchSamplerStats* outStats) {
+    if (outStats == NULL) return false;
+    memset(outStats, 0, sizeof(*outStats));
+
+    pthread_mutex_lock(&g_samplerMutex);
+    bool started = g_samplerStarted;
+    if (started) {
+        uint_fast32_t claimed = atomic_load_explicit(&g_sampleClaimed, memory_order_relaxed);
+        outStats->intervalMicros = g_samplerIntervalMicros;
+        outStats->sampleCount = (uint32_t)(claimed < DP_LAUNCH_SAMPLER_CAPACITY ? claimed : DP_LAUNCH_SAMPLER_CAPACITY);
+        outStats->droppedCount = (uint32_t)atomic_load_explicit(&g_sampleDropped, memory_order_relaxed);
+        outStats->running = atomic_load_explicit(&g_samplerRunning, memory_order_relaxed);
+        outStats->startMachTime = g_samplerStartMachTime;
+        outStats->stopMachTime = g_samplerStopMachTime;
+    }
+    pthread_mutex_unlock(&g_samplerMutex);
+    return started;
+}
+
+// MARK: - 符号化
+
+/// dp_platform_enumerate_text_segments 回调：登记镜像与段
+static void dp_profile_add_segment(const void* header, const char* path, uintptr_t start, size_t size,
+                                   void* context) {
+    dp_profile_images_t* table = context;
+
+    if (table->imageCount == 0 || table->images[table->imageCount - 1].header != header) {
+        if (table->imageCount == table->imageCapacity) {
+            uint32_t capacity = table->imageCapacity > 0 ? table->imageCapacity * 2 : 256;
+            dp_profile_image_t* images = realloc(table->images, capacity * sizeof(dp_profile_image_t));
+            if (images == NULL) return;
+            table->images = images;
+            table->imageCapacity = capacity;
+        }
+        char* copy = strdup(path != NULL ? path : "");
+        if (copy == NULL) return;
+        const char* slash = strrchr(copy, '/');
+        table->images[table->imageCount++] = (dp_profile_image_t){
+            .header = header,
+            .path = copy,
+            .name = slash != NULL ? slash + 1 : copy,
+        };
+    }
+
+    if (table->segmentCount == table->segmentCapacity) {
+        uint32_t capacity = table->segmentCapacity > 0 ? table->segmentCapacity * 2 : 256;
+        dp_profile_segment_t* segments = realloc(table->segments, capacity * sizeof(dp_profile_segment_t));
+        if (segments == NULL) return;
+        table->segments = segments;
+        table->segmentCapacity = capacity;
+    }
+    table->segments[table->segmentCount++] = (dp_profile_segment_t){
+        .start = start,
+        .end = start + size,
+        .imageIndex = table->imageCount - 1,
+    };
+}
+
+static int dp_profile_compare_segments(const void* lhs, const void* rhs) {
+    const dp_profile_segment_t* a = lhs;
+    const dp_profile_segment_t* b = rhs;
+    if (a->start != b->start) return a->start < b->start ? -1 : 1;
+    return 0;
+}
+
+/// dp_platform_enumerate_function_symbols 回调：复制符号到镜像的符号数组
+static void dp_profile_collect_symbol(const char* name, uintptr_t address, size_t size, void* context) {
+    dp_profile_symbol_collector_t* collector = context;
+    dp_profile_image_t* image = collector->image;
+    if (collector->failed) return;
+
+    if (image->symbolCount == collector->capacity) {
+        size_t capacity = collector->capacity > 0 ? collector->capacity * 2 : 1024;
+        dp_profile_symbol_t* symbols = realloc(image->symbols, capacity * sizeof(dp_profile_symbol_t));
+        if (symbols == NULL) {
+            collector->failed = true;
+            return;
+        }
+        image->symbols = symbols;
+        collector->capacity = capacity;
+    }
+
+    size_t length = strlen(name) + 1;
+    if (image->namesLength + length > collector->namesCapacity) {
+        size_t capacity = collector->namesCapacity > 0 ? collector->namesCapacity * 2 : 16 * 1024;
+        while (capacity < image->namesLength + length) capacity *= 2;
+        char* names = realloc(image->names, capacity);
+        if (names == NULL) {
+            collector->failed = true;
+            return;
+        }
+        image->names = names;
+        collector->namesCapacity = capacity;
+    }
+    memcpy(image->names + image->namesLength, name, length);
+
+    image->symbols[image->symbolCount++] = (dp_profile_symbol_t){
+        .address = address,
+        .size = size,
+        .nameOffset = image->namesLength,
+    };
+    image->namesLength += length;
+}
+
+static int dp_profile_compare_symbols(const void* lhs, const void* rhs) {
+    const dp_profile_symbol_t* a = lhs;
+    const dp_profile_symbol_t* b = rhs;
+    if (a->address != b->address) return a->address < b->address ? -1 : 1;
+    return 0;
+}
+
+/// 读取镜像符号表并按地址排序
+static void dp_profile_load_symbols(dp_profile_image_t* image) {
+    image->loaded = true;
+    dp_profile_symbol_collector_t collector = { .image = image };
+    dp_platform_enumerate_function_symbols(image->header, image->path, dp_profile_collect_symbol, &collector);
+    if (collector.failed) {
+        image->symbolCount = 0;
+        return;
+    }
+    qsort(image->symbols, image->symbolCount, sizeof(dp_profile_symbol_t), dp_profile_compare_symbols);
+}
+
+/// 将地址格式化为 "镜像名`符号"
+/// @param isReturnAddress 返回地址指向调用指令之后，需回退一个字节再查找
+static void dp_profile_format_frame(dp_profile_images_t* table, uintptr_t address,
+                                    bool isReturnAddress, char* buffer, size_t bufferSize) {
+    uintptr_t lookup = isReturnAddress && address > 0 ? address - 1 : address;
+
+    // 二分查找所属段
+    uint32_t low = 0;
+    uint32_t high = table->segmentCount;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (table->segments[mid].start <= lookup) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == 0 || lookup >= table->segments[low - 1].end) {
+        snprintf(buffer, bufferSize, "0x%llx", (unsigned long long)address);
+        return;
+    }
+
+    uint32_t imageIndex = table->segments[low - 1].imageIndex;
+    dp_profile_image_t* image = &table->images[imageIndex];
+    if (!image->loaded) {
+        dp_profile_load_symbols(image);
+    }
+
+    // 最后一个起始地址不大于目标地址的符号；大小未知时视为延伸到下一个符号
+    size_t symbolLow = 0;
+    size_t symbolHigh = image->symbolCount;
+    while (symbolLow < symbolHigh) {
+        size_t mid = symbolLow + (symbolHigh - symbolLow) / 2;
+        if (image->symbols[mid].address <= lookup) {
+            symbolLow = mid + 1;
+        } else {
+            symbolHigh = mid;
+        }
+    }
+    if (symbolLow > 0) {
+        const dp_profile_symbol_t* symbol = &image->symbols[symbolLow - 1];
+        if (symbol->size == 0 || lookup < symbol->address + symbol->size) {
+            snprintf(buffer, bufferSize, "%s`%s", image->name, image->names + symbol->nameOffset);
+            return;
+        }
+    }
+    // 镜像内偏移与加载地址无关，可离线用 atos / addr2line 符号化
+    snprintf(buffer, bufferSize, "%s`+0x%llx", image->name,
+             (unsigned long long)(address - (uintptr_t)image->header));
+}
+
+// MARK: - 导出
+
+/// 按线程与栈帧比较样本，使相同调用栈相邻
+static int dp_profile_compare_samples(const void* lhs, const void* rhs) {
+    const dp_launch_sample_t* a = *(const dp_launch_sample_t* const*)lhs;
+    const dp_launch_sample_t* b = *(const dp_launch_sample_t* const*)rhs;
+    if (a->threadId != b->threadId) return a->threadId < b->threadId ? -1 : 1;
+    if (a->frameCount != b->frameCount) return a->frameCount < b->frameCount ? -1 : 1;
+    for (uint32_t i = 0; i < a->frameCount; i++) {
+        if (a->frames[i] != b->frames[i]) return a->frames[i] < b->frames[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+/// 缓冲写出器
+typedef struct {
+    int fd;
+    char buffer[4096];
+    size_t used;
+    bool failed;
+} dp_profile_writer_t;
+
+static void dp_profile_flush(dp_profile_writer_t* writer) {
+    const char* data = writer->buffer;
+    size_t length = writer->used;
+    while (length > 0 && !writer->failed) {
+        ssize_t written = write(writer->fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            writer->failed = true;
+            break;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    writer->used = 0;
+}
+
+static void dp_profile_append(dp_profile_writer_t* writer, const char* string) {
+    size_t length = strlen(string);
+    while (length > 0 && !writer->failed) {
+        if (writer->used == sizeof(writer->buffer)) {
+            dp_profile_flush(writer);
+        }
+        size_t chunk = sizeof(writer->buffer) - writer->used;
+        if (chunk > length) chunk = length;
+        memcpy(writer->buffer + writer->used, string, chunk);
+        writer->used += chunk;
+        string += chunk;
+        length -= chunk;
+    }
+}
+
+/// 写出一个聚合后的调用栈（根帧在前）
+static void dp_profile_write_stack(dp_profile_writer_t* writer, dp_profile_images_t* table,
+                                   const dp_launch_sample_t* sample, size_t count) {
+    char frame[512];
+    if (sample->flags & DP_SAMPLE_FLAG_MAIN_THREAD) {
+        dp_profile_append(writer, "main-thread");
+    } else {
+        snprintf(frame, sizeof(frame), "thread-%llu", (unsigned long long)sample->threadId);
+        dp_profile_append(writer, frame);
+    }
+    for (uint32_t i = sample->frameCount; i > 0; i--) {
+        dp_profile_format_frame(table, sample->frames[i - 1], i - 1 > 0, frame, sizeof(frame));
+        // 折叠格式以 ';' 分隔帧、以最后一个空格分隔计数
+        for (char* c = frame; *c != '\0'; c++) {
+            if (*c == ';' || *c == ' ') *c = '_';
+        }
+        dp_profile_append(writer, ";");
+        dp_profile_append(writer, frame);
+    }
+    snprintf(frame, sizeof(frame), " %zu\n", count);
+    dp_profile_append(writer, frame);
+}
+
+int64_t DPPreMainExportLaunchProfileToFileDescriptor(int fd) {
+    pthread_mutex_lock(&g_samplerMutex);
+    if (!g_samplerStarted) {
+        pthread_mutex_unlock(&g_samplerMutex);
+        return -1;
+    }
+    dp_launch_sampler_stop_locked();
+
+    uint_fast32_t claimed = atomic_load_explicit(&g_sampleClaimed, memory_order_relaxed);
+    size_t available = claimed < DP_LAUNCH_SAMPLER_CAPACITY ? claimed : DP_LAUNCH_SAMPLER_CAPACITY;
+    const dp_launch_sample_t** samples = malloc((available > 0 ? available : 1) * sizeof(dp_launch_sample_t*));
+    if (samples == NULL) {
+        pthread_mutex_unlock(&g_samplerMutex);
+        return -1;
+    }
+    size_t sampleCount = 0;
+    for (size_t i = 0; i < available; i++) {
+        if (__atomic_load_n(&g_samples[i].frameCount, __ATOMIC_ACQUIRE) > 0) {
+            samples[sampleCount++] = &g_samples[i];
+        }
+    }
+    pthread_mutex_unlock(&g_samplerMutex);
+
+    qsort(samples, sampleCount, sizeof(dp_launch_sample_t*), dp_profile_compare_samples);
+
+    // 当前加载的全部镜像（含系统库）
+    dp_profile_images_t table = { 0 };
+    dp_platform_enumerate_text_segments(dp_profile_add_segment, &table);
+    qsort(table.segments, table.segmentCount, sizeof(dp_profile_segment_t), dp_profile_compare_segments);
+
+    // 相同调用栈已相邻，逐组写出
+    dp_profile_writer_t writer = { .fd = fd };
+    int64_t stackCount = 0;
+    for (size_t first = 0; first < sampleCount && !writer.failed;) {
+        size_t last = first + 1;
+        while (last < sampleCount && dp_profile_compare_samples(&samples[first], &samples[last]) == 0) last++;
+        dp_profile_write_stack(&writer, &table, samples[first], last - first);
+        stackCount++;
+        first = last;
+    }
+    dp_profile_flush(&writer);
+    if (writer.failed) stackCount = -1;
+
+    for (uint32_t i = 0; i < table.imageCount; i++) {
+        free(table.images[i].path);
+        free(table.images[i].symbols);
+        free(table.images[i].names);
+    }
+    free(table.images);
+    free(table.segments);
+    free(samples);
+    return stackCount;
+}
@@ -0,0 +1,181 @@
+//
+//  DPPreMainStringArena.c
+//  DebugProbe
+//
+//  PreMain 监控使用的驻留字符串区
+//  记录中只保存 (offset, length)，字符串按块存储且地址稳定，
+//  相同名称只存储一次
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#include "DPPreMainInternal.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// MARK: - 全局数据
+
+/// 字符串块（只追加，发布后地址不变，读取无需加锁）
+static _Atomic(char*) g_arenaBlocks[DP_STRING_ARENA_MAX_BLOCKS];
+
+/// 已分配的块数量
+static uint32_t g_arenaBlockCount = 0;
+
+/// 当前块已使用字节数
+static uint32_t g_arenaBlockUsed = 0;
+
+/// 驻留哈希表（开放寻址，存储字符串区偏移，0 表示空位）
+static uint32_t* g_internTable = NULL;
+static uint32_t g_internTableCapacity = 0;
+static uint32_t g_internTableCount = 0;
+
+// MARK: - 内部函数
+
+/// FNV-1a 哈希
+static uint32_t dp_string_hash(const char* string, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)string[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/// 偏移对应的字符串地址
+static const char* dp_string_arena_at(uint32_t offset) {
+    uint32_t blockIndex = offset / DP_STRING_ARENA_BLOCK_SIZE;
+    if (blockIndex >= DP_STRING_ARENA_MAX_BLOCKS) {
+        return NULL;
+    }
+    const char* block = atomic_load_explicit(&g_arenaBlocks[blockIndex], memory_order_acquire);
+    if (block == NULL) {
+        return NULL;
+    }
+    return block + (offset % DP_STRING_ARENA_BLOCK_SIZE);
+}
+
+/// 追加字符串到字符串区（不去重）
+static uint32_t dp_string_arena_append(const char* string, size_t length) {
+    size_t required = length + 1;
+
+    if (g_arenaBlockCount == 0 || g_arenaBlockUsed + required > DP_STRING_ARENA_BLOCK_SIZE) {
+        if (g_arenaBlockCount >= DP_STRING_ARENA_MAX_BLOCKS) {
+            return 0;
+        }
+        char* block = malloc(DP_STRING_ARENA_BLOCK_SIZE);
+        if (block == NULL) {
+            return 0;
+        }
+        // 偏移 0 保留给空字符串
+        block[0] = '\0';
+        g_arenaBlockUsed = 1;
+        atomic_store_explicit(&g_arenaBlocks[g_arenaBlockCount], block, memory_order_release);
+        g_arenaBlockCount++;
+    }
+
+    uint32_t blockIndex = g_arenaBlockCount - 1;
+    char* block = atomic_load_explicit(&g_arenaBlocks[blockIndex], memory_order_relaxed);
+    uint32_t offset = blockIndex * DP_STRING_ARENA_BLOCK_SIZE + g_arenaBlockUsed;
+
+    memcpy(block + g_arenaBlockUsed, string, length);
+    block[g_arenaBlockUsed + length] = '\0';
+    g_arenaBlockUsed += (uint32_t)required;
+
+    return offset;
+}
+
+/// 扩容驻留哈希表
+static bool dp_intern_table_grow(void) {
+    uint32_t newCapacity = g_internTableCapacity == 0 ? 256 : g_internTableCapacity * 2;
+    uint32_t* newTable = calloc(newCapacity, sizeof(uint32_t));
+    if (newTable == NULL) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < g_internTableCapacity; i++) {
+        uint32_t offset = g_internTable[i];
+        if (offset == 0) continue;
+
+        const char* existing = dp_string_arena_at(offset);
+        uint32_t slot = dp_string_hash(existing, strlen(existing)) & (newCapacity - 1);
+        while (newTable[slot] != 0) {
+            slot = (slot + 1) & (newCapacity - 1);
+        }
+        newTable[slot] = offset;
+    }
+
+    free(g_internTable);
+    g_internTable = newTable;
+    g_internTableCapacity = newCapacity;
+    return true;
+}
+
+// MARK: - 内部 API
+
+uint32_t dp_string_arena_intern(const char* string, size_t length, uint16_t* outLength) {
+    if (outLength != NULL) {
+        *outLength = 0;
+    }
+    if (string == NULL || length == 0) {
+        return 0;
+    }
+    if (length > DP_MAX_DYLIB_NAME_LENGTH - 1) {
+        length = DP_MAX_DYLIB_NAME_LENGTH - 1;
+    }
+
+    // 负载因子超过 0.5 时扩容
+    if ((g_internTableCount + 1) * 2 > g_internTableCapacity && !dp_intern_table_grow()) {
+        return 0;
+    }
+
+    uint32_t mask = g_internTableCapacity - 1;
+    uint32_t slot = dp_string_hash(string, length) & mask;
+    while (g_internTable[slot] != 0) {
+        const char* existing = dp_string_arena_at(g_internTable[slot]);
+        if (strncmp(existing, string, length) == 0 && existing[length] == '\0') {
+            if (outLength != NULL) {
+                *outLength = (uint16_t)length;
+            }
+            return g_internTable[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    uint32_t offset = dp_string_arena_append(string, length);
+    if (offset == 0) {
+        return 0;
+    }
+    g_internTable[slot] = offset;
+    g_internTableCount++;
+
+    if (outLength != NULL) {
+        *outLength = (uint16_t)length;
+    }
+    return offset;
+}
+
+void dp_string_arena_reset(void) {
+    for (uint32_t i = 0; i < g_arenaBlockCount; i++) {
+        free(atomic_exchange_explicit(&g_arenaBlocks[i], NULL, memory_order_relaxed));
+    }
+    g_arenaBlockCount = 0;
+    g_arenaBlockUsed = 0;
+
+    free(g_internTable);
+    g_internTable = NULL;
+    g_internTableCapacity = 0;
+    g_internTableCount = 0;
+}
+
+// MARK: - 公开 API 实现
+
+const char* DPPreMainGetInternedString(uint32_t offset) {
+    if (offset == 0) {
+        return "";
+    }
+    const char* string = dp_string_arena_at(offset);
+    return string != NULL ? string : "";
+}
@@ -0,0 +1,363 @@
+//
+//  DPPreMainTraceExport.c
+//  DebugProbe
+//
+//  启动时间线导出：Chrome Trace Event JSON（可直接在 Perfetto / chrome://tracing 打开）
+//  流式生成，只使用固定大小的栈上缓冲区，写满即交给输出端（调用方缓冲区或文件描述符）
+//
+//  时间轴：ts 单位为微秒，0 为估算的进程启动时刻（无估算时为 constructor）
+//  轨道：
+//  - tid 1 启动阶段（kernel -> constructor、静态初始化器、dylib 加载、dyld 结束 -> main、ObjC +load）
+//  - tid 2 镜像加载（dlopen 计时的镜像为加载区间，补发的镜像为通知时刻）
+//  - tid 3 静态初始化器（逐个计时的初始化器）
+//  - 自定义标记使用实际线程 ID
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#include "DPPreMainInternal.h"
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// MARK: - 常量定义
+
+/// 固定缓冲区大小
+#define DP_TRACE_SCRATCH_SIZE 4096
+
+/// 合成轨道线程 ID
+#define DP_TRACE_TID_PHASES 1
+#define DP_TRACE_TID_IMAGES 2
+#define DP_TRACE_TID_INITIALIZERS 3
+
+// MARK: - 输出端
+
+/// 输出函数，返回 false 表示写出失败
+typedef bool (*dp_trace_sink_t)(const char* data, size_t length, void* context);
+
+/// 流式写入器
+typedef struct {
+    /// 固定缓冲区
+    char scratch[DP_TRACE_SCRATCH_SIZE];
+    /// 缓冲区已使用字节数
+    size_t used;
+    /// 输出函数与上下文
+    dp_trace_sink_t sink;
+    void* sinkContext;
+    /// 已生成的总字节数（含写出失败或截断部分）
+    size_t total;
+    /// 是否已写出失败
+    bool failed;
+    /// 是否已写出第一个事件（控制逗号）
+    bool hasEvent;
+    /// 时间轴原点（mach_absolute_time）与原点之后的偏移（纳秒）
+    uint64_t originMachTime;
+    uint64_t originOffsetNanos;
+} DPTraceWriter;
+
+/// 调用方缓冲区输出上下文
+typedef struct {
+    char* buffer;
+    size_t capacity;
+    size_t written;
+} DPTraceBufferSink;
+
+/// 复制到调用方缓冲区（超出部分丢弃，总长度仍继续统计）
+static bool dp_trace_buffer_sink(const char* data, size_t length, void* context) {
+    DPTraceBufferSink* sink = context;
+    if (sink->written < sink->capacity) {
+        size_t available = sink->capacity - sink->written;
+        size_t copyLength = length < available ? length : available;
+        memcpy(sink->buffer + sink->written, data, copyLength);
+        sink->written += copyLength;
+    }
+    return true;
+}
+
+/// 写入文件描述符（处理 EINTR 与部分写入）
+static bool dp_trace_fd_sink(const char* data, size_t length, void* context) {
+    int fd = *(const int*)context;
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        length -= (size_t)n;
+    }
+    return true;
+}
+
+// MARK: - 写入器
+
+/// 将缓冲区内容交给输出端
+static void dp_trace_flush(DPTraceWriter* writer) {
+    if (writer->used > 0 && !writer->failed) {
+        writer->failed = !writer->sink(writer->scratch, writer->used, writer->sinkContext);
+    }
+    writer->used = 0;
+}
+
+/// 追加原始字节
+static void dp_trace_append(DPTraceWriter* writer, const char* data, size_t length) {
+    writer->total += length;
+    while (length > 0) {
+        if (writer->used == DP_TRACE_SCRATCH_SIZE) {
+            dp_trace_flush(writer);
+        }
+        size_t available = DP_TRACE_SCRATCH_SIZE - writer->used;
+        size_t chunk = length < available ? length : available;
+        memcpy(writer->scratch + writer->used, data, chunk);
+        writer->used += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+/// 追加 NUL 结尾字符串
+static void dp_trace_append_cstring(DPTraceWriter* writer, const char* string) {
+    dp_trace_append(writer, string, strlen(string));
+}
+
+/// 追加格式化文本（单次不超过 128 字节，仅用于数字）
+static void dp_trace_append_format(DPTraceWriter* writer, const char* format, ...) __attribute__((format(printf, 2, 3)));
+static void dp_trace_append_format(DPTraceWriter* writer, const char* format, ...) {
+    char buffer[128];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length > 0) {
+        dp_trace_append(writer, buffer, (size_t)length < sizeof(buffer) ? (size_t)length : sizeof(buffer) - 1);
+    }
+}
+
+/// 追加无符号整数（热路径，避免 snprintf）
+static void dp_trace_append_uint(DPTraceWriter* writer, uint64_t value) {
+    char digits[20];
+    size_t length = 0;
+    do {
+        digits[sizeof(digits) - 1 - length++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    dp_trace_append(writer, digits + sizeof(digits) - length, length);
+}
+
+/// 追加纳秒对应的微秒数（保留 3 位小数）
+static void dp_trace_append_micros(DPTraceWriter* writer, uint64_t nanos) {
+    char fraction[4] = { '.', (char)('0' + nanos / 100 % 10), (char)('0' + nanos / 10 % 10), (char)('0' + nanos % 10) };
+    dp_trace_append_uint(writer, nanos / 1000);
+    dp_trace_append(writer, fraction, sizeof(fraction));
+}
+
+/// 追加 JSON 字符串（含引号与转义）
+static void dp_trace_append_json_string(DPTraceWriter* writer, const char* string) {
+    dp_trace_append(writer, "\"", 1);
+    if (string != NULL) {
+        const char* runStart = string;
+        for (const char* cursor = string; *cursor != '\0'; cursor++) {
+            unsigned char c = (unsigned char)*cursor;
+            if (c != '"' && c != '\\' && c >= 0x20) {
+                continue;
+            }
+            dp_trace_append(writer, runStart, (size_t)(cursor - runStart));
+            if (c == '"' || c == '\\') {
+                char escaped[2] = { '\\', (char)c };
+                dp_trace_append(writer, escaped, 2);
+            } else {
+                dp_trace_append_format(writer, "\\u%04x", c);
+            }
+            runStart = cursor + 1;
+        }
+        dp_trace_append_cstring(writer, runStart);
+    }
+    dp_trace_append(writer, "\"", 1);
+}
+
+/// mach_absolute_time 转换为时间轴纳秒
+static uint64_t dp_trace_nanos(const DPTraceWriter* writer, uint64_t machTime) {
+    if (machTime <= writer->originMachTime) {
+        return writer->originOffsetNanos;
+    }
+    return writer->originOffsetNanos + DPMachTimeToNanos(machTime - writer->originMachTime);
+}
+
+/// 开始一个事件对象：{"name":...,"ph":...,"pid":1,"tid":...,"ts":...
+static void dp_trace_begin_event(DPTraceWriter* writer, const char* name, const char* phase,
+                                 uint64_t tid, uint64_t tsNanos) {
+    dp_trace_append_cstring(writer, writer->hasEvent ? ",\n{\"name\":" : "\n{\"name\":");
+    writer->hasEvent = true;
+    dp_trace_append_json_string(writer, name);
+    dp_trace_append_cstring(writer, ",\"ph\":\"");
+    dp_trace_append_cstring(writer, phase);
+    dp_trace_append_cstring(writer, "\",\"pid\":1,\"tid\":");
+    dp_trace_append_uint(writer, tid);
+    dp_trace_append_cstring(writer, ",\"ts\":");
+    dp_trace_append_micros(writer, tsNanos);
+}
+
+/// 完整区间事件（ph = X），调用方负责追加 args 并闭合对象
+static void dp_trace_complete_event(DPTraceWriter* writer, const char* name, const char* category,
+                                    uint64_t tid, uint64_t startNanos, uint64_t durationNanos) {
+    dp_trace_begin_event(writer, name, "X", tid, startNanos);
+    dp_trace_append_cstring(writer, ",\"dur\":");
+    dp_trace_append_micros(writer, durationNanos);
+    dp_trace_append_cstring(writer, ",\"cat\":\"");
+    dp_trace_append_cstring(writer, category);
+    dp_trace_append_cstring(writer, "\"");
+}
+
+/// 线程名元数据
+static void dp_trace_thread_name(DPTraceWriter* writer, uint64_t tid, const char* name) {
+    dp_trace_begin_event(writer, "thread_name", "M", tid, 0);
+    dp_trace_append_cstring(writer, ",\"args\":{\"name\":");
+    dp_trace_append_json_string(writer, name);
+    dp_trace_append_cstring(writer, "}}");
+}
+
+// MARK: - 事件生成
+
+/// 阶段区间（任一端缺失时跳过）
+static void dp_trace_phase(DPTraceWriter* writer, const char* name, uint64_t startMachTime, uint64_t endMachTime) {
+    if (startMachTime == 0 || endMachTime == 0 || endMachTime < startMachTime) {
+        return;
+    }
+    uint64_t start = dp_trace_nanos(writer, startMachTime);
+    dp_trace_complete_event(writer, name, "phase", DP_TRACE_TID_PHASES, start,
+                            dp_trace_nanos(writer, endMachTime) - start);
+    dp_trace_append_cstring(writer, "}");
+}
+
+/// 自定义标记遍历回调
+static bool dp_trace_mark_visitor(const DPMarkEvent* event, void* context) {
+    DPTraceWriter* writer = context;
+    static const char* phases[] = { "i", "B", "E" };
+    const char* phase = event->kind <= DPMarkKindEnd ? phases[event->kind] : "i";
+
+    dp_trace_begin_event(writer, event->name != NULL ? event->name : "", phase, event->threadId,
+                         dp_trace_nanos(writer, event->machTime));
+    dp_trace_append_cstring(writer, ",\"cat\":\"mark\"");
+    if (event->kind == DPMarkKindInstant) {
+        dp_trace_append_cstring(writer, ",\"s\":\"t\"");
+    }
+    dp_trace_append_cstring(writer, "}");
+    return !writer->failed;
+}
+
+/// 生成完整的 Trace JSON
+static void dp_trace_write_all(DPTraceWriter* writer) {
+    DPPreMainData data;
+    DPPreMainCopySnapshot(&data, NULL);
+    const DPPreMainTimestamps* ts = &data.timestamps;
+
+    // 原点：估算的进程启动时刻，constructor 位于 kernel -> constructor 估算耗时之后
+    writer->originMachTime = ts->constructorMachTime;
+    writer->originOffsetNanos = data.durations.estimatedKernelToConstructorMs > 0
+        ? (uint64_t)(data.durations.estimatedKernelToConstructorMs * 1e6)
+        : 0;
+
+    dp_trace_append_cstring(writer, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    dp_trace_begin_event(writer, "process_name", "M", 0, 0);
+    dp_trace_append_cstring(writer, ",\"args\":{\"name\":\"Launch\"}}");
+    dp_trace_thread_name(writer, DP_TRACE_TID_PHASES, "Launch Phases");
+    dp_trace_thread_name(writer, DP_TRACE_TID_IMAGES, "Image Loading");
+    dp_trace_thread_name(writer, DP_TRACE_TID_INITIALIZERS, "Static Initializers");
+
+    // 启动阶段
+    if (writer->originOffsetNanos > 0) {
+        dp_trace_complete_event(writer, "kernel -> constructor (estimated)", "phase", DP_TRACE_TID_PHASES,
+                                0, writer->originOffsetNanos);
+        dp_trace_append_cstring(writer, "}");
+    }
+    dp_trace_phase(writer, "constructor -> first dyld callback", ts->constructorMachTime, ts->firstDyldCallbackMachTime);
+    dp_trace_phase(writer, "dylib loading", ts->firstDyldCallbackMachTime, ts->lastDyldCallbackMachTime);
+    dp_trace_phase(writer, "last dyld callback -> main", ts->lastDyldCallbackMachTime, ts->mainExecutedMachTime);
+    dp_trace_phase(writer, "ObjC +load", ts->objcLoadStartMachTime, ts->objcLoadEndMachTime);
+
+    if (ts->mainExecutedMachTime > 0) {
+        dp_trace_begin_event(writer, "main()", "i", DP_TRACE_TID_PHASES, dp_trace_nanos(writer, ts->mainExecutedMachTime));
+        dp_trace_append_cstring(writer, ",\"cat\":\"phase\",\"s\":\"g\",\"args\":{\"minorFaults\":");
+        dp_trace_append_format(writer, "%llu,\"majorFaults\":%llu}}",
+                               (unsigned long long)data.phaseFaults.total.minorFaults,
+                               (unsigned long long)data.phaseFaults.total.majorFaults);
+    }
+
+    // 镜像加载
+    for (uint32_t i = 0; i < data.dylibCount && !writer->failed; i++) {
+        const DPDylibLoadInfo* info = DPPreMainGetDylibInfo(i);
+        if (info == NULL) break;
+
+        // 只有 dlopen 计时的镜像有加载区间，补发的镜像只标记通知时刻
+        if (info->loadFlags & DP_DYLIB_LOAD_TIMED) {
+            dp_trace_complete_event(writer, DPPreMainGetInternedString(info->nameOffset), "image", DP_TRACE_TID_IMAGES,
+                                    dp_trace_nanos(writer, info->loadStartMachTime), info->loadDurationNanos);
+        } else {
+            dp_trace_begin_event(writer, DPPreMainGetInternedString(info->nameOffset), "i", DP_TRACE_TID_IMAGES,
+                                 dp_trace_nanos(writer, info->loadMachTime));
+            dp_trace_append_cstring(writer, ",\"cat\":\"image\",\"s\":\"t\"");
+        }
+        dp_trace_append_cstring(writer, info->isSystemLibrary ? ",\"args\":{\"system\":true" : ",\"args\":{\"system\":false");
+        dp_trace_append_cstring(writer, (info->loadFlags & DP_DYLIB_LOAD_REPLAYED) ? ",\"replayed\":true" : ",\"replayed\":false");
+        dp_trace_append_cstring(writer, ",\"minorFaults\":");
+        dp_trace_append_uint(writer, info->minorFaults);
+        dp_trace_append_cstring(writer, ",\"majorFaults\":");
+        dp_trace_append_uint(writer, info->majorFaults);
+        dp_trace_append_cstring(writer, "}}");
+    }
+
+    // 静态初始化器
+    uint32_t initializerSlots = dp_initializers_slot_count();
+    for (uint32_t i = 0; i < initializerSlots && !writer->failed; i++) {
+        DPInitializerInfo info;
+        if (!dp_initializer_info_at(i, &info)) continue;
+
+        const char* symbol = DPPreMainGetInternedString(info.symbolNameOffset);
+        char fallback[64];
+        if (symbol[0] == '\0') {
+            snprintf(fallback, sizeof(fallback), "initializer %p", info.function);
+            symbol = fallback;
+        }
+
+        dp_trace_complete_event(writer, symbol, "initializer", DP_TRACE_TID_INITIALIZERS,
+                                dp_trace_nanos(writer, info.startMachTime), info.durationNanos);
+        dp_trace_append_cstring(writer, ",\"args\":{\"image\":");
+        dp_trace_append_json_string(writer, DPPreMainGetInternedString(info.imageNameOffset));
+        dp_trace_append_cstring(writer, "}}");
+    }
+
+    // 自定义标记
+    if (!writer->failed) {
+        dp_markers_visit(DP_MARK_RING_CAPACITY, dp_trace_mark_visitor, writer);
+    }
+
+    dp_trace_append_cstring(writer, "\n]}\n");
+    dp_trace_flush(writer);
+}
+
+// MARK: - 公开 API 实现
+
+size_t DPPreMainExportChromeTrace(char* buffer, size_t bufferSize) {
+    DPTraceBufferSink sink = { buffer, buffer != NULL && bufferSize > 0 ? bufferSize - 1 : 0, 0 };
+    DPTraceWriter writer = { .sink = dp_trace_buffer_sink, .sinkContext = &sink };
+
+    dp_trace_write_all(&writer);
+
+    if (buffer != NULL && bufferSize > 0) {
+        buffer[sink.written] = '\0';
+    }
+    return writer.total;
+}
+
+int64_t DPPreMainExportChromeTraceToFileDescriptor(int fd) {
+    DPTraceWriter writer = { .sink = dp_trace_fd_sink, .sinkContext = &fd };
+
+    dp_trace_write_all(&writer);
+
+    return writer.failed ? -1 : (int64_t)writer.total;
+}
@@ -0,0 +1,343 @@
+//
+//  LaunchHistory.swift
+//  DebugProbe
+//
+//  启动历史的 Swift 封装
+//  只读映射 C 层在每次 main() 标记时写入的环形文件，记录与镜像直接读取映射内存，不做复制
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+import DPPreMainMonitor
+import Foundation
+
+// MARK: - LaunchHistory
+
+/// 最近若干次启动的历史记录
+///
+/// ## 使用方式
+///
+/// ```swift
+/// if let history = LaunchHistory.open(), let trend = history.trend() {
+///     print("PreMain p50: \(trend.totalPreMain.p50Ms)ms, p90: \(trend.totalPreMain.p90Ms)ms")
+///     for regression in trend.regressedImages {
+///         print("\(regression.name): \(regression.baselineP50Ms)ms -> \(regression.currentMs)ms")
+///     }
+/// }
+/// ```
+public final class LaunchHistory {
+    private let handle: OpaquePointer
+
+    private init(handle: OpaquePointer) {
+        self.handle = handle
+    }
+
+    deinit {
+        DPLaunchHistoryClose(handle)
+    }
+
+    /// 映射启动历史文件
+    /// - Parameter path: 文件路径，nil 使用当前路径
+    /// - Returns: 文件不存在或格式不符时返回 nil
+    public static func open(path: String? = nil) -> LaunchHistory? {
+        let handle = path.map { DPLaunchHistoryOpen($0) } ?? DPLaunchHistoryOpen(nil)
+        return handle.map { LaunchHistory(handle: $0) }
+    }
+
+    /// 当前启动历史文件路径（已关闭时为 nil）
+    public static var path: String? {
+        var buffer = [CChar](repeating: 0, count: Int(PATH_MAX))
+        guard DPPreMainGetLaunchHistoryPath(&buffer, buffer.count) > 0 else { return nil }
+        return String(cString: buffer)
+    }
+
+    /// 设置启动历史文件路径（需在 main() 标记之前调用），nil 关闭写入
+    public static func setPath(_ path: String?) {
+        if let path {
+            DPPreMainSetLaunchHistoryPath(path)
+        } else {
+            DPPreMainSetLaunchHistoryPath(nil)
+        }
+    }
+
+    /// 有效的启动记录数量
+    public var count: Int {
+        Int(DPLaunchHistoryGetCount(handle))
+    }
+
+    /// 获取第 index 条记录（0 为最旧），槽位正在写入时返回 nil
+    public func record(at index: Int) -> LaunchHistoryRecord? {
+        guard index >= 0, let pointer = DPLaunchHistoryGetRecord(handle, UInt32(index)) else { return nil }
+        return LaunchHistoryRecord(history: self, pointer: pointer)
+    }
+
+    /// 全部记录（按启动先后排列，最后一条为最近一次启动）
+    public var records: [LaunchHistoryRecord] {
+        (0 ..< count).compactMap { record(at: $0) }
+    }
+
+    /// 名称表中的字符串
+    func name(at offset: UInt32) -> String {
+        String(cString: DPLaunchHistoryGetName(handle, offset))
+    }
+
+    // MARK: - 趋势分析
+
+    /// 计算各阶段 p50/p90，并将当前启动的镜像启动开销与之前启动的中位数比较
+    ///
+    /// 本次启动的记录由后台线程在 main() 标记后写入，调用时可能尚未落盘：
+    /// 最后一条记录的进程启动时间与 `currentProcessStartUnixMicros` 不一致时，全部记录仅作为基线，不做回退比较
+    /// - Parameters:
+    ///   - regressionRatio: 开销达到基线中位数的该倍数才视为回退
+    ///   - minimumDeltaMs: 开销增量的最小值（毫秒），过滤微小镜像的噪声
+    ///   - minimumBaselineLaunches: 基线中至少出现的启动次数
+    ///   - currentProcessStartUnixMicros: 当前启动的进程启动时间（微秒），默认取本进程；
+    ///     nil 表示直接将最后一条记录视为当前启动（分析其他程序的历史文件时使用）
+    /// - Returns: 没有任何有效记录时返回 nil
+    public func trend(
+        regressionRatio: Double = 1.5,
+        minimumDeltaMs: Double = 1.0,
+        minimumBaselineLaunches: Int = 3,
+        currentProcessStartUnixMicros: UInt64? = PreMainMonitor.timestamps.processStartTimeUnixMicros
+    ) -> LaunchHistoryTrend? {
+        // 其他进程启动时可能覆盖正在读取的槽位：先复制记录与镜像，复制完成后仍有效才采用
+        let records = records.compactMap { $0.copy() }
+        guard let last = records.last else { return nil }
+        let includesCurrentLaunch = currentProcessStartUnixMicros.map { last.raw.processStartUnixMicros == $0 } ?? true
+        let latest = includesCurrentLaunch ? last : nil
+
+        // 同一文件内名称偏移相同即为同一镜像，无需构造字符串
+        var baselineNanos: [UInt32: [UInt64]] = [:]
+        for record in includesCurrentLaunch ? records.dropLast() : records[...] {
+            for image in record.images where image.nameOffset != 0 {
+                baselineNanos[image.nameOffset, default: []].append(image.launchCostNanos)
+            }
+        }
+
+        var regressions: [LaunchImageRegression] = []
+        for image in latest?.images ?? [] where image.nameOffset != 0 {
+            guard let samples = baselineNanos[image.nameOffset], samples.count >= minimumBaselineLaunches else {
+                continue
+            }
+            let baselineMs = LaunchHistoryPercentiles(nanos: samples).p50Ms
+            let currentMs = Double(image.launchCostNanos) / 1_000_000
+            guard currentMs >= baselineMs * regressionRatio, currentMs - baselineMs >= minimumDeltaMs else {
+                continue
+            }
+            regressions.append(LaunchImageRegression(
+                name: name(at: image.nameOffset),
+                currentMs: currentMs,
+                baselineP50Ms: baselineMs,
+                baselineLaunches: samples.count
+            ))
+        }
+        regressions.sort { $0.currentMs - $0.baselineP50Ms > $1.currentMs - $1.baselineP50Ms }
+
+        return LaunchHistoryTrend(
+            launchCount: records.count,
+            totalPreMain: LaunchHistoryPercentiles(nanos: records.map(\.raw.totalPreMainNanos)),
+            dylibLoading: LaunchHistoryPercentiles(nanos: records.map(\.raw.dylibLoadingNanos)),
+            staticInitializer: LaunchHistoryPercentiles(nanos: records.map(\.raw.staticInitializerNanos)),
+            postDyldToMain: LaunchHistoryPercentiles(nanos: records.map(\.raw.postDyldToMainNanos)),
+            includesCurrentLaunch: includesCurrentLaunch,
+            latestTotalPreMainMs: latest.map { Double($0.raw.totalPreMainNanos) / 1_000_000 },
+            regressedImages: regressions
+        )
+    }
+}
+
+// MARK: - LaunchHistoryRecord
+
+/// 一次启动的记录（直接引用映射内存，持有 LaunchHistory 以保证映射有效）
+public struct LaunchHistoryRecord {
+    private let history: LaunchHistory
+    private let pointer: UnsafePointer<DPLaunchHistoryRecord>
+
+    /// 启动序号（从 1 开始）
+    public let sequence: UInt64
+
+    init(history: LaunchHistory, pointer: UnsafePointer<DPLaunchHistoryRecord>) {
+        self.history = history
+        self.pointer = pointer
+        sequence = pointer.pointee.sequence
+    }
+
+    /// 映射中的原始记录
+    var raw: DPLaunchHistoryRecord {
+        pointer.pointee
+    }
+
+    /// 记录是否仍有效（其他进程启动时可能覆盖最旧的槽位）
+    public var isValid: Bool {
+        pointer.pointee.sequence == sequence
+    }
+
+    /// 进程启动时间
+    public var processStartDate: Date? {
+        let micros = pointer.pointee.processStartUnixMicros
+        return micros > 0 ? Date(timeIntervalSince1970: Double(micros) / 1_000_000) : nil
+    }
+
+    /// 各阶段耗时（毫秒）
+    public var durations: PreMainDurations {
+        let record = pointer.pointee
+        return PreMainDurations(
+            totalPreMainMs: Double(record.totalPreMainNanos) / 1_000_000,
+            dylibLoadingMs: Double(record.dylibLoadingNanos) / 1_000_000,
+            objcLoadMs: Double(record.objcLoadNanos) / 1_000_000,
+            staticInitializerMs: Double(record.staticInitializerNanos) / 1_000_000,
+            postDyldToMainMs: Double(record.postDyldToMainNanos) / 1_000_000,
+            estimatedKernelToConstructorMs: Double(record.estimatedKernelToConstructorNanos) / 1_000_000
+        )
+    }
+
+    /// 各阶段缺页与读盘统计
+    public var phaseFaults: PreMainPhaseFaults {
+        PreMainPhaseFaults(from: pointer.pointee.phaseFaults)
+    }
+
+    /// dylib 总数
+    public var dylibCount: Int {
+        Int(pointer.pointee.dylibCount)
+    }
+
+    /// 复制记录与镜像，复制后槽位已被覆盖时返回 nil
+    func copy() -> LaunchHistoryRecordCopy? {
+        let raw = pointer.pointee
+        let count = min(Int(raw.imageCount), Int(DP_LAUNCH_HISTORY_MAX_IMAGES))
+        let images = Array(UnsafeBufferPointer(start: DPLaunchHistoryGetImages(pointer), count: count))
+        guard raw.sequence == sequence, isValid else { return nil }
+        return LaunchHistoryRecordCopy(raw: raw, images: images)
+    }
+
+    /// 记录的镜像（按启动开销降序，开销相同时按 fixup 数与段大小降序）
+    public var images: LaunchHistoryImages {
+        LaunchHistoryImages(
+            history: history,
+            buffer: UnsafeBufferPointer(start: DPLaunchHistoryGetImages(pointer), count: Int(pointer.pointee.imageCount))
+        )
+    }
+}
+
+// MARK: - LaunchHistoryRecordCopy
+
+/// 复制后确认有效的记录（趋势分析使用，不再引用映射内存）
+struct LaunchHistoryRecordCopy {
+    let raw: DPLaunchHistoryRecord
+    let images: [DPLaunchHistoryImage]
+}
+
+extension DPLaunchHistoryImage {
+    /// 启动开销（纳秒，加载耗时 + 初始化器耗时）
+    var launchCostNanos: UInt64 {
+        loadDurationNanos &+ initializerNanos
+    }
+}
+
+// MARK: - LaunchHistoryImages
+
+/// 一次启动中记录的镜像（映射内存上的只读集合）
+public struct LaunchHistoryImages: RandomAccessCollection {
+    private let history: LaunchHistory
+    private let buffer: UnsafeBufferPointer<DPLaunchHistoryImage>
+
+    init(history: LaunchHistory, buffer: UnsafeBufferPointer<DPLaunchHistoryImage>) {
+        self.history = history
+        self.buffer = buffer
+    }
+
+    public var startIndex: Int { 0 }
+    public var endIndex: Int { buffer.count }
+
+    public subscript(position: Int) -> LaunchHistoryImage {
+        LaunchHistoryImage(history: history, raw: buffer[position])
+    }
+}
+
+/// 启动记录中单个镜像的加载开销
+public struct LaunchHistoryImage {
+    private let history: LaunchHistory
+    private let raw: DPLaunchHistoryImage
+
+    init(history: LaunchHistory, raw: DPLaunchHistoryImage) {
+        self.history = history
+        self.raw = raw
+    }
+
+    /// 名称在历史文件名称表中的偏移（同一文件内可直接作为镜像标识比较）
+    public var nameOffset: UInt32 { raw.nameOffset }
+
+    /// 镜像文件名
+    public var name: String { history.name(at: raw.nameOffset) }
+
+    /// 加载耗时（纳秒，dlopen 入口 -> 回调）
+    public var loadDurationNanos: UInt64 { raw.loadDurationNanos }
+
+    /// 加载耗时（毫秒，dlopen 入口 -> 回调）
+    public var loadDurationMs: Double { Double(raw.loadDurationNanos) / 1_000_000 }
+
+    /// 已计时的静态初始化器耗时合计（纳秒）
+    public var initializerNanos: UInt64 { raw.initializerNanos }
+
+    /// 已计时的静态初始化器耗时合计（毫秒）
+    public var initializerMs: Double { Double(raw.initializerNanos) / 1_000_000 }
+
+    /// 启动开销（毫秒，加载耗时 + 初始化器耗时，趋势分析按此比较）
+    public var launchCostMs: Double { loadDurationMs + initializerMs }
+
+    /// 是否为系统库
+    public var isSystemLibrary: Bool { raw.flags & DP_LAUNCH_HISTORY_IMAGE_SYSTEM != 0 }
+
+    /// minor / major page fault 数量
+    public var minorFaults: Int { Int(raw.minorFaults) }
+    public var majorFaults: Int { Int(raw.majorFaults) }
+}
+
+// MARK: - LaunchHistoryTrend
+
+/// 跨启动趋势
+public struct LaunchHistoryTrend: Codable, Sendable {
+    /// 参与统计的启动次数
+    public let launchCount: Int
+    /// 各阶段耗时分位数
+    public let totalPreMain: LaunchHistoryPercentiles
+    public let dylibLoading: LaunchHistoryPercentiles
+    public let staticInitializer: LaunchHistoryPercentiles
+    public let postDyldToMain: LaunchHistoryPercentiles
+    /// 历史中是否已包含当前启动（后台写入尚未完成时为 false，此时不做回退比较）
+    public let includesCurrentLaunch: Bool
+    /// 当前启动的 PreMain 总耗时（毫秒，不含当前启动时为 nil）
+    public let latestTotalPreMainMs: Double?
+    /// 当前启动中启动开销回退的镜像（按增量降序）
+    public let regressedImages: [LaunchImageRegression]
+}
+
+/// 耗时分位数（毫秒，最近邻秩）
+public struct LaunchHistoryPercentiles: Codable, Sendable {
+    public let p50Ms: Double
+    public let p90Ms: Double
+
+    init(nanos: [UInt64]) {
+        let sorted = nanos.sorted()
+        let percentile = { (fraction: Double) -> Double in
+            guard !sorted.isEmpty else { return 0 }
+            let rank = Int((fraction * Double(sorted.count)).rounded(.up))
+            return Double(sorted[min(max(rank, 1), sorted.count) - 1]) / 1_000_000
+        }
+        p50Ms = percentile(0.5)
+        p90Ms = percentile(0.9)
+    }
+}
+
+/// 镜像启动开销回退
+public struct LaunchImageRegression: Codable, Sendable {
+    /// 镜像文件名
+    public let name: String
+    /// 当前启动的启动开销（毫秒，加载耗时 + 初始化器耗时）
+    public let currentMs: Double
+    /// 之前启动的启动开销中位数（毫秒）
+    public let baselineP50Ms: Double
+    /// 基线中出现该镜像的启动次数
+    public let baselineLaunches: Int
+}
@@ -35,7 +35,22 @@ import Foundation
 /// ```swift
 /// let slowestDylibs = PreMainMonitor.getSlowestDylibs(count: 10)
 /// for dylib in slowestDylibs {
-///     print("\(dylib.name): \(dylib.loadDurationMs)ms")
+///     print("\(dylib.name): \(dylib.launchCostMs)ms")
+/// }
+/// ```
+///
+/// 4. 记录 main 之后的启动里程碑（无锁，可在正式版本中保留）：
+/// ```swift
+/// PreMainMonitor.markBegin("load_config")
+/// loadConfig()
+/// PreMainMonitor.markEnd("load_config")
+/// PreMainMonitor.mark("home_ready")
+/// ```
+///
+/// 5. 获取静态初始化器耗时：
+/// ```swift
+/// for initializer in PreMainMonitor.getSlowestInitializers(count: 10) {
+///     print("\(initializer.displayName): \(initializer.durationMs)ms")
 /// }
 /// ```
 public enum PreMainMonitor {
@@ -57,84 +72,304 @@ public enum PreMainMonitor {
         DPPreMainMarkObjCLoadEnd()
     }
 
-    /// 获取 PreMain 各阶段耗时
-    public static var durations: PreMainDurations {
-        guard let data = DPPreMainGetData() else {
-            return PreMainDurations()
+    /// 获取一致的 PreMain 数据快照
+    /// C 层通过顺序锁无锁复制，时间戳、耗时、统计与 dylib 列表来自同一时刻，不会读到中间状态
+    /// - Parameter includeDylibs: 是否同时复制 dylib 列表
+    public static func snapshot(includeDylibs: Bool = false) -> PreMainSnapshot {
+        var data = DPPreMainData()
+        guard includeDylibs else {
+            let sequence = DPPreMainCopySnapshot(&data, nil)
+            return PreMainSnapshot(sequence: sequence, data: data, dylibs: [])
         }
-        let dur = data.pointee.durations
-        return PreMainDurations(
-            totalPreMainMs: dur.totalPreMainMs,
-            dylibLoadingMs: dur.dylibLoadingMs,
-            objcLoadMs: dur.objcLoadMs,
-            staticInitializerMs: dur.staticInitializerMs,
-            postDyldToMainMs: dur.postDyldToMainMs,
-            estimatedKernelToConstructorMs: dur.estimatedKernelToConstructorMs
+
+        // 列缓冲区容量不足时（期间有新镜像解析）扩容后重试
+        var capacity = Int(DP_DYLIB_CHUNK_CAPACITY)
+        while true {
+            let buffers = DylibColumnBuffers(capacity: capacity)
+            defer { buffers.deallocate() }
+
+            var columns = buffers.columns
+            let sequence = DPPreMainCopySnapshot(&data, &columns)
+            if columns.totalCount > columns.capacity {
+                capacity = Int(columns.totalCount) + Int(DP_DYLIB_CHUNK_CAPACITY)
+                continue
+            }
+            return PreMainSnapshot(sequence: sequence, data: data, dylibs: buffers.dylibs(count: Int(columns.count)))
+        }
+    }
+
+    // MARK: - 自定义标记
+
+    /// 记录单点标记
+    /// - Parameter name: 标记名称（静态字符串，C 层只保存指针）
+    public static func mark(_ name: StaticString) {
+        guard name.hasPointerRepresentation else { return }
+        DPMark(cName(name))
+    }
+
+    /// 记录区间开始（与同一线程上同名的 markEnd 配对）
+    public static func markBegin(_ name: StaticString) {
+        guard name.hasPointerRepresentation else { return }
+        DPMarkBegin(cName(name))
+    }
+
+    /// 记录区间结束
+    public static func markEnd(_ name: StaticString) {
+        guard name.hasPointerRepresentation else { return }
+        DPMarkEnd(cName(name))
+    }
+
+    /// 获取当前记录的启动标记（按写入顺序）
+    /// 区间结束标记会与同一线程上最近的同名开始标记配对并计算耗时；
+    /// 偏移以 main() 标记为基准，未标记时以 constructor 为基准
+    public static func launchMarkers() -> LaunchMarkerSnapshot {
+        var buffer = [DPMarkEvent](repeating: DPMarkEvent(), count: Int(DP_MARK_RING_CAPACITY))
+        var overwrittenCount: UInt64 = 0
+        let count = Int(DPMarkCopyEvents(&buffer, UInt32(buffer.count), &overwrittenCount))
+
+        let timestamps = snapshot().timestamps
+        let referenceMachTime = timestamps.mainExecutedMachTime > 0
+            ? timestamps.mainExecutedMachTime
+            : timestamps.constructorMachTime
+
+        var openBegins: [String: [UInt64]] = [:]
+        let markers = buffer.prefix(count).map { event -> LaunchMarker in
+            let name = event.name.map { String(cString: $0) } ?? ""
+            let kind = LaunchMarkerKind(rawValue: Int(event.kind)) ?? .instant
+            let pairKey = "\(event.threadId):\(name)"
+
+            var durationNanos: UInt64?
+            switch kind {
+            case .begin:
+                openBegins[pairKey, default: []].append(event.machTime)
+            case .end:
+                if let beginMachTime = openBegins[pairKey]?.popLast(), event.machTime >= beginMachTime {
+                    durationNanos = DPMachTimeToNanos(event.machTime - beginMachTime)
+                }
+            case .instant:
+                break
+            }
+
+            let offsetMs = event.machTime >= referenceMachTime
+                ? DPMachTimeToMillis(event.machTime - referenceMachTime)
+                : -DPMachTimeToMillis(referenceMachTime - event.machTime)
+
+            return LaunchMarker(
+                name: name,
+                kind: kind,
+                machTime: event.machTime,
+                offsetMs: offsetMs,
+                durationNanos: durationNanos,
+                threadId: event.threadId,
+                isMainThread: event.isMainThread
+            )
+        }
+
+        return LaunchMarkerSnapshot(markers: markers, overwrittenCount: Int(overwrittenCount))
+    }
+
+    /// 静态字符串的 C 指针（进程生命周期内有效）
+    private static func cName(_ name: StaticString) -> UnsafePointer<CChar> {
+        UnsafeRawPointer(name.utf8Start).assumingMemoryBound(to: CChar.self)
+    }
+
+    // MARK: - 代码页访问追踪
+
+    /// 启用/禁用代码页访问追踪（需在 main() 标记之前调用，或设置环境变量 DP_PREMAIN_PAGE_TRACE=1）
+    public static func setPageTraceEnabled(_ enabled: Bool) {
+        DPPreMainSetPageTraceEnabled(enabled)
+    }
+
+    /// 标记启动完成（如首帧渲染完成），采样此时的常驻代码页
+    public static func markLaunchComplete() {
+        DPPreMainMarkLaunchComplete()
+    }
+
+    /// 代码页访问追踪统计，未采样时为 nil
+    public static var pageTraceStats: PageTraceStats? {
+        var stats = DPPageTraceStats()
+        guard DPPreMainGetPageTraceStats(&stats) else { return nil }
+        return PageTraceStats(
+            imageCount: Int(stats.imageCount),
+            pageSize: Int(stats.pageSize),
+            textPageCount: Int(stats.textPageCount),
+            residentAtMainCount: Int(stats.residentAtMainCount),
+            residentAtLaunchCompleteCount: Int(stats.residentAtLaunchCompleteCount),
+            launchCompleteCaptured: stats.launchCompleteCaptured
+        )
+    }
+
+    /// 导出链接器 order file 到文件描述符（不会关闭 fd）
+    /// - Parameters:
+    ///   - fileDescriptor: 可写文件描述符
+    ///   - imageName: 只导出路径以该名称结尾的镜像，nil 导出全部用户镜像
+    /// - Returns: 写出的符号数量，未采样或写入失败返回 nil
+    @discardableResult
+    public static func exportOrderFile(to fileDescriptor: Int32, imageName: String? = nil) -> Int? {
+        let written = imageName.map { DPPreMainExportOrderFileToFileDescriptor(fileDescriptor, $0) }
+            ?? DPPreMainExportOrderFileToFileDescriptor(fileDescriptor, nil)
+        return written >= 0 ? Int(written) : nil
+    }
+
+    // MARK: - 启动采样
+
+    /// 开始启动采样（通常通过环境变量 DP_PREMAIN_SAMPLE_LAUNCH=1 在 constructor 中开始，以覆盖 main() 之前）
+    /// - Parameter intervalMicros: 采样间隔（微秒），0 使用默认值 1000
+    /// - Returns: 平台不支持、已开始过或不在主线程（Apple）时返回 false
+    @discardableResult
+    public static func startLaunchSampler(intervalMicros: UInt32 = 0) -> Bool {
+        DPPreMainStartLaunchSampler(intervalMicros)
+    }
+
+    /// 停止启动采样（markLaunchComplete 也会停止）
+    public static func stopLaunchSampler() {
+        DPPreMainStopLaunchSampler()
+    }
+
+    /// 启动采样统计，从未开始采样时为 nil
+    public static var launchSamplerStats: LaunchSamplerStats? {
+        var stats = DPLaunchSamplerStats()
+        guard DPPreMainGetLaunchSamplerStats(&stats) else { return nil }
+        let stopMachTime = stats.stopMachTime > 0 ? stats.stopMachTime : DPGetCurrentMachTime()
+        return LaunchSamplerStats(
+            intervalMicros: Int(stats.intervalMicros),
+            sampleCount: Int(stats.sampleCount),
+            droppedCount: Int(stats.droppedCount),
+            isRunning: stats.running,
+            durationMs: stopMachTime > stats.startMachTime ? DPMachTimeToMillis(stopMachTime - stats.startMachTime) : 0
         )
     }
 
+    /// 符号化并导出折叠调用栈到文件描述符（不会关闭 fd，仍在采样时先停止）
+    /// - Returns: 写出的不同调用栈数量，从未采样或写入失败返回 nil
+    @discardableResult
+    public static func exportLaunchProfile(to fileDescriptor: Int32) -> Int? {
+        let written = DPPreMainExportLaunchProfileToFileDescriptor(fileDescriptor)
+        return written >= 0 ? Int(written) : nil
+    }
+
+    // MARK: - 时间线导出
+
+    /// 导出启动时间线为 Chrome Trace Event JSON（可在 Perfetto / chrome://tracing 直接打开）
+    /// 包含启动阶段、逐镜像加载、静态初始化器、main 与自定义标记
+    public static func exportChromeTrace() -> Data {
+        var capacity = DPPreMainExportChromeTrace(nil, 0) + 1
+        while true {
+            var data = Data(count: capacity)
+            let length = data.withUnsafeMutableBytes { buffer in
+                DPPreMainExportChromeTrace(buffer.baseAddress?.assumingMemoryBound(to: CChar.self), capacity)
+            }
+            // 两次导出之间可能有新标记写入，长度不足时按新长度重试
+            if length < capacity {
+                data.count = length
+                return data
+            }
+            capacity = length + 1
+        }
+    }
+
+    /// 导出启动时间线到文件描述符（不会关闭 fd）
+    /// - Returns: 写出的字节数，写入失败返回 nil
+    @discardableResult
+    public static func exportChromeTrace(to fileDescriptor: Int32) -> Int? {
+        let written = DPPreMainExportChromeTraceToFileDescriptor(fileDescriptor)
+        return written >= 0 ? Int(written) : nil
+    }
+
+    // MARK: - dlopen 耗时
+
+    /// dlopen / dlclose 钩子是否已挂接（未挂接时无法开启计时）
+    public static var isDlopenTracingAvailable: Bool {
+        DPPreMainIsDlopenTracingAvailable()
+    }
+
+    /// 启用/禁用 dlopen / dlclose 计时
+    ///
+    /// 需要挂接钩子才会产生事件：Apple 以 DP_PREMAIN_DLOPEN_INTERPOSE=1 编译（以 Swift Package 依赖集成时无法定义），
+    /// Linux 以 -Wl,--wrap=dlopen,--wrap=dlclose 链接；启动期间的 dlopen 需设置环境变量 DP_PREMAIN_TRACE_DLOPEN=1
+    /// - Returns: 钩子未挂接时开启返回 false，计时保持关闭
+    @discardableResult
+    public static func setDlopenTracingEnabled(_ enabled: Bool) -> Bool {
+        DPPreMainSetDlopenTracingEnabled(enabled)
+    }
+
+    /// 获取序号大于 sequence 的 dlopen / dlclose 事件（按序号升序）
+    /// - Parameter sequence: 上次获取到的最大序号，0 表示从最早的事件开始
+    public static func dlopenEvents(after sequence: UInt64 = 0) -> DlopenEventSnapshot {
+        var buffer = [DPDlopenEvent](repeating: DPDlopenEvent(), count: Int(DP_DLOPEN_RING_CAPACITY))
+        var overwrittenCount: UInt64 = 0
+        let count = Int(DPPreMainCopyDlopenEvents(&buffer, UInt32(buffer.count), sequence, &overwrittenCount))
+
+        let events = buffer.prefix(count).map { event in
+            DlopenEvent(
+                sequence: event.sequence,
+                path: String(cString: DPPreMainGetInternedString(event.pathOffset)),
+                kind: event.kind == DPDlopenKindClose.rawValue ? .close : .open,
+                machTime: event.startMachTime,
+                durationNanos: event.durationNanos,
+                threadId: event.threadId,
+                isMainThread: event.isMainThread,
+                succeeded: event.succeeded
+            )
+        }
+        return DlopenEventSnapshot(events: events, overwrittenCount: Int(overwrittenCount))
+    }
+
+    // MARK: - 数据查询
+
+    /// 获取 PreMain 各阶段耗时
+    public static var durations: PreMainDurations {
+        snapshot().durations
+    }
+
     /// 获取 PreMain 时间戳
     public static var timestamps: PreMainTimestamps {
-        guard let data = DPPreMainGetData() else {
-            return PreMainTimestamps()
-        }
-        let ts = data.pointee.timestamps
-        return PreMainTimestamps(
-            processStartTimeUnixMicros: ts.processStartTimeUnixMicros,
-            constructorMachTime: ts.constructorMachTime,
-            firstDyldCallbackMachTime: ts.firstDyldCallbackMachTime,
-            lastDyldCallbackMachTime: ts.lastDyldCallbackMachTime,
-            mainExecutedMachTime: ts.mainExecutedMachTime,
-            objcLoadStartMachTime: ts.objcLoadStartMachTime,
-            objcLoadEndMachTime: ts.objcLoadEndMachTime
-        )
+        snapshot().timestamps
+    }
+
+    /// 获取 PreMain 各阶段缺页与读盘统计（main 标记后有效）
+    public static var phaseFaults: PreMainPhaseFaults {
+        snapshot().phaseFaults
     }
 
     /// 获取 dylib 统计信息
     public static var dylibStats: DylibStats {
-        guard let data = DPPreMainGetData() else {
-            return DylibStats()
-        }
-        return DylibStats(
-            totalCount: Int(data.pointee.dylibCount),
-            systemCount: Int(data.pointee.systemDylibCount),
-            userCount: Int(data.pointee.userDylibCount)
-        )
+        snapshot().dylibStats
     }
 
     /// main() 是否已标记执行
     public static var isMainExecutedMarked: Bool {
-        guard let data = DPPreMainGetData() else {
-            return false
-        }
-        return data.pointee.mainExecutedMarked
+        snapshot().isMainExecutedMarked
     }
 
     /// 获取所有 dylib 加载信息
     public static func getAllDylibs() -> [DylibLoadInfo] {
-        guard let data = DPPreMainGetData() else {
-            return []
-        }
+        snapshot(includeDylibs: true).dylibs
+    }
 
-        let count = min(Int(data.pointee.dylibCount), Int(DP_MAX_DYLIB_COUNT))
+    /// 获取启动开销最大的 N 个 dylib
+    /// 按 launchCostMs 降序；启动时加载的镜像无法单独测量映射与修正耗时，开销相同时按修正数量、再按段大小排序
+    /// - Parameter count: 请求的数量
+    /// - Returns: 按开销降序排列的 dylib 列表
+    public static func getSlowestDylibs(count: Int) -> [DylibLoadInfo] {
         guard count > 0 else { return [] }
 
         var buffer = [DPDylibLoadInfo](repeating: DPDylibLoadInfo(), count: count)
-        let actualCount = DPPreMainGetAllDylibs(&buffer, UInt32(count))
+        let actualCount = DPPreMainGetSlowestDylibs(&buffer, UInt32(count))
 
         return buffer.prefix(Int(actualCount)).map { DylibLoadInfo(from: $0) }
     }
 
-    /// 获取加载耗时最长的 N 个 dylib
+    /// 获取执行耗时最长的 N 个静态初始化器
     /// - Parameter count: 请求的数量
-    /// - Returns: 按耗时降序排列的 dylib 列表
-    public static func getSlowestDylibs(count: Int) -> [DylibLoadInfo] {
+    /// - Returns: 按耗时降序排列的初始化器列表（仅用户镜像）
+    public static func getSlowestInitializers(count: Int) -> [InitializerTiming] {
         guard count > 0 else { return [] }
 
-        var buffer = [DPDylibLoadInfo](repeating: DPDylibLoadInfo(), count: count)
-        let actualCount = DPPreMainGetSlowestDylibs(&buffer, UInt32(count))
+        var buffer = [DPInitializerInfo](repeating: DPInitializerInfo(), count: count)
+        let actualCount = DPPreMainGetSlowestInitializers(&buffer, UInt32(count))
 
-        return buffer.prefix(Int(actualCount)).map { DylibLoadInfo(from: $0) }
+        return buffer.prefix(Int(actualCount)).map { InitializerTiming(from: $0) }
     }
 
     /// 获取用户库列表（非系统库）
@@ -147,6 +382,21 @@ public enum PreMainMonitor {
         getAllDylibs().filter(\.isSystemLibrary)
     }
 
+    /// 启用/禁用逐镜像缺页统计
+    /// - Parameter enabled: 是否启用
+    ///
+    /// 启动批次的镜像在 constructor 中即完成回调，需在启动前设置环境变量 DP_PREMAIN_PER_IMAGE_FAULTS=1；
+    /// 运行时调用只影响之后加载的镜像
+    public static func setPerImageFaultsEnabled(_ enabled: Bool) {
+        DPPreMainSetPerImageFaultsEnabled(enabled)
+    }
+
+    /// 设置 dylib 记录内存上限
+    /// - Parameter bytes: 最大字节数，达到上限后停止记录新镜像
+    public static func setDylibMemoryLimit(_ bytes: Int) {
+        DPPreMainSetDylibMemoryLimit(max(0, bytes))
+    }
+
     /// 启用/禁用 dylib 细分记录
     /// - Parameter enabled: 是否启用
     ///
@@ -170,12 +420,318 @@ public enum PreMainMonitor {
         DPMachTimeToNanos(machTime)
     }
 
+    /// 批量将 mach_absolute_time 转换为纳秒
+    public static func machTimesToNanos(_ machTimes: [UInt64]) -> [UInt64] {
+        guard !machTimes.isEmpty else { return [] }
+        var nanos = [UInt64](repeating: 0, count: machTimes.count)
+        machTimes.withUnsafeBufferPointer { input in
+            nanos.withUnsafeMutableBufferPointer { output in
+                DPMachTimesToNanos(input.baseAddress, output.baseAddress, input.count)
+            }
+        }
+        return nanos
+    }
+
     /// 重置所有记录（仅用于测试）
     public static func reset() {
         DPPreMainReset()
     }
 }
 
+// MARK: - PreMainSnapshot
+
+/// PreMain 数据快照（一次复制得到的一致状态）
+public struct PreMainSnapshot: Codable, Sendable {
+    /// 快照序号（数据每次变化后递增）
+    public let sequence: UInt64
+
+    /// 时间戳
+    public let timestamps: PreMainTimestamps
+
+    /// 各阶段耗时
+    public let durations: PreMainDurations
+
+    /// 各阶段缺页与读盘统计
+    public let phaseFaults: PreMainPhaseFaults
+
+    /// dylib 统计
+    public let dylibStats: DylibStats
+
+    /// main() 是否已标记执行
+    public let isMainExecutedMarked: Bool
+
+    /// dylib 列表（按加载顺序，仅 includeDylibs 时填充）
+    public let dylibs: [DylibLoadInfo]
+
+    /// 从 C 结构体初始化
+    init(sequence: UInt64, data: DPPreMainData, dylibs: [DylibLoadInfo]) {
+        self.sequence = sequence
+
+        let ts = data.timestamps
+        timestamps = PreMainTimestamps(
+            processStartTimeUnixMicros: ts.processStartTimeUnixMicros,
+            constructorMachTime: ts.constructorMachTime,
+            firstDyldCallbackMachTime: ts.firstDyldCallbackMachTime,
+            lastDyldCallbackMachTime: ts.lastDyldCallbackMachTime,
+            mainExecutedMachTime: ts.mainExecutedMachTime,
+            objcLoadStartMachTime: ts.objcLoadStartMachTime,
+            objcLoadEndMachTime: ts.objcLoadEndMachTime
+        )
+
+        let dur = data.durations
+        durations = PreMainDurations(
+            totalPreMainMs: dur.totalPreMainMs,
+            dylibLoadingMs: dur.dylibLoadingMs,
+            objcLoadMs: dur.objcLoadMs,
+            staticInitializerMs: dur.staticInitializerMs,
+            postDyldToMainMs: dur.postDyldToMainMs,
+            estimatedKernelToConstructorMs: dur.estimatedKernelToConstructorMs,
+            estimatedKernelToConstructorErrorMs: dur.estimatedKernelToConstructorErrorMs
+        )
+
+        phaseFaults = PreMainPhaseFaults(from: data.phaseFaults)
+
+        dylibStats = DylibStats(
+            totalCount: Int(data.dylibCount),
+            systemCount: Int(data.systemDylibCount),
+            userCount: Int(data.userDylibCount),
+            droppedCount: Int(data.droppedDylibCount),
+            timedInitializerCount: Int(data.timedInitializerCount),
+            untimedInitializerCount: Int(data.untimedInitializerCount)
+        )
+
+        isMainExecutedMarked = data.mainExecutedMarked
+        self.dylibs = dylibs
+    }
+}
+
+// MARK: - DylibColumnBuffers
+
+/// DPDylibColumns 各列的缓冲区（调用方负责释放）
+private struct DylibColumnBuffers {
+    let capacity: Int
+    let loadStartMachTimes: UnsafeMutablePointer<UInt64>
+    let loadMachTimes: UnsafeMutablePointer<UInt64>
+    let loadDurationNanos: UnsafeMutablePointer<UInt64>
+    let nameOffsets: UnsafeMutablePointer<UInt32>
+    let isSystemLibrary: UnsafeMutablePointer<Bool>
+    let slides: UnsafeMutablePointer<Int>
+    let minorFaults: UnsafeMutablePointer<UInt32>
+    let majorFaults: UnsafeMutablePointer<UInt32>
+    let imageStats: UnsafeMutablePointer<DPImageStats>
+    let loadFlags: UnsafeMutablePointer<UInt32>
+    let initializerNanos: UnsafeMutablePointer<UInt64>
+
+    init(capacity: Int) {
+        self.capacity = capacity
+        loadStartMachTimes = .allocate(capacity: capacity)
+        loadMachTimes = .allocate(capacity: capacity)
+        loadDurationNanos = .allocate(capacity: capacity)
+        nameOffsets = .allocate(capacity: capacity)
+        isSystemLibrary = .allocate(capacity: capacity)
+        slides = .allocate(capacity: capacity)
+        minorFaults = .allocate(capacity: capacity)
+        majorFaults = .allocate(capacity: capacity)
+        imageStats = .allocate(capacity: capacity)
+        loadFlags = .allocate(capacity: capacity)
+        initializerNanos = .allocate(capacity: capacity)
+    }
+
+    /// 指向各列的 C 视图
+    var columns: DPDylibColumns {
+        var columns = DPDylibColumns()
+        columns.capacity = UInt32(capacity)
+        columns.loadStartMachTimes = loadStartMachTimes
+        columns.loadMachTimes = loadMachTimes
+        columns.loadDurationNanos = loadDurationNanos
+        columns.nameOffsets = nameOffsets
+        columns.isSystemLibrary = isSystemLibrary
+        columns.slides = slides
+        columns.minorFaults = minorFaults
+        columns.majorFaults = majorFaults
+        columns.imageStats = imageStats
+        columns.loadFlags = loadFlags
+        columns.initializerNanos = initializerNanos
+        return columns
+    }
+
+    /// 组装前 count 条记录
+    func dylibs(count: Int) -> [DylibLoadInfo] {
+        (0..<count).map { i in
+            DylibLoadInfo(
+                name: String(cString: DPPreMainGetInternedString(nameOffsets[i])),
+                loadStartMachTime: loadStartMachTimes[i],
+                loadMachTime: loadMachTimes[i],
+                loadDurationNanos: loadDurationNanos[i],
+                initializerNanos: initializerNanos[i],
+                isLoadTimed: loadFlags[i] & UInt32(DP_DYLIB_LOAD_TIMED) != 0,
+                isReplayed: loadFlags[i] & UInt32(DP_DYLIB_LOAD_REPLAYED) != 0,
+                isSystemLibrary: isSystemLibrary[i],
+                slide: slides[i],
+                minorFaults: Int(minorFaults[i]),
+                majorFaults: Int(majorFaults[i]),
+                imageStats: DylibImageStats(from: imageStats[i])
+            )
+        }
+    }
+
+    func deallocate() {
+        loadStartMachTimes.deallocate()
+        loadMachTimes.deallocate()
+        loadDurationNanos.deallocate()
+        nameOffsets.deallocate()
+        isSystemLibrary.deallocate()
+        slides.deallocate()
+        minorFaults.deallocate()
+        majorFaults.deallocate()
+        imageStats.deallocate()
+        loadFlags.deallocate()
+        initializerNanos.deallocate()
+    }
+}
+
+// MARK: - LaunchMarker
+
+/// 启动标记类型
+public enum LaunchMarkerKind: Int, Codable, Sendable {
+    /// 单点标记
+    case instant = 0
+    /// 区间开始
+    case begin = 1
+    /// 区间结束
+    case end = 2
+}
+
+/// 启动标记
+public struct LaunchMarker: Codable, Sendable {
+    /// 标记名称
+    public let name: String
+
+    /// 标记类型
+    public let kind: LaunchMarkerKind
+
+    /// 标记时的 mach_absolute_time
+    public let machTime: UInt64
+
+    /// 相对 main()（未标记时为 constructor）的偏移（毫秒）
+    public let offsetMs: Double
+
+    /// 区间耗时（纳秒，仅配对成功的区间结束标记有值）
+    public let durationNanos: UInt64?
+
+    /// 系统线程 ID
+    public let threadId: UInt64
+
+    /// 是否在主线程
+    public let isMainThread: Bool
+
+    /// 区间耗时（毫秒）
+    public var durationMs: Double? {
+        durationNanos.map { Double($0) / 1_000_000 }
+    }
+}
+
+/// 启动标记快照
+public struct LaunchMarkerSnapshot: Codable, Sendable {
+    /// 按写入顺序排列的标记
+    public let markers: [LaunchMarker]
+
+    /// 因环形缓冲区写满被覆盖的标记数量
+    public let overwrittenCount: Int
+}
+
+// MARK: - LaunchSamplerStats
+
+/// 启动采样统计
+public struct LaunchSamplerStats: Codable, Sendable {
+    /// 采样间隔（微秒）
+    public let intervalMicros: Int
+
+    /// 已记录的样本数量
+    public let sampleCount: Int
+
+    /// 缓冲区写满后丢弃的样本数量
+    public let droppedCount: Int
+
+    /// 是否仍在采样
+    public let isRunning: Bool
+
+    /// 采样持续时间（毫秒，仍在采样时截至当前）
+    public let durationMs: Double
+}
+
+// MARK: - PageTraceStats
+
+/// 代码页访问追踪统计
+public struct PageTraceStats: Codable, Sendable {
+    /// 采样的用户镜像数量
+    public let imageCount: Int
+
+    /// 页大小（字节）
+    public let pageSize: Int
+
+    /// 可执行段总页数
+    public let textPageCount: Int
+
+    /// main() 时常驻的页数
+    public let residentAtMainCount: Int
+
+    /// 启动完成时常驻的页数（含 main() 时已常驻的页）
+    public let residentAtLaunchCompleteCount: Int
+
+    /// 是否已采样启动完成时刻
+    public let launchCompleteCaptured: Bool
+}
+
+// MARK: - DlopenEvent
+
+/// dlopen / dlclose 调用类型
+public enum DlopenEventKind: String, Codable, Sendable {
+    case open
+    case close
+}
+
+/// 一次 dlopen / dlclose 调用
+public struct DlopenEvent: Codable, Sendable {
+    /// 事件序号（从 1 开始递增）
+    public let sequence: UInt64
+
+    /// 镜像路径（过长时保留末尾，找不到对应 dlopen 的 dlclose 为空）
+    public let path: String
+
+    /// 调用类型
+    public let kind: DlopenEventKind
+
+    /// 调用开始时的 mach_absolute_time
+    public let machTime: UInt64
+
+    /// 调用阻塞耗时（纳秒）
+    public let durationNanos: UInt64
+
+    /// 系统线程 ID
+    public let threadId: UInt64
+
+    /// 是否在主线程
+    public let isMainThread: Bool
+
+    /// 调用是否成功
+    public let succeeded: Bool
+
+    /// 调用阻塞耗时（毫秒）
+    public var durationMs: Double {
+        Double(durationNanos) / 1_000_000
+    }
+}
+
+/// dlopen / dlclose 事件快照
+public struct DlopenEventSnapshot: Codable, Sendable {
+    /// 按序号升序排列的事件
+    public let events: [DlopenEvent]
+
+    /// 请求的序号之后因环形缓冲区写满被覆盖的事件数量
+    public let overwrittenCount: Int
+}
+
 // MARK: - PreMainDurations
 
 /// PreMain 各阶段耗时（毫秒）
@@ -196,10 +752,14 @@ public struct PreMainDurations: Codable, Sendable {
     /// last dyld callback 到 main（包含 Swift 静态初始化等）
     public let postDyldToMainMs: Double
 
-    /// 进程实际启动到 constructor 的估算时间（基于系统时间差）
+    /// 进程实际启动到 constructor 的估算时间（内核记录的启动时刻对齐到单调时钟后求差）
     /// 包含内核加载、dyld 初始化等
     public let estimatedKernelToConstructorMs: Double
 
+    /// estimatedKernelToConstructorMs 的误差上界（毫秒）
+    /// Apple 为一个时钟计数，Linux 主要来自 /proc/self/stat 的滴答精度（通常 ±5ms）
+    public let estimatedKernelToConstructorErrorMs: Double
+
     /// 估算的完整 PreMain 时间（包含内核启动时间）
     public var estimatedFullPreMainMs: Double {
         estimatedKernelToConstructorMs + totalPreMainMs
@@ -211,7 +771,8 @@ public struct PreMainDurations: Codable, Sendable {
         objcLoadMs: Double = 0,
         staticInitializerMs: Double = 0,
         postDyldToMainMs: Double = 0,
-        estimatedKernelToConstructorMs: Double = 0
+        estimatedKernelToConstructorMs: Double = 0,
+        estimatedKernelToConstructorErrorMs: Double = 0
     ) {
         self.totalPreMainMs = totalPreMainMs
         self.dylibLoadingMs = dylibLoadingMs
@@ -219,6 +780,7 @@ public struct PreMainDurations: Codable, Sendable {
         self.staticInitializerMs = staticInitializerMs
         self.postDyldToMainMs = postDyldToMainMs
         self.estimatedKernelToConstructorMs = estimatedKernelToConstructorMs
+        self.estimatedKernelToConstructorErrorMs = estimatedKernelToConstructorErrorMs
     }
 }
 
@@ -273,6 +835,71 @@ public struct PreMainTimestamps: Codable, Sendable {
     }
 }
 
+// MARK: - ResourceUsage
+
+/// 资源使用差值（getrusage）
+public struct ResourceUsage: Codable, Sendable {
+    /// minor page fault 数量（无需 I/O）
+    public let minorFaults: UInt64
+
+    /// major page fault 数量（需从磁盘读入）
+    public let majorFaults: UInt64
+
+    /// 块设备读入次数
+    public let blockInputOps: UInt64
+
+    public init(minorFaults: UInt64 = 0, majorFaults: UInt64 = 0, blockInputOps: UInt64 = 0) {
+        self.minorFaults = minorFaults
+        self.majorFaults = majorFaults
+        self.blockInputOps = blockInputOps
+    }
+
+    /// 从 C 结构体初始化
+    init(from cUsage: DPResourceUsage) {
+        minorFaults = cUsage.minorFaults
+        majorFaults = cUsage.majorFaults
+        blockInputOps = cUsage.blockInputOps
+    }
+}
+
+// MARK: - PreMainPhaseFaults
+
+/// PreMain 各阶段缺页与读盘统计（阶段划分与 PreMainDurations 对应）
+/// 缺页多而耗时长通常为冷缓存启动，缺页持平而耗时增长通常为代码回退
+public struct PreMainPhaseFaults: Codable, Sendable {
+    /// constructor 到 main
+    public let total: ResourceUsage
+
+    /// first dyld callback 到 last dyld callback
+    public let dylibLoading: ResourceUsage
+
+    /// constructor 到 first dyld callback
+    public let staticInitializer: ResourceUsage
+
+    /// last dyld callback 到 main
+    public let postDyldToMain: ResourceUsage
+
+    public init(
+        total: ResourceUsage = ResourceUsage(),
+        dylibLoading: ResourceUsage = ResourceUsage(),
+        staticInitializer: ResourceUsage = ResourceUsage(),
+        postDyldToMain: ResourceUsage = ResourceUsage()
+    ) {
+        self.total = total
+        self.dylibLoading = dylibLoading
+        self.staticInitializer = staticInitializer
+        self.postDyldToMain = postDyldToMain
+    }
+
+    /// 从 C 结构体初始化
+    init(from cFaults: DPPreMainPhaseFaults) {
+        total = ResourceUsage(from: cFaults.total)
+        dylibLoading = ResourceUsage(from: cFaults.dylibLoading)
+        staticInitializer = ResourceUsage(from: cFaults.staticInitializer)
+        postDyldToMain = ResourceUsage(from: cFaults.postDyldToMain)
+    }
+}
+
 // MARK: - DylibStats
 
 /// dylib 统计信息
@@ -286,10 +913,29 @@ public struct DylibStats: Codable, Sendable {
     /// 用户库数量
     public let userCount: Int
 
-    public init(totalCount: Int = 0, systemCount: Int = 0, userCount: Int = 0) {
+    /// 因内存上限未能记录的数量
+    public let droppedCount: Int
+
+    /// 已单独计时的静态初始化器数量
+    public let timedInitializerCount: Int
+
+    /// 无法单独计时的静态初始化器数量
+    public let untimedInitializerCount: Int
+
+    public init(
+        totalCount: Int = 0,
+        systemCount: Int = 0,
+        userCount: Int = 0,
+        droppedCount: Int = 0,
+        timedInitializerCount: Int = 0,
+        untimedInitializerCount: Int = 0
+    ) {
         self.totalCount = totalCount
         self.systemCount = systemCount
         self.userCount = userCount
+        self.droppedCount = droppedCount
+        self.timedInitializerCount = timedInitializerCount
+        self.untimedInitializerCount = untimedInitializerCount
     }
 }
 
@@ -300,50 +946,217 @@ public struct DylibLoadInfo: Codable, Sendable {
     /// dylib 名称
     public let name: String
 
-    /// 加载时的 mach_absolute_time
+    /// 加载起点的 mach_absolute_time（dlopen 计时的镜像为 dlopen 入口时间，否则等于 loadMachTime）
+    public let loadStartMachTime: UInt64
+
+    /// 加载完成时的 mach_absolute_time
     public let loadMachTime: UInt64
 
-    /// 相对于监控开始的加载耗时（纳秒）
+    /// 加载耗时（纳秒），仅 isLoadTimed 时非 0
     public let loadDurationNanos: UInt64
 
+    /// 已计时的静态初始化器耗时合计（纳秒）；启动时加载的镜像只有这一项可测量的开销
+    public let initializerNanos: UInt64
+
+    /// 是否在已挂接的 dlopen 中加载（加载耗时与缺页统计有效）
+    public let isLoadTimed: Bool
+
+    /// 是否为注册回调时补发的已加载镜像（constructor 之前已加载完成，无单独的加载耗时）
+    public let isReplayed: Bool
+
     /// 是否为系统库
     public let isSystemLibrary: Bool
 
     /// 镜像基地址偏移
     public let slide: Int
 
+    /// 加载期间的 minor page fault 数量（需启用逐镜像缺页统计，仅 isLoadTimed 时有效）
+    public let minorFaults: Int
+
+    /// 加载期间的 major page fault 数量（需启用逐镜像缺页统计，仅 isLoadTimed 时有效）
+    public let majorFaults: Int
+
+    /// 修正数量与段大小（解析失败时为 nil）
+    public let imageStats: DylibImageStats?
+
     /// 加载耗时（毫秒）
     public var loadDurationMs: Double {
         Double(loadDurationNanos) / 1_000_000
     }
 
+    /// 已计时的静态初始化器耗时（毫秒）
+    public var initializerMs: Double {
+        Double(initializerNanos) / 1_000_000
+    }
+
+    /// 可测量的启动开销（毫秒）：加载耗时 + 已计时的静态初始化器耗时，getSlowestDylibs 按此排序
+    public var launchCostMs: Double {
+        loadDurationMs + initializerMs
+    }
+
+    /// 平均每个修正（rebase + bind）的加载耗时（毫秒），无加载耗时或修正信息时为 nil
+    public var msPerFixup: Double? {
+        guard isLoadTimed, let fixupCount = imageStats?.fixupCount, fixupCount > 0 else { return nil }
+        return loadDurationMs / Double(fixupCount)
+    }
+
     public init(
         name: String = "",
+        loadStartMachTime: UInt64 = 0,
         loadMachTime: UInt64 = 0,
         loadDurationNanos: UInt64 = 0,
+        initializerNanos: UInt64 = 0,
+        isLoadTimed: Bool = false,
+        isReplayed: Bool = false,
         isSystemLibrary: Bool = false,
-        slide: Int = 0
+        slide: Int = 0,
+        minorFaults: Int = 0,
+        majorFaults: Int = 0,
+        imageStats: DylibImageStats? = nil
     ) {
         self.name = name
+        self.loadStartMachTime = loadStartMachTime
         self.loadMachTime = loadMachTime
         self.loadDurationNanos = loadDurationNanos
+        self.initializerNanos = initializerNanos
+        self.isLoadTimed = isLoadTimed
+        self.isReplayed = isReplayed
         self.isSystemLibrary = isSystemLibrary
         self.slide = slide
+        self.minorFaults = minorFaults
+        self.majorFaults = majorFaults
+        self.imageStats = imageStats
     }
 
     /// 从 C 结构体初始化
     init(from cInfo: DPDylibLoadInfo) {
-        // 将 C 字符数组转换为 Swift String
-        let nameBytes = withUnsafePointer(to: cInfo.name) { ptr in
-            ptr.withMemoryRebound(to: CChar.self, capacity: Int(DP_MAX_DYLIB_NAME_LENGTH)) { charPtr in
-                String(cString: charPtr)
-            }
-        }
-        name = nameBytes
+        // 名称存储在 C 层驻留字符串区中
+        name = String(cString: DPPreMainGetInternedString(cInfo.nameOffset))
+        loadStartMachTime = cInfo.loadStartMachTime
         loadMachTime = cInfo.loadMachTime
         loadDurationNanos = cInfo.loadDurationNanos
+        initializerNanos = cInfo.initializerNanos
+        isLoadTimed = cInfo.loadFlags & UInt32(DP_DYLIB_LOAD_TIMED) != 0
+        isReplayed = cInfo.loadFlags & UInt32(DP_DYLIB_LOAD_REPLAYED) != 0
         isSystemLibrary = cInfo.isSystemLibrary
         slide = cInfo.slide
+        minorFaults = Int(cInfo.minorFaults)
+        majorFaults = Int(cInfo.majorFaults)
+        imageStats = DylibImageStats(from: cInfo.imageStats)
+    }
+}
+
+// MARK: - DylibImageStats
+
+/// 镜像静态统计（查询时延迟解析）
+public struct DylibImageStats: Codable, Sendable {
+    /// rebase 数量（Linux 为 RELATIVE / RELR 重定位）
+    public let rebaseCount: Int
+
+    /// bind 数量（含 lazy / weak bind，Linux 为符号重定位含 PLT）
+    public let bindCount: Int
+
+    /// 代码段大小（字节）
+    public let textSize: UInt64
+
+    /// 数据段大小（字节）
+    public let dataSize: UInt64
+
+    /// 静态初始化器数量
+    public let initializerCount: Int
+
+    /// 是否使用链式修正（修正数读取自磁盘文件）
+    public let usesChainedFixups: Bool
+
+    /// 是否位于 dyld 共享缓存中（修正已预先完成）
+    public let isInSharedCache: Bool
+
+    /// 修正总数
+    public var fixupCount: Int {
+        rebaseCount + bindCount
+    }
+
+    public init(
+        rebaseCount: Int = 0,
+        bindCount: Int = 0,
+        textSize: UInt64 = 0,
+        dataSize: UInt64 = 0,
+        initializerCount: Int = 0,
+        usesChainedFixups: Bool = false,
+        isInSharedCache: Bool = false
+    ) {
+        self.rebaseCount = rebaseCount
+        self.bindCount = bindCount
+        self.textSize = textSize
+        self.dataSize = dataSize
+        self.initializerCount = initializerCount
+        self.usesChainedFixups = usesChainedFixups
+        self.isInSharedCache = isInSharedCache
+    }
+
+    /// 从 C 结构体初始化（未解析时返回 nil）
+    init?(from cStats: DPImageStats) {
+        guard cStats.flags & UInt32(DP_IMAGE_STATS_AVAILABLE) != 0 else { return nil }
+        rebaseCount = Int(cStats.rebaseCount)
+        bindCount = Int(cStats.bindCount)
+        textSize = cStats.textSize
+        dataSize = cStats.dataSize
+        initializerCount = Int(cStats.initializerCount)
+        usesChainedFixups = cStats.flags & UInt32(DP_IMAGE_STATS_CHAINED_FIXUPS) != 0
+        isInSharedCache = cStats.flags & UInt32(DP_IMAGE_STATS_SHARED_CACHE) != 0
+    }
+}
+
+// MARK: - InitializerTiming
+
+/// 静态初始化器执行耗时
+public struct InitializerTiming: Codable, Sendable {
+    /// 所属镜像名称
+    public let imageName: String
+
+    /// 函数符号名（符号不可见时为空字符串）
+    public let symbolName: String
+
+    /// 函数地址
+    public let functionAddress: UInt
+
+    /// 开始执行时的 mach_absolute_time
+    public let startMachTime: UInt64
+
+    /// 执行耗时（纳秒）
+    public let durationNanos: UInt64
+
+    /// 执行耗时（毫秒）
+    public var durationMs: Double {
+        Double(durationNanos) / 1_000_000
+    }
+
+    /// 展示名称：优先使用符号名，否则为 镜像名+地址
+    public var displayName: String {
+        symbolName.isEmpty ? "\(imageName)+0x\(String(functionAddress, radix: 16))" : symbolName
+    }
+
+    public init(
+        imageName: String = "",
+        symbolName: String = "",
+        functionAddress: UInt = 0,
+        startMachTime: UInt64 = 0,
+        durationNanos: UInt64 = 0
+    ) {
+        self.imageName = imageName
+        self.symbolName = symbolName
+        self.functionAddress = functionAddress
+        self.startMachTime = startMachTime
+        self.durationNanos = durationNanos
+    }
+
+    /// 从 C 结构体初始化
+    init(from cInfo: DPInitializerInfo) {
+        imageName = String(cString: DPPreMainGetInternedString(cInfo.imageNameOffset))
+        symbolName = String(cString: DPPreMainGetInternedString(cInfo.symbolNameOffset))
+        functionAddress = UInt(bitPattern: cInfo.function)
+        startMachTime = cInfo.startMachTime
+        durationNanos = cInfo.durationNanos
     }
 }
 
@@ -358,7 +1171,7 @@ extension PreMainDurations: CustomStringConvertible {
           Static Initializers: \(String(format: "%.2f", staticInitializerMs))ms
           Post-dyld to main: \(String(format: "%.2f", postDyldToMainMs))ms
           ObjC +load: \(String(format: "%.2f", objcLoadMs))ms
-          Estimated Kernel -> Constructor: \(String(format: "%.2f", estimatedKernelToConstructorMs))ms
+          Estimated Kernel -> Constructor: \(String(format: "%.2f", estimatedKernelToConstructorMs))ms (± \(String(format: "%.3f", estimatedKernelToConstructorErrorMs))ms)
           Estimated Full PreMain: \(String(format: "%.2f", estimatedFullPreMainMs))ms
         """
     }
@@ -369,6 +1182,6 @@ extension PreMainDurations: CustomStringConvertible {
 extension DylibLoadInfo: CustomStringConvertible {
     public var description: String {
         let type = isSystemLibrary ? "System" : "User"
-        return "\(name) [\(type)]: \(String(format: "%.2f", loadDurationMs))ms"
+        return "\(name) [\(type)]: \(String(format: "%.2f", launchCostMs))ms"
     }
 }
@@ -22,33 +22,266 @@ extern "C" {
 
 // MARK: - 常量定义
 
-/// 最大记录的 dylib 数量（避免内存无限增长）
-#define DP_MAX_DYLIB_COUNT 512
+/// 每个 dylib 记录块容纳的记录数量（首块静态分配，之后按块追加）
+#define DP_DYLIB_CHUNK_CAPACITY 512
 
-/// dylib 名称最大长度
+/// dylib 记录块默认内存上限（字节，可通过 DPPreMainSetDylibMemoryLimit 调整）
+#ifndef DP_DEFAULT_DYLIB_MEMORY_LIMIT
+#define DP_DEFAULT_DYLIB_MEMORY_LIMIT (1024 * 1024)
+#endif
+
+/// dylib 名称最大长度（驻留时超出部分截断）
 #define DP_MAX_DYLIB_NAME_LENGTH 256
 
+/// 可单独计时的静态初始化器最大数量（超出部分计入 untimedInitializerCount）
+#define DP_MAX_TIMED_INITIALIZERS 256
+
+/// 自定义标记环形缓冲区容量（2 的幂，写满后覆盖最旧的标记）
+#ifndef DP_MARK_RING_CAPACITY
+#define DP_MARK_RING_CAPACITY 1024
+#endif
+
+/// dlopen / dlclose 事件环形缓冲区容量（写满后覆盖最旧的事件）
+#ifndef DP_DLOPEN_RING_CAPACITY
+#define DP_DLOPEN_RING_CAPACITY 256
+#endif
+
+/// 启动采样缓冲区可容纳的样本数量（启动时一次性预留，写满后丢弃新样本）
+#ifndef DP_LAUNCH_SAMPLER_CAPACITY
+#define DP_LAUNCH_SAMPLER_CAPACITY 4096
+#endif
+
+/// 每个样本记录的最大栈帧数
+#ifndef DP_LAUNCH_SAMPLER_MAX_FRAMES
+#define DP_LAUNCH_SAMPLER_MAX_FRAMES 64
+#endif
+
+/// 启动历史文件保留的启动次数（环形覆盖最旧的记录）
+#ifndef DP_LAUNCH_HISTORY_CAPACITY
+#define DP_LAUNCH_HISTORY_CAPACITY 32
+#endif
+
+/// 每次启动记录的镜像数量上限（按加载耗时取最慢的 dlopen 计时镜像）
+#define DP_LAUNCH_HISTORY_MAX_IMAGES 128
+
+/// 启动历史文件名称表大小（字节）与哈希桶数量
+#define DP_LAUNCH_HISTORY_NAME_BYTES (64 * 1024)
+#define DP_LAUNCH_HISTORY_NAME_BUCKETS 2048
+
+/// 启动历史镜像标志：系统库
+#define DP_LAUNCH_HISTORY_IMAGE_SYSTEM 0x1u
+
+/// 镜像加载标志：注册回调时补发的已加载镜像（constructor 之前已加载完成，无单独的加载耗时）
+#define DP_DYLIB_LOAD_REPLAYED 0x1u
+/// 镜像加载标志：在已挂接的 dlopen 中加载，loadStartMachTime 为 dlopen 入口时间，加载耗时有效
+#define DP_DYLIB_LOAD_TIMED 0x2u
+
+/// 镜像静态统计标志：已成功解析
+#define DP_IMAGE_STATS_AVAILABLE 0x1u
+/// 镜像静态统计标志：使用链式修正（LC_DYLD_CHAINED_FIXUPS），修正数读取自磁盘文件
+#define DP_IMAGE_STATS_CHAINED_FIXUPS 0x2u
+/// 镜像静态统计标志：位于 dyld 共享缓存中（修正已预先完成，修正数为 0）
+#define DP_IMAGE_STATS_SHARED_CACHE 0x4u
+
 // MARK: - 数据结构
 
+/// 镜像静态统计（修正数量与段大小）
+/// 每个镜像只在首次查询时解析一次并缓存在记录中，快照与查询只复制缓存；用于把加载耗时归因到修正数量（ms / fixup）
+typedef struct {
+    /// rebase 数量（Apple 为 rebase 操作数 / 链式修正中的 rebase，Linux 为 RELATIVE / RELR 重定位）
+    uint32_t rebaseCount;
+    /// bind 数量（Apple 含 lazy / weak bind，Linux 为符号重定位含 PLT）
+    uint32_t bindCount;
+    /// 代码段大小（Apple 为 __TEXT，Linux 为带 PF_X 的 PT_LOAD，字节）
+    uint64_t textSize;
+    /// 数据段大小（Apple 为 __DATA* / __AUTH*，Linux 为带 PF_W 的 PT_LOAD，字节）
+    uint64_t dataSize;
+    /// 静态初始化器数量（含无法单独计时的 __init_offsets / DT_INIT）
+    uint32_t initializerCount;
+    /// 标志位（DP_IMAGE_STATS_*）
+    uint32_t flags;
+} DPImageStats;
+
 /// dylib 加载信息
+/// 名称以 (offset, length) 形式引用驻留字符串区，通过 DPPreMainGetInternedString 获取
 typedef struct {
-    /// dylib 名称（仅保留文件名，不含路径）
-    char name[DP_MAX_DYLIB_NAME_LENGTH];
-    /// 加载时的 mach_absolute_time 值
+    /// 镜像头地址（mach_header）
+    const void* header;
+    /// 加载起点的 mach_absolute_time 值（DP_DYLIB_LOAD_TIMED 时为 dlopen 入口时间，否则等于 loadMachTime）
+    uint64_t loadStartMachTime;
+    /// 加载完成（dyld 回调）时的 mach_absolute_time 值
     uint64_t loadMachTime;
-    /// 相对于进程启动的耗时（纳秒）
+    /// 加载耗时（纳秒）：loadStartMachTime -> loadMachTime，仅 DP_DYLIB_LOAD_TIMED 时非 0
     uint64_t loadDurationNanos;
-    /// 是否为系统库（/usr/lib 或 /System 开头）
-    bool isSystemLibrary;
+    /// 本镜像已计时的静态初始化器耗时合计（纳秒，初始化器执行完成后在查询时更新）
+    /// 启动时加载的镜像没有单独的加载耗时，此项是其可测量的启动开销
+    uint64_t initializerNanos;
     /// 镜像基地址偏移
     intptr_t slide;
+    /// 本镜像加载期间的 minor page fault 数量（需启用逐镜像缺页统计且 DP_DYLIB_LOAD_TIMED，否则为 0）
+    uint32_t minorFaults;
+    /// 本镜像加载期间的 major page fault 数量（需读盘，条件同 minorFaults）
+    uint32_t majorFaults;
+    /// dylib 名称在驻留字符串区中的偏移（仅保留文件名，不含路径）
+    uint32_t nameOffset;
+    /// dylib 名称长度（字节）
+    uint16_t nameLength;
+    /// 是否为系统库（/usr/lib 或 /System 开头）
+    bool isSystemLibrary;
+    /// 加载标志（DP_DYLIB_LOAD_*）
+    uint32_t loadFlags;
+    /// 镜像静态统计（解析失败时 flags 不含 DP_IMAGE_STATS_AVAILABLE）
+    DPImageStats imageStats;
 } DPDylibLoadInfo;
 
+/// 静态初始化器执行信息
+/// 名称以偏移形式引用驻留字符串区，通过 DPPreMainGetInternedString 获取
+typedef struct {
+    /// 所属镜像头地址
+    const void* imageHeader;
+    /// 初始化器函数地址
+    const void* function;
+    /// 开始执行时的 mach_absolute_time 值
+    uint64_t startMachTime;
+    /// 执行耗时（纳秒）
+    uint64_t durationNanos;
+    /// 所属镜像文件名在驻留字符串区中的偏移
+    uint32_t imageNameOffset;
+    /// 函数符号名在驻留字符串区中的偏移（符号不可见时为 0，即空字符串）
+    uint32_t symbolNameOffset;
+} DPInitializerInfo;
+
+/// 自定义标记类型
+typedef enum {
+    /// 单点标记（DPMark）
+    DPMarkKindInstant = 0,
+    /// 区间开始（DPMarkBegin）
+    DPMarkKindBegin = 1,
+    /// 区间结束（DPMarkEnd）
+    DPMarkKindEnd = 2,
+} DPMarkKind;
+
+/// 自定义标记事件
+typedef struct {
+    /// 标记名称（调用方传入的静态字符串）
+    const char* name;
+    /// 标记时的 mach_absolute_time 值
+    uint64_t machTime;
+    /// 系统线程 ID
+    uint64_t threadId;
+    /// 全局写入序号（反映标记之间的先后顺序）
+    uint64_t sequence;
+    /// 标记类型（DPMarkKind）
+    uint32_t kind;
+    /// 是否在主线程
+    bool isMainThread;
+} DPMarkEvent;
+
+/// 动态库加载调用类型
+typedef enum {
+    DPDlopenKindOpen = 0,
+    DPDlopenKindClose = 1,
+} DPDlopenKind;
+
+/// 一次 dlopen / dlclose 调用
+typedef struct {
+    /// 全局写入序号（从 1 开始）
+    uint64_t sequence;
+    /// 调用开始时的 mach_absolute_time 值
+    uint64_t startMachTime;
+    /// 调用阻塞时长（纳秒）
+    uint64_t durationNanos;
+    /// 调用线程的系统线程 ID
+    uint64_t threadId;
+    /// dlopen 返回 / dlclose 传入的句柄
+    const void* handle;
+    /// 路径在驻留字符串区中的偏移（dlopen 传入的路径，过长时保留末尾；dlclose 取自对应的 dlopen）
+    uint32_t pathOffset;
+    /// 调用类型（DPDlopenKind）
+    uint32_t kind;
+    /// 是否在主线程调用
+    bool isMainThread;
+    /// 调用是否成功（dlopen 返回非空 / dlclose 返回 0）
+    bool succeeded;
+} DPDlopenEvent;
+
+/// 代码页访问追踪统计
+typedef struct {
+    /// 采样的用户镜像数量
+    uint32_t imageCount;
+    /// 页大小（字节）
+    uint32_t pageSize;
+    /// 可执行段总页数
+    uint32_t textPageCount;
+    /// main() 时常驻的页数
+    uint32_t residentAtMainCount;
+    /// 启动完成时常驻的页数（含 main() 时已常驻的页）
+    uint32_t residentAtLaunchCompleteCount;
+    /// 是否已采样启动完成时刻
+    bool launchCompleteCaptured;
+} DPPageTraceStats;
+
+/// 启动采样统计
+typedef struct {
+    /// 采样间隔（微秒）
+    uint32_t intervalMicros;
+    /// 已记录的样本数量
+    uint32_t sampleCount;
+    /// 缓冲区写满后丢弃的样本数量
+    uint32_t droppedCount;
+    /// 是否仍在采样
+    bool running;
+    /// 开始 / 停止时的 mach_absolute_time 值（未停止时 stop 为 0）
+    uint64_t startMachTime;
+    uint64_t stopMachTime;
+} DPLaunchSamplerStats;
+
+/// 资源使用快照 / 差值（getrusage）
+typedef struct {
+    /// minor page fault（无需 I/O，如共享缓存已驻留页、零页）
+    uint64_t minorFaults;
+    /// major page fault（需从磁盘读入）
+    uint64_t majorFaults;
+    /// 块设备读入次数
+    uint64_t blockInputOps;
+} DPResourceUsage;
+
+/// PreMain 各时间点的资源使用快照（进程累计值）
+typedef struct {
+    /// constructor 执行时
+    DPResourceUsage constructor;
+    /// 首次 dyld 回调时
+    DPResourceUsage firstDyldCallback;
+    /// 最后一次 dyld 回调时（未启用逐镜像统计时为注册回调返回时，即启动批次镜像通知完毕）
+    DPResourceUsage lastDyldCallback;
+    /// main() 标记时
+    DPResourceUsage mainExecuted;
+} DPPreMainResourceSnapshots;
+
+/// PreMain 各阶段的资源消耗（快照差值，阶段划分与 DPPreMainDurations 对应）
+/// 缺页多而耗时长通常为冷缓存启动，缺页持平而耗时增长通常为代码回退
+typedef struct {
+    /// constructor 到 main
+    DPResourceUsage total;
+    /// first dyld callback 到 last dyld callback
+    DPResourceUsage dylibLoading;
+    /// constructor 到 first dyld callback
+    DPResourceUsage staticInitializer;
+    /// last dyld callback 到 main
+    DPResourceUsage postDyldToMain;
+} DPPreMainPhaseFaults;
+
 /// PreMain 阶段时间点
 typedef struct {
     /// 进程启动时间（通过 sysctl 获取的 timeval）
     uint64_t processStartTimeUnixMicros;  // Unix 时间戳（微秒）
     
+    /// 进程启动时刻在单调时钟上的位置（纳秒，可与 DPMachTimeToNanos(constructorMachTime) 直接相减；0 表示未知）
+    uint64_t processStartNanos;
+    
+    /// processStartNanos 的误差上界（纳秒）
+    uint64_t processStartErrorNanos;
+    
     /// __attribute__((constructor)) 执行时的 mach_absolute_time
     uint64_t constructorMachTime;
     
@@ -85,8 +318,11 @@ typedef struct {
     /// last dyld callback 到 main（包含 Swift 静态初始化等）
     double postDyldToMainMs;
     
-    /// 进程实际启动到 constructor 的估算时间（基于系统时间差）
+    /// 进程实际启动到 constructor 的估算时间（内核记录的启动时刻对齐到单调时钟后求差）
     double estimatedKernelToConstructorMs;
+    
+    /// estimatedKernelToConstructorMs 的误差上界（毫秒，真实值位于估算值 ± 该值之间）
+    double estimatedKernelToConstructorErrorMs;
 } DPPreMainDurations;
 
 /// 完整的 PreMain 监控数据
@@ -97,6 +333,12 @@ typedef struct {
     /// 耗时统计
     DPPreMainDurations durations;
     
+    /// 资源使用快照
+    DPPreMainResourceSnapshots resourceSnapshots;
+    
+    /// 各阶段缺页与读盘统计（main 标记后计算）
+    DPPreMainPhaseFaults phaseFaults;
+    
     /// 已加载的 dylib 数量
     uint32_t dylibCount;
     
@@ -106,6 +348,16 @@ typedef struct {
     /// 用户库数量（总数 - 系统库）
     uint32_t userDylibCount;
     
+    /// 因内存上限未能记录的 dylib 数量
+    uint32_t droppedDylibCount;
+    
+    /// 已计时执行完成的静态初始化器数量（用户镜像，只统计实际执行过的包装）
+    uint32_t timedInitializerCount;
+    
+    /// 无法单独计时的静态初始化器数量（__init_offsets、DT_INIT、arm64e 签名表项、超出上限、
+    /// 先于 constructor 初始化的依赖镜像，以及到达 main() 时仍未执行的包装等）
+    uint32_t untimedInitializerCount;
+    
     /// 是否已完成 main() 标记
     bool mainExecutedMarked;
     
@@ -117,9 +369,95 @@ typedef struct {
     uint32_t timebaseDenom;
 } DPPreMainData;
 
+/// dylib 列式视图（struct-of-arrays）
+/// 调用方提供各列数组，不需要的列传 NULL
+typedef struct {
+    /// 各列数组容量（输入）
+    uint32_t capacity;
+    /// 实际复制的数量（输出，不超过 capacity）
+    uint32_t count;
+    /// 快照时已解析的 dylib 总数（输出，大于 capacity 时可扩容后重试）
+    uint32_t totalCount;
+    /// 镜像头地址
+    const void** headers;
+    /// 加载起点 mach_absolute_time
+    uint64_t* loadStartMachTimes;
+    /// 加载完成 mach_absolute_time
+    uint64_t* loadMachTimes;
+    /// 加载耗时（纳秒，仅 DP_DYLIB_LOAD_TIMED 时非 0）
+    uint64_t* loadDurationNanos;
+    /// 名称在驻留字符串区中的偏移
+    uint32_t* nameOffsets;
+    /// 是否为系统库
+    bool* isSystemLibrary;
+    /// 镜像基地址偏移
+    intptr_t* slides;
+    /// minor page fault 数量
+    uint32_t* minorFaults;
+    /// major page fault 数量
+    uint32_t* majorFaults;
+    /// 镜像静态统计
+    DPImageStats* imageStats;
+    /// 加载标志（DP_DYLIB_LOAD_*）
+    uint32_t* loadFlags;
+    /// 已计时的静态初始化器耗时合计（纳秒）
+    uint64_t* initializerNanos;
+} DPDylibColumns;
+
+/// 启动历史中单个镜像的加载开销
+typedef struct {
+    /// 名称在历史文件名称表中的偏移（通过 DPLaunchHistoryGetName 获取，0 为未命名）
+    uint32_t nameOffset;
+    /// 标志位（DP_LAUNCH_HISTORY_IMAGE_SYSTEM）
+    uint32_t flags;
+    /// minor / major page fault 数量（未启用逐镜像缺页统计时为 0）
+    uint32_t minorFaults;
+    uint32_t majorFaults;
+    /// 加载耗时（纳秒，dlopen 入口 -> 回调；启动时加载的镜像为 0）
+    uint64_t loadDurationNanos;
+    /// 已计时的静态初始化器耗时合计（纳秒）
+    uint64_t initializerNanos;
+} DPLaunchHistoryImage;
+
+/// 启动历史中的一次启动（文件内布局，紧随其后为 imageCount 个 DPLaunchHistoryImage）
+typedef struct {
+    /// 启动序号（从 1 开始；0 表示空槽位或正在写入）
+    uint64_t sequence;
+    /// 进程启动时间（Unix 时间戳，微秒）
+    uint64_t processStartUnixMicros;
+    /// 各阶段耗时（纳秒，阶段划分与 DPPreMainDurations 对应）
+    uint64_t totalPreMainNanos;
+    uint64_t dylibLoadingNanos;
+    uint64_t staticInitializerNanos;
+    uint64_t postDyldToMainNanos;
+    uint64_t objcLoadNanos;
+    uint64_t estimatedKernelToConstructorNanos;
+    /// 各阶段缺页与读盘统计
+    DPPreMainPhaseFaults phaseFaults;
+    /// dylib 总数与用户库数量
+    uint32_t dylibCount;
+    uint32_t userDylibCount;
+    /// 记录的镜像数量（不超过 DP_LAUNCH_HISTORY_MAX_IMAGES）
+    uint32_t imageCount;
+    uint32_t reserved;
+} DPLaunchHistoryRecord;
+
+/// 只读映射的启动历史文件（不透明句柄）
+typedef struct DPLaunchHistory DPLaunchHistory;
+
 // MARK: - 公开 API
 
+/// 复制一份一致的 PreMain 数据快照（推荐）
+/// 读取方通过顺序锁（seqlock）无锁复制，遇到并发写入时重试，不阻塞 dyld 回调与写入方；
+/// 若无其他线程正在解析，会先顺带解析新加载的镜像
+/// @param outData 时间戳、耗时、缺页与计数
+/// @param outDylibs dylib 列式视图，可为 NULL
+/// @return 快照序号（每次数据变化后递增，可用于判断数据是否更新）
+uint64_t DPPreMainCopySnapshot(DPPreMainData* outData, DPDylibColumns* outDylibs);
+
 /// 获取 PreMain 监控数据（只读）
+/// 注意：返回的是全局数据指针，其他线程可能同时修改，逐字段读取可能得到不一致的状态；
+/// 新代码请使用 DPPreMainCopySnapshot
 /// @return 指向全局 PreMain 数据的指针
 const DPPreMainData* DPPreMainGetData(void);
 
@@ -144,26 +482,224 @@ const DPDylibLoadInfo* DPPreMainGetDylibInfo(uint32_t index);
 /// @return 实际复制的 dylib 数量
 uint32_t DPPreMainGetAllDylibs(DPDylibLoadInfo* outBuffer, uint32_t bufferSize);
 
-/// 获取加载耗时最长的 N 个 dylib
-/// @param outBuffer 输出缓冲区
+/// 获取启动开销最大的 N 个 dylib（O(n log N)，包含全部已记录的镜像）
+/// 按 loadDurationNanos + initializerNanos 降序；开销相同时按修正数量（rebase + bind）、再按段大小降序
+/// 启动时加载的镜像在 constructor 之前已完成映射与修正，无法单独计时：其开销只有已计时的初始化器耗时，
+/// 修正数量与段大小作为映射 / 修正开销的相对指标，没有可计时初始化器的镜像按此排序
+/// @param outBuffer 输出缓冲区（同时用作排序堆，无额外内存分配）
 /// @param count 请求的数量
 /// @return 实际返回的数量
 uint32_t DPPreMainGetSlowestDylibs(DPDylibLoadInfo* outBuffer, uint32_t count);
 
+/// 获取执行耗时最长的 N 个静态初始化器（按耗时降序，O(n log N)）
+/// 仅统计 constructor 执行时已加载的用户镜像；可设置环境变量 DP_PREMAIN_DISABLE_INITIALIZER_TIMING 关闭
+/// @param outBuffer 输出缓冲区（同时用作排序堆，无额外内存分配）
+/// @param count 请求的数量
+/// @return 实际返回的数量
+uint32_t DPPreMainGetSlowestInitializers(DPInitializerInfo* outBuffer, uint32_t count);
+
+/// 获取驻留字符串
+/// @param offset 驻留字符串区偏移（如 DPDylibLoadInfo.nameOffset）
+/// @return NUL 结尾的字符串，进程生命周期内地址不变；无效偏移返回空字符串
+const char* DPPreMainGetInternedString(uint32_t offset);
+
 /// 启用/禁用 dylib 细分记录（默认启用）
 /// 禁用后可减少内存占用，但无法获取单个 dylib 的加载耗时
 void DPPreMainSetDylibDetailEnabled(bool enabled);
 
+/// 启用/禁用逐镜像缺页统计（默认禁用，也可设置环境变量 DP_PREMAIN_PER_IMAGE_FAULTS=1 在启动时启用）
+/// 启用后每次 dyld 回调额外调用一次 getrusage（约数百纳秒），结果见 DPDylibLoadInfo.minorFaults / majorFaults
+void DPPreMainSetPerImageFaultsEnabled(bool enabled);
+
+/// 设置 dylib 记录块总内存上限（默认 DP_DEFAULT_DYLIB_MEMORY_LIMIT）
+/// 达到上限后停止记录新镜像，未记录数量见 DPPreMainData.droppedDylibCount
+/// @param maxBytes 最大字节数（含静态分配的首个记录块）
+void DPPreMainSetDylibMemoryLimit(size_t maxBytes);
+
+// MARK: - 自定义标记
+//
+// 用于 main 之后的启动里程碑，多线程无锁写入固定容量的环形缓冲区，可在正式版本中保留：
+//   DPMark("home_ready");
+//   DPMarkBegin("load_config"); ... DPMarkEnd("load_config");
+// C++ 可使用 DPPreMainScope.h 中的 DP_SCOPE("name") 按作用域自动配对
+
+/// 记录单点标记
+/// @param staticName 标记名称，必须为静态字符串（只保存指针，不复制内容）
+void DPMark(const char* staticName);
+
+/// 记录区间开始（与同一线程上同名的 DPMarkEnd 配对）
+/// @param staticName 标记名称，必须为静态字符串
+void DPMarkBegin(const char* staticName);
+
+/// 记录区间结束
+/// @param staticName 标记名称，必须为静态字符串
+void DPMarkEnd(const char* staticName);
+
+/// 复制当前环形缓冲区中的标记（按写入序号升序）
+/// 读取不加锁，正在写入或已被覆盖的槽位会被跳过
+/// @param outBuffer 输出缓冲区
+/// @param bufferSize 缓冲区大小（小于环形缓冲区中的标记数量时只复制最新的 bufferSize 条）
+/// @param outOverwrittenCount 因缓冲区写满被覆盖的标记数量，可为 NULL
+/// @return 实际复制的数量
+uint32_t DPMarkCopyEvents(DPMarkEvent* outBuffer, uint32_t bufferSize, uint64_t* outOverwrittenCount);
+
+// MARK: - dlopen / dlclose 耗时
+//
+// 记录 main 之后按需加载的动态库阻塞调用线程的时长，需同时满足：
+// 1. 挂接调用：Apple 以 DP_PREMAIN_DLOPEN_INTERPOSE=1 编译（DYLD_INTERPOSE，本模块须位于启动时加载的镜像中，
+//    挂接函数经 dyld 私有接口 dlopen_from 保留调用方的 @rpath，仅用于调试构建；
+//    Swift Package 依赖无法由使用方追加编译宏，需以源码方式集成本模块时自行定义），
+//    Linux 以 -Wl,--wrap=dlopen,--wrap=dlclose 链接
+// 2. 运行时开启：DPPreMainSetDlopenTracingEnabled(true) 或环境变量 DP_PREMAIN_TRACE_DLOPEN=1
+// 未开启时挂接函数只多一次原子读取
+
+/// dlopen / dlclose 钩子是否已挂接（未挂接时无法开启计时）
+/// Linux 上本模块以共享库提供、由宿主程序以 --wrap 链接时，钩子首次被调用之前返回 false
+bool DPPreMainIsDlopenTracingAvailable(void);
+
+/// 启用/禁用 dlopen / dlclose 计时
+/// @return 钩子未挂接时开启返回 false，计时保持关闭；关闭总是返回 true
+bool DPPreMainSetDlopenTracingEnabled(bool enabled);
+
+/// 复制序号大于 afterSequence 的 dlopen / dlclose 事件（按序号升序）
+/// @param outBuffer 输出缓冲区
+/// @param bufferSize 缓冲区大小（不足时只复制最旧的 bufferSize 条，可以最后一条的序号继续读取）
+/// @param afterSequence 上次读取到的最大序号，首次传 0
+/// @param outOverwrittenCount 序号大于 afterSequence 但已被覆盖的事件数量，可为 NULL
+/// @return 实际复制的数量
+uint32_t DPPreMainCopyDlopenEvents(DPDlopenEvent* outBuffer, uint32_t bufferSize, uint64_t afterSequence,
+                                   uint64_t* outOverwrittenCount);
+
+// MARK: - 代码页访问追踪
+//
+// 在 main() 标记与启动完成标记时以 mincore 采样用户镜像可执行段的常驻页，导出时将常驻页映射回函数符号，
+// 按首次常驻的阶段排序生成链接器 order file（ld64 -order_file / lld --symbol-ordering-file），
+// 使启动路径上的代码聚集到更少的页中以减少缺页
+// 开启：DPPreMainSetPageTraceEnabled(true)（需在 main() 标记之前）或环境变量 DP_PREMAIN_PAGE_TRACE=1
+// 注意：mincore 反映页缓存常驻状态而非本进程的实际访问，需在冷启动（重启设备或清空页缓存）后采集，
+// 预读会使相邻页一并常驻
+
+/// 启用/禁用代码页访问追踪
+void DPPreMainSetPageTraceEnabled(bool enabled);
+
+/// 标记启动完成（如首帧渲染完成），采样此时的常驻页并停止启动采样；重复调用无效
+void DPPreMainMarkLaunchComplete(void);
+
+/// 获取代码页访问追踪统计
+/// @return 尚未在 main() 时采样时返回 false
+bool DPPreMainGetPageTraceStats(DPPageTraceStats* outStats);
+
+/// 导出 order file（每行一个符号名：先为 main() 时常驻的函数，再为启动完成时才常驻的函数，各自按地址排列）
+/// Apple 读取镜像 __LINKEDIT 中的符号表，Linux 从磁盘读取 ELF 的 .symtab（已剥离时退回 .dynsym）
+/// @param fd 已打开的可写文件描述符（不会关闭）
+/// @param imageName 只导出路径以该名称结尾的镜像（order file 仅对链接的单个镜像有效），NULL 导出全部用户镜像
+/// @return 写出的符号数量，未采样或写入失败返回 -1
+int64_t DPPreMainExportOrderFileToFileDescriptor(int fd, const char* imageName);
+
+// MARK: - 启动采样
+//
+// 从 constructor 开始按固定间隔采集调用栈，直到 DPPreMainStopLaunchSampler 或 DPPreMainMarkLaunchComplete：
+// Linux 为 setitimer(ITIMER_PROF) + SIGPROF（按进程 CPU 时间触发，采样当时运行的线程），
+// Apple 为独立线程定时挂起主线程读取寄存器（按墙钟时间，包含主线程阻塞等待）
+// 采样路径只沿帧指针链记录原始返回地址到预留缓冲区，不加锁、不分配内存，符号化在导出时进行
+// 开启：DPPreMainStartLaunchSampler 或环境变量 DP_PREMAIN_SAMPLE_LAUNCH=1（间隔 DP_PREMAIN_SAMPLE_INTERVAL_US，默认 1000）
+// 主线程的帧限定在启动采样时读取的栈范围内；Linux 的其他线程栈范围未知，每帧以 process_vm_readv 读取，
+// 不可读时停止回溯（内核禁止该调用时这些线程只记录当前指令地址）
+// 注意：需保留帧指针（Apple 默认保留，Linux 需以 -fno-omit-frame-pointer 编译）。回溯经过未保留帧指针的函数时，
+// 帧指针寄存器可能存放任意数据，调用栈会在该处截断或缺失其直接调用方
+
+/// 开始启动采样（每个进程只能开始一次）
+/// @param intervalMicros 采样间隔（微秒），0 使用默认值 1000
+/// @return 平台不支持、已开始过或预留缓冲区失败时返回 false；Apple 须在主线程调用
+bool DPPreMainStartLaunchSampler(uint32_t intervalMicros);
+
+/// 停止启动采样（DPPreMainMarkLaunchComplete 也会停止采样）
+void DPPreMainStopLaunchSampler(void);
+
+/// 获取启动采样统计
+/// @return 从未开始采样时返回 false
+bool DPPreMainGetLaunchSamplerStats(DPLaunchSamplerStats* outStats);
+
+/// 符号化并导出折叠调用栈（flamegraph.pl / speedscope 可直接读取）
+/// 每行为 "线程;根帧;...;叶帧 样本数"，帧格式为 "镜像名`符号"，找不到符号时为 "镜像名`+镜像内偏移"
+/// 仍在采样时先停止采样
+/// @param fd 已打开的可写文件描述符（不会关闭）
+/// @return 写出的不同调用栈数量，从未采样或写入失败返回 -1
+int64_t DPPreMainExportLaunchProfileToFileDescriptor(int fd);
+
+// MARK: - 时间线导出
+
+/// 导出启动时间线为 Chrome Trace Event JSON（可在 Perfetto / chrome://tracing 直接打开）
+/// 包含启动阶段、逐镜像加载、静态初始化器、main 与自定义标记；不分配堆内存
+/// 与 snprintf 相同：输出截断到 bufferSize - 1 字节并以 NUL 结尾，返回完整输出所需的字节数（不含 NUL）
+/// @param buffer 输出缓冲区，可为 NULL（仅计算长度）
+/// @param bufferSize 缓冲区大小
+/// @return 完整输出所需的字节数
+size_t DPPreMainExportChromeTrace(char* buffer, size_t bufferSize);
+
+/// 导出启动时间线到文件描述符（经固定大小缓冲区分块写出）
+/// @param fd 已打开的可写文件描述符（不会关闭）
+/// @return 写出的字节数，写入失败返回 -1
+int64_t DPPreMainExportChromeTraceToFileDescriptor(int fd);
+
+// MARK: - 启动历史
+//
+// 每次启动在 DPPreMainMarkMainExecuted 之后由后台线程向固定大小的 mmap 环形文件追加一条记录，
+// 保留最近 DP_LAUNCH_HISTORY_CAPACITY 次启动的阶段耗时、最慢镜像与缺页统计；
+// 默认路径 Apple 为 $HOME/Library/Caches/<文件名>，Linux 为 ${XDG_CACHE_HOME:-$HOME/.cache}/<文件名>，
+// 文件名为 DPLaunchHistory-<可执行文件名>-<可执行文件路径哈希>.bin，不同程序各自独立
+// 环境变量 DP_PREMAIN_LAUNCH_HISTORY_PATH 可覆盖路径，DP_PREMAIN_DISABLE_LAUNCH_HISTORY=1 关闭写入
+
+/// 设置启动历史文件路径（需在 DPPreMainMarkMainExecuted 之前调用，如在 constructor 中）
+/// @param path 文件路径，NULL 关闭写入
+void DPPreMainSetLaunchHistoryPath(const char* path);
+
+/// 获取当前启动历史文件路径
+/// @param buffer 输出缓冲区
+/// @param bufferSize 缓冲区大小
+/// @return 路径长度，已关闭或缓冲区不足时返回 0
+size_t DPPreMainGetLaunchHistoryPath(char* buffer, size_t bufferSize);
+
+/// 只读映射启动历史文件（读取方直接访问映射内存，不复制记录）
+/// @param path 文件路径，NULL 使用当前路径
+/// @return 文件不存在或格式不符时返回 NULL
+DPLaunchHistory* DPLaunchHistoryOpen(const char* path);
+
+/// 解除映射并释放句柄
+void DPLaunchHistoryClose(DPLaunchHistory* history);
+
+/// 文件中有效的启动记录数量
+uint32_t DPLaunchHistoryGetCount(const DPLaunchHistory* history);
+
+/// 获取第 index 条启动记录（0 为最旧）
+/// 其他进程启动时可能覆盖最旧的槽位：读取后应再次确认 sequence 未变化
+/// @return 索引越界或槽位正在写入时返回 NULL
+const DPLaunchHistoryRecord* DPLaunchHistoryGetRecord(const DPLaunchHistory* history, uint32_t index);
+
+/// 获取启动记录中的镜像数组（共 record->imageCount 个，按加载耗时降序）
+const DPLaunchHistoryImage* DPLaunchHistoryGetImages(const DPLaunchHistoryRecord* record);
+
+/// 获取名称表中的字符串
+/// @return 偏移无效时返回空字符串
+const char* DPLaunchHistoryGetName(const DPLaunchHistory* history, uint32_t nameOffset);
+
 /// 将 mach_absolute_time 转换为纳秒
+/// 使用初始化时预计算的 64.64 定点系数，无除法、无溢出（numer == denom 时直接返回）
 uint64_t DPMachTimeToNanos(uint64_t machTime);
 
+/// 批量将 mach_absolute_time 转换为纳秒（单次遍历）
+/// @param machTimes 输入时间数组
+/// @param outNanos 输出数组，可与输入相同（原地转换）
+/// @param count 元素数量
+void DPMachTimesToNanos(const uint64_t* machTimes, uint64_t* outNanos, size_t count);
+
 /// 将 mach_absolute_time 转换为毫秒
 double DPMachTimeToMillis(uint64_t machTime);
 
 /// 获取当前 mach_absolute_time
 uint64_t DPGetCurrentMachTime(void);
 
-/// 重置所有记录（仅用于测试）
+/// 重置所有记录（仅用于测试，不可与 DPPreMainCopySnapshot 并发调用）
 void DPPreMainReset(void);
 
 #ifdef __cplusplus
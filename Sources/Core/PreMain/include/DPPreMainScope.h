@@ -0,0 +1,98 @@
+//
+//  DPPreMainScope.h
+//  DebugProbe
+//
+//  C++ 作用域计时（header-only）
+//  在 DPMarkBegin / DPMarkEnd 之上提供 RAII 封装，区间写入同一个标记环形缓冲区，
+//  与 Swift / C 标记一起出现在启动时间线与 Trace 导出中：
+//    void Decoder::init() {
+//        DP_SCOPE("Decoder::init");
+//        ...
+//    }
+//  以 DP_SCOPE_ENABLED=0 编译时 DP_SCOPE 展开为空类型的局部变量，不产生任何调用
+//
+//  本目录同时是 Clang 模块的伞形目录，C / Swift 导入时整个头文件为空
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#ifndef DPPreMainScope_h
+#define DPPreMainScope_h
+
+#ifdef __cplusplus
+
+#include <stddef.h>
+
+#include "DPPreMainMonitor.h"
+
+// MARK: - 编译开关
+
+/// 是否启用作用域计时（默认启用，可在编译选项中定义为 0 关闭）
+#ifndef DP_SCOPE_ENABLED
+#define DP_SCOPE_ENABLED 1
+#endif
+
+namespace dp {
+
+/// 编译期开关，DP_SCOPE 据此选择计时器实现
+constexpr bool kScopeTimersEnabled = DP_SCOPE_ENABLED != 0;
+
+// MARK: - ScopedTimer
+
+/// 作用域计时器：构造时写入区间开始标记，析构时写入同名区间结束标记
+/// 名称只接受字符数组，传入 const char* 会在编译期报错；DP_SCOPE 还会以 "" name 拼接，
+/// 字符数组变量（内容可变或生命周期较短）同样无法编译，保证环形缓冲区中保存的指针始终有效
+template <bool Enabled>
+class ScopedTimer;
+
+template <>
+class ScopedTimer<true> final {
+public:
+    template <size_t N>
+    explicit ScopedTimer(const char (&name)[N]) noexcept : name_(name) {
+        static_assert(N > 1, "DP_SCOPE name must not be empty");
+        DPMarkBegin(name_);
+    }
+
+    ~ScopedTimer() noexcept {
+        DPMarkEnd(name_);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* name_;
+};
+
+/// 关闭时的空实现：无成员、平凡析构，优化后不留任何代码
+template <>
+class ScopedTimer<false> final {
+public:
+    template <size_t N>
+    constexpr explicit ScopedTimer(const char (&)[N]) noexcept {
+        static_assert(N > 1, "DP_SCOPE name must not be empty");
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+/// 按编译开关选择的计时器类型
+using Scope = ScopedTimer<kScopeTimersEnabled>;
+
+} // namespace dp
+
+// MARK: - 宏
+
+#define DP_SCOPE_CONCAT_INNER(a, b) a##b
+#define DP_SCOPE_CONCAT(a, b) DP_SCOPE_CONCAT_INNER(a, b)
+
+/// 为当前作用域计时，名称须为字符串字面量（与 "" 拼接，非字面量无法编译）
+/// 以 __COUNTER__ 生成变量名，同一行（如其他宏展开）内多次使用也不会重名
+#define DP_SCOPE(name) const ::dp::Scope DP_SCOPE_CONCAT(dpScope_, __COUNTER__)("" name)
+
+#endif /* __cplusplus */
+
+#endif /* DPPreMainScope_h */
@@ -11,8 +11,14 @@ import Foundation
 public enum BridgeMessage: Codable {
     // MARK: - 客户端 -> 服务端
 
-    /// 设备注册（包含插件状态）
-    case register(DeviceInfo, token: String, pluginStates: [String: Bool])
+    /// 设备注册（包含插件状态，以及按优先级排列的传输编码与批量压缩算法）
+    case register(
+        DeviceInfo,
+        token: String,
+        pluginStates: [String: Bool],
+        wireEncodings: [BridgeWireEncoding] = [.json],
+        compressions: [BridgeWireCompression] = [.none]
+    )
 
     /// 心跳
     case heartbeat
@@ -34,8 +40,8 @@ public enum BridgeMessage: Codable {
 
     // MARK: - 服务端 -> 客户端
 
-    /// 注册成功响应
-    case registered(sessionId: String)
+    /// 注册成功响应（Hub 选定的传输编码与压缩算法，旧版 Hub 不返回时为 JSON、不压缩）
+    case registered(sessionId: String, wireEncoding: BridgeWireEncoding = .json, compression: BridgeWireCompression = .none)
 
     /// 更新 Mock 规则
     case updateMockRules([MockRule])
@@ -102,7 +108,13 @@ public enum BridgeMessage: Codable {
         switch type {
         case .register:
             let payload = try container.decode(RegisterPayload.self, forKey: .payload)
-            self = .register(payload.deviceInfo, token: payload.token, pluginStates: payload.pluginStates ?? [:])
+            self = .register(
+                payload.deviceInfo,
+                token: payload.token,
+                pluginStates: payload.pluginStates ?? [:],
+                wireEncodings: payload.wireEncodings?.compactMap(BridgeWireEncoding.init(rawValue:)) ?? [.json],
+                compressions: payload.compressions?.compactMap(BridgeWireCompression.init(rawValue:)) ?? [.none]
+            )
         case .heartbeat:
             self = .heartbeat
         case .events:
@@ -122,7 +134,11 @@ public enum BridgeMessage: Codable {
             self = .updateDeviceInfo(deviceInfo)
         case .registered:
             let payload = try container.decode(RegisteredPayload.self, forKey: .payload)
-            self = .registered(sessionId: payload.sessionId)
+            self = .registered(
+                sessionId: payload.sessionId,
+                wireEncoding: payload.wireEncoding.flatMap(BridgeWireEncoding.init(rawValue:)) ?? .json,
+                compression: payload.compression.flatMap(BridgeWireCompression.init(rawValue:)) ?? .none
+            )
         case .updateMockRules:
             let rules = try container.decode([MockRule].self, forKey: .payload)
             self = .updateMockRules(rules)
@@ -160,9 +176,18 @@ public enum BridgeMessage: Codable {
         var container = encoder.container(keyedBy: CodingKeys.self)
 
         switch self {
-        case let .register(deviceInfo, token, pluginStates):
+        case let .register(deviceInfo, token, pluginStates, wireEncodings, compressions):
             try container.encode(MessageType.register, forKey: .type)
-            try container.encode(RegisterPayload(deviceInfo: deviceInfo, token: token, pluginStates: pluginStates), forKey: .payload)
+            try container.encode(
+                RegisterPayload(
+                    deviceInfo: deviceInfo,
+                    token: token,
+                    pluginStates: pluginStates,
+                    wireEncodings: wireEncodings.map(\.rawValue),
+                    compressions: compressions.map(\.rawValue)
+                ),
+                forKey: .payload
+            )
         case .heartbeat:
             try container.encode(MessageType.heartbeat, forKey: .type)
         case let .events(events):
@@ -180,9 +205,12 @@ public enum BridgeMessage: Codable {
         case let .updateDeviceInfo(deviceInfo):
             try container.encode(MessageType.updateDeviceInfo, forKey: .type)
             try container.encode(deviceInfo, forKey: .payload)
-        case let .registered(sessionId):
+        case let .registered(sessionId, wireEncoding, compression):
             try container.encode(MessageType.registered, forKey: .type)
-            try container.encode(RegisteredPayload(sessionId: sessionId), forKey: .payload)
+            try container.encode(
+                RegisteredPayload(sessionId: sessionId, wireEncoding: wireEncoding.rawValue, compression: compression.rawValue),
+                forKey: .payload
+            )
         case let .updateMockRules(rules):
             try container.encode(MessageType.updateMockRules, forKey: .type)
             try container.encode(rules, forKey: .payload)
@@ -223,10 +251,14 @@ private struct RegisterPayload: Codable {
     let deviceInfo: DeviceInfo
     let token: String
     let pluginStates: [String: Bool]? // 插件 ID -> 是否启用
+    let wireEncodings: [String]? // 支持的传输编码（按优先级），旧版 Hub 忽略
+    let compressions: [String]? // 支持的批量压缩算法（按优先级），旧版 Hub 忽略
 }
 
 private struct RegisteredPayload: Codable {
     let sessionId: String
+    let wireEncoding: String? // Hub 选定的传输编码，缺省为 JSON
+    let compression: String? // Hub 选定的批量压缩算法，缺省为不压缩
 }
 
 private struct ExportPayload: Codable {
@@ -390,6 +390,8 @@ public struct StatsEvent: Codable {
     public let logCount: Int
     public let memoryUsage: UInt64
     public let cpuUsage: Double
+    /// Bridge 批量压缩统计（启用压缩时上报）
+    public let compression: BridgeCompressionStats?
 
     public init(
         id: String = UUID().uuidString,
@@ -399,7 +401,8 @@ public struct StatsEvent: Codable {
         wsMessageCount: Int = 0,
         logCount: Int = 0,
         memoryUsage: UInt64 = 0,
-        cpuUsage: Double = 0
+        cpuUsage: Double = 0,
+        compression: BridgeCompressionStats? = nil
     ) {
         self.id = id
         self.timestamp = timestamp
@@ -409,6 +412,7 @@ public struct StatsEvent: Codable {
         self.logCount = logCount
         self.memoryUsage = memoryUsage
         self.cpuUsage = cpuUsage
+        self.compression = compression
     }
 }
 
@@ -550,19 +554,23 @@ public struct JankEventData: Codable, Sendable {
     public let duration: Double
     public let droppedFrames: Int
     public let stackTrace: String?
+    /// 已知的卡顿原因（如 "dlopen libFoo.dylib"），由帧率检测到的卡顿为 nil
+    public let cause: String?
 
     public init(
         id: String = UUID().uuidString,
         timestamp: Date = Date(),
         duration: Double,
         droppedFrames: Int,
-        stackTrace: String? = nil
+        stackTrace: String? = nil,
+        cause: String? = nil
     ) {
         self.id = id
         self.timestamp = timestamp
         self.duration = duration
         self.droppedFrames = droppedFrames
         self.stackTrace = stackTrace
+        self.cause = cause
     }
 }
 
@@ -663,13 +671,21 @@ public struct AppLaunchMetricsData: Codable, Sendable {
     /// PreMain 细分详情
     public let preMainDetails: PreMainDetailsData?
 
+    /// 自定义启动标记（DPMark / PreMainMonitor.mark）
+    public let launchMarkers: [LaunchMarkerData]?
+
+    /// 跨启动趋势（最近若干次启动的分位数与镜像回退）
+    public let launchTrend: LaunchTrendData?
+
     public init(
         totalTime: Double,
         preMainTime: Double?,
         mainToLaunchTime: Double?,
         launchToFirstFrameTime: Double?,
         timestamp: Date,
-        preMainDetails: PreMainDetailsData? = nil
+        preMainDetails: PreMainDetailsData? = nil,
+        launchMarkers: [LaunchMarkerData]? = nil,
+        launchTrend: LaunchTrendData? = nil
     ) {
         self.totalTime = totalTime
         self.preMainTime = preMainTime
@@ -677,6 +693,90 @@ public struct AppLaunchMetricsData: Codable, Sendable {
         self.launchToFirstFrameTime = launchToFirstFrameTime
         self.timestamp = timestamp
         self.preMainDetails = preMainDetails
+        self.launchMarkers = launchMarkers
+        self.launchTrend = launchTrend
+    }
+}
+
+/// 跨启动趋势数据（用于事件传输）
+public struct LaunchTrendData: Codable, Sendable {
+    /// 参与统计的启动次数
+    public let launchCount: Int
+    /// 历史中是否已包含本次启动（为 false 时 regressedImages 为空）
+    public let includesCurrentLaunch: Bool?
+    /// PreMain 总耗时分位数（毫秒）
+    public let totalPreMainP50Ms: Double
+    public let totalPreMainP90Ms: Double
+    /// dylib 加载耗时分位数（毫秒）
+    public let dylibLoadingP50Ms: Double
+    public let dylibLoadingP90Ms: Double
+    /// 耗时回退的镜像
+    public let regressedImages: [LaunchImageRegressionData]
+
+    public init(
+        launchCount: Int,
+        includesCurrentLaunch: Bool? = nil,
+        totalPreMainP50Ms: Double,
+        totalPreMainP90Ms: Double,
+        dylibLoadingP50Ms: Double,
+        dylibLoadingP90Ms: Double,
+        regressedImages: [LaunchImageRegressionData]
+    ) {
+        self.launchCount = launchCount
+        self.includesCurrentLaunch = includesCurrentLaunch
+        self.totalPreMainP50Ms = totalPreMainP50Ms
+        self.totalPreMainP90Ms = totalPreMainP90Ms
+        self.dylibLoadingP50Ms = dylibLoadingP50Ms
+        self.dylibLoadingP90Ms = dylibLoadingP90Ms
+        self.regressedImages = regressedImages
+    }
+}
+
+/// 镜像启动开销回退数据（用于事件传输）
+public struct LaunchImageRegressionData: Codable, Sendable {
+    /// 镜像文件名
+    public let name: String
+    /// 本次启动的启动开销（毫秒，加载耗时 + 初始化器耗时）
+    public let currentMs: Double
+    /// 之前启动的启动开销中位数（毫秒）
+    public let baselineP50Ms: Double
+
+    public init(name: String, currentMs: Double, baselineP50Ms: Double) {
+        self.name = name
+        self.currentMs = currentMs
+        self.baselineP50Ms = baselineP50Ms
+    }
+}
+
+/// 启动标记数据（用于事件传输）
+public struct LaunchMarkerData: Codable, Sendable {
+    /// 标记名称
+    public let name: String
+    /// 标记类型：instant / begin / end
+    public let kind: String
+    /// 相对 main() 的偏移（毫秒）
+    public let offsetMs: Double
+    /// 区间耗时（毫秒，仅配对成功的区间结束标记有值）
+    public let durationMs: Double?
+    /// 系统线程 ID
+    public let threadId: UInt64
+    /// 是否在主线程
+    public let isMainThread: Bool
+
+    public init(
+        name: String,
+        kind: String,
+        offsetMs: Double,
+        durationMs: Double? = nil,
+        threadId: UInt64,
+        isMainThread: Bool
+    ) {
+        self.name = name
+        self.kind = kind
+        self.offsetMs = offsetMs
+        self.durationMs = durationMs
+        self.threadId = threadId
+        self.isMainThread = isMainThread
     }
 }
 
@@ -692,6 +792,8 @@ public struct PreMainDetailsData: Codable, Sendable {
     public let objcLoadMs: Double?
     /// 估算的内核启动到 constructor 的时间（毫秒）
     public let estimatedKernelToConstructorMs: Double?
+    /// 上述估算的误差上界（毫秒）
+    public let estimatedKernelToConstructorErrorMs: Double?
 
     /// dylib 统计
     public let dylibStats: DylibStatsData?
@@ -699,22 +801,34 @@ public struct PreMainDetailsData: Codable, Sendable {
     /// 加载最慢的 dylib 列表
     public let slowestDylibs: [DylibLoadInfoData]?
 
+    /// 执行最慢的静态初始化器列表
+    public let slowestInitializers: [InitializerInfoData]?
+
+    /// 各阶段缺页与读盘统计
+    public let phaseFaults: PreMainPhaseFaultsData?
+
     public init(
         dylibLoadingMs: Double? = nil,
         staticInitializerMs: Double? = nil,
         postDyldToMainMs: Double? = nil,
         objcLoadMs: Double? = nil,
         estimatedKernelToConstructorMs: Double? = nil,
+        estimatedKernelToConstructorErrorMs: Double? = nil,
         dylibStats: DylibStatsData? = nil,
-        slowestDylibs: [DylibLoadInfoData]? = nil
+        slowestDylibs: [DylibLoadInfoData]? = nil,
+        slowestInitializers: [InitializerInfoData]? = nil,
+        phaseFaults: PreMainPhaseFaultsData? = nil
     ) {
         self.dylibLoadingMs = dylibLoadingMs
         self.staticInitializerMs = staticInitializerMs
         self.postDyldToMainMs = postDyldToMainMs
         self.objcLoadMs = objcLoadMs
         self.estimatedKernelToConstructorMs = estimatedKernelToConstructorMs
+        self.estimatedKernelToConstructorErrorMs = estimatedKernelToConstructorErrorMs
         self.dylibStats = dylibStats
         self.slowestDylibs = slowestDylibs
+        self.slowestInitializers = slowestInitializers
+        self.phaseFaults = phaseFaults
     }
 }
 
@@ -738,15 +852,111 @@ public struct DylibStatsData: Codable, Sendable {
 public struct DylibLoadInfoData: Codable, Sendable {
     /// dylib 名称
     public let name: String
-    /// 加载耗时（毫秒）
+    /// 加载耗时（毫秒，仅经 dlopen 钩子加载的镜像非 0）
     public let loadDurationMs: Double
+    /// 已计时的静态初始化器耗时（毫秒，无可计时初始化器时为 nil）
+    public let initializerMs: Double?
     /// 是否为系统库
     public let isSystemLibrary: Bool
+    /// 加载期间的 minor page fault 数量（未启用逐镜像统计时为 nil）
+    public let minorFaults: Int?
+    /// 加载期间的 major page fault 数量（未启用逐镜像统计时为 nil）
+    public let majorFaults: Int?
+    /// rebase 数量（镜像统计不可用时为 nil，下同）
+    public let rebaseCount: Int?
+    /// bind 数量
+    public let bindCount: Int?
+    /// 代码段大小（字节）
+    public let textSize: UInt64?
+    /// 数据段大小（字节）
+    public let dataSize: UInt64?
+    /// 静态初始化器数量
+    public let initializerCount: Int?
+    /// 平均每个修正的加载耗时（毫秒，无修正时为 nil）
+    public let msPerFixup: Double?
 
-    public init(name: String, loadDurationMs: Double, isSystemLibrary: Bool) {
+    public init(
+        name: String,
+        loadDurationMs: Double,
+        initializerMs: Double? = nil,
+        isSystemLibrary: Bool,
+        minorFaults: Int? = nil,
+        majorFaults: Int? = nil,
+        rebaseCount: Int? = nil,
+        bindCount: Int? = nil,
+        textSize: UInt64? = nil,
+        dataSize: UInt64? = nil,
+        initializerCount: Int? = nil,
+        msPerFixup: Double? = nil
+    ) {
         self.name = name
         self.loadDurationMs = loadDurationMs
+        self.initializerMs = initializerMs
         self.isSystemLibrary = isSystemLibrary
+        self.minorFaults = minorFaults
+        self.majorFaults = majorFaults
+        self.rebaseCount = rebaseCount
+        self.bindCount = bindCount
+        self.textSize = textSize
+        self.dataSize = dataSize
+        self.initializerCount = initializerCount
+        self.msPerFixup = msPerFixup
+    }
+}
+
+/// 资源使用数据（用于事件传输）
+public struct ResourceUsageData: Codable, Sendable {
+    /// minor page fault 数量
+    public let minorFaults: UInt64
+    /// major page fault 数量
+    public let majorFaults: UInt64
+    /// 块设备读入次数
+    public let blockInputOps: UInt64
+
+    public init(minorFaults: UInt64, majorFaults: UInt64, blockInputOps: UInt64) {
+        self.minorFaults = minorFaults
+        self.majorFaults = majorFaults
+        self.blockInputOps = blockInputOps
+    }
+}
+
+/// PreMain 各阶段缺页与读盘数据（用于事件传输）
+public struct PreMainPhaseFaultsData: Codable, Sendable {
+    /// constructor 到 main
+    public let total: ResourceUsageData
+    /// dylib 加载阶段
+    public let dylibLoading: ResourceUsageData
+    /// 静态初始化器阶段
+    public let staticInitializer: ResourceUsageData
+    /// dyld 结束到 main
+    public let postDyldToMain: ResourceUsageData
+
+    public init(
+        total: ResourceUsageData,
+        dylibLoading: ResourceUsageData,
+        staticInitializer: ResourceUsageData,
+        postDyldToMain: ResourceUsageData
+    ) {
+        self.total = total
+        self.dylibLoading = dylibLoading
+        self.staticInitializer = staticInitializer
+        self.postDyldToMain = postDyldToMain
+    }
+}
+
+/// 静态初始化器耗时数据（用于事件传输）
+public struct InitializerInfoData: Codable, Sendable {
+    /// 所属镜像名称
+    public let imageName: String
+    /// 函数符号名（不可见时为 镜像名+地址）
+    public let symbolName: String
+    /// 执行耗时（毫秒）
+    public let durationMs: Double
+
+    public init(imageName: String, symbolName: String, durationMs: Double) {
+        self.imageName = imageName
+        self.symbolName = symbolName
+        self.durationMs = durationMs
     }
 }
 
@@ -69,6 +69,15 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
     /// 是否启用 UIKit 自动采集
     public var pageTimingAutoTrackingEnabled: Bool = true
 
+    // MARK: - dlopen Configuration
+
+    /// 是否监控 dlopen 阻塞耗时（需挂接 dlopen 钩子，见 PreMainMonitor.setDlopenTracingEnabled）
+    /// 钩子未挂接时 start() 会记录警告并将其重置为 false
+    public var monitorDlopen: Bool = false
+
+    /// 主线程 dlopen 耗时超过该阈值（毫秒）时按卡顿上报
+    public var dlopenJankThresholdMs: Double = 16
+
     // MARK: - Private Properties
 
     private weak var context: PluginContext?
@@ -95,6 +104,8 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
     private var alertChecker: AlertChecker?
     /// 智能采样控制器
     private var smartSampler: SmartSampler?
+    /// 已处理的最大 dlopen 事件序号
+    private var lastDlopenSequence: UInt64 = 0
 
     /// App 启动阶段时间记录
     private static var phaseTimestamps: [LaunchPhase: CFAbsoluteTime] = [:]
@@ -134,9 +145,10 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
             phaseTimestamps[phase] = now
         }
 
-        // 当首帧渲染完成时，计算最终指标
+        // 当首帧渲染完成时，计算最终指标，并作为代码页追踪的启动完成时刻
         if phase == .firstFrameRendered {
             calculateLaunchMetrics()
+            PreMainMonitor.markLaunchComplete()
         }
     }
 
@@ -202,8 +214,9 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
         var totalLaunchTime: Double?
 
         // PreMain: 优先使用 PreMainMonitor 的精确数据
-        let preMainDurations = PreMainMonitor.durations
-        if PreMainMonitor.isMainExecutedMarked, preMainDurations.totalPreMainMs > 0 {
+        let preMainSnapshot = PreMainMonitor.snapshot()
+        let preMainDurations = preMainSnapshot.durations
+        if preMainSnapshot.isMainExecutedMarked, preMainDurations.totalPreMainMs > 0 {
             // 使用 dyld 回调 + mach_absolute_time 的精确数据
             // 加上估算的内核启动时间，得到完整的 PreMain 时间
             preMainTime = preMainDurations.estimatedFullPreMainMs
@@ -228,11 +241,13 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
         }
 
         // 缓存 PreMain 详细数据
-        if PreMainMonitor.isMainExecutedMarked {
+        if preMainSnapshot.isMainExecutedMarked {
             cachedPreMainDetails = PreMainDetails(
                 durations: preMainDurations,
-                dylibStats: PreMainMonitor.dylibStats,
-                slowestDylibs: PreMainMonitor.getSlowestDylibs(count: 20)
+                dylibStats: preMainSnapshot.dylibStats,
+                slowestDylibs: PreMainMonitor.getSlowestDylibs(count: 20),
+                slowestInitializers: PreMainMonitor.getSlowestInitializers(count: 20),
+                phaseFaults: preMainSnapshot.phaseFaults
             )
         }
 
@@ -258,7 +273,7 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
         PreMainMonitor.getAllDylibs()
     }
 
-    /// 获取加载最慢的 N 个 dylib
+    /// 获取启动开销最大的 N 个 dylib（加载耗时 + 已计时的初始化器耗时，相同时按修正数量排序）
     public static func getSlowestDylibs(count: Int) -> [DylibLoadInfo] {
         PreMainMonitor.getSlowestDylibs(count: count)
     }
@@ -268,6 +283,11 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
         PreMainMonitor.getUserDylibs()
     }
 
+    /// 获取启动时间线（Chrome Trace Event JSON，可在 Perfetto 直接打开）
+    public static func launchTraceJSON() -> Data {
+        PreMainMonitor.exportChromeTrace()
+    }
+
     /// 重置启动记录（用于热启动场景）
     public static func resetLaunchRecording() {
         launchMetricsLock.lock()
@@ -341,6 +361,15 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
             setupPageTimingRecorder()
         }
 
+        // 开启 dlopen 计时（启动期间已记录的事件会在首次采样时一并检查）
+        if monitorDlopen, !PreMainMonitor.setDlopenTracingEnabled(true) {
+            monitorDlopen = false
+            context?.logWarning(
+                "monitorDlopen ignored: dlopen hooks are not compiled in "
+                    + "(Apple needs DP_PREMAIN_DLOPEN_INTERPOSE=1, Linux needs -Wl,--wrap=dlopen,--wrap=dlclose)"
+            )
+        }
+
         // 初始化告警检测器
         alertChecker = AlertChecker(config: alertConfig) { [weak self] alert in
             self?.reportAlert(alert)
@@ -410,6 +439,9 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
         diskIOMonitor = nil
         alertChecker = nil
         smartSampler = nil
+        if monitorDlopen {
+            PreMainMonitor.setDlopenTracingEnabled(false)
+        }
 
         // 停止页面耗时记录器
         stopPageTimingRecorder()
@@ -440,6 +472,9 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
         case "get_current_metrics":
             await handleGetCurrentMetrics(command)
 
+        case "get_launch_trace":
+            handleGetLaunchTrace(command)
+
         // 告警相关命令
         case "get_alert_config":
             await handleGetAlertConfig(command)
@@ -578,6 +613,11 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
         // 告警检测
         alertChecker?.checkMetrics(metrics)
 
+        // 主线程 dlopen 卡顿
+        if monitorDlopen {
+            reportDlopenJankEvents()
+        }
+
         // 添加到批次
         batchLock.lock()
         metricsBatch.append(metrics)
@@ -662,18 +702,85 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
                 DylibLoadInfoData(
                     name: dylib.name,
                     loadDurationMs: dylib.loadDurationMs,
-                    isSystemLibrary: dylib.isSystemLibrary
+                    initializerMs: dylib.initializerNanos > 0 ? dylib.initializerMs : nil,
+                    isSystemLibrary: dylib.isSystemLibrary,
+                    minorFaults: dylib.minorFaults > 0 ? dylib.minorFaults : nil,
+                    majorFaults: dylib.majorFaults > 0 ? dylib.majorFaults : nil,
+                    rebaseCount: dylib.imageStats?.rebaseCount,
+                    bindCount: dylib.imageStats?.bindCount,
+                    textSize: dylib.imageStats?.textSize,
+                    dataSize: dylib.imageStats?.dataSize,
+                    initializerCount: dylib.imageStats?.initializerCount,
+                    msPerFixup: dylib.msPerFixup
                 )
             }
 
+            let slowestInitializersData = details.slowestInitializers.map { initializer in
+                InitializerInfoData(
+                    imageName: initializer.imageName,
+                    symbolName: initializer.displayName,
+                    durationMs: initializer.durationMs
+                )
+            }
+
+            let usageData = { (usage: ResourceUsage) in
+                ResourceUsageData(
+                    minorFaults: usage.minorFaults,
+                    majorFaults: usage.majorFaults,
+                    blockInputOps: usage.blockInputOps
+                )
+            }
+            let faults = details.phaseFaults
+            let phaseFaultsData = PreMainPhaseFaultsData(
+                total: usageData(faults.total),
+                dylibLoading: usageData(faults.dylibLoading),
+                staticInitializer: usageData(faults.staticInitializer),
+                postDyldToMain: usageData(faults.postDyldToMain)
+            )
+
             preMainDetailsData = PreMainDetailsData(
                 dylibLoadingMs: details.durations.dylibLoadingMs,
                 staticInitializerMs: details.durations.staticInitializerMs,
                 postDyldToMainMs: details.durations.postDyldToMainMs,
                 objcLoadMs: details.durations.objcLoadMs > 0 ? details.durations.objcLoadMs : nil,
                 estimatedKernelToConstructorMs: details.durations.estimatedKernelToConstructorMs,
+                estimatedKernelToConstructorErrorMs: details.durations.estimatedKernelToConstructorErrorMs,
                 dylibStats: dylibStatsData,
-                slowestDylibs: slowestDylibsData
+                slowestDylibs: slowestDylibsData,
+                slowestInitializers: slowestInitializersData.isEmpty ? nil : slowestInitializersData,
+                phaseFaults: phaseFaultsData
+            )
+        }
+
+        // 自定义启动标记
+        let launchMarkersData = PreMainMonitor.launchMarkers().markers.map { marker in
+            LaunchMarkerData(
+                name: marker.name,
+                kind: String(describing: marker.kind),
+                offsetMs: marker.offsetMs,
+                durationMs: marker.durationMs,
+                threadId: marker.threadId,
+                isMainThread: marker.isMainThread
+            )
+        }
+
+        // 跨启动趋势（本次记录由后台线程在 main() 标记后写入，尚未落盘时 trend 只给出基线分位数）
+        let trend = LaunchHistory.open()?.trend()
+        let launchTrendData = trend.map { trend in
+            LaunchTrendData(
+                launchCount: trend.launchCount,
+                includesCurrentLaunch: trend.includesCurrentLaunch,
+                totalPreMainP50Ms: trend.totalPreMain.p50Ms,
+                totalPreMainP90Ms: trend.totalPreMain.p90Ms,
+                dylibLoadingP50Ms: trend.dylibLoading.p50Ms,
+                dylibLoadingP90Ms: trend.dylibLoading.p90Ms,
+                regressedImages: trend.regressedImages.map { regression in
+                    LaunchImageRegressionData(
+                        name: regression.name,
+                        currentMs: regression.currentMs,
+                        baselineP50Ms: regression.baselineP50Ms
+                    )
+                }
             )
         }
 
@@ -683,7 +790,9 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
             mainToLaunchTime: launchMetrics.mainToLaunchTime,
             launchToFirstFrameTime: launchMetrics.launchToFirstFrameTime,
             timestamp: launchMetrics.timestamp,
-            preMainDetails: preMainDetailsData
+            preMainDetails: preMainDetailsData,
+            launchMarkers: launchMarkersData.isEmpty ? nil : launchMarkersData,
+            launchTrend: launchTrendData
         )
         let performanceEvent = PerformanceEvent(
             eventType: .appLaunch,
@@ -709,6 +818,18 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
             if let dylibStats = details.dylibStats {
                 logParts.append("dylibs=\(dylibStats.totalCount)(\(dylibStats.userCount) user)")
             }
+            if let total = details.phaseFaults?.total {
+                logParts.append("faults=\(total.minorFaults)/\(total.majorFaults) major")
+            }
+        }
+        if let trend, trend.launchCount > 1 {
+            logParts.append(
+                "preMainTrend=p50 \(String(format: "%.1f", trend.totalPreMain.p50Ms))ms"
+                    + "/p90 \(String(format: "%.1f", trend.totalPreMain.p90Ms))ms over \(trend.launchCount) launches"
+            )
+            if !trend.regressedImages.isEmpty {
+                logParts.append("regressedImages=\(trend.regressedImages.map(\.name).joined(separator: ","))")
+            }
         }
         context?.logInfo(logParts.joined(separator: ", "))
 
@@ -777,7 +898,8 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
             timestamp: event.timestamp,
             duration: event.duration,
             droppedFrames: event.droppedFrames,
-            stackTrace: event.stackTrace
+            stackTrace: event.stackTrace,
+            cause: event.cause
         )
         let performanceEvent = PerformanceEvent(
             eventType: .jank,
@@ -786,6 +908,33 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
         EventCallbacks.reportEvent(.performance(performanceEvent))
     }
 
+    /// 将新增的超过阈值的主线程 dlopen 按卡顿上报（原因直接归因到对应镜像）
+    private func reportDlopenJankEvents() {
+        let snapshot = PreMainMonitor.dlopenEvents(after: lastDlopenSequence)
+        guard let last = snapshot.events.last else { return }
+        lastDlopenSequence = last.sequence
+
+        let referenceMachTime = PreMainMonitor.currentMachTime
+        let now = Date()
+        for event in snapshot.events where event.kind == .open && event.isMainThread {
+            let durationMs = event.durationMs
+            guard durationMs >= dlopenJankThresholdMs else { continue }
+
+            let elapsedSeconds = referenceMachTime >= event.machTime
+                ? PreMainMonitor.machTimeToMillis(referenceMachTime - event.machTime) / 1000
+                : 0
+            reportJankEvent(JankEvent(
+                id: UUID().uuidString,
+                timestamp: now.addingTimeInterval(-elapsedSeconds),
+                duration: durationMs,
+                droppedFrames: Int(durationMs / 16.67),
+                stackTrace: nil,
+                cause: "dlopen \(event.path)"
+            ))
+            context?.logWarning("Main thread dlopen blocked \(String(format: "%.1f", durationMs))ms: \(event.path)")
+        }
+    }
+
     private func reportAlert(_ alert: Alert) {
         let alertData = AlertData(
             id: alert.id,
@@ -935,6 +1084,17 @@ public final class PerformancePlugin: DebugProbePlugin, @unchecked Sendable {
         }
     }
 
+    /// 启动时间线已是 JSON，直接作为响应负载整块发送
+    private func handleGetLaunchTrace(_ command: PluginCommand) {
+        let response = PluginCommandResponse(
+            pluginId: pluginId,
+            commandId: command.commandId,
+            success: true,
+            payload: Self.launchTraceJSON()
+        )
+        context?.sendCommandResponse(response)
+    }
+
     // MARK: - Alert Command Handlers
 
     private func handleGetAlertConfig(_ command: PluginCommand) async {
@@ -1199,17 +1359,27 @@ public struct PreMainDetails: Codable, Sendable {
     /// dylib 统计信息
     public let dylibStats: DylibStats
 
-    /// 加载最慢的 dylib 列表
+    /// 启动开销最大的 dylib 列表（按 launchCostMs 降序）
     public let slowestDylibs: [DylibLoadInfo]
 
+    /// 执行最慢的静态初始化器列表
+    public let slowestInitializers: [InitializerTiming]
+
+    /// 各阶段缺页与读盘统计
+    public let phaseFaults: PreMainPhaseFaults
+
     public init(
         durations: PreMainDurations,
         dylibStats: DylibStats,
-        slowestDylibs: [DylibLoadInfo]
+        slowestDylibs: [DylibLoadInfo],
+        slowestInitializers: [InitializerTiming] = [],
+        phaseFaults: PreMainPhaseFaults = PreMainPhaseFaults()
     ) {
         self.durations = durations
         self.dylibStats = dylibStats
         self.slowestDylibs = slowestDylibs
+        self.slowestInitializers = slowestInitializers
+        self.phaseFaults = phaseFaults
     }
 }
 
@@ -1252,6 +1422,8 @@ public struct JankEvent: Codable, Sendable {
     public let droppedFrames: Int
     /// 主线程调用栈（如果可获取）
     public let stackTrace: String?
+    /// 已知的卡顿原因（如主线程 dlopen），由帧率检测到的卡顿为 nil
+    public var cause: String? = nil
 }
 
 // MARK: - Alert Models
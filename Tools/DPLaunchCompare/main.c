@@ -0,0 +1,556 @@
+//
+//  main.c
+//  DPLaunchCompare
+//
+//  离线启动对比工具：比较两组启动历史文件（如两个构建版本从设备上导出的 DPLaunchHistory.bin）
+//  与 PreMain 监控共用同一份 C 源码读取文件，可在 Linux 上运行，发版门禁不依赖 Mac
+//
+//  对比项：
+//  - phase.*:  各阶段耗时（毫秒）与缺页数量
+//  - image.*:  各镜像启动开销（毫秒，加载耗时 + 已计时初始化器耗时，按镜像文件名聚合）
+//              历史每次只保留开销最大的 DP_LAUNCH_HISTORY_MAX_IMAGES 个镜像，未上榜的启动没有样本，
+//              只比较两组每次启动都有记录的镜像，避免截断造成的偏差；
+//              任一组没有镜像开销数据时在 stderr 提示，此时只有 phase.* 参与比较
+//
+//  统计方法：
+//  1. Mann-Whitney U 检验（双侧，含并列秩校正与连续性校正的正态近似）
+//  2. 效应量 Cliff's delta = P(候选 > 基线) - P(候选 < 基线)，|d| < 0.147 视为可忽略
+//  3. 偏移量 Hodges-Lehmann 估计（候选与基线两两差值的中位数）
+//  4. 多重比较按 Benjamini-Hochberg 校正为 q 值
+//  q < alpha、候选更慢、效应量不低于 --min-effect，且偏移量同时达到实际意义下限
+//  （耗时项 --min-shift-ms 毫秒，所有项 --min-relative-shift 相对基线中位数）的项为显著回退，
+//  未达下限的项视为无变化；
+//  耗时项按绝对偏移（毫秒）降序排在前面，缺页项按相对偏移降序排在其后
+//
+//  用法：
+//    DPLaunchCompare --baseline <file> [--baseline <file> ...] --candidate <file> [--candidate <file> ...]
+//                    [--alpha 0.05] [--min-effect 0.147] [--min-shift-ms 1] [--min-relative-shift 0.05]
+//                    [--min-samples 5] [--all] [--json]
+//
+//  --json 每行输出一个 JSON 对象；存在显著回退时以退出码 2 结束，可直接作为发版门禁
+//
+//  Created by Sun on 2025/12/18.
+//  Copyright © 2025 Sun. All rights reserved.
+//
+
+#include "DPPreMainMonitor.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// MARK: - 常量定义
+
+/// 每组最多的输入文件数量
+#define DP_COMPARE_MAX_FILES 64
+
+/// 对比项名称最大长度
+#define DP_COMPARE_NAME_LENGTH (DP_MAX_DYLIB_NAME_LENGTH + 16)
+
+/// 两两差值数量超过该值时，偏移量退化为中位数之差
+#define DP_COMPARE_MAX_PAIRS (4 * 1024 * 1024)
+
+// MARK: - 数据结构
+
+/// 样本组
+typedef struct {
+    double* values;
+    uint32_t count;
+    uint32_t capacity;
+} DPSampleSet;
+
+/// 对比项
+typedef struct {
+    char name[DP_COMPARE_NAME_LENGTH];
+    /// 单位（"ms" 或 "faults"）
+    const char* unit;
+    /// 0 为基线，1 为候选
+    DPSampleSet samples[2];
+    /// 创建顺序（阶段项按固定顺序输出）
+    uint32_t order;
+    /// 每组中出现该项的启动次数
+    uint32_t launches[2];
+    /// 最近一次追加样本的启动序号（从 1 开始，用于统计出现次数）
+    uint32_t lastLaunch[2];
+
+    // 统计结果
+    bool tested;
+    double baselineMedian;
+    double candidateMedian;
+    double shift;
+    double relativeShift;
+    double cliffsDelta;
+    double pValue;
+    double qValue;
+    bool regression;
+} DPCompareMetric;
+
+/// 配置
+typedef struct {
+    const char* files[2][DP_COMPARE_MAX_FILES];
+    uint32_t fileCount[2];
+    double alpha;
+    double minEffect;
+    double minShiftMs;
+    double minRelativeShift;
+    uint32_t minSamples;
+    bool all;
+    bool json;
+} DPCompareConfig;
+
+// MARK: - 全局数据
+
+static DPCompareMetric* g_metrics = NULL;
+static uint32_t g_metricCount = 0;
+static uint32_t g_metricCapacity = 0;
+
+/// 每组读取到的启动次数
+static uint32_t g_launchCount[2];
+
+// MARK: - 样本收集
+
+static bool dp_samples_append(DPSampleSet* set, double value) {
+    if (set->count == set->capacity) {
+        uint32_t capacity = set->capacity > 0 ? set->capacity * 2 : 64;
+        double* values = realloc(set->values, capacity * sizeof(double));
+        if (values == NULL) return false;
+        set->values = values;
+        set->capacity = capacity;
+    }
+    set->values[set->count++] = value;
+    return true;
+}
+
+/// 按名称查找对比项，不存在时创建
+static DPCompareMetric* dp_metric_named(const char* name, const char* unit) {
+    for (uint32_t i = 0; i < g_metricCount; i++) {
+        if (strcmp(g_metrics[i].name, name) == 0) {
+            return &g_metrics[i];
+        }
+    }
+
+    if (g_metricCount == g_metricCapacity) {
+        uint32_t capacity = g_metricCapacity > 0 ? g_metricCapacity * 2 : 64;
+        DPCompareMetric* metrics = realloc(g_metrics, capacity * sizeof(DPCompareMetric));
+        if (metrics == NULL) return NULL;
+        g_metrics = metrics;
+        g_metricCapacity = capacity;
+    }
+
+    DPCompareMetric* metric = &g_metrics[g_metricCount++];
+    memset(metric, 0, sizeof(*metric));
+    snprintf(metric->name, sizeof(metric->name), "%s", name);
+    metric->unit = unit;
+    metric->order = g_metricCount - 1;
+    return metric;
+}
+
+/// 每组读取的镜像记录数量，与其中启动开销不为 0 的数量
+static uint32_t g_imageRowCount[2] = {0, 0};
+static uint32_t g_costedImageRowCount[2] = {0, 0};
+
+static bool dp_add_sample(int group, const char* name, const char* unit, double value) {
+    DPCompareMetric* metric = dp_metric_named(name, unit);
+    if (metric == NULL) {
+        return false;
+    }
+    if (metric->lastLaunch[group] != g_launchCount[group]) {
+        metric->lastLaunch[group] = g_launchCount[group];
+        metric->launches[group]++;
+    }
+    return dp_samples_append(&metric->samples[group], value);
+}
+
+/// 读取一个启动历史文件中的全部记录
+static bool dp_load_file(int group, const char* path) {
+    DPLaunchHistory* history = DPLaunchHistoryOpen(path);
+    if (history == NULL) {
+        fprintf(stderr, "cannot read launch history %s (missing, or built with a different record layout)\n", path);
+        return false;
+    }
+
+    bool ok = true;
+    uint32_t count = DPLaunchHistoryGetCount(history);
+    for (uint32_t i = 0; i < count && ok; i++) {
+        const DPLaunchHistoryRecord* record = DPLaunchHistoryGetRecord(history, i);
+        if (record == NULL) continue;
+        g_launchCount[group]++;
+
+        ok = dp_add_sample(group, "phase.totalPreMain", "ms", (double)record->totalPreMainNanos / 1e6)
+            && dp_add_sample(group, "phase.dylibLoading", "ms", (double)record->dylibLoadingNanos / 1e6)
+            && dp_add_sample(group, "phase.staticInitializer", "ms", (double)record->staticInitializerNanos / 1e6)
+            && dp_add_sample(group, "phase.postDyldToMain", "ms", (double)record->postDyldToMainNanos / 1e6)
+            && dp_add_sample(group, "phase.objcLoad", "ms", (double)record->objcLoadNanos / 1e6)
+            && dp_add_sample(group, "phase.kernelToConstructor", "ms",
+                             (double)record->estimatedKernelToConstructorNanos / 1e6)
+            && dp_add_sample(group, "phase.minorFaults", "faults", (double)record->phaseFaults.total.minorFaults)
+            && dp_add_sample(group, "phase.majorFaults", "faults", (double)record->phaseFaults.total.majorFaults);
+
+        const DPLaunchHistoryImage* images = DPLaunchHistoryGetImages(record);
+        for (uint32_t j = 0; j < record->imageCount && ok; j++) {
+            const char* imageName = DPLaunchHistoryGetName(history, images[j].nameOffset);
+            if (imageName[0] == '\0') continue;
+
+            char name[DP_COMPARE_NAME_LENGTH];
+            snprintf(name, sizeof(name), "image.%s", imageName);
+            uint64_t costNanos = images[j].loadDurationNanos + images[j].initializerNanos;
+            g_imageRowCount[group]++;
+            if (costNanos > 0) g_costedImageRowCount[group]++;
+            ok = dp_add_sample(group, name, "ms", (double)costNanos / 1e6);
+        }
+    }
+
+    DPLaunchHistoryClose(history);
+    if (!ok) {
+        fprintf(stderr, "out of memory while reading %s\n", path);
+    }
+    return ok;
+}
+
+// MARK: - 统计
+
+static int dp_compare_double(const void* a, const void* b) {
+    double lhs = *(const double*)a;
+    double rhs = *(const double*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/// 已排序数组的中位数
+static double dp_median_sorted(const double* sorted, size_t count) {
+    if (count == 0) return 0;
+    return count % 2 == 1 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+}
+
+/// 合并排序用的带组别样本
+typedef struct {
+    double value;
+    int group;
+} DPRankedValue;
+
+static int dp_compare_ranked(const void* a, const void* b) {
+    return dp_compare_double(&((const DPRankedValue*)a)->value, &((const DPRankedValue*)b)->value);
+}
+
+/// Mann-Whitney U 检验
+/// @param outCandidateU 候选组的 U 统计量（候选 > 基线的配对数，并列计 0.5）
+/// @return 双侧 p 值
+static double dp_mann_whitney(const DPSampleSet* baseline, const DPSampleSet* candidate, double* outCandidateU) {
+    size_t n1 = baseline->count;
+    size_t n2 = candidate->count;
+    size_t n = n1 + n2;
+
+    DPRankedValue* ranked = malloc(n * sizeof(DPRankedValue));
+    if (ranked == NULL) {
+        *outCandidateU = (double)(n1 * n2) / 2;
+        return 1;
+    }
+    for (size_t i = 0; i < n1; i++) ranked[i] = (DPRankedValue){ baseline->values[i], 0 };
+    for (size_t i = 0; i < n2; i++) ranked[n1 + i] = (DPRankedValue){ candidate->values[i], 1 };
+    qsort(ranked, n, sizeof(DPRankedValue), dp_compare_ranked);
+
+    // 并列值取平均秩，同时累计并列校正项 sum(t^3 - t)
+    double candidateRankSum = 0;
+    double tieTerm = 0;
+    for (size_t start = 0; start < n;) {
+        size_t end = start + 1;
+        while (end < n && ranked[end].value == ranked[start].value) end++;
+
+        double averageRank = (double)(start + 1 + end) / 2;
+        for (size_t i = start; i < end; i++) {
+            if (ranked[i].group == 1) candidateRankSum += averageRank;
+        }
+        double t = (double)(end - start);
+        tieTerm += t * t * t - t;
+        start = end;
+    }
+    free(ranked);
+
+    double candidateU = candidateRankSum - (double)n2 * (double)(n2 + 1) / 2;
+    *outCandidateU = candidateU;
+
+    double mean = (double)n1 * (double)n2 / 2;
+    double variance = (double)n1 * (double)n2 / 12
+        * ((double)(n + 1) - tieTerm / ((double)n * (double)(n - 1)));
+    if (variance <= 0) {
+        return 1;
+    }
+
+    double z = (fabs(candidateU - mean) - 0.5) / sqrt(variance);
+    if (z < 0) z = 0;
+    return erfc(z / sqrt(2.0));
+}
+
+/// Hodges-Lehmann 偏移估计（候选 - 基线）
+static double dp_hodges_lehmann(const DPSampleSet* baseline, const DPSampleSet* candidate,
+                                double baselineMedian, double candidateMedian) {
+    size_t pairs = (size_t)baseline->count * candidate->count;
+    double* differences = pairs <= DP_COMPARE_MAX_PAIRS ? malloc(pairs * sizeof(double)) : NULL;
+    if (differences == NULL) {
+        return candidateMedian - baselineMedian;
+    }
+
+    size_t k = 0;
+    for (uint32_t i = 0; i < baseline->count; i++) {
+        for (uint32_t j = 0; j < candidate->count; j++) {
+            differences[k++] = candidate->values[j] - baseline->values[i];
+        }
+    }
+    qsort(differences, pairs, sizeof(double), dp_compare_double);
+    double shift = dp_median_sorted(differences, pairs);
+    free(differences);
+    return shift;
+}
+
+/// 因未在每次启动中都有记录而跳过的镜像数量
+static uint32_t g_partialImageCount = 0;
+
+/// 计算单个对比项
+static void dp_analyze_metric(DPCompareMetric* metric, const DPCompareConfig* config) {
+    DPSampleSet* baseline = &metric->samples[0];
+    DPSampleSet* candidate = &metric->samples[1];
+    if (baseline->count < config->minSamples || candidate->count < config->minSamples) {
+        return;
+    }
+
+    // 镜像只在上榜的启动中有样本，缺失的启动并非耗时为 0，部分缺失的镜像不参与比较
+    if (strncmp(metric->name, "image.", 6) == 0
+        && (metric->launches[0] != g_launchCount[0] || metric->launches[1] != g_launchCount[1])) {
+        g_partialImageCount++;
+        return;
+    }
+
+    qsort(baseline->values, baseline->count, sizeof(double), dp_compare_double);
+    qsort(candidate->values, candidate->count, sizeof(double), dp_compare_double);
+
+    // 两组全为 0 的项（如未记录 ObjC +load）没有比较意义
+    if (baseline->values[baseline->count - 1] == 0 && candidate->values[candidate->count - 1] == 0) {
+        return;
+    }
+
+    double candidateU = 0;
+    metric->tested = true;
+    metric->baselineMedian = dp_median_sorted(baseline->values, baseline->count);
+    metric->candidateMedian = dp_median_sorted(candidate->values, candidate->count);
+    metric->pValue = dp_mann_whitney(baseline, candidate, &candidateU);
+    metric->cliffsDelta = 2 * candidateU / ((double)baseline->count * (double)candidate->count) - 1;
+    metric->shift = dp_hodges_lehmann(baseline, candidate, metric->baselineMedian, metric->candidateMedian);
+    metric->relativeShift = metric->baselineMedian > 0 ? metric->shift / metric->baselineMedian : 0;
+}
+
+/// Benjamini-Hochberg 校正
+static int dp_compare_metric_p(const void* a, const void* b) {
+    const DPCompareMetric* lhs = *(DPCompareMetric* const*)a;
+    const DPCompareMetric* rhs = *(DPCompareMetric* const*)b;
+    return dp_compare_double(&lhs->pValue, &rhs->pValue);
+}
+
+static void dp_adjust_q_values(void) {
+    DPCompareMetric** tested = malloc(g_metricCount * sizeof(DPCompareMetric*));
+    if (tested == NULL) return;
+
+    uint32_t m = 0;
+    for (uint32_t i = 0; i < g_metricCount; i++) {
+        if (g_metrics[i].tested) tested[m++] = &g_metrics[i];
+    }
+    qsort(tested, m, sizeof(DPCompareMetric*), dp_compare_metric_p);
+
+    double running = 1;
+    for (uint32_t i = m; i > 0; i--) {
+        double q = tested[i - 1]->pValue * m / i;
+        if (q < running) running = q;
+        tested[i - 1]->qValue = running;
+    }
+    free(tested);
+}
+
+// MARK: - 输出
+
+/// 显著回退排在前面（耗时项按绝对偏移、缺页项按相对偏移降序）；其余阶段项在前、镜像项按名称
+static int dp_compare_metric_rank(const void* a, const void* b) {
+    const DPCompareMetric* lhs = a;
+    const DPCompareMetric* rhs = b;
+    if (lhs->regression != rhs->regression) return lhs->regression ? -1 : 1;
+    if (lhs->regression) {
+        bool lhsTime = strcmp(lhs->unit, "ms") == 0;
+        bool rhsTime = strcmp(rhs->unit, "ms") == 0;
+        if (lhsTime != rhsTime) return lhsTime ? -1 : 1;
+        return lhsTime ? dp_compare_double(&rhs->shift, &lhs->shift)
+                       : dp_compare_double(&rhs->relativeShift, &lhs->relativeShift);
+    }
+    bool lhsPhase = strncmp(lhs->name, "phase.", 6) == 0;
+    bool rhsPhase = strncmp(rhs->name, "phase.", 6) == 0;
+    if (lhsPhase != rhsPhase) return lhsPhase ? -1 : 1;
+    return lhsPhase ? (lhs->order > rhs->order) - (lhs->order < rhs->order) : strcmp(lhs->name, rhs->name);
+}
+
+static const char* dp_effect_label(double delta) {
+    double magnitude = fabs(delta);
+    if (magnitude < 0.147) return "negligible";
+    if (magnitude < 0.33) return "small";
+    if (magnitude < 0.474) return "medium";
+    return "large";
+}
+
+/// JSON 字符串（镜像名只含可打印字符，仅转义引号与反斜杠）
+static void dp_print_json_string(const char* string) {
+    putchar('"');
+    for (const char* cursor = string; *cursor != '\0'; cursor++) {
+        if (*cursor == '"' || *cursor == '\\') putchar('\\');
+        putchar((unsigned char)*cursor < 0x20 ? '?' : *cursor);
+    }
+    putchar('"');
+}
+
+static void dp_print_results(const DPCompareConfig* config, uint32_t regressionCount) {
+    if (!config->json) {
+        printf("baseline: %u file(s), %u launches; candidate: %u file(s), %u launches\n\n",
+               config->fileCount[0], g_launchCount[0], config->fileCount[1], g_launchCount[1]);
+        printf("%-40s %5s %5s %10s %10s %10s %8s %7s %-10s %9s %9s\n",
+               "metric", "n_b", "n_c", "p50_b", "p50_c", "shift", "change", "delta", "effect", "p", "q");
+    }
+
+    for (uint32_t i = 0; i < g_metricCount; i++) {
+        const DPCompareMetric* metric = &g_metrics[i];
+        if (!metric->tested) continue;
+        // 默认只输出阶段项与显著回退的镜像
+        if (!config->all && !metric->regression && strncmp(metric->name, "phase.", 6) != 0) continue;
+
+        if (config->json) {
+            printf("{\"metric\":");
+            dp_print_json_string(metric->name);
+            printf(",\"unit\":\"%s\",\"baselineSamples\":%u,\"candidateSamples\":%u,"
+                   "\"baselineP50\":%.4f,\"candidateP50\":%.4f,\"shift\":%.4f,\"relativeShift\":%.4f,"
+                   "\"cliffsDelta\":%.4f,\"effect\":\"%s\",\"p\":%.6g,\"q\":%.6g,\"regression\":%s}\n",
+                   metric->unit, metric->samples[0].count, metric->samples[1].count,
+                   metric->baselineMedian, metric->candidateMedian, metric->shift, metric->relativeShift,
+                   metric->cliffsDelta, dp_effect_label(metric->cliffsDelta), metric->pValue, metric->qValue,
+                   metric->regression ? "true" : "false");
+        } else {
+            printf("%-40.40s %5u %5u %10.3f %10.3f %+10.3f %+7.1f%% %+7.3f %-10s %9.2g %9.2g%s\n",
+                   metric->name, metric->samples[0].count, metric->samples[1].count,
+                   metric->baselineMedian, metric->candidateMedian, metric->shift, metric->relativeShift * 100,
+                   metric->cliffsDelta, dp_effect_label(metric->cliffsDelta), metric->pValue, metric->qValue,
+                   metric->regression ? "  REGRESSION" : "");
+        }
+    }
+
+    if (!config->json) {
+        printf("\n%u significant regression(s) (q < %.3g, |delta| >= %.3g, shift >= %.3g ms and >= %.3g%%)\n",
+               regressionCount, config->alpha, config->minEffect, config->minShiftMs, config->minRelativeShift * 100);
+        if (g_partialImageCount > 0) {
+            printf("%u image(s) not compared: missing from some launches (history keeps the %u costliest per launch)\n",
+                   g_partialImageCount, (unsigned)DP_LAUNCH_HISTORY_MAX_IMAGES);
+        }
+        uint32_t rank = 0;
+        for (uint32_t i = 0; i < g_metricCount && rank < regressionCount; i++) {
+            const DPCompareMetric* metric = &g_metrics[i];
+            if (!metric->regression) continue;
+            printf("%3u. %s: %.3f -> %.3f %s (%+.3f, %+.1f%%, delta %.2f)\n",
+                   ++rank, metric->name, metric->baselineMedian, metric->candidateMedian, metric->unit,
+                   metric->shift, metric->relativeShift * 100, metric->cliffsDelta);
+        }
+    }
+}
+
+// MARK: - 入口
+
+static bool dp_parse_args(int argc, char** argv, DPCompareConfig* config) {
+    memset(config, 0, sizeof(*config));
+    config->alpha = 0.05;
+    config->minEffect = 0.147;
+    config->minShiftMs = 1.0;
+    config->minRelativeShift = 0.05;
+    config->minSamples = 5;
+
+    for (int i = 1; i < argc; i++) {
+        int group = -1;
+        if (strcmp(argv[i], "--baseline") == 0) {
+            group = 0;
+        } else if (strcmp(argv[i], "--candidate") == 0) {
+            group = 1;
+        }
+
+        if (group >= 0 && i + 1 < argc) {
+            if (config->fileCount[group] == DP_COMPARE_MAX_FILES) return false;
+            config->files[group][config->fileCount[group]++] = argv[++i];
+        } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            config->alpha = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--min-effect") == 0 && i + 1 < argc) {
+            config->minEffect = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--min-shift-ms") == 0 && i + 1 < argc) {
+            config->minShiftMs = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--min-relative-shift") == 0 && i + 1 < argc) {
+            config->minRelativeShift = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--min-samples") == 0 && i + 1 < argc) {
+            config->minSamples = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--all") == 0) {
+            config->all = true;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            config->json = true;
+        } else {
+            return false;
+        }
+    }
+    return config->fileCount[0] > 0 && config->fileCount[1] > 0
+        && config->alpha > 0 && config->alpha < 1 && config->minSamples >= 2
+        && config->minShiftMs >= 0 && config->minRelativeShift >= 0;
+}
+
+int main(int argc, char** argv) {
+    DPCompareConfig config;
+    if (!dp_parse_args(argc, argv, &config)) {
+        fprintf(stderr, "usage: %s --baseline <file> [--baseline <file> ...] --candidate <file> [...] "
+                        "[--alpha 0.05] [--min-effect 0.147] [--min-shift-ms 1] [--min-relative-shift 0.05] "
+                        "[--min-samples 5] [--all] [--json]\n", argv[0]);
+        return 64;
+    }
+
+    for (int group = 0; group < 2; group++) {
+        for (uint32_t i = 0; i < config.fileCount[group]; i++) {
+            if (!dp_load_file(group, config.files[group][i])) {
+                return 1;
+            }
+        }
+    }
+
+    // 没有镜像数据时 image.* 不会出现在结果中，明确提示而不是让无回退看起来像镜像都正常
+    static const char* const groupNames[2] = {"baseline", "candidate"};
+    for (int group = 0; group < 2; group++) {
+        if (g_imageRowCount[group] == 0) {
+            fprintf(stderr, "note: %s inputs contain no per-image records; image.* metrics are not compared\n",
+                    groupNames[group]);
+        } else if (g_costedImageRowCount[group] == 0) {
+            fprintf(stderr, "note: %s inputs record %u image(s) but none has a timed load or initializer cost; "
+                            "image.* metrics are not compared\n", groupNames[group], g_imageRowCount[group]);
+        }
+    }
+
+    for (uint32_t i = 0; i < g_metricCount; i++) {
+        dp_analyze_metric(&g_metrics[i], &config);
+    }
+    dp_adjust_q_values();
+
+    uint32_t regressionCount = 0;
+    for (uint32_t i = 0; i < g_metricCount; i++) {
+        DPCompareMetric* metric = &g_metrics[i];
+        // 统计显著但偏移低于实际意义下限（同一二进制多次运行的抖动）的项视为无变化
+        bool isTime = strcmp(metric->unit, "ms") == 0;
+        bool aboveFloor = metric->shift > 0
+            && (!isTime || metric->shift >= config.minShiftMs)
+            && (metric->baselineMedian <= 0 || metric->relativeShift >= config.minRelativeShift);
+        metric->regression = metric->tested && metric->qValue < config.alpha
+            && aboveFloor && metric->cliffsDelta >= config.minEffect;
+        if (metric->regression) regressionCount++;
+    }
+    qsort(g_metrics, g_metricCount, sizeof(DPCompareMetric), dp_compare_metric_rank);
+
+    dp_print_results(&config, regressionCount);
+
+    for (uint32_t i = 0; i < g_metricCount; i++) {
+        free(g_metrics[i].samples[0].values);
+        free(g_metrics[i].samples[1].values);
+    }
+    free(g_metrics);
+    return regressionCount > 0 ? 2 : 0;
+}